@@ -12,6 +12,11 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "ao40short_decode_message.h"
+#include "../../common/ao40_unpack.h"
+
+static const ao40_interleaver_t ao40short_Interleaver = {
+  AO40SHORT_INTERLEAVER_STEP_SIZE, AO40SHORT_INTERLEAVER_ROWS, 0, AO40SHORT_INTERLEAVER_PILOT_BITS
+};
 
 const uint8_t ao40short_Scrambler[320] = {
   0xff, 0x48, 0x0e, 0xc0, 0x9a, 0x0d, 0x70, 0xbc, 0x8e, 0x2c, 0x93, 0xad, 0xa7, 0xb7, 0x46, 0xce,
@@ -45,7 +50,7 @@ const uint8_t ao40short_Scrambler[320] = {
  *   ao40short_viterbi decoder assumes non-inverted bits, so invert every second bit
  *   by hand.
  */
-void ao40short_deinterleave(uint8_t raw[AO40SHORT_RAW_SIZE], uint8_t conv[AO40SHORT_CONV_SIZE]) {
+void ao40short_deinterleave(uint8_t raw[AO40SHORT_RAW_SIZE], AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE]) {
   uint16_t i = 0;
   uint16_t j = 0;
   uint16_t counter = 0;
@@ -67,10 +72,8 @@ void ao40short_deinterleave(uint8_t raw[AO40SHORT_RAW_SIZE], uint8_t conv[AO40SH
 /* Viterbi decoder:
  *   It uses the one generated from http://www.spiral.net/
  */
-void ao40short_viterbi(uint8_t conv[AO40SHORT_CONV_SIZE], uint8_t dec_data[AO40SHORT_RS_SIZE]) {
+void ao40short_viterbi(AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE], uint8_t dec_data[AO40SHORT_RS_SIZE]) {
   struct ao40short_v *vp;
-  AO40SHORT_COMPUTETYPE conv_compute[AO40SHORT_CONV_SIZE];
-  int i;
 
   if((vp = ao40short_create_viterbi(AO40SHORT_FRAMEBITS)) == AO40SHORT_NULL){
     printf("ao40short_create_viterbi failed\n");
@@ -79,19 +82,82 @@ void ao40short_viterbi(uint8_t conv[AO40SHORT_CONV_SIZE], uint8_t dec_data[AO40S
 
   ao40short_init_viterbi(vp, 0);
 
-  // AO40SHORT_COMPUTETYPE is set to uint32, so convert uint8 to uint32
-  // but the softbit value should be between 0 and 255 (!)
-  i = AO40SHORT_CONV_SIZE;
-  while (i--) {
-    conv_compute[i] = conv[i];
-  }
-
-  ao40short_update_viterbi_blk(vp, conv_compute, AO40SHORT_FRAMEBITS+(AO40SHORT_K-1));
+  // the softbit values should be between 0 and 255 (!)
+  ao40short_update_viterbi_blk(vp, conv, AO40SHORT_FRAMEBITS+(AO40SHORT_K-1));
   ao40short_chainback_viterbi(vp, dec_data, AO40SHORT_FRAMEBITS, 0);
 
   ao40short_delete_viterbi(vp);
 }
 
+/* Viterbi soft output:
+ *   Runs the add-compare-select recursion of the SPIRAL decoder once more, but
+ *   also keeps the margin by which the survivor path won at every state. The
+ *   reliability of a decoded byte is the smallest margin along the traced back
+ *   survivor path while the bits of that byte are in the encoder register.
+ *   Only used for frames that the plain RS decoder could not correct.
+ */
+int ao40short_viterbi_reliability(const AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE], uint16_t reliability[AO40SHORT_RS_SIZE]) {
+  uint32_t metrics[2][AO40SHORT_NUMSTATES];
+  uint32_t *old_metrics = metrics[0], *new_metrics = metrics[1], *tmp;
+  uint32_t metric, m0, m1;
+  uint64_t *decisions;
+  uint16_t *margins, path[AO40SHORT_STEPS];
+  int s, i, state;
+
+  margins = malloc(AO40SHORT_STEPS * AO40SHORT_NUMSTATES * sizeof(uint16_t));
+  decisions = malloc(AO40SHORT_STEPS * sizeof(uint64_t));
+  if (margins == AO40SHORT_NULL || decisions == AO40SHORT_NULL) {
+    free(margins);
+    free(decisions);
+    return -1;
+  }
+
+  for (i = 0; i < AO40SHORT_NUMSTATES; ++i)
+    old_metrics[i] = 63;
+  old_metrics[0] = 0;
+
+  for (s = 0; s < AO40SHORT_STEPS; ++s) {
+    decisions[s] = 0;
+    for (i = 0; i < AO40SHORT_NUMSTATES/2; ++i) {
+      metric = (ao40short_Branchtab[i] ^ conv[2*s]) + (ao40short_Branchtab[AO40SHORT_NUMSTATES/2 + i] ^ conv[2*s + 1]);
+
+      m0 = old_metrics[i] + metric;
+      m1 = old_metrics[i + AO40SHORT_NUMSTATES/2] + (510 - metric);
+      new_metrics[2*i] = m0 > m1 ? m1 : m0;
+      decisions[s] |= (uint64_t)(m0 > m1) << (2*i);
+      margins[s*AO40SHORT_NUMSTATES + 2*i] = AO40SHORT_MARGIN(m0, m1);
+
+      m0 = old_metrics[i] + (510 - metric);
+      m1 = old_metrics[i + AO40SHORT_NUMSTATES/2] + metric;
+      new_metrics[2*i + 1] = m0 > m1 ? m1 : m0;
+      decisions[s] |= (uint64_t)(m0 > m1) << (2*i + 1);
+      margins[s*AO40SHORT_NUMSTATES + 2*i + 1] = AO40SHORT_MARGIN(m0, m1);
+    }
+    tmp = old_metrics;
+    old_metrics = new_metrics;
+    new_metrics = tmp;
+  }
+
+  /* The tail bits flush the encoder into state 0 */
+  state = 0;
+  for (s = AO40SHORT_STEPS - 1; s >= 0; --s) {
+    path[s] = margins[s*AO40SHORT_NUMSTATES + state];
+    state = (state >> 1) | (int)(((decisions[s] >> state) & 1) << (AO40SHORT_K - 2));
+  }
+
+  for (i = 0; i < AO40SHORT_RS_SIZE; ++i) {
+    reliability[i] = UINT16_MAX;
+    for (s = 8*i; s < 8*i + 8 + (AO40SHORT_K - 1); ++s) {
+      if (reliability[i] > path[s])
+        reliability[i] = path[s];
+    }
+  }
+
+  free(margins);
+  free(decisions);
+  return 0;
+}
+
 void ao40short_descramble(uint8_t dec_data[AO40SHORT_RS_SIZE], uint8_t rs[AO40SHORT_RS_BLOCK_SIZE]) {
   uint16_t i;
 
@@ -111,15 +177,68 @@ void ao40short_rs_decode(uint8_t rs[AO40SHORT_RS_BLOCK_SIZE], uint8_t data[AO40S
   }
 }
 
+/* Erasure decoding:
+ *   Retries the RS block that could not be corrected with the least reliable
+ *   bytes of the Viterbi output marked as erasures, using more and more
+ *   erasures up to AO40SHORT_MAX_ERASURES.
+ */
+void ao40short_rs_decode_erasures(const AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE], uint8_t rs[AO40SHORT_RS_BLOCK_SIZE], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error) {
+  uint16_t reliability[AO40SHORT_RS_SIZE];
+  uint8_t order[AO40SHORT_RS_BLOCK_SIZE], t;
+  int eras_pos[AO40SHORT_NROOTS];
+  int i, j, no_eras;
+
+  if (ao40short_viterbi_reliability(conv, reliability) != 0)
+    return;
+
+  /* Insertion sort of the block positions, least reliable first */
+  for (i = 0; i < AO40SHORT_RS_BLOCK_SIZE; ++i) {
+    t = (uint8_t)i;
+    for (j = i; j > 0 && reliability[order[j - 1]] > reliability[t]; --j)
+      order[j] = order[j - 1];
+    order[j] = t;
+  }
+
+  for (no_eras = AO40SHORT_ERASURE_STEP; no_eras <= AO40SHORT_MAX_ERASURES; no_eras += AO40SHORT_ERASURE_STEP) {
+    /* Erasure positions are counted in the full codeword, including the padding */
+    for (i = 0; i < no_eras; ++i)
+      eras_pos[i] = order[i] + AO40SHORT_PAD;
+
+    *error = ao40short_decode_rs_8(rs, eras_pos, no_eras);
+    if (*error != -1)
+      break;
+  }
+
+  for (i = 0; i < AO40SHORT_DATA_SIZE; ++i) {
+    data[i] = rs[i];
+  }
+}
+
+/* Everything after the deinterleaving, shared by the decoding entry points */
+static void ao40short_decode_conv(AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error, uint8_t dec_data[AO40SHORT_RS_SIZE], uint8_t rs[AO40SHORT_RS_BLOCK_SIZE]) {
+  ao40short_viterbi(conv, dec_data);
+  ao40short_descramble(dec_data, rs);
+  ao40short_rs_decode(rs, data, error);
+  if (*error == -1)
+    ao40short_rs_decode_erasures(conv, rs, data, error);
+}
+
 void ao40short_decode_data(uint8_t raw[AO40SHORT_RAW_SIZE], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error) {
-  uint8_t conv[AO40SHORT_CONV_SIZE];
+  AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE];
   uint8_t dec_data[AO40SHORT_RS_SIZE];
   uint8_t rs[AO40SHORT_RS_BLOCK_SIZE];
 
   ao40short_deinterleave(raw, conv);
-  ao40short_viterbi(conv, dec_data);
-  ao40short_descramble(dec_data, rs);
-  ao40short_rs_decode(rs, data, error);
+  ao40short_decode_conv(conv, data, error, dec_data, rs);
+}
+
+void ao40short_decode_packed(const uint8_t packed[AO40SHORT_CODE_LENGTH], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error) {
+  AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE];
+  uint8_t dec_data[AO40SHORT_RS_SIZE];
+  uint8_t rs[AO40SHORT_RS_BLOCK_SIZE];
+
+  ao40_unpack_deinterleave(packed, &ao40short_Interleaver, conv, AO40SHORT_CONV_SIZE);
+  ao40short_decode_conv(conv, data, error, dec_data, rs);
 }
 
 void ao40short_decode_data_debug(
@@ -130,8 +249,12 @@ void ao40short_decode_data_debug(
     uint8_t dec_data[AO40SHORT_RS_SIZE],    // Viterbi decoder output
     uint8_t rs[AO40SHORT_RS_BLOCK_SIZE]     // RS codeblocks without the leading padding 95 zeros
   ) {
-  ao40short_deinterleave(raw, conv);
-  ao40short_viterbi(conv, dec_data);
-  ao40short_descramble(dec_data, rs);
-  ao40short_rs_decode(rs, data, error);
+  AO40SHORT_COMPUTETYPE conv_compute[AO40SHORT_CONV_SIZE];
+  uint16_t i;
+
+  ao40short_deinterleave(raw, conv_compute);
+  for (i = 0; i < AO40SHORT_CONV_SIZE; ++i) {
+    conv[i] = (uint8_t)conv_compute[i];
+  }
+  ao40short_decode_conv(conv_compute, data, error, dec_data, rs);
 }
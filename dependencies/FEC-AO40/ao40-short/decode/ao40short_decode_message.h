@@ -9,14 +9,23 @@
 
 #define AO40SHORT_INTERLEAVER_STEP_SIZE    51
 #define AO40SHORT_INTERLEAVER_PILOT_BITS   80
+#define AO40SHORT_INTERLEAVER_ROWS         52
 
 #define AO40SHORT_RAW_SIZE      2652 // 51*52
 #define AO40SHORT_CONV_SIZE     2572
 
 #define AO40SHORT_RS_SIZE        160
 #define AO40SHORT_DATA_SIZE      128
+#define AO40SHORT_CODE_LENGTH    333
 #define AO40SHORT_FRAME_BITS    1280
 #define AO40SHORT_RS_BLOCK_SIZE  160
+#define AO40SHORT_STEPS         1286 // AO40SHORT_FRAME_BITS + 6 tail bits
+
+/* Erasure decoding keeps 16 parity symbols in reserve to detect miscorrections */
+#define AO40SHORT_ERASURE_STEP     4
+#define AO40SHORT_MAX_ERASURES    16
+
+#define AO40SHORT_MARGIN(a, b) ((a) > (b) ? ((a) - (b) > UINT16_MAX ? UINT16_MAX : (a) - (b)) : ((b) - (a) > UINT16_MAX ? UINT16_MAX : (b) - (a)))
 
 #if !defined(AO40SHORT_NULL)
 #define AO40SHORT_NULL ((void *)0)
@@ -30,6 +39,12 @@ extern const uint8_t ao40short_Scrambler[320];
 
 void ao40short_decode_data(uint8_t raw[AO40SHORT_RAW_SIZE], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error);
 
+/* Same as ao40short_decode_data, but takes the received frame as it is, 333 byte with 8 hard bits each */
+void ao40short_decode_packed(const uint8_t packed[AO40SHORT_CODE_LENGTH], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error);
+
+/* Per byte reliability of the Viterbi output, returns -1 if it could not be computed */
+int ao40short_viterbi_reliability(const AO40SHORT_COMPUTETYPE conv[AO40SHORT_CONV_SIZE], uint16_t reliability[AO40SHORT_RS_SIZE]);
+
 #ifdef AO40SHORT_DEBUG
 void ao40short_decode_data_debug(uint8_t raw[AO40SHORT_RAW_SIZE], uint8_t data[AO40SHORT_DATA_SIZE], int8_t *error, uint8_t conv[AO40SHORT_CONV_SIZE], uint8_t dec_data[AO40SHORT_RS_SIZE], uint8_t rs[AO40SHORT_RS_BLOCK_SIZE]);
 #endif
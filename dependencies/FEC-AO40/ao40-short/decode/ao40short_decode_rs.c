@@ -36,6 +36,19 @@
 #undef AO40SHORT_A0
 #define AO40SHORT_A0 (AO40SHORT_NN)
 
+/* The syndromes are computed over AO40SHORT_SYNDROME_LANES interleaved subsequences
+ * of the shortened block at once, see ao40short_rs_syndromes */
+#define AO40SHORT_SYNDROME_LANES 16
+
+#if (AO40SHORT_NN - AO40SHORT_PAD) % AO40SHORT_SYNDROME_LANES != 0
+#error "Shortened block length is not a multiple of AO40SHORT_SYNDROME_LANES"
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AO40SHORT_SYNDROME_SSSE3
+#include <tmmintrin.h>
+#endif
+
 const uint8_t AO40SHORT_INDEX_OF[] = {
    0xff, 0x00, 0x01, 0x63, 0x02, 0xc6, 0x64, 0x6a, 0x03, 0xcd, 0xc7, 0xbc, 0x65, 0x7e, 0x6b, 0x2a,
    0x04, 0x8d, 0xce, 0x4e, 0xc8, 0xd4, 0xbd, 0xe1, 0x66, 0xdd, 0x7f, 0x31, 0x6c, 0x20, 0x2b, 0xf3,
@@ -74,6 +87,148 @@ const uint8_t AO40SHORT_ALPHA_TO[] = {
     0x33, 0x66, 0xcc, 0x1f, 0x3e, 0x7c, 0xf8, 0x77, 0xee, 0x5b, 0xb6, 0xeb, 0x51, 0xa2, 0xc3, 0x00,
 };
 
+/* Split nibble tables for multiplying by the 16th power of the roots of g(x):
+ * AO40SHORT_SYNDROME_MUL16[i][0][x] = r_i^16 * x and AO40SHORT_SYNDROME_MUL16[i][1][x] = r_i^16 * (x << 4),
+ * where r_i = alpha^((AO40SHORT_FCR + i) * AO40SHORT_PRIM). */
+static const uint8_t AO40SHORT_SYNDROME_MUL16[AO40SHORT_NROOTS][2][16] = {
+  {{0x00, 0xca, 0x13, 0xd9, 0x26, 0xec, 0x35, 0xff, 0x4c, 0x86, 0x5f, 0x95, 0x6a, 0xa0, 0x79, 0xb3},
+   {0x00, 0x98, 0xb7, 0x2f, 0xe9, 0x71, 0x5e, 0xc6, 0x55, 0xcd, 0xe2, 0x7a, 0xbc, 0x24, 0x0b, 0x93}},
+  {{0x00, 0xa2, 0xc3, 0x61, 0x01, 0xa3, 0xc2, 0x60, 0x02, 0xa0, 0xc1, 0x63, 0x03, 0xa1, 0xc0, 0x62},
+   {0x00, 0x04, 0x08, 0x0c, 0x10, 0x14, 0x18, 0x1c, 0x20, 0x24, 0x28, 0x2c, 0x30, 0x34, 0x38, 0x3c}},
+  {{0x00, 0x94, 0xaf, 0x3b, 0xd9, 0x4d, 0x76, 0xe2, 0x35, 0xa1, 0x9a, 0x0e, 0xec, 0x78, 0x43, 0xd7},
+   {0x00, 0x6a, 0xd4, 0xbe, 0x2f, 0x45, 0xfb, 0x91, 0x5e, 0x34, 0x8a, 0xe0, 0x71, 0x1b, 0xa5, 0xcf}},
+  {{0x00, 0xba, 0xf3, 0x49, 0x61, 0xdb, 0x92, 0x28, 0xc2, 0x78, 0x31, 0x8b, 0xa3, 0x19, 0x50, 0xea},
+   {0x00, 0x03, 0x06, 0x05, 0x0c, 0x0f, 0x0a, 0x09, 0x18, 0x1b, 0x1e, 0x1d, 0x14, 0x17, 0x12, 0x11}},
+  {{0x00, 0x6f, 0xde, 0xb1, 0x3b, 0x54, 0xe5, 0x8a, 0x76, 0x19, 0xa8, 0xc7, 0x4d, 0x22, 0x93, 0xfc},
+   {0x00, 0xec, 0x5f, 0xb3, 0xbe, 0x52, 0xe1, 0x0d, 0xfb, 0x17, 0xa4, 0x48, 0x45, 0xa9, 0x1a, 0xf6}},
+  {{0x00, 0xb0, 0xe7, 0x57, 0x49, 0xf9, 0xae, 0x1e, 0x92, 0x22, 0x75, 0xc5, 0xdb, 0x6b, 0x3c, 0x8c},
+   {0x00, 0xa3, 0xc1, 0x62, 0x05, 0xa6, 0xc4, 0x67, 0x0a, 0xa9, 0xcb, 0x68, 0x0f, 0xac, 0xce, 0x6d}},
+  {{0x00, 0x8e, 0x9b, 0x15, 0xb1, 0x3f, 0x2a, 0xa4, 0xe5, 0x6b, 0x7e, 0xf0, 0x54, 0xda, 0xcf, 0x41},
+   {0x00, 0x4d, 0x9a, 0xd7, 0xb3, 0xfe, 0x29, 0x64, 0xe1, 0xac, 0x7b, 0x36, 0x52, 0x1f, 0xc8, 0x85}},
+  {{0x00, 0x74, 0xe8, 0x9c, 0x57, 0x23, 0xbf, 0xcb, 0xae, 0xda, 0x46, 0x32, 0xf9, 0x8d, 0x11, 0x65},
+   {0x00, 0xdb, 0x31, 0xea, 0x62, 0xb9, 0x53, 0x88, 0xc4, 0x1f, 0xf5, 0x2e, 0xa6, 0x7d, 0x97, 0x4c}},
+  {{0x00, 0xa7, 0xc9, 0x6e, 0x15, 0xb2, 0xdc, 0x7b, 0x2a, 0x8d, 0xe3, 0x44, 0x3f, 0x98, 0xf6, 0x51},
+   {0x00, 0x54, 0xa8, 0xfc, 0xd7, 0x83, 0x7f, 0x2b, 0x29, 0x7d, 0x81, 0xd5, 0xfe, 0xaa, 0x56, 0x02}},
+  {{0x00, 0x27, 0x4e, 0x69, 0x9c, 0xbb, 0xd2, 0xf5, 0xbf, 0x98, 0xf1, 0xd6, 0x23, 0x04, 0x6d, 0x4a},
+   {0x00, 0xf9, 0x75, 0x8c, 0xea, 0x13, 0x9f, 0x66, 0x53, 0xaa, 0x26, 0xdf, 0xb9, 0x40, 0xcc, 0x35}},
+  {{0x00, 0xd8, 0x37, 0xef, 0x6e, 0xb6, 0x59, 0x81, 0xdc, 0x04, 0xeb, 0x33, 0xb2, 0x6a, 0x85, 0x5d},
+   {0x00, 0x3f, 0x7e, 0x41, 0xfc, 0xc3, 0x82, 0xbd, 0x7f, 0x40, 0x01, 0x3e, 0x83, 0xbc, 0xfd, 0xc2}},
+  {{0x00, 0xb8, 0xf7, 0x4f, 0x69, 0xd1, 0x9e, 0x26, 0xd2, 0x6a, 0x25, 0x9d, 0xbb, 0x03, 0x4c, 0xf4},
+   {0x00, 0x23, 0x46, 0x65, 0x8c, 0xaf, 0xca, 0xe9, 0x9f, 0xbc, 0xd9, 0xfa, 0x13, 0x30, 0x55, 0x76}},
+  {{0x00, 0x5a, 0xb4, 0xee, 0xef, 0xb5, 0x5b, 0x01, 0x59, 0x03, 0xed, 0xb7, 0xb6, 0xec, 0x02, 0x58},
+   {0x00, 0xb2, 0xe3, 0x51, 0x41, 0xf3, 0xa2, 0x10, 0x82, 0x30, 0x61, 0xd3, 0xc3, 0x71, 0x20, 0x92}},
+  {{0x00, 0x72, 0xe4, 0x96, 0x4f, 0x3d, 0xab, 0xd9, 0x9e, 0xec, 0x7a, 0x08, 0xd1, 0xa3, 0x35, 0x47},
+   {0x00, 0xbb, 0xf1, 0x4a, 0x65, 0xde, 0x94, 0x2f, 0xca, 0x71, 0x3b, 0x80, 0xaf, 0x14, 0x5e, 0xe5}},
+  {{0x00, 0xf8, 0x77, 0x8f, 0xee, 0x16, 0x99, 0x61, 0x5b, 0xa3, 0x2c, 0xd4, 0xb5, 0x4d, 0xc2, 0x3a},
+   {0x00, 0xb6, 0xeb, 0x5d, 0x51, 0xe7, 0xba, 0x0c, 0xa2, 0x14, 0x49, 0xff, 0xf3, 0x45, 0x18, 0xae}},
+  {{0x00, 0xe6, 0x4b, 0xad, 0x96, 0x70, 0xdd, 0x3b, 0xab, 0x4d, 0xe0, 0x06, 0x3d, 0xdb, 0x76, 0x90},
+   {0x00, 0xd1, 0x25, 0xf4, 0x4a, 0x9b, 0x6f, 0xbe, 0x94, 0x45, 0xb1, 0x60, 0xde, 0x0f, 0xfb, 0x2a}},
+  {{0x00, 0x42, 0x84, 0xc6, 0x8f, 0xcd, 0x0b, 0x49, 0x99, 0xdb, 0x1d, 0x5f, 0x16, 0x54, 0x92, 0xd0},
+   {0x00, 0xb5, 0xed, 0x58, 0x5d, 0xe8, 0xb0, 0x05, 0xba, 0x0f, 0x57, 0xe2, 0xe7, 0x52, 0x0a, 0xbf}},
+  {{0x00, 0x89, 0x95, 0x1c, 0xad, 0x24, 0x38, 0xb1, 0xdd, 0x54, 0x48, 0xc1, 0x70, 0xf9, 0xe5, 0x6c},
+   {0x00, 0x3d, 0x7a, 0x47, 0xf4, 0xc9, 0x8e, 0xb3, 0x6f, 0x52, 0x15, 0x28, 0x9b, 0xa6, 0xe1, 0xdc}},
+  {{0x00, 0xf2, 0x63, 0x91, 0xc6, 0x34, 0xa5, 0x57, 0x0b, 0xf9, 0x68, 0x9a, 0xcd, 0x3f, 0xae, 0x5c},
+   {0x00, 0x16, 0x2c, 0x3a, 0x58, 0x4e, 0x74, 0x62, 0xb0, 0xa6, 0x9c, 0x8a, 0xe8, 0xfe, 0xc4, 0xd2}},
+  {{0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b, 0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d},
+   {0x00, 0x70, 0xe0, 0x90, 0x47, 0x37, 0xa7, 0xd7, 0x8e, 0xfe, 0x6e, 0x1e, 0xc9, 0xb9, 0x29, 0x59}},
+  {{0x00, 0x86, 0x8b, 0x0d, 0x91, 0x17, 0x1a, 0x9c, 0xa5, 0x23, 0x2e, 0xa8, 0x34, 0xb2, 0xbf, 0x39},
+   {0x00, 0xcd, 0x1d, 0xd0, 0x3a, 0xf7, 0x27, 0xea, 0x74, 0xb9, 0x69, 0xa4, 0x4e, 0x83, 0x53, 0x9e}},
+  {{0x00, 0xa0, 0xc7, 0x67, 0x09, 0xa9, 0xce, 0x6e, 0x12, 0xb2, 0xd5, 0x75, 0x1b, 0xbb, 0xdc, 0x7c},
+   {0x00, 0x24, 0x48, 0x6c, 0x90, 0xb4, 0xd8, 0xfc, 0xa7, 0x83, 0xef, 0xcb, 0x37, 0x13, 0x7f, 0x5b}},
+  {{0x00, 0xa1, 0xc5, 0x64, 0x0d, 0xac, 0xc8, 0x69, 0x1a, 0xbb, 0xdf, 0x7e, 0x17, 0xb6, 0xd2, 0x73},
+   {0x00, 0x34, 0x68, 0x5c, 0xd0, 0xe4, 0xb8, 0x8c, 0x27, 0x13, 0x4f, 0x7b, 0xf7, 0xc3, 0x9f, 0xab}},
+  {{0x00, 0x78, 0xf0, 0x88, 0x67, 0x1f, 0x97, 0xef, 0xce, 0xb6, 0x3e, 0x46, 0xa9, 0xd1, 0x59, 0x21},
+   {0x00, 0x1b, 0x36, 0x2d, 0x6c, 0x77, 0x5a, 0x41, 0xd8, 0xc3, 0xee, 0xf5, 0xb4, 0xaf, 0x82, 0x99}},
+  {{0x00, 0x19, 0x32, 0x2b, 0x64, 0x7d, 0x56, 0x4f, 0xc8, 0xd1, 0xfa, 0xe3, 0xac, 0xb5, 0x9e, 0x87},
+   {0x00, 0x17, 0x2e, 0x39, 0x5c, 0x4b, 0x72, 0x65, 0xb8, 0xaf, 0x96, 0x81, 0xe4, 0xf3, 0xca, 0xdd}},
+  {{0x00, 0x22, 0x44, 0x66, 0x88, 0xaa, 0xcc, 0xee, 0x97, 0xb5, 0xd3, 0xf1, 0x1f, 0x3d, 0x5b, 0x79},
+   {0x00, 0xa9, 0xd5, 0x7c, 0x2d, 0x84, 0xf8, 0x51, 0x5a, 0xf3, 0x8f, 0x26, 0x77, 0xde, 0xa2, 0x0b}},
+  {{0x00, 0x6b, 0xd6, 0xbd, 0x2b, 0x40, 0xfd, 0x96, 0x56, 0x3d, 0x80, 0xeb, 0x7d, 0x16, 0xab, 0xc0},
+   {0x00, 0xac, 0xdf, 0x73, 0x39, 0x95, 0xe6, 0x4a, 0x72, 0xde, 0xad, 0x01, 0x4b, 0xe7, 0x94, 0x38}},
+  {{0x00, 0xda, 0x33, 0xe9, 0x66, 0xbc, 0x55, 0x8f, 0xcc, 0x16, 0xff, 0x25, 0xaa, 0x70, 0x99, 0x43},
+   {0x00, 0x1f, 0x3e, 0x21, 0x7c, 0x63, 0x42, 0x5d, 0xf8, 0xe7, 0xc6, 0xd9, 0x84, 0x9b, 0xba, 0xa5}},
+  {{0x00, 0x8d, 0x9d, 0x10, 0xbd, 0x30, 0x20, 0xad, 0xfd, 0x70, 0x60, 0xed, 0x40, 0xcd, 0xdd, 0x50},
+   {0x00, 0x7d, 0xfa, 0x87, 0x73, 0x0e, 0x89, 0xf4, 0xe6, 0x9b, 0x1c, 0x61, 0x95, 0xe8, 0x6f, 0x12}},
+  {{0x00, 0x98, 0xb7, 0x2f, 0xe9, 0x71, 0x5e, 0xc6, 0x55, 0xcd, 0xe2, 0x7a, 0xbc, 0x24, 0x0b, 0x93},
+   {0x00, 0xaa, 0xd3, 0x79, 0x21, 0x8b, 0xf2, 0x58, 0x42, 0xe8, 0x91, 0x3b, 0x63, 0xc9, 0xb0, 0x1a}},
+  {{0x00, 0x04, 0x08, 0x0c, 0x10, 0x14, 0x18, 0x1c, 0x20, 0x24, 0x28, 0x2c, 0x30, 0x34, 0x38, 0x3c},
+   {0x00, 0x40, 0x80, 0xc0, 0x87, 0xc7, 0x07, 0x47, 0x89, 0xc9, 0x09, 0x49, 0x0e, 0x4e, 0x8e, 0xce}},
+  {{0x00, 0x6a, 0xd4, 0xbe, 0x2f, 0x45, 0xfb, 0x91, 0x5e, 0x34, 0x8a, 0xe0, 0x71, 0x1b, 0xa5, 0xcf},
+   {0x00, 0xbc, 0xff, 0x43, 0x79, 0xc5, 0x86, 0x3a, 0xf2, 0x4e, 0x0d, 0xb1, 0x8b, 0x37, 0x74, 0xc8}},
+};
+
+/* s_i = sum_k acc[k] * r_i^(15 - k), where acc[k] is the partial syndrome of
+ * the subsequence data[k], data[k + 16], ... */
+static uint8_t ao40short_syndrome_fold(const uint8_t acc[AO40SHORT_SYNDROME_LANES], int i) {
+  int k, step, power = 0;
+  uint8_t s = 0;
+
+  step = AO40SHORT_MODNN((AO40SHORT_FCR+i)*AO40SHORT_PRIM);
+  for (k = AO40SHORT_SYNDROME_LANES - 1; k >= 0; k--) {
+    if (acc[k] != 0)
+      s ^= AO40SHORT_ALPHA_TO[AO40SHORT_MODNN(AO40SHORT_INDEX_OF[acc[k]] + power)];
+    power = AO40SHORT_MODNN(power + step);
+  }
+  return s;
+}
+
+static int ao40short_rs_syndromes_scalar(const uint8_t *data, uint8_t s[AO40SHORT_NROOTS]) {
+  int i, j, k, syn_error = 0;
+  uint8_t acc[AO40SHORT_SYNDROME_LANES], v;
+
+  for (i = 0; i < AO40SHORT_NROOTS; i++) {
+    memset(acc, 0, sizeof(acc));
+    for (j = 0; j < AO40SHORT_NN - AO40SHORT_PAD; j += AO40SHORT_SYNDROME_LANES) {
+      for (k = 0; k < AO40SHORT_SYNDROME_LANES; k++) {
+        v = acc[k];
+        acc[k] = data[j + k] ^ AO40SHORT_SYNDROME_MUL16[i][0][v & 0x0f] ^ AO40SHORT_SYNDROME_MUL16[i][1][v >> 4];
+      }
+    }
+    s[i] = ao40short_syndrome_fold(acc, i);
+    syn_error |= s[i];
+  }
+  return syn_error;
+}
+
+#ifdef AO40SHORT_SYNDROME_SSSE3
+/* Same as ao40short_rs_syndromes_scalar, but the multiplication by r_i^16 is done
+ * on all 16 lanes at once with two pshufb nibble lookups */
+__attribute__((target("ssse3")))
+static int ao40short_rs_syndromes_ssse3(const uint8_t *data, uint8_t s[AO40SHORT_NROOTS]) {
+  int i, j, syn_error = 0;
+  __m128i block[(AO40SHORT_NN - AO40SHORT_PAD) / AO40SHORT_SYNDROME_LANES];
+  __m128i nibble = _mm_set1_epi8(0x0f);
+  __m128i lo, hi, acc;
+  uint8_t lanes[AO40SHORT_SYNDROME_LANES];
+
+  for (j = 0; j < (AO40SHORT_NN - AO40SHORT_PAD) / AO40SHORT_SYNDROME_LANES; j++)
+    block[j] = _mm_loadu_si128((const __m128i *)(data + j * AO40SHORT_SYNDROME_LANES));
+
+  for (i = 0; i < AO40SHORT_NROOTS; i++) {
+    lo = _mm_loadu_si128((const __m128i *)AO40SHORT_SYNDROME_MUL16[i][0]);
+    hi = _mm_loadu_si128((const __m128i *)AO40SHORT_SYNDROME_MUL16[i][1]);
+    acc = _mm_setzero_si128();
+    for (j = 0; j < (AO40SHORT_NN - AO40SHORT_PAD) / AO40SHORT_SYNDROME_LANES; j++) {
+      acc = _mm_xor_si128(_mm_shuffle_epi8(lo, _mm_and_si128(acc, nibble)),
+                          _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(acc, 4), nibble)));
+      acc = _mm_xor_si128(acc, block[j]);
+    }
+    _mm_storeu_si128((__m128i *)lanes, acc);
+    s[i] = ao40short_syndrome_fold(lanes, i);
+    syn_error |= s[i];
+  }
+  return syn_error;
+}
+#endif
+
+int ao40short_rs_syndromes(const uint8_t *data, uint8_t s[AO40SHORT_NROOTS]) {
+#ifdef AO40SHORT_SYNDROME_SSSE3
+  if (__builtin_cpu_supports("ssse3"))
+    return ao40short_rs_syndromes_ssse3(data, s);
+#endif
+  return ao40short_rs_syndromes_scalar(data, s);
+}
+
 int8_t ao40short_decode_rs_8(uint8_t *data, int *eras_pos, int no_eras) {
   int deg_lambda, el, deg_omega;
   int i, j, r,k;
@@ -84,25 +239,7 @@ int8_t ao40short_decode_rs_8(uint8_t *data, int *eras_pos, int no_eras) {
   int syn_error, count;
 
   /* form the syndromes; i.e., evaluate data(x) at roots of g(x) */
-  for (i=0;i<AO40SHORT_NROOTS;i++)
-    s[i] = data[0];
-
-  for (j=1;j<AO40SHORT_NN-AO40SHORT_PAD;j++) {
-    for (i=0;i<AO40SHORT_NROOTS;i++) {
-      if (s[i] == 0) {
-        s[i] = data[j];
-      } else {
-        s[i] = data[j] ^ AO40SHORT_ALPHA_TO[AO40SHORT_MODNN(AO40SHORT_INDEX_OF[s[i]] + (AO40SHORT_FCR+i)*AO40SHORT_PRIM)];
-      }
-    }
-  }
-
-  /* Convert syndromes to index form, checking for nonzero condition */
-  syn_error = 0;
-  for (i=0;i<AO40SHORT_NROOTS;i++) {
-    syn_error |= s[i];
-    s[i] = AO40SHORT_INDEX_OF[s[i]];
-  }
+  syn_error = ao40short_rs_syndromes(data, s);
 
   if (!syn_error) {
     /* if syndrome is zero, data[] is a codeword and there are no
@@ -111,6 +248,10 @@ int8_t ao40short_decode_rs_8(uint8_t *data, int *eras_pos, int no_eras) {
     count = 0;
     goto finish;
   }
+  /* Convert syndromes to index form */
+  for (i=0;i<AO40SHORT_NROOTS;i++)
+    s[i] = AO40SHORT_INDEX_OF[s[i]];
+
   memset(&lambda[1],0,AO40SHORT_NROOTS*sizeof(lambda[0]));
   lambda[0] = 1;
 
@@ -25,6 +25,9 @@ static inline int ao40short_mod255(int x){
   return x;
 }
 
+/* Evaluates data(x) at the roots of g(x), returns nonzero if any syndrome is nonzero */
+int ao40short_rs_syndromes(const uint8_t *data, uint8_t s[AO40SHORT_NROOTS]);
+
 int8_t ao40short_decode_rs_8(uint8_t *data, int *eras_pots, int no_eras);
 
 #endif
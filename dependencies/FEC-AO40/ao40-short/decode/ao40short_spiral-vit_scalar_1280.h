@@ -83,10 +83,18 @@ static inline int ao40short_parity(uint32_t x){
   return ao40short_Partab[x];
 }
 
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
 int ao40short_init_viterbi(void *p, int starting_state);
 void *ao40short_create_viterbi(int len);
 int ao40short_chainback_viterbi(void *p, uint8_t *data, uint32_t nbits, uint32_t endstate);
 void ao40short_delete_viterbi(void *p);
 int ao40short_update_viterbi_blk(void *p, AO40SHORT_COMPUTETYPE *syms, int nbits);
 
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
 #endif
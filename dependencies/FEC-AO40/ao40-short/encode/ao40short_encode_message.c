@@ -0,0 +1,77 @@
+/*
+ * AO40 short frame encoder, the counterpart of ao40short_decode_message.c
+ * Reed-Solomon encoder is based on Phil Karn's work
+ */
+
+#include <string.h>
+#include "ao40short_encode_message.h"
+
+/* Generator polynomial of the CCSDS code in index form */
+static const uint8_t ao40short_Genpoly[AO40SHORT_NROOTS + 1] = {
+  0, 249, 59, 66, 4, 43, 126, 251, 97, 30, 3, 213, 50, 66, 170, 5, 24,
+  5, 170, 66, 50, 213, 3, 30, 97, 251, 126, 43, 4, 66, 59, 249, 0,
+};
+
+/* Fills the last AO40SHORT_NROOTS bytes of the block with the parity of the rest */
+static void ao40short_encode_rs_8(uint8_t block[AO40SHORT_RS_BLOCK_SIZE]) {
+  uint8_t *parity = block + AO40SHORT_RS_BLOCK_SIZE - AO40SHORT_NROOTS;
+  uint8_t feedback;
+  int i, j;
+
+  memset(parity, 0, AO40SHORT_NROOTS);
+
+  for (i = 0; i < AO40SHORT_RS_BLOCK_SIZE - AO40SHORT_NROOTS; ++i) {
+    feedback = AO40SHORT_INDEX_OF[block[i] ^ parity[0]];
+    if (feedback != AO40SHORT_NN) {
+      for (j = 1; j < AO40SHORT_NROOTS; ++j)
+        parity[j] ^= AO40SHORT_ALPHA_TO[AO40SHORT_MODNN(feedback + ao40short_Genpoly[AO40SHORT_NROOTS - j])];
+    }
+    memmove(parity, parity + 1, AO40SHORT_NROOTS - 1);
+    parity[AO40SHORT_NROOTS - 1] =
+      feedback != AO40SHORT_NN ? AO40SHORT_ALPHA_TO[AO40SHORT_MODNN(feedback + ao40short_Genpoly[0])] : 0;
+  }
+}
+
+/* Bit position of the k-th symbol of the 52 x 51 interleaver, pilot bits included */
+static inline uint16_t ao40short_interleaver_pos(uint16_t k) {
+  return (k % AO40SHORT_INTERLEAVER_ROWS) * AO40SHORT_INTERLEAVER_STEP_SIZE + k / AO40SHORT_INTERLEAVER_ROWS;
+}
+
+static inline void ao40short_set_bit(uint8_t packed[AO40SHORT_CODE_LENGTH], uint16_t pos, int bit) {
+  if (bit)
+    packed[pos >> 3] |= 0x80 >> (pos & 7);
+}
+
+/* Encoding:
+ * - The data is a single RS codeblock, which is scrambled and convolutionally
+ *   encoded, with CONV_POLY_B inverted as the CCSDS standard requires.
+ * - The symbols are written down the columns of the 52 x 51 interleaver after
+ *   the pilot bits, the last 12 bits of the frame are padding.
+ */
+void ao40short_encode_data(const uint8_t data[AO40SHORT_DATA_SIZE], uint8_t packed[AO40SHORT_CODE_LENGTH]) {
+  uint8_t rs[AO40SHORT_RS_BLOCK_SIZE];
+  uint8_t sr = 0x7f, byte = 0;
+  uint32_t encstate = 0;
+  uint16_t i, k = 0;
+  int bit;
+
+  memset(packed, 0, AO40SHORT_CODE_LENGTH);
+
+  memcpy(rs, data, AO40SHORT_DATA_SIZE);
+  ao40short_encode_rs_8(rs);
+
+  for (k = 0; k < AO40SHORT_INTERLEAVER_PILOT_BITS; ++k) {
+    ao40short_set_bit(packed, ao40short_interleaver_pos(k), (sr >> 6) & 1);
+    sr = (uint8_t)(((sr << 1) | __builtin_parity(sr & AO40SHORT_SYNC_POLY)) & 0x7f);
+  }
+
+  for (i = 0; i < AO40SHORT_STEPS; ++i) {
+    if ((i & 7) == 0 && i < AO40SHORT_FRAME_BITS)
+      byte = rs[i >> 3] ^ ao40short_Scrambler[i >> 3];
+    bit = i < AO40SHORT_FRAME_BITS ? (byte >> (7 - (i & 7))) & 1 : 0;
+    encstate = (encstate << 1) | (uint32_t)bit;
+
+    ao40short_set_bit(packed, ao40short_interleaver_pos(k++), __builtin_parity(encstate & AO40SHORT_CONV_POLY_A));
+    ao40short_set_bit(packed, ao40short_interleaver_pos(k++), !__builtin_parity(encstate & AO40SHORT_CONV_POLY_B));
+  }
+}
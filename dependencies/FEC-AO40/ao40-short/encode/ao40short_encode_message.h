@@ -0,0 +1,22 @@
+#ifndef AO40SHORT_ENCODE_MESSAGE_H
+#define AO40SHORT_ENCODE_MESSAGE_H
+
+#include <stdint.h>
+#include "../decode/ao40short_decode_message.h"
+
+#define AO40SHORT_SYNC_POLY     0x48
+#define AO40SHORT_CONV_POLY_A   0x4f
+#define AO40SHORT_CONV_POLY_B   0x6d
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/* Encodes 128 data bytes into a 333 byte frame, the inverse of ao40short_decode_packed */
+void ao40short_encode_data(const uint8_t data[AO40SHORT_DATA_SIZE], uint8_t packed[AO40SHORT_CODE_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif
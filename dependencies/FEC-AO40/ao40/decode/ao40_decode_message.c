@@ -12,6 +12,11 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include "ao40_decode_message.h"
+#include "../../common/ao40_unpack.h"
+
+static const ao40_interleaver_t ao40_Interleaver = {
+  AO40_INTERLEAVER_STEP_SIZE, AO40_INTERLEAVER_ROWS, 1, 0
+};
 
 const uint8_t ao40_Scrambler[320] = {
   0xff, 0x48, 0x0e, 0xc0, 0x9a, 0x0d, 0x70, 0xbc, 0x8e, 0x2c, 0x93, 0xad, 0xa7, 0xb7, 0x46, 0xce,
@@ -44,17 +49,20 @@ const uint8_t ao40_Scrambler[320] = {
  * - The CCSDS standard using CONV_POLY_B (0x6d) in inverted format, but
  *   ao40_viterbi decoder assumes non-inverted bits, so invert every second bit 
  *   by hand.
+ * - The last column only holds the tail of the convolutional code, only
+ *   AO40_CONV_SIZE symbols are kept.
+ * - The symbols are widened to the type of the Viterbi decoder here.
  */
-void ao40_deinterleave(uint8_t raw[AO40_RAW_SIZE], uint8_t conv[AO40_CONV_SIZE]) {
+void ao40_deinterleave(uint8_t raw[AO40_RAW_SIZE], AO40_COMPUTETYPE conv[AO40_CONV_SIZE]) {
   uint16_t i = 1;
   uint16_t j = 0;
 
-  while (i != (AO40_RAW_SIZE + 79)) {
+  while (j != AO40_CONV_SIZE) {
     if (i >= AO40_RAW_SIZE) {
       i -= (AO40_RAW_SIZE - 1);
     }
     conv[j] = raw[i];
-    i += 80;
+    i += AO40_INTERLEAVER_STEP_SIZE;
     ++j;
   }
 }
@@ -62,10 +70,8 @@ void ao40_deinterleave(uint8_t raw[AO40_RAW_SIZE], uint8_t conv[AO40_CONV_SIZE])
 /* Viterbi decoder:
  *   It uses the one generated from http://www.spiral.net/
  */
-void ao40_viterbi(uint8_t conv[AO40_CONV_SIZE], uint8_t dec_data[AO40_RS_SIZE]) {
+void ao40_viterbi(AO40_COMPUTETYPE conv[AO40_CONV_SIZE], uint8_t dec_data[AO40_RS_SIZE]) {
   struct ao40_v *vp;
-  AO40_COMPUTETYPE conv_compute[AO40_CONV_SIZE];
-  int i;
 
   if((vp = ao40_create_viterbi(AO40_FRAMEBITS)) == AO40_NULL){
     printf("ao40_create_viterbi failed\n");
@@ -74,19 +80,82 @@ void ao40_viterbi(uint8_t conv[AO40_CONV_SIZE], uint8_t dec_data[AO40_RS_SIZE])
 
   ao40_init_viterbi(vp, 0);
 
-  // AO40_COMPUTETYPE is set to uint32, so convert uint8 to uint32
-  // but the softbit value should be between 0 and 255 (!)
-  i = AO40_CONV_SIZE;
-  while (i--) {
-    conv_compute[i] = conv[i];
-  }
-
-  ao40_update_viterbi_blk(vp, conv_compute, AO40_FRAMEBITS+(AO40_K-1));
+  // the softbit values should be between 0 and 255 (!)
+  ao40_update_viterbi_blk(vp, conv, AO40_FRAMEBITS+(AO40_K-1));
   ao40_chainback_viterbi(vp, dec_data, AO40_FRAMEBITS, 0);
 
   ao40_delete_viterbi(vp);
 }
 
+/* Viterbi soft output:
+ *   Runs the add-compare-select recursion of the SPIRAL decoder once more, but
+ *   also keeps the margin by which the survivor path won at every state. The
+ *   reliability of a decoded byte is the smallest margin along the traced back
+ *   survivor path while the bits of that byte are in the encoder register.
+ *   Only used for frames that the plain RS decoder could not correct.
+ */
+int ao40_viterbi_reliability(const AO40_COMPUTETYPE conv[AO40_CONV_SIZE], uint16_t reliability[AO40_RS_SIZE]) {
+  uint32_t metrics[2][AO40_NUMSTATES];
+  uint32_t *old_metrics = metrics[0], *new_metrics = metrics[1], *tmp;
+  uint32_t metric, m0, m1;
+  uint64_t *decisions;
+  uint16_t *margins, path[AO40_STEPS];
+  int s, i, state;
+
+  margins = malloc(AO40_STEPS * AO40_NUMSTATES * sizeof(uint16_t));
+  decisions = malloc(AO40_STEPS * sizeof(uint64_t));
+  if (margins == AO40_NULL || decisions == AO40_NULL) {
+    free(margins);
+    free(decisions);
+    return -1;
+  }
+
+  for (i = 0; i < AO40_NUMSTATES; ++i)
+    old_metrics[i] = 63;
+  old_metrics[0] = 0;
+
+  for (s = 0; s < AO40_STEPS; ++s) {
+    decisions[s] = 0;
+    for (i = 0; i < AO40_NUMSTATES/2; ++i) {
+      metric = (ao40_Branchtab[i] ^ conv[2*s]) + (ao40_Branchtab[AO40_NUMSTATES/2 + i] ^ conv[2*s + 1]);
+
+      m0 = old_metrics[i] + metric;
+      m1 = old_metrics[i + AO40_NUMSTATES/2] + (510 - metric);
+      new_metrics[2*i] = m0 > m1 ? m1 : m0;
+      decisions[s] |= (uint64_t)(m0 > m1) << (2*i);
+      margins[s*AO40_NUMSTATES + 2*i] = AO40_MARGIN(m0, m1);
+
+      m0 = old_metrics[i] + (510 - metric);
+      m1 = old_metrics[i + AO40_NUMSTATES/2] + metric;
+      new_metrics[2*i + 1] = m0 > m1 ? m1 : m0;
+      decisions[s] |= (uint64_t)(m0 > m1) << (2*i + 1);
+      margins[s*AO40_NUMSTATES + 2*i + 1] = AO40_MARGIN(m0, m1);
+    }
+    tmp = old_metrics;
+    old_metrics = new_metrics;
+    new_metrics = tmp;
+  }
+
+  /* The tail bits flush the encoder into state 0 */
+  state = 0;
+  for (s = AO40_STEPS - 1; s >= 0; --s) {
+    path[s] = margins[s*AO40_NUMSTATES + state];
+    state = (state >> 1) | (int)(((decisions[s] >> state) & 1) << (AO40_K - 2));
+  }
+
+  for (i = 0; i < AO40_RS_SIZE; ++i) {
+    reliability[i] = UINT16_MAX;
+    for (s = 8*i; s < 8*i + 8 + (AO40_K - 1); ++s) {
+      if (reliability[i] > path[s])
+        reliability[i] = path[s];
+    }
+  }
+
+  free(margins);
+  free(decisions);
+  return 0;
+}
+
 void ao40_descramble_and_deinterleave(uint8_t dec_data[AO40_RS_SIZE], uint8_t rs[2][AO40_RS_BLOCK_SIZE]) {
   uint16_t i;
   uint16_t j = 0;
@@ -111,15 +180,73 @@ void ao40_rs_decode(uint8_t rs[2][AO40_RS_BLOCK_SIZE], uint8_t data[AO40_DATA_SI
 
 }
 
+/* Erasure decoding:
+ *   Retries the RS blocks that could not be corrected with the least reliable
+ *   bytes of the Viterbi output marked as erasures, using more and more
+ *   erasures up to AO40_MAX_ERASURES.
+ */
+void ao40_rs_decode_erasures(const AO40_COMPUTETYPE conv[AO40_CONV_SIZE], uint8_t rs[2][AO40_RS_BLOCK_SIZE], uint8_t data[AO40_DATA_SIZE], int8_t error[2]) {
+  uint16_t reliability[AO40_RS_SIZE];
+  uint8_t order[AO40_RS_BLOCK_SIZE], t;
+  int eras_pos[AO40_NROOTS];
+  int b, i, j, no_eras;
+
+  if (ao40_viterbi_reliability(conv, reliability) != 0)
+    return;
+
+  for (b = 0; b < 2; ++b) {
+    if (error[b] != -1)
+      continue;
+
+    /* Insertion sort of the block positions, least reliable first */
+    for (i = 0; i < AO40_RS_BLOCK_SIZE; ++i) {
+      t = (uint8_t)i;
+      for (j = i; j > 0 && reliability[2*order[j - 1] + b] > reliability[2*t + b]; --j)
+        order[j] = order[j - 1];
+      order[j] = t;
+    }
+
+    for (no_eras = AO40_ERASURE_STEP; no_eras <= AO40_MAX_ERASURES; no_eras += AO40_ERASURE_STEP) {
+      /* Erasure positions are counted in the full codeword, including the padding */
+      for (i = 0; i < no_eras; ++i)
+        eras_pos[i] = order[i] + AO40_PAD;
+
+      error[b] = ao40_decode_rs_8(rs[b], eras_pos, no_eras);
+      if (error[b] != -1)
+        break;
+    }
+  }
+
+  for (i = 0; i < AO40_DATA_SIZE; ++i) {
+    data[i] = rs[i & 1][i >> 1];
+  }
+}
+
+/* Everything after the deinterleaving, shared by the decoding entry points */
+static void ao40_decode_conv(AO40_COMPUTETYPE conv[AO40_CONV_SIZE], uint8_t data[AO40_DATA_SIZE], int8_t error[2], uint8_t dec_data[AO40_RS_SIZE], uint8_t rs[2][AO40_RS_BLOCK_SIZE]) {
+  ao40_viterbi(conv, dec_data);
+  ao40_descramble_and_deinterleave(dec_data, rs);
+  ao40_rs_decode(rs, data, error);
+  if (error[0] == -1 || error[1] == -1)
+    ao40_rs_decode_erasures(conv, rs, data, error);
+}
+
 void ao40_decode_data(uint8_t raw[AO40_RAW_SIZE], uint8_t data[AO40_DATA_SIZE], int8_t error[2]) {
-  uint8_t conv[AO40_CONV_SIZE];
+  AO40_COMPUTETYPE conv[AO40_CONV_SIZE];
   uint8_t dec_data[AO40_RS_SIZE];
   uint8_t rs[2][AO40_RS_BLOCK_SIZE];
 
   ao40_deinterleave(raw, conv);
-  ao40_viterbi(conv, dec_data);
-  ao40_descramble_and_deinterleave(dec_data, rs);
-  ao40_rs_decode(rs, data, error);
+  ao40_decode_conv(conv, data, error, dec_data, rs);
+}
+
+void ao40_decode_packed(const uint8_t packed[AO40_CODE_LENGTH], uint8_t data[AO40_DATA_SIZE], int8_t error[2]) {
+  AO40_COMPUTETYPE conv[AO40_CONV_SIZE];
+  uint8_t dec_data[AO40_RS_SIZE];
+  uint8_t rs[2][AO40_RS_BLOCK_SIZE];
+
+  ao40_unpack_deinterleave(packed, &ao40_Interleaver, conv, AO40_CONV_SIZE);
+  ao40_decode_conv(conv, data, error, dec_data, rs);
 }
 
 void ao40_decode_data_debug(
@@ -130,8 +257,12 @@ void ao40_decode_data_debug(
     uint8_t dec_data[AO40_RS_SIZE],    // Viterbi decoder output (320 byte): two RS codeblock interleaved and scrambled(!)
     uint8_t rs[2][AO40_RS_BLOCK_SIZE]  // RS codeblocks without the leading padding 95 zeros
   ) {
-  ao40_deinterleave(raw, conv);
-  ao40_viterbi(conv, dec_data);
-  ao40_descramble_and_deinterleave(dec_data, rs);
-  ao40_rs_decode(rs, data, error);
-}
\ No newline at end of file
+  AO40_COMPUTETYPE conv_compute[AO40_CONV_SIZE];
+  uint16_t i;
+
+  ao40_deinterleave(raw, conv_compute);
+  for (i = 0; i < AO40_CONV_SIZE; ++i) {
+    conv[i] = (uint8_t)conv_compute[i];
+  }
+  ao40_decode_conv(conv_compute, data, error, dec_data, rs);
+}
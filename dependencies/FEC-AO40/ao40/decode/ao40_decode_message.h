@@ -7,14 +7,24 @@
 
 #define AO40_DEBUG
 
+#define AO40_INTERLEAVER_STEP_SIZE    80
+#define AO40_INTERLEAVER_ROWS         65
+
 #define AO40_RAW_SIZE      5200
-#define AO40_CONV_SIZE     5132
+#define AO40_CONV_SIZE     5132 // AO40_STEPS * 2, the rest of the last column is unused
 
 #define AO40_RS_SIZE        320
 #define AO40_DATA_SIZE      256
 #define AO40_CODE_LENGTH    650
 #define AO40_FRAME_BITS    2560
 #define AO40_RS_BLOCK_SIZE  160
+#define AO40_STEPS         2566 // AO40_FRAME_BITS + 6 tail bits
+
+/* Erasure decoding keeps 16 parity symbols in reserve to detect miscorrections */
+#define AO40_ERASURE_STEP     4
+#define AO40_MAX_ERASURES    16
+
+#define AO40_MARGIN(a, b) ((a) > (b) ? ((a) - (b) > UINT16_MAX ? UINT16_MAX : (a) - (b)) : ((b) - (a) > UINT16_MAX ? UINT16_MAX : (b) - (a)))
 
 #if !defined(AO40_NULL)
 #define AO40_NULL ((void *)0)
@@ -28,6 +38,12 @@ extern const uint8_t ao40_Scrambler[320];
 
 void ao40_decode_data(uint8_t raw[AO40_RAW_SIZE], uint8_t data[AO40_DATA_SIZE], int8_t error[2]);
 
+/* Same as ao40_decode_data, but takes the received frame as it is, 650 byte with 8 hard bits each */
+void ao40_decode_packed(const uint8_t packed[AO40_CODE_LENGTH], uint8_t data[AO40_DATA_SIZE], int8_t error[2]);
+
+/* Per byte reliability of the Viterbi output, returns -1 if it could not be computed */
+int ao40_viterbi_reliability(const AO40_COMPUTETYPE conv[AO40_CONV_SIZE], uint16_t reliability[AO40_RS_SIZE]);
+
 #ifdef AO40_DEBUG
 void ao40_decode_data_debug(uint8_t raw[AO40_RAW_SIZE], uint8_t data[AO40_DATA_SIZE], int8_t  error[2], uint8_t conv[AO40_CONV_SIZE], uint8_t dec_data[AO40_RS_SIZE], uint8_t rs[2][AO40_RS_BLOCK_SIZE]);
 #endif
@@ -78,10 +78,18 @@ static inline int ao40_parity(uint32_t x){
   return ao40_Partab[x];
 }
 
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
 int ao40_init_viterbi(void *p, int starting_state);
 void *ao40_create_viterbi(int len);
 int ao40_chainback_viterbi(void *p, uint8_t *data, uint32_t nbits, uint32_t endstate);
 void ao40_delete_viterbi(void *p);
 int ao40_update_viterbi_blk(void *p, AO40_COMPUTETYPE *syms, int nbits);
 
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
 #endif /* AO40_SPIRAL_VIT_SCALAR_H */
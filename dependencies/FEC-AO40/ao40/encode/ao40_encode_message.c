@@ -0,0 +1,80 @@
+/*
+ * AO40 frame encoder, the counterpart of ao40_decode_message.c
+ * Reed-Solomon encoder is based on Phil Karn's work
+ */
+
+#include <string.h>
+#include "ao40_encode_message.h"
+
+/* Generator polynomial of the CCSDS code in index form */
+static const uint8_t ao40_Genpoly[AO40_NROOTS + 1] = {
+  0, 249, 59, 66, 4, 43, 126, 251, 97, 30, 3, 213, 50, 66, 170, 5, 24,
+  5, 170, 66, 50, 213, 3, 30, 97, 251, 126, 43, 4, 66, 59, 249, 0,
+};
+
+/* Fills the last AO40_NROOTS bytes of the block with the parity of the rest */
+static void ao40_encode_rs_8(uint8_t block[AO40_RS_BLOCK_SIZE]) {
+  uint8_t *parity = block + AO40_RS_BLOCK_SIZE - AO40_NROOTS;
+  uint8_t feedback;
+  int i, j;
+
+  memset(parity, 0, AO40_NROOTS);
+
+  for (i = 0; i < AO40_RS_BLOCK_SIZE - AO40_NROOTS; ++i) {
+    feedback = AO40_INDEX_OF[block[i] ^ parity[0]];
+    if (feedback != AO40_NN) {
+      for (j = 1; j < AO40_NROOTS; ++j)
+        parity[j] ^= AO40_ALPHA_TO[AO40_MODNN(feedback + ao40_Genpoly[AO40_NROOTS - j])];
+    }
+    memmove(parity, parity + 1, AO40_NROOTS - 1);
+    parity[AO40_NROOTS - 1] = feedback != AO40_NN ? AO40_ALPHA_TO[AO40_MODNN(feedback + ao40_Genpoly[0])] : 0;
+  }
+}
+
+static inline void ao40_set_bit(uint8_t packed[AO40_CODE_LENGTH], uint16_t pos, int bit) {
+  if (bit)
+    packed[pos >> 3] |= 0x80 >> (pos & 7);
+}
+
+/* Encoding:
+ * - The data is split into two RS codeblocks, every second byte into each.
+ * - The interleaved codeblocks are scrambled and convolutionally encoded,
+ *   with CONV_POLY_B inverted as the CCSDS standard requires, see
+ *   ao40_deinterleave.
+ * - The symbols are written down the columns of the 65 x 80 interleaver,
+ *   the first column holds the sync vector.
+ */
+void ao40_encode_data(const uint8_t data[AO40_DATA_SIZE], uint8_t packed[AO40_CODE_LENGTH]) {
+  uint8_t rs[2][AO40_RS_BLOCK_SIZE];
+  uint8_t sr = 0x7f, byte = 0;
+  uint32_t encstate = 0;
+  uint16_t i, j = 0, pos;
+  int bit;
+
+  memset(packed, 0, AO40_CODE_LENGTH);
+
+  for (i = 0; i < AO40_DATA_SIZE; ++i) {
+    rs[i & 1][i >> 1] = data[i];
+  }
+  ao40_encode_rs_8(rs[0]);
+  ao40_encode_rs_8(rs[1]);
+
+  for (i = 0; i < AO40_INTERLEAVER_ROWS; ++i) {
+    ao40_set_bit(packed, i * AO40_INTERLEAVER_STEP_SIZE, (sr >> 6) & 1);
+    sr = (uint8_t)(((sr << 1) | __builtin_parity(sr & AO40_SYNC_POLY)) & 0x7f);
+  }
+
+  for (i = 0; i < AO40_STEPS; ++i) {
+    if ((i & 7) == 0 && i < AO40_FRAME_BITS)
+      byte = rs[(i >> 3) & 1][i >> 4] ^ ao40_Scrambler[i >> 3];
+    bit = i < AO40_FRAME_BITS ? (byte >> (7 - (i & 7))) & 1 : 0;
+    encstate = (encstate << 1) | (uint32_t)bit;
+
+    pos = (j % AO40_INTERLEAVER_ROWS) * AO40_INTERLEAVER_STEP_SIZE + 1 + j / AO40_INTERLEAVER_ROWS;
+    ao40_set_bit(packed, pos, __builtin_parity(encstate & AO40_CONV_POLY_A));
+    ++j;
+    pos = (j % AO40_INTERLEAVER_ROWS) * AO40_INTERLEAVER_STEP_SIZE + 1 + j / AO40_INTERLEAVER_ROWS;
+    ao40_set_bit(packed, pos, !__builtin_parity(encstate & AO40_CONV_POLY_B));
+    ++j;
+  }
+}
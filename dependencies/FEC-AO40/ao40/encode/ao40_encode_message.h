@@ -0,0 +1,22 @@
+#ifndef AO40_ENCODE_MESSAGE_H
+#define AO40_ENCODE_MESSAGE_H
+
+#include <stdint.h>
+#include "../decode/ao40_decode_message.h"
+
+#define AO40_SYNC_POLY     0x48
+#define AO40_CONV_POLY_A   0x4f
+#define AO40_CONV_POLY_B   0x6d
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/* Encodes 256 data bytes into a 650 byte frame, the inverse of ao40_decode_packed */
+void ao40_encode_data(const uint8_t data[AO40_DATA_SIZE], uint8_t packed[AO40_CODE_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * Common input stage of the AO40 and AO40 short decoders
+ */
+
+#include "ao40_unpack.h"
+
+/* Within a column the bit position grows by step from row to row, so the
+ * byte offset grows by step / 8 and the bit offset by step % 8. Walking the
+ * column keeps both as running offsets, no division per symbol and no
+ * intermediate one byte per bit buffer is needed. */
+void ao40_unpack_deinterleave(const uint8_t *packed, const ao40_interleaver_t *il, uint32_t *syms, uint16_t count) {
+  uint16_t col, row, skip = il->skip;
+  uint32_t byte, bit;
+  uint32_t *end = syms + count;
+
+  for (col = il->first_col; col < il->step && syms != end; ++col) {
+    byte = col >> 3;
+    bit = col & 7;
+
+    for (row = 0; row < il->rows && syms != end; ++row) {
+      if (skip) {
+        --skip;
+      } else {
+        *syms++ = ((packed[byte] >> (7 - bit)) & 1) ? AO40_SOFT_ONE : AO40_SOFT_ZERO;
+      }
+
+      bit += il->step;
+      byte += bit >> 3;
+      bit &= 7;
+    }
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef AO40_UNPACK_H
+#define AO40_UNPACK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif // __cplusplus
+
+/* Soft symbol values the Viterbi decoders expect for a received 0 and 1 bit */
+#define AO40_SOFT_ZERO   0
+#define AO40_SOFT_ONE  255
+
+/* Geometry of a row-column block interleaver: the symbol in row r and column c
+ * was sent as bit (step * r + c) of the frame. Reading starts at column
+ * first_col, goes down the columns and skips the first skip symbols (sync or
+ * pilot bits). */
+typedef struct {
+  uint16_t step;
+  uint16_t rows;
+  uint16_t first_col;
+  uint16_t skip;
+} ao40_interleaver_t;
+
+/* Unpacks, deinterleaves and widens a received frame in one pass:
+ *   Reads the hard decision bits straight from the packed bytes (MSB first)
+ *   and writes count soft symbols in the order and type the Viterbi decoders
+ *   of both AO40 variants take them. */
+void ao40_unpack_deinterleave(const uint8_t *packed, const ao40_interleaver_t *il, uint32_t *syms, uint16_t count);
+
+#ifdef __cplusplus
+}
+#endif // __cplusplus
+
+#endif
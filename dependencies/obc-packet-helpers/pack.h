@@ -201,6 +201,20 @@ namespace s1utils {
         template <size_t N>
         using ItemSize = typename detail::ChooseSizeSum<N, TPackArgs...>::Type;
 
+        /**
+         * @brief Number of items in the pack.
+         */
+        static constexpr size_t itemCount = sizeof...(TPackArgs);
+
+        /**
+         * @brief Byte offset of the Nth item inside the pack.
+         */
+        template <size_t N>
+        static constexpr size_t offset()
+        {
+            return m_fullSize - ItemSize<N>::offset - sizeof(ItemType<N>);
+        }
+
         explicit Pack() { memset(this->m_bytes, 0, Pack::m_fullSize); }
 
         explicit Pack(const TPackArgs &... args) { Pack::initializeData<TPackArgs...>(m_bytes, args...); }
@@ -253,6 +267,72 @@ namespace s1utils {
 
     }; // class Pack
 
+    /**
+     * @brief Non-owning, read-only view of packed data.
+     *
+     * Reads the items of `TPack` (a `Pack`, or a class derived from one) straight from a buffer that
+     * has the layout of `TPack`, without copying the whole pack first. Only the requested item is copied.
+     * The buffer must be at least `sizeof(TPack)` bytes long and must outlive the view.
+     */
+    template <typename TPack>
+    class PackView
+    {
+
+    private:
+        const uint8_t *m_bytes;
+
+    public:
+        template <size_t N>
+        using ItemType = typename TPack::template ItemType<N>;
+
+        static constexpr size_t size = sizeof(TPack);
+
+        explicit PackView(const uint8_t *binary)
+            : m_bytes(binary)
+        {
+        }
+
+        const uint8_t *binary() const { return this->m_bytes; }
+
+        template <size_t N>
+        inline ItemType<N> get() const
+        {
+            static_assert(std::is_trivially_copyable<ItemType<N>>::value, "Item type must be trivially copyable.");
+            ItemType<N> result;
+            ::std::memcpy(&result, this->m_bytes + TPack::template offset<N>(), sizeof(ItemType<N>));
+            return result;
+        }
+
+        /**
+         * @brief Gets a pointer to the bytes of the Nth item.
+         */
+        template <size_t N>
+        inline const uint8_t *itemBinary() const
+        {
+            return this->m_bytes + TPack::template offset<N>();
+        }
+
+        /**
+         * @brief Gets a view of the Nth item, which must be a pack itself.
+         */
+        template <size_t N>
+        inline PackView<ItemType<N>> view() const
+        {
+            return PackView<ItemType<N>>(this->itemBinary<N>());
+        }
+
+        /**
+         * @brief Copies the viewed data into an owning `TPack`.
+         */
+        TPack load() const
+        {
+            TPack result;
+            result.loadBinary(this->m_bytes);
+            return result;
+        }
+
+    }; // class PackView
+
 } // namespace s1utils
 
 #endif // S1_PACK_H
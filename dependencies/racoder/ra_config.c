@@ -33,11 +33,11 @@ static uint16_t ra_lfsr_masks_table[9][4] = {
     {0x1013, 0x109D, 0x117D, 0x1271}, // highbit 12, data_length <= 8191
 };
 
-ra_index_t ra_data_length = 0;
-ra_index_t ra_code_length = 0;
-ra_index_t ra_chck_length = 0;
-uint16_t ra_lfsr_masks[4];
-uint8_t ra_lfsr_highbit;
+RA_THREAD_LOCAL ra_index_t ra_data_length = 0;
+RA_THREAD_LOCAL ra_index_t ra_code_length = 0;
+RA_THREAD_LOCAL ra_index_t ra_chck_length = 0;
+RA_THREAD_LOCAL uint16_t ra_lfsr_masks[4];
+RA_THREAD_LOCAL uint8_t ra_lfsr_highbit;
 
 void ra_length_init(ra_index_t data_length) {
   assert(4 <= data_length && data_length <= RA_MAX_DATA_LENGTH);
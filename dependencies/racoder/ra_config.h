@@ -40,13 +40,21 @@ enum {
   RA_MAX_CODE_LENGTH = RA_MAX_DATA_LENGTH * 2 + 3,
 };
 
-extern ra_index_t ra_data_length;
-extern ra_index_t ra_code_length;
-extern ra_index_t ra_chck_length;
-extern uint16_t ra_lfsr_masks[4];
-extern uint8_t ra_lfsr_highbit;
+/* the code parameters are per thread, so that packets of different lengths
+ * can be encoded and decoded on several threads at the same time */
+#ifdef __cplusplus
+#define RA_THREAD_LOCAL thread_local
+#else
+#define RA_THREAD_LOCAL _Thread_local
+#endif
+
+extern RA_THREAD_LOCAL ra_index_t ra_data_length;
+extern RA_THREAD_LOCAL ra_index_t ra_code_length;
+extern RA_THREAD_LOCAL ra_index_t ra_chck_length;
+extern RA_THREAD_LOCAL uint16_t ra_lfsr_masks[4];
+extern RA_THREAD_LOCAL uint8_t ra_lfsr_highbit;
 
-/* data length in words */
+/* data length in words, must be called on the thread that uses the coder */
 void ra_length_init(ra_index_t data_length);
 
 enum { RA_BITCOUNT = 8 * sizeof(ra_word_t), RA_BITSHIFT = RA_BITCOUNT - 1 };
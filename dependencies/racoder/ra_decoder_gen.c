@@ -19,6 +19,7 @@
 
 
 #include "ra_decoder_gen.h"
+#include "ra_encoder.h"
 #include "ra_lfsr.h"
 #include <assert.h>
 #include <float.h>
@@ -27,18 +28,14 @@
 
 /* --- REPEAT ACCUMULATE GENERIC DECODER --- */
 
-static float ra_dataword_gen[RA_MAX_DATA_LENGTH * RA_BITCOUNT];
-static float ra_codeword_gen[RA_MAX_CODE_LENGTH * RA_BITCOUNT];
-static float ra_forward_gen[RA_MAX_DATA_LENGTH * RA_BITCOUNT];
-
-void ra_prepare_gen(float *softbits) {
+void ra_prepare_gen(ra_decoder_gen_t *dec, float *softbits) {
   int index;
 
   for (index = 0; index < ra_data_length * RA_BITCOUNT; index++)
-    ra_dataword_gen[index] = 0.0f;
+    dec->dataword[index] = 0.0f;
 
   for (index = 0; index < ra_code_length * RA_BITCOUNT; index++)
-    ra_codeword_gen[index] = softbits[index];
+    dec->codeword[index] = softbits[index];
 }
 
 static inline float ra_llr_min(float a, float b) {
@@ -52,7 +49,8 @@ static inline float ra_llr_min(float a, float b) {
   return copysignf(a, c);
 }
 
-void ra_improve_gen(float *codeword, int puncture, bool half) {
+void ra_improve_gen(ra_decoder_gen_t *dec, float *codeword, int puncture,
+                    bool half) {
   int index, bit, pos;
   float accu[RA_BITCOUNT];
   float data, left;
@@ -66,8 +64,8 @@ void ra_improve_gen(float *codeword, int puncture, bool half) {
     pos = ra_lfsr_next();
 
     for (bit = 0; bit < RA_BITCOUNT; bit++) {
-      data = ra_dataword_gen[pos * RA_BITCOUNT + bit];
-      ra_forward_gen[index * RA_BITCOUNT + bit] = accu[bit];
+      data = dec->dataword[pos * RA_BITCOUNT + bit];
+      dec->forward[index * RA_BITCOUNT + bit] = accu[bit];
       accu[bit] = ra_llr_min(accu[bit], data);
     }
 
@@ -101,24 +99,24 @@ void ra_improve_gen(float *codeword, int puncture, bool half) {
     }
 
     for (bit = 0; bit < RA_BITCOUNT; bit++) {
-      left = ra_forward_gen[index * RA_BITCOUNT + bit];
+      left = dec->forward[index * RA_BITCOUNT + bit];
       left = ra_llr_min(left, accu[bit]);
 
-      data = ra_dataword_gen[pos * RA_BITCOUNT + bit];
+      data = dec->dataword[pos * RA_BITCOUNT + bit];
       accu[bit] = ra_llr_min(accu[bit], data);
 
       if (half)
         data *= 0.5f;
 
       left += data;
-      ra_dataword_gen[pos * RA_BITCOUNT + bit] = left;
+      dec->dataword[pos * RA_BITCOUNT + bit] = left;
     }
 
     pos = ra_lfsr_prev();
   }
 }
 
-void ra_decide_gen(ra_word_t *packet) {
+void ra_decide_gen(ra_decoder_gen_t *dec, ra_word_t *packet) {
   int index, bit;
   ra_word_t word;
   float data;
@@ -127,7 +125,7 @@ void ra_decide_gen(ra_word_t *packet) {
     word = 0;
 
     for (bit = 0; bit < RA_BITCOUNT; bit++) {
-      data = ra_dataword_gen[index * RA_BITCOUNT + bit];
+      data = dec->dataword[index * RA_BITCOUNT + bit];
       word |= (data < 0.0f) << bit;
     }
 
@@ -135,23 +133,91 @@ void ra_decide_gen(ra_word_t *packet) {
   }
 }
 
-void ra_decoder_gen(float *softbits, ra_word_t *packet, int passes) {
-  int count, seqno;
-  float *codeword;
+void ra_pass_gen(ra_decoder_gen_t *dec, int count) {
+  int seqno;
+  float *codeword = dec->codeword;
 
-  ra_prepare_gen(softbits);
+  for (seqno = 0; seqno < 4; seqno++) {
+    ra_lfsr_init(seqno);
+    ra_improve_gen(dec, codeword, seqno == 0 ? 1 : RA_PUNCTURE_RATE,
+                   count > 0);
+    codeword += (seqno == 0 ? ra_data_length : ra_chck_length) * RA_BITCOUNT;
+  }
 
-  for (count = 0; count < passes; count++) {
-    codeword = ra_codeword_gen;
+  assert(dec->codeword + ra_code_length * RA_BITCOUNT == codeword);
+}
 
-    for (seqno = 0; seqno < 4; seqno++) {
-      ra_lfsr_init(seqno);
-      ra_improve_gen(codeword, seqno == 0 ? 1 : RA_PUNCTURE_RATE, count > 0);
-      codeword += (seqno == 0 ? ra_data_length : ra_chck_length) * RA_BITCOUNT;
-    }
+bool ra_stable_gen(ra_decoder_gen_t *dec, const ra_word_t *packet, bool first) {
+  int index;
+  bool stable = !first;
 
-    assert(ra_codeword_gen + ra_code_length * RA_BITCOUNT == codeword);
+  for (index = 0; index < ra_data_length; index++) {
+    stable &= packet[index] == dec->previous[index];
+    dec->previous[index] = packet[index];
   }
 
-  ra_decide_gen(packet);
+  return stable;
+}
+
+int ra_mismatch_gen(ra_decoder_gen_t *dec, const float *softbits,
+                    const ra_word_t *packet) {
+  int index, bit, mismatch = 0;
+  ra_word_t word;
+
+  ra_encoder(packet, dec->reencoded);
+
+  for (index = 0; index < ra_code_length; index++) {
+    word = dec->reencoded[index];
+
+    for (bit = 0; bit < RA_BITCOUNT; bit++) {
+      /* a zero bit is sent as a positive soft value, see ra_decide_gen */
+      mismatch += ((word >> bit) & 1) != (softbits[index * RA_BITCOUNT + bit] < 0.0f);
+    }
+  }
+
+  return mismatch;
+}
+
+void ra_decoder_gen(ra_decoder_gen_t *dec, float *softbits, ra_word_t *packet,
+                    int passes) {
+  int count;
+
+  ra_prepare_gen(dec, softbits);
+
+  for (count = 0; count < passes; count++)
+    ra_pass_gen(dec, count);
+
+  ra_decide_gen(dec, packet);
+}
+
+int ra_decoder_gen_conv(ra_decoder_gen_t *dec, float *softbits,
+                        ra_word_t *packet, int passes, int *performed) {
+  int count = 0, mismatch, limit;
+  bool stable;
+
+  limit = ra_code_length * RA_BITCOUNT / RA_MISMATCH_FRACTION;
+  ra_prepare_gen(dec, softbits);
+
+  do {
+    ra_pass_gen(dec, count);
+    ra_decide_gen(dec, packet);
+    stable = ra_stable_gen(dec, packet, count == 0);
+    count++;
+
+    /* reencoding is only worth the effort once the decisions repeat */
+    mismatch = -1;
+    if (stable) {
+      mismatch = ra_mismatch_gen(dec, softbits, packet);
+      if (mismatch <= limit)
+        break;
+    }
+  } while (count < passes);
+
+  if (mismatch < 0)
+    mismatch = ra_mismatch_gen(dec, softbits, packet);
+
+  if (performed)
+    *performed = count;
+
+  return mismatch;
 }
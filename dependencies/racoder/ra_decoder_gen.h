@@ -27,7 +27,34 @@
 extern "C" {
 #endif
 
-void ra_decoder_gen(float *softbits, ra_word_t *packet, int passes);
+enum {
+  /* reencoded packets that disagree with more than 1/RA_MISMATCH_FRACTION
+   * of the received code bits are not considered to be consistent. Correct
+   * decodes disagree exactly where the channel flipped a bit, and the
+   * decoder does not converge above a channel bit error rate of about 8%,
+   * so 1/12 rejects few correct packets but most wrong ones */
+  RA_MISMATCH_FRACTION = 12,
+};
+
+/* working memory of the decoder, threads that decode at the same time must
+ * each use their own */
+typedef struct {
+  float dataword[RA_MAX_DATA_LENGTH * RA_BITCOUNT];
+  float codeword[RA_MAX_CODE_LENGTH * RA_BITCOUNT];
+  float forward[RA_MAX_DATA_LENGTH * RA_BITCOUNT];
+  ra_word_t previous[RA_MAX_DATA_LENGTH];
+  ra_word_t reencoded[RA_MAX_CODE_LENGTH];
+} ra_decoder_gen_t;
+
+void ra_decoder_gen(ra_decoder_gen_t *dec, float *softbits, ra_word_t *packet,
+                    int passes);
+
+/* Runs at most passes passes, but stops as soon as the decisions are stable
+ * and the reencoded packet is consistent with the sign of softbits. Returns
+ * the number of code bits where the two disagree, and the number of passes
+ * actually performed is stored into performed if it is not NULL. */
+int ra_decoder_gen_conv(ra_decoder_gen_t *dec, float *softbits,
+                        ra_word_t *packet, int passes, int *performed);
 
 #ifdef __cplusplus
 }
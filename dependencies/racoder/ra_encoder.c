@@ -0,0 +1,68 @@
+/*
+ * Copyright 2015-2019 Miklos Maroti.
+ *
+ * This is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this software; see the file COPYING.  If not, write to
+ * the Free Software Foundation, Inc., 51 Franklin Street,
+ * Boston, MA 02110-1301, USA.
+ */
+
+
+
+#include "ra_encoder.h"
+#include "ra_lfsr.h"
+#include <assert.h>
+
+/* --- REPEAT ACCUMULATE ENCODER --- */
+
+static inline ra_word_t ra_rotate_right(ra_word_t word) {
+  return (ra_word_t)((word >> 1) | (word << RA_BITSHIFT));
+}
+
+static inline ra_word_t ra_rotate_left(ra_word_t word) {
+  return (ra_word_t)((word << 1) | (word >> RA_BITSHIFT));
+}
+
+static ra_word_t *ra_accumulate(const ra_word_t *packet, ra_word_t *output,
+                                int puncture) {
+  int index;
+  ra_word_t accu = 0;
+
+  for (index = 0; index < ra_data_length; index++) {
+    accu ^= packet[ra_lfsr_next()];
+
+    if ((index + 1) % puncture == 0)
+      *(output++) = accu;
+
+    accu = ra_rotate_right(accu);
+  }
+
+  /* the tail word closes the accumulator, see ra_improve_gen */
+  if (ra_data_length % puncture != 0)
+    *(output++) = ra_rotate_left(accu);
+
+  return output;
+}
+
+void ra_encoder(const ra_word_t *packet, ra_word_t *output) {
+  int seqno;
+  ra_word_t *end = output;
+
+  for (seqno = 0; seqno < 4; seqno++) {
+    ra_lfsr_init(seqno);
+    end = ra_accumulate(packet, end, seqno == 0 ? 1 : RA_PUNCTURE_RATE);
+  }
+
+  assert(output + ra_code_length == end);
+  (void)end;
+}
@@ -21,9 +21,9 @@
 #include "ra_lfsr.h"
 #include <assert.h>
 
-static ra_index_t ra_lfsr_mask;
-static ra_index_t ra_lfsr_state;
-static ra_index_t ra_lfsr_offset;
+static RA_THREAD_LOCAL ra_index_t ra_lfsr_mask;
+static RA_THREAD_LOCAL ra_index_t ra_lfsr_state;
+static RA_THREAD_LOCAL ra_index_t ra_lfsr_offset;
 
 /* last element returned will be seqno */
 void ra_lfsr_init(uint8_t seqno) {
@@ -30,6 +30,12 @@ DEFINES += \
     # A1GND_USE_CONFIDENTIAL_REPO \ # ATL 1 confidential repo flag
     INITIALBASEFREQUENCY=437345000 \
 
+# qmake CONFIG+=fixed_point_dsp demodulates with the fixed-point chain of newsmog1dem, for stations without a fast FPU
+# (e.g. ARM boards). tools/dspcheck compares it with the floating-point chain.
+fixed_point_dsp {
+    DEFINES += S1DEM_FIXED_POINT
+}
+
 RESOURCES += source/qml/qml.qrc
 
 INCLUDEPATH += "$$PWD/dependencies/3rdparty/rtlsdr"
@@ -38,7 +44,9 @@ QMAKE_CXXFLAGS += -Wno-type-limits
 QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic -Wunreachable-code #-Wshadow  #-Wswitch-default  -Wconversion
 
 win32 {
-    LIBS += -L"$$_PRO_FILE_PWD_/dependencies/3rdparty/fftw3" -lfftw3 \
+    # Only the double precision fftw3 is bundled. The single precision fftw3f (used by the wideband spectrum) is not,
+    # you need to acquire fftw3f.dll and fftw3f.lib on your own and put them next to fftw3.lib
+    LIBS += -L"$$_PRO_FILE_PWD_/dependencies/3rdparty/fftw3" -lfftw3 -lfftw3f \
             -L$$PWD/dependencies/3rdparty/libusb -lusb-1.0 \
             -L$$PWD/dependencies/3rdparty/openssl -lcrypto-1_1 # You need to acquire this on your own
 
@@ -55,7 +63,7 @@ RC_ICONS = "icon/smoggnd.ico"
 
 linux {
     CONFIG += link_pkgconfig
-    PKGCONFIG += libusb-1.0 fftw3 libudev openssl
+    PKGCONFIG += libusb-1.0 fftw3 fftw3f libudev openssl
 }
 
 linux-g++ {
@@ -77,7 +85,7 @@ mac {
 ICON = $$PWD/icon/smoggnd.icns
 #packages installed with Homebrew
     LIBS += -L/usr/local/Cellar/libusb/1.0.23/lib -lusb-1.0 \
-            -L/usr/local/Cellar/fftw/3.3.8_1/lib -lfftw3 \
+            -L/usr/local/Cellar/fftw/3.3.8_1/lib -lfftw3 -lfftw3f \
             -L/usr/local/Cellar/openssl@1.1/1.1.1d/lib -lssl
 
     INCLUDEPATH +=  "$$_PRO_FILE_PWD_/dependencies/3rdparty/fftw3" \
@@ -86,8 +94,10 @@ ICON = $$PWD/icon/smoggnd.icns
 
 HEADERS += \
     dependencies/obc-packet-helpers/helper.h \
+    source/audio/audiofilesource.h \
     source/audio/audioindemodulator.h \
     source/audio/audioindemodulatorthread.h \
+    source/audio/audiosampleblock.h \
     source/audio/audiosampler.h \
     source/command/commandtracker.h \
     source/command/commandqueue.h \
@@ -97,13 +107,23 @@ HEADERS += \
     source/connection/uploadworker.h \
     source/demod/magicdemodulator.h \
     source/demod/newsmog1dem.h \
+    source/demod/rationalresampler.h \
+    source/packet/archiveredecoder.h \
     source/packet/chartwindow.h \
     source/packet/decodedpacket.h \
+    source/packet/fecdecoder.h \
+    source/packet/fecjob.h \
     source/packet/filedownload.h \
+    source/packet/packetarchive.h \
     source/packet/packetdecoder.h \
+    source/packet/packetfiltermodel.h \
+    source/packet/packetformatter.h \
+    source/packet/packethistorymodel.h \
+    source/packet/packetrecord.h \
     source/packet/packettablemodel.h \
     source/packet/syncpacket.h \
     source/packet/spectrumreceiver.h \
+    source/packet/telemetrystore.h \
     source/predict/predictercontroller.h \
     source/predict/predicterworker.h \
     source/predict/predictmod.h \
@@ -118,11 +138,13 @@ HEADERS += \
     source/rotators/rotator.h \
     source/sdr/sdrthread.h \
     source/sdr/sdrworker.h \
+    source/sdr/widebandspectrum.h \
     source/settings/settingsholder.h \
     source/settings/settingsproxy.h \
     source/utilities/common.h \
     source/utilities/devicediscovery.h \
     source/utilities/eventfilter.h \
+    source/utilities/fftplanner.h \
     source/utilities/logger.h \
     source/utilities/messageproxy.h \
     source/utilities/satellitechanger.h \
@@ -143,6 +165,7 @@ HEADERS += \
     dependencies/FEC-AO40/ao40/decode/ao40_decode_message.h \
     dependencies/FEC-AO40/ao40/decode/ao40_spiral-vit_scalar.h \
     dependencies/FEC-AO40/ao40/decode/ao40_decode_rs.h \
+    dependencies/FEC-AO40/common/ao40_unpack.h \
     dependencies/obc-packet-helpers/int24.h \
     dependencies/obc-packet-helpers/bitfield.h \
     dependencies/obc-packet-helpers/pack.h \
@@ -152,13 +175,17 @@ HEADERS += \
     dependencies/obc-packet-helpers/packethelper.h \
     dependencies/racoder/ra_config.h \
     dependencies/racoder/ra_decoder_gen.h \
+    dependencies/racoder/ra_encoder.h \
     dependencies/racoder/ra_lfsr.h \
-    source/visualization/spectogram.h
+    source/visualization/spectogram.h \
+    source/visualization/waterfalltexture.h
 
 SOURCES += \
     source/main.cpp \
+    source/audio/audiofilesource.cpp \
     source/audio/audioindemodulator.cpp \
     source/audio/audioindemodulatorthread.cpp \
+    source/audio/audiosampleblock.cpp \
     source/audio/audiosampler.cpp \
     source/command/commandtracker.cpp \
     source/command/commandqueue.cpp \
@@ -168,12 +195,22 @@ SOURCES += \
     source/connection/uploadworker.cpp \
     source/demod/magicdemodulator.cpp \
     source/demod/newsmog1dem.cpp \
+    source/demod/rationalresampler.cpp \
+    source/packet/archiveredecoder.cpp \
     source/packet/chartwindow.cpp \
     source/packet/decodedpacket.cpp \
+    source/packet/fecdecoder.cpp \
+    source/packet/fecjob.cpp \
     source/packet/filedownload.cpp \
+    source/packet/packetarchive.cpp \
     source/packet/packetdecoder.cpp \
+    source/packet/packetfiltermodel.cpp \
+    source/packet/packetformatter.cpp \
+    source/packet/packethistorymodel.cpp \
+    source/packet/packetrecord.cpp \
     source/packet/packettablemodel.cpp \
     source/packet/spectrumreceiver.cpp \
+    source/packet/telemetrystore.cpp \
     source/packet/syncpacket.cpp \
     source/predict/predictercontroller.cpp \
     source/predict/predicterworker.cpp \
@@ -189,11 +226,13 @@ SOURCES += \
     source/rotators/rotator.cpp \
     source/sdr/sdrthread.cpp \
     source/sdr/sdrworker.cpp \
+    source/sdr/widebandspectrum.cpp \
     source/settings/settingsholder.cpp \
     source/settings/settingsproxy.cpp \
     source/utilities/common.cpp \
     source/utilities/devicediscovery.cpp \
     source/utilities/eventfilter.cpp \
+    source/utilities/fftplanner.cpp \
     source/utilities/logger.cpp \
     source/utilities/messageproxy.cpp \
     source/utilities/satellitechanger.cpp \
@@ -211,8 +250,11 @@ SOURCES += \
     dependencies/FEC-AO40/ao40/decode/ao40_decode_message.c \
     dependencies/FEC-AO40/ao40/decode/ao40_spiral-vit_scalar.c \
     dependencies/FEC-AO40/ao40/decode/ao40_decode_rs.c \
+    dependencies/FEC-AO40/common/ao40_unpack.c \
     dependencies/obc-packet-helpers/packethelper.cpp \
     dependencies/racoder/ra_config.c \
     dependencies/racoder/ra_decoder_gen.c \
+    dependencies/racoder/ra_encoder.c \
     dependencies/racoder/ra_lfsr.c \
-   source/visualization/spectogram.cpp
+   source/visualization/spectogram.cpp \
+   source/visualization/waterfalltexture.cpp
@@ -0,0 +1,278 @@
+#include "audiofilesource.h"
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QMetaObject>
+#include <QQueue>
+#include <QThread>
+#include <QUrl>
+#include <QVector>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+/**
+ * @brief Returns the sample at \p data as a 16 bit sample
+ */
+inline int sampleAt(const uchar *data, int bitsPerSample, bool isFloat) {
+    switch (bitsPerSample) {
+    case 8:
+        return (static_cast<int>(data[0]) - 128) * 256; // 8 bit samples are unsigned
+    case 16:
+        return qFromLittleEndian<qint16>(data);
+    case 24:
+        // Sign extension from the most significant byte
+        return static_cast<int>(static_cast<qint8>(data[2])) * 256 + data[1];
+    default:
+        if (isFloat) {
+            const quint32 bits = qFromLittleEndian<quint32>(data);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return static_cast<int>(qBound(-1.0f, value, 1.0f) * 32767.0f);
+        }
+        return qFromLittleEndian<qint32>(data) / 65536;
+    }
+}
+} // namespace
+
+/**
+ * @brief Constructor for the class.
+ * @param parent The parent QObject, should be left empty.
+ */
+AudioFileSource::AudioFileSource(QObject *parent)
+: QObject(parent), running_priv(0), stopping_priv(0), progress_priv(0) {
+    pool_priv.setMaxThreadCount(1);
+}
+
+/**
+ * @brief Stops the worker and waits for it
+ */
+AudioFileSource::~AudioFileSource() {
+    stop();
+    pool_priv.waitForDone();
+}
+
+/**
+ * @brief Starts playing the WAV recording \p fileName on the worker thread.
+ * @param fileName The path or the file URL of the recording
+ * @param realTime Plays the recording at its own pace if true, as fast as the receivers process it otherwise
+ * @return Returns false if a recording is already played or this one can not be played, AudioFileSource::fileError()
+ * is emitted with the reason then.
+ */
+bool AudioFileSource::start(const QString &fileName, bool realTime) {
+    if (running_priv.loadAcquire() != 0) {
+        emit fileError(tr("A recording is already being played."));
+        return false;
+    }
+    file_priv.setFileName(fileName.startsWith("file:") ? QUrl(fileName).toLocalFile() : fileName);
+    if (!file_priv.open(QIODevice::ReadOnly)) {
+        emit fileError(tr("Could not open %1: %2").arg(fileName, file_priv.errorString()));
+        return false;
+    }
+    Format format;
+    QString error;
+    if (!readFormat(file_priv, format, error)) {
+        file_priv.close();
+        emit fileError(tr("Could not play %1: %2").arg(fileName, error));
+        return false;
+    }
+    qInfo() << "Playing" << fileName << "with" << format.channels << "channels at" << format.sampleRate << "Hz,"
+            << format.frames << "frames";
+
+    stopping_priv.storeRelease(0);
+    progress_priv.storeRelease(0);
+    running_priv.storeRelease(1);
+    emit runningChanged();
+    emit progressChanged();
+    pool_priv.start(new FunctionJob([this, format, realTime]() {
+        play(format, realTime);
+        QMetaObject::invokeMethod(this, [this]() { finished(); }, Qt::QueuedConnection);
+    }));
+    return true;
+}
+
+/**
+ * @brief Stops playing the recording, AudioFileSource::runningChanged() is emitted when the worker has stopped
+ */
+void AudioFileSource::stop() {
+    stopping_priv.storeRelease(1);
+}
+
+bool AudioFileSource::isRunning() const {
+    return running_priv.loadAcquire() != 0;
+}
+
+/**
+ * @brief Returns the part of the recording that has been played, from 0 to 1
+ */
+double AudioFileSource::progress() const {
+    return progress_priv.loadAcquire() / 10000.0;
+}
+
+/**
+ * @brief Reads the RIFF header of a WAV recording, up to the start of its data chunk.
+ * @param[in] file The opened recording
+ * @param[out] format The format of the recording
+ * @param[out] error The reason if the recording can not be played
+ * @return Returns true if the recording can be played.
+ */
+bool AudioFileSource::readFormat(QFile &file, Format &format, QString &error) {
+    const QByteArray riff = file.read(12);
+    if (riff.size() != 12 || !riff.startsWith("RIFF") || riff.mid(8, 4) != "WAVE") {
+        error = tr("it is not a WAV file");
+        return false;
+    }
+    bool hasFormat = false;
+    while (!file.atEnd()) {
+        const QByteArray header = file.read(8);
+        if (header.size() != 8) {
+            break;
+        }
+        const QByteArray id = header.left(4);
+        const quint32 size = qFromLittleEndian<quint32>(reinterpret_cast<const uchar *>(header.constData() + 4));
+        if (id == "fmt ") {
+            const QByteArray fmt = file.read(size);
+            if (size < 16 || fmt.size() != static_cast<int>(size)) {
+                break;
+            }
+            const uchar *data = reinterpret_cast<const uchar *>(fmt.constData());
+            int encoding = qFromLittleEndian<quint16>(data);
+            if (encoding == 0xFFFE && size >= 26) {
+                encoding = qFromLittleEndian<quint16>(data + 24); // WAVE_FORMAT_EXTENSIBLE, the start of the GUID
+            }
+            format.channels = qFromLittleEndian<quint16>(data + 2);
+            format.sampleRate = static_cast<int>(qFromLittleEndian<quint32>(data + 4));
+            format.bitsPerSample = qFromLittleEndian<quint16>(data + 14);
+            format.isFloat = encoding == 3;
+            const bool supported = (encoding == 1 && (format.bitsPerSample == 8 || format.bitsPerSample == 16 ||
+                                                         format.bitsPerSample == 24 || format.bitsPerSample == 32)) ||
+                                   (format.isFloat && format.bitsPerSample == 32);
+            if (!supported || format.channels == 0 || format.sampleRate <= 0) {
+                error = tr("only 8, 16, 24 and 32 bit PCM and 32 bit float WAV files are supported");
+                return false;
+            }
+            hasFormat = true;
+            file.seek(file.pos() + (size & 1)); // Chunks are padded to an even size
+        }
+        else if (id == "data") {
+            if (!hasFormat) {
+                break;
+            }
+            format.dataOffset = file.pos();
+            qint64 bytes = size;
+            if (size == 0xFFFFFFFF || format.dataOffset + bytes > file.size()) {
+                // The size of unfinished recordings is often not written
+                bytes = file.size() - format.dataOffset;
+            }
+            format.frames = bytes / format.frameSize();
+            if (format.frames == 0) {
+                error = tr("the recording is empty");
+                return false;
+            }
+            return true;
+        }
+        else {
+            file.seek(file.pos() + size + (size & 1));
+        }
+    }
+    error = tr("the WAV file is damaged");
+    return false;
+}
+
+/**
+ * @brief Converts \p frames frames at \p data into 16 bit samples, the channels are averaged
+ */
+void AudioFileSource::convertFrames(const Format &format, const uchar *data, int frames, std::int16_t *samples) {
+    const int sampleSize = format.bitsPerSample / 8;
+    for (int i = 0; i < frames; i++) {
+        int sum = 0;
+        for (int channel = 0; channel < format.channels; channel++) {
+            sum += sampleAt(data, format.bitsPerSample, format.isFloat);
+            data += sampleSize;
+        }
+        samples[i] = static_cast<std::int16_t>(sum / format.channels);
+    }
+}
+
+/**
+ * @brief Emits the blocks of the recording until its end or until it is stopped. Called by the worker.
+ */
+void AudioFileSource::play(const Format &format, bool realTime) {
+    const int frameSize = format.frameSize();
+    uchar *mapped = file_priv.map(format.dataOffset, format.frames * frameSize);
+    if (mapped == nullptr) {
+        qInfo() << "Could not map the recording, reading it in chunks:" << file_priv.errorString();
+    }
+    // The chunks hold whole blocks, so that a block never spans two chunks
+    const qint64 chunkFrames = qMax(1, chunkSize / (frameSize * blockSize)) * blockSize;
+    QByteArray chunk;
+    qint64 chunkFirstFrame = 0;
+    qint64 chunkFrameCount = 0;
+
+    QVector<std::int16_t> samples(blockSize);
+    QQueue<AudioSampleBlock> pending; // Blocks emitted as fast as possible, they may still be held by the receivers
+    int reportedProgress = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (qint64 frame = 0; frame < format.frames && stopping_priv.loadAcquire() == 0;) {
+        int count = static_cast<int>(qMin<qint64>(blockSize, format.frames - frame));
+        const uchar *data;
+        if (mapped != nullptr) {
+            data = mapped + frame * frameSize;
+        }
+        else {
+            if (frame >= chunkFirstFrame + chunkFrameCount) {
+                chunkFirstFrame = frame;
+                file_priv.seek(format.dataOffset + frame * frameSize);
+                chunk = file_priv.read(qMin(chunkFrames, format.frames - frame) * frameSize);
+                chunkFrameCount = chunk.size() / frameSize;
+            }
+            count = static_cast<int>(qMin<qint64>(count, chunkFirstFrame + chunkFrameCount - frame));
+            if (count <= 0) {
+                qWarning() << "Could not read the recording:" << file_priv.errorString();
+                break;
+            }
+            data = reinterpret_cast<const uchar *>(chunk.constData()) + (frame - chunkFirstFrame) * frameSize;
+        }
+        convertFrames(format, data, count, samples.data());
+        const AudioSampleBlock block = AudioSampleBlock::copyOf(samples.constData(), count, format.sampleRate, frame);
+        frame += count;
+
+        if (realTime) {
+            // A block is emitted when it would have been recorded
+            const qint64 wait = frame * 1000 / format.sampleRate - timer.elapsed();
+            if (wait > 0) {
+                QThread::msleep(static_cast<unsigned long>(wait));
+            }
+            emit audioSamples(block);
+        }
+        else {
+            emit audioSamples(block);
+            pending.enqueue(block);
+            while (pending.size() > maximumPendingBlocks) {
+                while (pending.head().isShared() && stopping_priv.loadAcquire() == 0) {
+                    QThread::msleep(1);
+                }
+                pending.dequeue();
+            }
+        }
+
+        const int progress = static_cast<int>(frame * 10000 / format.frames);
+        if (progress - reportedProgress >= 10 || frame == format.frames) {
+            reportedProgress = progress;
+            progress_priv.storeRelease(progress);
+            emit progressChanged();
+        }
+    }
+    if (mapped != nullptr) {
+        file_priv.unmap(mapped);
+    }
+}
+
+/**
+ * @brief Called on the thread of the object when the worker has stopped
+ */
+void AudioFileSource::finished() {
+    file_priv.close();
+    running_priv.storeRelease(0);
+    emit runningChanged();
+}
@@ -0,0 +1,90 @@
+#ifndef AUDIOFILESOURCE_H
+#define AUDIOFILESOURCE_H
+
+#include "../utilities/common.h"
+#include "audiosampleblock.h"
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QFile>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+/**
+ * @brief Plays a WAV recording into the audio demodulator, like AudioSampler plays the audio device.
+ *
+ * The recording is emitted in blocks of AudioFileSource::blockSize frames, the position of a block is the index of its
+ * first frame in the recording, so the demodulator can tell which sample of the recording completed a packet. The
+ * channels are averaged. 8, 16, 24 and 32 bit integer and 32 bit float PCM recordings are supported, at any sampling
+ * rate.
+ *
+ * The recording is memory-mapped and read on a worker thread. If it can not be mapped (e.g. it is too large for the
+ * address space), it is read sequentially in chunks of AudioFileSource::chunkSize bytes. The blocks are emitted at the
+ * pace of the recording or as fast as the receivers process them: then at most AudioFileSource::maximumPendingBlocks
+ * blocks are held by the receivers at a time.
+ */
+class AudioFileSource : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(double progress READ progress NOTIFY progressChanged)
+
+public:
+    static constexpr int blockSize = 4096;         //!< Frames per block
+    static constexpr int chunkSize = 1 << 20;      //!< Bytes read at once if the recording is not mapped
+    static constexpr int maximumPendingBlocks = 8; //!< Blocks held by the receivers when played as fast as possible
+
+    explicit AudioFileSource(QObject *parent = 0);
+    ~AudioFileSource() override;
+
+    Q_INVOKABLE bool start(const QString &fileName, bool realTime);
+    Q_INVOKABLE void stop();
+    bool isRunning() const;
+    double progress() const;
+
+signals:
+    void runningChanged();
+    void progressChanged();
+
+    /**
+     * @brief Emitted when the recording can not be played
+     * @param message The reason, can be shown to the user
+     */
+    void fileError(QString message);
+
+    /**
+     * @brief Emitted for every block of the recording, from the worker thread
+     * @param samples The samples of the block, shared by the receivers
+     */
+    void audioSamples(AudioSampleBlock samples);
+
+private:
+    /**
+     * @brief The format of the samples, from the fmt chunk of the recording
+     */
+    struct Format {
+        int channels = 0;
+        int sampleRate = 0;
+        int bitsPerSample = 0;
+        bool isFloat = false;
+        qint64 dataOffset = 0; //!< Offset of the first frame in the file [bytes]
+        qint64 frames = 0;     //!< Frames in the data chunk
+
+        int frameSize() const {
+            return channels * (bitsPerSample / 8);
+        }
+    };
+
+    static bool readFormat(QFile &file, Format &format, QString &error);
+    static void convertFrames(const Format &format, const uchar *data, int frames, std::int16_t *samples);
+    void play(const Format &format, bool realTime);
+    void finished();
+
+    QFile file_priv;          //!< Opened by start(), read by the worker
+    QAtomicInt running_priv;  //!< Set while the worker plays the recording
+    QAtomicInt stopping_priv; //!< Set by stop() to stop the worker
+    QAtomicInt progress_priv; //!< Played frames in 1 / 10000 of the recording
+
+    QThreadPool pool_priv; //!< The worker thread, destroyed (and waited for) first
+};
+
+#endif // AUDIOFILESOURCE_H
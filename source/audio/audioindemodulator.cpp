@@ -1,58 +1,149 @@
 #include "audioindemodulator.h"
+#include "../utilities/common.h"
+#include <algorithm>
 
 /**
- * @brief Processes \p len number of \p samples. Emits AudioInDemodulator::dataReady() if a packet was found.
+ * @brief Processes the \p samples. Emits AudioInDemodulator::dataReady() if a packet was found.
  *
  * Iterates over \p samples and processes them.
  * When a packet was found a properly formatted QString is created.
  * Then that QString is emitted through AudioInDemodulator::dataReady().
- * Takes ownership of \p samples.
  *
- * @param[in] samples The samples from audiosampler. The method takes ownership of it.
- * @param[in] len The number of samples.
+ * @param[in] samples The samples from audiosampler, shared with the other receivers.
  */
-void AudioInDemodulator::process_samples(int16_t *samples, int len) {
-    QScopedArrayPointer<int16_t> samples_qsap(samples);
-    for (int i = 0; i < len; i++) {
-        resample_input_buffer[current_input_buffer_idx] = s16le2cf(samples[i]);
-        current_input_buffer_idx++;
-        if (current_input_buffer_idx == S1DEM_ORIGINAL_AUDIO_SAMPLING_FREQ) {
-            rational_resample(resample_input_buffer, resample_output_buffer);
-            for (int j = 0; j < S1DEM_AUDIO_SAMPLING_FREQ; j++) {
-                auto cncod = cnco(&cnco_vars, resample_output_buffer[j]);
-                magic_demod.addSample(cncod);
-            }
-            current_input_buffer_idx = 0;
-        }
+void AudioInDemodulator::process_samples(const AudioSampleBlock &samples) {
+    if (samples.sampleRate() != input_sampling_rate || samples.position() != next_position) {
+        startStream(samples.sampleRate(), samples.position());
+    }
+    next_position = samples.position() + samples.size();
+    if (resampler.isNull() || demodulators.isEmpty()) {
+        return;
+    }
+
+    // The shared front-end
+    resample_output_buffer.resize(resampler->maximumOutputCount(samples.size()));
+#ifdef S1DEM_FIXED_POINT
+    const int count = resampler->process(samples.constData(), samples.size(), resample_output_buffer.data());
+    mixed_buffer.resize(count);
+    for (int i = 0; i < count; i++) {
+        mixed_buffer[i] = cnco_fixed(&cnco_vars, s16le2fixed(resample_output_buffer[i]));
+    }
+#else
+    resample_input_buffer.resize(samples.size());
+    std::transform(samples.begin(), samples.end(), resample_input_buffer.begin(), [](std::int16_t sample) {
+        return s16le2cf(sample).real();
+    });
+    const int count =
+        resampler->process(resample_input_buffer.constData(), samples.size(), resample_output_buffer.data());
+    mixed_buffer.resize(count);
+    for (int i = 0; i < count; i++) {
+        mixed_buffer[i] = cnco(&cnco_vars, std::complex<float>(resample_output_buffer[i], 0));
+    }
+#endif
+
+    // The datarates of the bank in parallel
+    const S1demSample *mixed = mixed_buffer.constData();
+    if (demodulators.size() == 1) {
+        demodulators.first()->addSamples(mixed, count);
+        return;
     }
+    for (MagicDemodulator *demodulator : demodulators) {
+        pool_priv.start(new FunctionJob([demodulator, mixed, count]() { demodulator->addSamples(mixed, count); }));
+    }
+    pool_priv.waitForDone();
+}
+
+/**
+ * @brief Starts a new stream at \p position: clears the demodulators and designs the resampler for the
+ * \p sampling_rate of the source. The filter is made longer when the rate is decimated, so that its transition band
+ * stays as narrow.
+ */
+void AudioInDemodulator::startStream(int sampling_rate, qint64 position) {
+    stream_position = position;
+    stream_demodulated_samples = demodulators.isEmpty() ? 0 : demodulators.first()->sampleCount();
+    resetDemodulatorSlot();
+    if (sampling_rate == input_sampling_rate && !resampler.isNull()) {
+        resampler->clear();
+        return;
+    }
+    input_sampling_rate = sampling_rate;
+    if (sampling_rate <= 0) {
+        resampler.reset();
+        return;
+    }
+    const int ratio = (sampling_rate + S1DEM_AUDIO_SAMPLING_FREQ - 1) / S1DEM_AUDIO_SAMPLING_FREQ;
+    resampler.reset(new RationalResampler(
+        sampling_rate, S1DEM_AUDIO_SAMPLING_FREQ, RationalResampler::DEFAULT_TAPS_PER_PHASE * qMax(1, ratio)));
+}
+
+/**
+ * @brief Returns the stream position of the input sample that completed the sample number \p demodulated_samples of a
+ * demodulator, without the delay of the resampler.
+ */
+qint64 AudioInDemodulator::packetPosition(qint64 demodulated_samples) const {
+    const qint64 output_index = demodulated_samples - stream_demodulated_samples - 1;
+    const qint64 input_index = output_index * input_sampling_rate / S1DEM_AUDIO_SAMPLING_FREQ - resampler->delay();
+    return stream_position + qMax<qint64>(0, input_index);
 }
 
 /**
  * @brief Constructor for the class.
  *
- * Initializes the object. Sets packet length to \p packet_length.
+ * Initializes the object. Creates a demodulator for every datarate in \p datarates.
  * Initializes a number of private variables.
+ * @param[in] datarates The datarates of the bank, they have to divide S1DEM_AUDIO_SAMPLING_FREQ / 2 and must not be
+ * above AudioInDemodulator::MAXIMUM_DATARATE.
+ * @param[in] source_name The source of the packets is "<source_name> <datarate> BPS".
+ * @param[in] report_positions Reports the position of the packets in the stream with them.
  * @param[in] parent The parent QObject, should be left empty.
  */
-AudioInDemodulator::AudioInDemodulator(QObject *parent) : QObject(parent) {
-    current_input_buffer_idx = 0;
-    change_cnco_sampling_rate(&cnco_vars, S1DEM_AUDIO_SAMPLING_FREQ); // After resampling, sampling rate is 42.5 kHz
+AudioInDemodulator::AudioInDemodulator(
+    const QList<long> &datarates, const QString &source_name, bool report_positions, QObject *parent)
+: QObject(parent), report_positions(report_positions), input_sampling_rate(0), stream_position(0),
+  stream_demodulated_samples(0), next_position(-1) {
+    change_cnco_sampling_rate(&cnco_vars, S1DEM_AUDIO_SAMPLING_FREQ); // After resampling, sampling rate is 50 kHz
     change_cnco_offset_frequency(&cnco_vars, S1DEM_AUDIO_FREQ_CENTER_OFFSET); // We have an offset of 1.5 kHz
-    // Forwarding the signal
-    QObject::connect(&magic_demod, &MagicDemodulator::dataReady, this, &AudioInDemodulator::dataReady);
+    for (long datarate : datarates) {
+        if (datarate <= 0 || datarate > MAXIMUM_DATARATE || S1DEM_AUDIO_SAMPLING_FREQ % (2 * datarate) != 0) {
+            qWarning() << "Unsupported audio datarate" << datarate;
+            continue;
+        }
+        auto demodulator = new MagicDemodulator(
+            S1DEM_AUDIO_SAMPLING_FREQ, datarate, QString("%1 %2 BPS").arg(source_name).arg(datarate), this);
+        // Forwarding the signal, on the thread of the demodulator while its sample count belongs to the packet
+        QObject::connect(demodulator,
+            &MagicDemodulator::dataReady,
+            this,
+            [this, demodulator](QDateTime timestamp, QString source, QString packetUpperHexString) {
+                // Kept apart from the source, so that a recording has one source per datarate
+                const qint64 position = this->report_positions ? packetPosition(demodulator->sampleCount()) : -1;
+                emit dataReady(timestamp, source, packetUpperHexString, position);
+            },
+            Qt::DirectConnection);
+        demodulators.append(demodulator);
+    }
+    pool_priv.setMaxThreadCount(qMax(1, demodulators.size()));
 }
 
 AudioInDemodulator::~AudioInDemodulator() {
+    pool_priv.waitForDone();
     free(cnco_vars.lo);
+    free(cnco_vars.lo_q15);
+}
+
+/**
+ * @brief Returns the datarates that fit into the audio of a receiver: 1250, 2500 and 5000 BPS
+ */
+QList<long> AudioInDemodulator::defaultDatarates() {
+    return {1250, 2500, 5000};
 }
 
 /**
  * @brief Slot used to call AudioInDemodulator::process_samples() from another thread.
- * @param[in] samples The samples from the audio sampler. Takes ownership of the pointer.
- * @param[in] len The number of samples forwarded for demodulation.
+ * @param[in] samples The samples from the audio sampler.
  */
-void AudioInDemodulator::demodulateSlot(int16_t *samples, int len) {
-    process_samples(samples, len);
+void AudioInDemodulator::demodulateSlot(AudioSampleBlock samples) {
+    process_samples(samples);
 }
 
 /**
@@ -65,5 +156,7 @@ void AudioInDemodulator::changeSettingsSlot(long new_packet_length) {
 }
 
 void AudioInDemodulator::resetDemodulatorSlot() {
-    magic_demod.clear();
+    for (MagicDemodulator *demodulator : demodulators) {
+        demodulator->clear();
+    }
 }
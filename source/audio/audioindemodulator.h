@@ -3,30 +3,66 @@
 
 #include "../demod/magicdemodulator.h"
 #include "../demod/newsmog1dem.h"
+#include "../demod/rationalresampler.h"
+#include "audiosampleblock.h"
+#include <QList>
 #include <QObject>
-#include <QScopedArrayPointer>
+#include <QScopedPointer>
+#include <QThreadPool>
+#include <QVector>
 #include <complex>
 
 /**
- * @brief The class that 1250 BPS data received from an audio sampler.
+ * @brief The class that demodulates the data received from an audio sampler with a bank of demodulators.
  *
  * Demodulates the received data and emits the demodulated packet when it is found.
  *
+ * The front-end is shared by the datarates of the bank: every block of samples is resampled from the rate of the
+ * device (48 kHz or 96 kHz) to S1DEM_AUDIO_SAMPLING_FREQ and mixed down by S1DEM_AUDIO_FREQ_CENTER_OFFSET once, as soon
+ * as it arrives. Then the demodulators of the datarates process the mixed block in parallel, each on a thread of
+ * \p pool_priv. The next block is only processed after every demodulator has finished the previous one. With
+ * S1DEM_FIXED_POINT the whole chain runs on the 16 bit samples in fixed-point.
+ *
+ * A new stream starts when a block does not continue the previous one (see AudioSampleBlock::position()), the filters
+ * and the demodulators are cleared then. If the positions are reported, the source of a packet tells which sample of
+ * the stream completed it, e.g. "File 1250 BPS, sample 1234567" for the frame 1234567 of a recording.
  */
 class AudioInDemodulator : public QObject {
     Q_OBJECT
+public:
+    static constexpr long MAXIMUM_DATARATE = 5000; //!< Faster bursts do not fit into the audio of a receiver
+
+    explicit AudioInDemodulator(const QList<long> &datarates = defaultDatarates(),
+        const QString &source_name = "Audio",
+        bool report_positions = false,
+        QObject *parent = 0);
+    ~AudioInDemodulator();
+    static QList<long> defaultDatarates();
+
 private:
-    void process_samples(std::int16_t *samples, int len);
-    std::complex<float> resample_input_buffer[S1DEM_ORIGINAL_AUDIO_SAMPLING_FREQ];
-    std::complex<float> resample_output_buffer[S1DEM_AUDIO_SAMPLING_FREQ];
+    void process_samples(const AudioSampleBlock &samples);
+    void startStream(int sampling_rate, qint64 position);
+    qint64 packetPosition(qint64 demodulated_samples) const;
+
+    bool report_positions;             //!< Reports the stream position of the packets with them
+    int input_sampling_rate;           //!< The rate of the device \p resampler is designed for
+    qint64 stream_position;            //!< The position of the first sample of the current stream
+    qint64 stream_demodulated_samples; //!< Samples the demodulators had processed when the current stream started
+    qint64 next_position;              //!< The position of the block that continues the current stream
+    QScopedPointer<RationalResampler> resampler;
+#ifdef S1DEM_FIXED_POINT
+    QVector<std::int16_t> resample_output_buffer; //!< The resampled samples of the current block
+#else
+    QVector<float> resample_input_buffer;  //!< The samples of the current block, reused between the blocks
+    QVector<float> resample_output_buffer; //!< The resampled samples of the current block
+#endif
+    QVector<S1demSample> mixed_buffer; //!< The mixed samples of the current block, shared by the bank
     long packet_length_priv;
-    long current_input_buffer_idx;
     CncoVariables cnco_vars;
-    MagicDemodulator magic_demod{S1DEM_AUDIO_SAMPLING_FREQ, 1250, "Audio 1250 BPS"};
+    QVector<MagicDemodulator *> demodulators; //!< The bank, one demodulator per datarate, children of this object
+
+    QThreadPool pool_priv; //!< Runs the demodulators of the bank in parallel, destroyed (and waited for) first
 
-public:
-    AudioInDemodulator(QObject *parent = 0);
-    ~AudioInDemodulator();
 signals:
     /**
      * @brief Signal emitted when a new packet was demodulated.
@@ -37,10 +73,11 @@ signals:
      * @param source The source of the packet (in this case, it is audio)
      * @param[in] packetUpperHexString QString that represents the data contained in the packet as an UPPERCASE Hex
      * QString
+     * @param[in] position Position of the packet in the stream [samples], -1 unless positions are reported
      */
-    void dataReady(QDateTime timestamp, QString source, QString packetUpperHexString);
+    void dataReady(QDateTime timestamp, QString source, QString packetUpperHexString, qint64 position);
 public slots:
-    void demodulateSlot(std::int16_t *samples, int len);
+    void demodulateSlot(AudioSampleBlock samples);
     void changeSettingsSlot(long new_packet_length);
     void resetDemodulatorSlot();
 };
@@ -2,15 +2,21 @@
 #include "audiosampler.h"
 
 /**
- * @brief Constructor for the class. Creates a new AudioInDemodulator with the specified \p datarate and sets up the
+ * @brief Constructor for the class. Creates a new AudioInDemodulator with the specified \p datarates and sets up the
  * necessary connections.
  * @param[in] ptm Pointer to a \p PacketDecoder instance that receives the emitted demodulated packets.
+ * @param[in] datarates The datarates of the demodulator bank.
+ * @param[in] sourceName The name of the source in the source of the packets, see AudioInDemodulator.
+ * @param[in] reportPositions Reports the position of the packets in the stream with them.
  */
-AudioInDemodulatorThread::AudioInDemodulatorThread(PacketDecoder *pd) {
-    demodulatorObject.reset(new AudioInDemodulator());
+AudioInDemodulatorThread::AudioInDemodulatorThread(
+    PacketDecoder *pd, const QList<long> &datarates, const QString &sourceName, bool reportPositions) {
+    demodulatorObject.reset(new AudioInDemodulator(datarates, sourceName, reportPositions));
     demodulatorObject->moveToThread(this); // may be unnecessary because the object itself was created on this thread
-    QObject::connect(
-        demodulatorObject.data(), &AudioInDemodulator::dataReady, pd, &PacketDecoder::decodablePacketReceived);
+    QObject::connect(demodulatorObject.data(),
+        &AudioInDemodulator::dataReady,
+        pd,
+        &PacketDecoder::decodablePacketReceivedAtPosition);
     QObject::connect(this,
         &AudioInDemodulatorThread::demodulateSignal,
         demodulatorObject.data(),
@@ -37,11 +43,10 @@ AudioInDemodulatorThread::~AudioInDemodulatorThread() {
 /**
  * @brief Slot that emits AudioInDemodulatorThread::demodulateSignal(), that is received by
  * AudioInDemodulator::demodulatorObject.
- * @param[in] samples The samples that are forwarded to the demodulator. Passes ownership of the pointer.
- * @param[in] len The number of samples that are forwarded to the demodulator.
+ * @param[in] samples The samples that are forwarded to the demodulator.
  */
-void AudioInDemodulatorThread::demodulate(int16_t *samples, int len) {
-    emit demodulateSignal(samples, len);
+void AudioInDemodulatorThread::demodulate(AudioSampleBlock samples) {
+    emit demodulateSignal(samples);
 }
 
 /**
@@ -14,22 +14,23 @@ class AudioInDemodulatorThread : public QThread {
 private:
     QScopedPointer<AudioInDemodulator> demodulatorObject; //!< AudioInDemodulator instance that demodulates the samples.
 public:
-    AudioInDemodulatorThread(PacketDecoder *pd);
+    AudioInDemodulatorThread(PacketDecoder *pd,
+        const QList<long> &datarates = AudioInDemodulator::defaultDatarates(),
+        const QString &sourceName = "Audio",
+        bool reportPositions = false);
     ~AudioInDemodulatorThread();
 
 public slots:
-    void demodulate(std::int16_t *samples, int len);
+    void demodulate(AudioSampleBlock samples);
     void changeSettings(unsigned int new_packet_length);
 
 signals:
     /**
      * @brief Signal that emits to AudioInDemodulatorThread::demodulatorObject in order to have it demodulate audio
      * samples.
-     * @param[in] samples The audio sampler data that will be processed. The samples wil have to be deleted after they
-     * have been processed.
-     * @param[in] len The number of samples that will be recived by AudioInDemodulatorThread::demodulatorObject.
+     * @param[in] samples The audio sampler data that will be processed.
      */
-    void demodulateSignal(std::int16_t *samples, int len);
+    void demodulateSignal(AudioSampleBlock samples);
 
     /**
      * @brief Signal that emits to AudioInDemodulatorThread::demodulatorObject in order to change its packetsize.
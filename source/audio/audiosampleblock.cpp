@@ -0,0 +1,161 @@
+#include "audiosampleblock.h"
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVector>
+#include <algorithm>
+#include <utility>
+
+/**
+ * @brief The samples of a block and their reference count
+ */
+struct AudioSampleBlock::Storage {
+    QAtomicInt ref;
+    int capacity;
+    int size;
+    int sampleRate;
+    qint64 position;
+    std::int16_t *samples;
+};
+
+/**
+ * @brief The released storage of the blocks, freed after main() has returned
+ */
+struct AudioSampleBlock::StoragePool {
+    QMutex mutex;
+    QVector<Storage *> storages;
+
+    ~StoragePool() {
+        for (Storage *storage : storages) {
+            delete[] storage->samples;
+            delete storage;
+        }
+    }
+};
+
+AudioSampleBlock::AudioSampleBlock() : storage_priv(nullptr) {
+}
+
+AudioSampleBlock::AudioSampleBlock(Storage *storage) : storage_priv(storage) {
+}
+
+AudioSampleBlock::AudioSampleBlock(const AudioSampleBlock &other) : storage_priv(other.storage_priv) {
+    if (storage_priv != nullptr) {
+        storage_priv->ref.ref();
+    }
+}
+
+AudioSampleBlock::AudioSampleBlock(AudioSampleBlock &&other) : storage_priv(other.storage_priv) {
+    other.storage_priv = nullptr;
+}
+
+/**
+ * @brief Releases the reference, the storage is returned to the pool by the last one
+ */
+AudioSampleBlock::~AudioSampleBlock() {
+    if (storage_priv == nullptr || storage_priv->ref.deref()) {
+        return;
+    }
+    StoragePool &pool = storagePool();
+    QMutexLocker locker(&pool.mutex);
+    if (pool.storages.size() < maximumPooledBlocks) {
+        pool.storages.append(storage_priv);
+        return;
+    }
+    locker.unlock();
+    delete[] storage_priv->samples;
+    delete storage_priv;
+}
+
+AudioSampleBlock &AudioSampleBlock::operator=(AudioSampleBlock other) {
+    std::swap(storage_priv, other.storage_priv);
+    return *this;
+}
+
+/**
+ * @brief Returns a block that holds a copy of \p count \p samples. This is the only copy of the samples.
+ * @param sampleRate The sampling rate of the device [Hz]
+ * @param position The position of the first sample in the stream of the source, 0 when the stream starts
+ */
+AudioSampleBlock AudioSampleBlock::copyOf(const std::int16_t *samples, int count, int sampleRate, qint64 position) {
+    if (count <= 0) {
+        return AudioSampleBlock();
+    }
+    Storage *storage = acquireStorage(count);
+    std::copy(samples, samples + count, storage->samples);
+    storage->size = count;
+    storage->sampleRate = sampleRate;
+    storage->position = position;
+    storage->ref.store(1);
+    return AudioSampleBlock(storage);
+}
+
+const std::int16_t *AudioSampleBlock::constData() const {
+    return storage_priv != nullptr ? storage_priv->samples : nullptr;
+}
+
+const std::int16_t *AudioSampleBlock::begin() const {
+    return constData();
+}
+
+const std::int16_t *AudioSampleBlock::end() const {
+    return constData() + size();
+}
+
+int AudioSampleBlock::size() const {
+    return storage_priv != nullptr ? storage_priv->size : 0;
+}
+
+bool AudioSampleBlock::isEmpty() const {
+    return size() == 0;
+}
+
+/**
+ * @brief Returns true if other copies of the block exist, i.e. a receiver still holds it
+ */
+bool AudioSampleBlock::isShared() const {
+    return storage_priv != nullptr && storage_priv->ref.load() > 1;
+}
+
+/**
+ * @brief Returns the sampling rate of the device that recorded the samples [Hz], 0 for an empty block
+ */
+int AudioSampleBlock::sampleRate() const {
+    return storage_priv != nullptr ? storage_priv->sampleRate : 0;
+}
+
+/**
+ * @brief Returns the position of the first sample in the stream of the source, e.g. the frame index in a file
+ */
+qint64 AudioSampleBlock::position() const {
+    return storage_priv != nullptr ? storage_priv->position : 0;
+}
+
+AudioSampleBlock::StoragePool &AudioSampleBlock::storagePool() {
+    static StoragePool pool;
+    return pool;
+}
+
+/**
+ * @brief Takes a storage of at least \p count samples from the pool, or allocates a new one
+ */
+AudioSampleBlock::Storage *AudioSampleBlock::acquireStorage(int count) {
+    StoragePool &pool = storagePool();
+    {
+        QMutexLocker locker(&pool.mutex);
+        for (int i = pool.storages.size() - 1; i >= 0; i--) {
+            Storage *storage = pool.storages.at(i);
+            if (storage->capacity >= count) {
+                pool.storages.remove(i);
+                return storage;
+            }
+        }
+    }
+    Storage *storage = new Storage;
+    storage->capacity = count > minimumCapacity ? count : minimumCapacity;
+    storage->size = 0;
+    storage->sampleRate = 0;
+    storage->position = 0;
+    storage->samples = new std::int16_t[storage->capacity];
+    return storage;
+}
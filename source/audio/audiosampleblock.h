@@ -0,0 +1,56 @@
+#ifndef AUDIOSAMPLEBLOCK_H
+#define AUDIOSAMPLEBLOCK_H
+
+#include <QMetaType>
+#include <QtGlobal>
+#include <cstdint>
+
+/**
+ * @brief A read-only block of 16 bit audio samples, shared by reference counting.
+ *
+ * AudioSampler copies every buffer of the device once into a block and passes the same block to every consumer (the
+ * demodulator, the spectogram, a recorder). Copying the block only increments the reference count, the samples are
+ * never copied again, so it can be passed through queued connections to any number of threads.
+ *
+ * The storage of the blocks is pooled: when the last reference is released, the storage is returned to the pool and
+ * the next block of at most the same size reuses it. The device delivers buffers of a similar size, so after the first
+ * few buffers no memory is allocated.
+ *
+ * A block knows the sampling rate of its source and the position of its first sample in the stream of the source, so
+ * the receivers can tell where a stream starts again and which sample of a recording they are at.
+ */
+class AudioSampleBlock {
+public:
+    static constexpr int minimumCapacity = 4096;   //!< Samples allocated at least for a block
+    static constexpr int maximumPooledBlocks = 64; //!< Released storage beyond this is freed
+
+    AudioSampleBlock();
+    AudioSampleBlock(const AudioSampleBlock &other);
+    AudioSampleBlock(AudioSampleBlock &&other);
+    ~AudioSampleBlock();
+    AudioSampleBlock &operator=(AudioSampleBlock other);
+
+    static AudioSampleBlock copyOf(const std::int16_t *samples, int count, int sampleRate, qint64 position);
+
+    const std::int16_t *constData() const;
+    const std::int16_t *begin() const;
+    const std::int16_t *end() const;
+    int size() const;
+    bool isEmpty() const;
+    bool isShared() const;
+    int sampleRate() const;
+    qint64 position() const;
+
+private:
+    struct Storage;
+    struct StoragePool;
+    explicit AudioSampleBlock(Storage *storage);
+    static StoragePool &storagePool();
+    static Storage *acquireStorage(int count);
+
+    Storage *storage_priv; //!< Shared storage, nullptr for an empty block
+};
+
+Q_DECLARE_METATYPE(AudioSampleBlock)
+
+#endif // AUDIOSAMPLEBLOCK_H
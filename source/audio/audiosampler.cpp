@@ -25,6 +25,8 @@
  */
 AudioSampler::AudioSampler(QObject *parent) : QIODevice(parent) {
     started_priv = false;
+    samplingFrequency_priv = defaultSamplingFrequency;
+    position_priv = 0;
 }
 
 /**
@@ -70,6 +72,7 @@ bool AudioSampler::start(int deviceIndex) {
     input_priv.reset(new QAudioInput(device_priv, format_priv, this));
     QObject::connect(input_priv.data(), &QAudioInput::stateChanged, this, &AudioSampler::audioInputStateChanged);
     this->open(QIODevice::WriteOnly);
+    position_priv = 0;
     input_priv->start(this);
 
     started_priv = true;
@@ -99,10 +102,25 @@ void AudioSampler::stop() {
 
 /**
  * @brief Returns the sampling frequency.
- * @return Returns 44100.
+ * @return Returns the sampling rate of the device [Hz].
  */
 quint32 AudioSampler::samplingFrequency() const {
-    return 44100;
+    return samplingFrequency_priv;
+}
+
+/**
+ * @brief Sets the sampling frequency, it is used when the device is started next time.
+ * @param samplingFrequency 48000 or 96000, the rates supported by AudioInDemodulator.
+ */
+void AudioSampler::setSamplingFrequency(quint32 samplingFrequency) {
+    if (samplingFrequency != 48000 && samplingFrequency != 96000) {
+        qWarning() << "Unsupported audio sampling frequency" << samplingFrequency;
+        return;
+    }
+    if (samplingFrequency != samplingFrequency_priv) {
+        samplingFrequency_priv = samplingFrequency;
+        emit samplingFrequencyChanged();
+    }
 }
 
 /**
@@ -122,7 +140,7 @@ qint64 AudioSampler::readData(char *data, qint64 maxlen) {
 /**
  * @brief Function that is called whenever some data was read from the device.
  *
- * It emits to the audio demodulating threads and updates \p in.
+ * It copies the samples into a block and emits it to the audio demodulating thread and the spectogram.
  * @param data Data received from the device.
  * @param len The length of \p data. There are \p len / 2 number of samples, since they are 16 bit.
  * @return
@@ -140,15 +158,9 @@ qint64 AudioSampler::writeData(const char *data, qint64 len) {
     // Since data is read as int16_t and received as char with length
     // Only half as many samples are available
 
-    // Emitting to the demodulating thread and letting them know that len/2 samples are available
-    QScopedArrayPointer<std::int16_t> dataFor1250(new std::int16_t[len / 2]);
-    std::copy(samples, samples + len / 2, dataFor1250.data());
-    emit this->audioSamplesReadyFor1250(dataFor1250.take(), len / 2);
-
-    // Emitting to the spectogram
-    QScopedArrayPointer<std::int16_t> audioSamples(new std::int16_t[len / 2]);
-    std::copy(samples, samples + len / 2, audioSamples.data());
-    emit this->audioSamples(audioSamples.take(), len / 2);
+    // The samples are copied once, every receiver shares the block
+    emit this->audioSamples(AudioSampleBlock::copyOf(samples, len / 2, format_priv.sampleRate(), position_priv));
+    position_priv += len / 2;
 
     return len;
 }
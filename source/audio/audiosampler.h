@@ -16,7 +16,7 @@
 #ifndef AUDIOSAMPLER_H
 #define AUDIOSAMPLER_H
 
-#include <QScopedArrayPointer>
+#include "audiosampleblock.h"
 #include <QScopedPointer>
 #include <QtCore/QIODevice>
 #include <QtCore/QScopedPointer>
@@ -29,23 +29,32 @@
  * @brief A class that handles audio input devices.
  *
  * It reads from a device and emits data to a demodulator and the spectogram
+ *
+ * The device is opened at 48 kHz or 96 kHz, see AudioSampler::setSamplingFrequency().
  */
 class AudioSampler : public QIODevice {
 private:
     Q_OBJECT
+    Q_PROPERTY(quint32 samplingFrequency READ samplingFrequency WRITE setSamplingFrequency NOTIFY
+            samplingFrequencyChanged)
     QAudioFormat format_priv;               //!< The variable storing the QAudioFormat used for the device
     QAudioDeviceInfo device_priv;           //!< The variable storing the QAudioDeviceInfo for the device being used
     QScopedPointer<QAudioInput> input_priv; //!< QAudioInput pointer to the currently opened port
     bool started_priv;                      //!< True if the device has been started
     QAudio::State state_priv;               //!< Current state of the device
+    quint32 samplingFrequency_priv;         //!< Sampling rate the device is opened with [Hz]
+    qint64 position_priv;                   //!< Samples received since the device was started
 
 public:
+    static constexpr quint32 defaultSamplingFrequency = 48000;
+
     explicit AudioSampler(QObject *parent = 0);
 
     Q_INVOKABLE bool start(int deviceIndex);
     bool isStarted() const;
     Q_INVOKABLE void stop();
     quint32 samplingFrequency() const;
+    void setSamplingFrequency(quint32 samplingFrequency);
     quint32 samplesToWait() const;
 
 protected:
@@ -53,17 +62,16 @@ protected:
     qint64 writeData(const char *data, qint64 len);
 
 signals:
+    void samplingFrequencyChanged();
+
     /**
-     * @brief Signal that is emitted to the thread that demodulates at 1250 bps.
+     * @brief Signal that is emitted for every buffer of the device, to the demodulating thread and the spectogram.
      *
-     * The ownership of \p samples is passed to the one (1!!!) receiving slot.
+     * Every receiver shares the same read-only \p samples, any number of slots can be connected.
      *
-     * @param samples Pointer to the array that contains the samples
-     * @param numberOfSamples Number of samples in \p samples.
+     * @param samples The samples of the buffer
      */
-    void audioSamplesReadyFor1250(std::int16_t *samples, int numberOfSamples);
-
-    void audioSamples(std::int16_t *samples, int sampleCount);
+    void audioSamples(AudioSampleBlock samples);
 
 private slots:
     void audioInputStateChanged(QAudio::State state);
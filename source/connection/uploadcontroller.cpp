@@ -65,9 +65,9 @@ void UploadController::logout() {
     emit logoutInWorker();
 }
 
-void UploadController::newPacket(QString packetQString, SatelliteChanger::Satellites satellite) {
-    Q_ASSERT(packetQString != nullptr);
-    emit newPacketForWorker(packetQString, satellite);
+void UploadController::newPacket(PacketRecord record) {
+    Q_ASSERT(!record.isNull());
+    emit newPacketForWorker(record);
 }
 
 void UploadController::errorInWorker(QString errorString) {
@@ -56,7 +56,7 @@ signals:
     void remainingChanged();
     void errorsInARowChanged();
     void uploadError(QString errorString);
-    void newPacketForWorker(QString packet, SatelliteChanger::Satellites satellite);
+    void newPacketForWorker(PacketRecord record);
     void loginInWorker(QString username, QString password);
     void uploadInWorker();
     void stopTimersInWorker();
@@ -67,7 +67,7 @@ signals:
     void logoutInWorker();
 
 public slots:
-    void newPacket(QString packetQString, SatelliteChanger::Satellites satellite);
+    void newPacket(PacketRecord record);
     void errorInWorker(QString errorString);
     void isCurrentlyUploadingChangedInWorker(bool newValue);
     void isLoggedInChangedInWorker(bool newValue);
@@ -135,8 +135,8 @@ void UploadWorker::login() {
     loginTimeoutTimer_priv.start(7000);
 }
 
-void UploadWorker::newPacket(QString packet, SatelliteChanger::Satellites satellite) {
-    pjw_priv->addPacket(packet, satellite);
+void UploadWorker::newPacket(PacketRecord record) {
+    pjw_priv->addPacket(record.dataHex(), record.satellite());
     setRemaining(pjw_priv->getPacketCount());
     auto saved = pjw_priv->writeContentsToFile(this->fileName);
     if (!saved) {
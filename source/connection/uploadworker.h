@@ -1,6 +1,7 @@
 #ifndef UPLOADWORKER_H
 #define UPLOADWORKER_H
 
+#include "../packet/packetrecord.h"
 #include "../utilities/satellitechanger.h"
 #include "packetsjsonwrapper.h"
 #include <QDir>
@@ -74,7 +75,7 @@ signals:
 
 public slots:
     void upload();
-    void newPacket(QString packet, SatelliteChanger::Satellites satellite);
+    void newPacket(PacketRecord record);
     void loginSlot(QString username, QString password);
     void stopUploadTimeoutTimer();
     void stopLoginTimeoutTimer();
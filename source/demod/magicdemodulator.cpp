@@ -18,41 +18,87 @@ MagicDemodulator::MagicDemodulator(long sampling_rate, long datarate, QString so
 }
 
 MagicDemodulator::~MagicDemodulator() {
+#ifdef S1DEM_FLOAT_CHAIN
     free(avg_vars.buf);
     free(avg_dec_vars.buf);
+#endif
+#ifdef S1DEM_FIXED_CHAIN
+    free(avg_fixed_vars.buf);
+#endif
 }
 
+#ifdef S1DEM_FLOAT_CHAIN
 void MagicDemodulator::addSample(std::complex<float> sample) {
+    sample_count++;
     auto avgd = average(&avg_vars, sample);
     std::complex<float> avg_dec_output;
     bool avg_dec_performed = average_dec(&avg_dec_vars, avgd, &avg_dec_output);
     if (avg_dec_performed) {
         auto demod_output = smog_atl_demodulate(&demod_vars, avg_dec_output);
-        if (dem_a_set) {
-            dem_b = demod_output;
-            dem_a_set = false;
-            for (int i = starting_index; i < PACKET_SIZES_COUNT; i++) {
-                packet_buffers[i].reserve(packet_lengths[i]);
-
-                auto decd = make_hard_decision(&dec_vars[i], dem_a, dem_b, packet_lengths[i]);
-                if (decd != -1) {
-                    packet_buffers[i].append(char(decd));
-                    if (packet_buffers[i].length() == packet_lengths[i]) {
-                        QDateTime timestamp = QDateTime::currentDateTimeUtc();
-                        QString packetUpperHexString = QString(
-                            QByteArray(reinterpret_cast<char *>(packet_buffers[i].data()), packet_lengths[i]).toHex())
-                                                           .toUpper();
-                        emit dataReady(timestamp, source_string, packetUpperHexString);
-                        packet_buffers[i].clear();
-                    }
+        addDecision(real(demod_output) > imag(demod_output));
+    }
+}
+
+void MagicDemodulator::addSamples(const std::complex<float> *samples, int count) {
+    for (int i = 0; i < count; i++) {
+        addSample(samples[i]);
+    }
+}
+#endif
+
+#ifdef S1DEM_FIXED_CHAIN
+void MagicDemodulator::addSample(FixedComplex sample) {
+    sample_count++;
+    auto avgd = average_fixed(&avg_fixed_vars, sample);
+    FixedComplex avg_dec_output;
+    bool avg_dec_performed = average_dec_fixed(&avg_dec_fixed_vars, avgd, &avg_dec_output);
+    if (avg_dec_performed) {
+        addDecision(smog_atl_demodulate_fixed(&demod_fixed_vars, avg_dec_output));
+    }
+}
+
+void MagicDemodulator::addSamples(const FixedComplex *samples, int count) {
+    for (int i = 0; i < count; i++) {
+        addSample(samples[i]);
+    }
+}
+#endif
+
+void MagicDemodulator::addDecision(uint8_t decision) {
+    if (decision_log != nullptr) {
+        decision_log->append(decision);
+    }
+    if (dem_a_set) {
+        dem_a_set = false;
+        for (int i = starting_index; i < PACKET_SIZES_COUNT; i++) {
+            packet_buffers[i].reserve(packet_lengths[i]);
+
+            auto decd = make_hard_decision_bits(&dec_vars[i], dem_a, decision, packet_lengths[i]);
+            if (decd != -1) {
+                packet_buffers[i].append(char(decd));
+                if (packet_buffers[i].length() == packet_lengths[i]) {
+                    QDateTime timestamp = QDateTime::currentDateTimeUtc();
+                    QByteArray packet(reinterpret_cast<char *>(packet_buffers[i].data()), packet_lengths[i]);
+                    QString packetUpperHexString = QString(packet.toHex()).toUpper();
+                    emit dataReady(timestamp, source_string, packetUpperHexString);
+                    packet_buffers[i].clear();
                 }
             }
         }
-        else {
-            dem_a = demod_output;
-            dem_a_set = true;
-        }
     }
+    else {
+        dem_a = decision;
+        dem_a_set = true;
+    }
+}
+
+qint64 MagicDemodulator::sampleCount() const {
+    return sample_count;
+}
+
+// Appends every hard decision (two per bit) to \p decisions from now on, nullptr stops it. For tools/dspcheck.
+void MagicDemodulator::setDecisionLog(QVector<uint8_t> *decisions) {
+    decision_log = decisions;
 }
 
 void MagicDemodulator::clear() {
@@ -63,9 +109,16 @@ void MagicDemodulator::reinitialize() {
     for (int i = starting_index; i < PACKET_SIZES_COUNT; i++) {
         packet_buffers[i].clear();
     }
+#ifdef S1DEM_FLOAT_CHAIN
     reinitialize_avg_vars(&avg_vars, sampling_rate / datarate);
     reinitialize_avg_dec_vars(&avg_dec_vars, sampling_rate / datarate / 2); // 2 samples / bit
     reinitialize_demod_vars(&demod_vars);
+#endif
+#ifdef S1DEM_FIXED_CHAIN
+    reinitialize_avg_fixed_vars(&avg_fixed_vars, sampling_rate / datarate);
+    reinitialize_avg_dec_fixed_vars(&avg_dec_fixed_vars, sampling_rate / datarate / 2);
+    reinitialize_demod_fixed_vars(&demod_fixed_vars);
+#endif
     for (int i = starting_index; i < PACKET_SIZES_COUNT; i++) {
         reinitialize_dec_vars(&dec_vars[i]);
     }
@@ -8,12 +8,29 @@
 #include <QtDebug>
 #include <complex>
 
+// A demodulator only has the chain of S1demSample, tools/dspcheck defines S1DEM_BOTH_CHAINS to compare them
+#if !defined(S1DEM_FIXED_POINT) || defined(S1DEM_BOTH_CHAINS)
+#define S1DEM_FLOAT_CHAIN
+#endif
+#if defined(S1DEM_FIXED_POINT) || defined(S1DEM_BOTH_CHAINS)
+#define S1DEM_FIXED_CHAIN
+#endif
+
 class MagicDemodulator : public QObject {
     Q_OBJECT
 public:
     MagicDemodulator(long sampling_rate, long datarate, QString source_string, QObject *parent = 0);
     ~MagicDemodulator();
+#ifdef S1DEM_FLOAT_CHAIN
     void addSample(std::complex<float> sample);
+    void addSamples(const std::complex<float> *samples, int count);
+#endif
+#ifdef S1DEM_FIXED_CHAIN
+    void addSample(FixedComplex sample);
+    void addSamples(const FixedComplex *samples, int count);
+#endif
+    qint64 sampleCount() const;
+    void setDecisionLog(QVector<uint8_t> *decisions);
     void clear();
 
 private:
@@ -28,14 +45,23 @@ private:
     QVector<char> packet_buffers[5] = {
         QVector<char>(), QVector<char>(), QVector<char>(), QVector<char>(), QVector<char>()};
 
+#ifdef S1DEM_FLOAT_CHAIN
     AveragingVariables avg_vars;
     AveragingDecVariables avg_dec_vars;
     DemodulationVariables demod_vars;
+#endif
+#ifdef S1DEM_FIXED_CHAIN
+    AveragingFixedVariables avg_fixed_vars;
+    AveragingDecFixedVariables avg_dec_fixed_vars;
+    DemodulationFixedVariables demod_fixed_vars;
+#endif
     DecisionVariables dec_vars[5];
 
-    std::complex<float> dem_a;
-    std::complex<float> dem_b;
+    uint8_t dem_a = 0;
     bool dem_a_set = false;
+    qint64 sample_count = 0; // Samples added since the construction, not reset by clear()
+    QVector<uint8_t> *decision_log = nullptr; // Receives a copy of the hard decisions, see setDecisionLog()
+    void addDecision(uint8_t decision);
     void reinitialize();
 
 signals:
@@ -6,17 +6,13 @@ std::complex<float> s16le2cf(int16_t input) {
     return std::complex<float>((float) input / (1 << 15), 0);
 }
 
-/*
-// Rational resampling for audio input
-// Input must have a length of S1DEM_ORIGINAL_AUDIO_SAMPLING_FREQ
-// Output must have a length of S1DEM_AUDIO_SAMPLING_FREQ
- */
-void rational_resample(std::complex<float> input[], std::complex<float> output[]) {
-    long f1 = S1DEM_ORIGINAL_AUDIO_SAMPLING_FREQ;
-    long f2 = S1DEM_AUDIO_SAMPLING_FREQ;
-    for (long i = 0; i < f1; i++) {
-        output[(long) round((float) i * f2 / f1)] = input[i];
-    }
+FixedComplex s16le2fixed(int16_t input) {
+    return FixedComplex{input, 0};
+}
+
+// Removes the DC of an RTL-SDR sample, the components are 128 times the DC-free floating-point ones (at most 16320)
+FixedComplex u8iq2fixed(uint8_t i, uint8_t q) {
+    return FixedComplex{(2 * i - 255) * 64, (2 * q - 255) * 64};
 }
 
 std::complex<float> cnco(CncoVariables *cnco_vars, std::complex<float> input) {
@@ -26,6 +22,16 @@ std::complex<float> cnco(CncoVariables *cnco_vars, std::complex<float> input) {
     return out;
 }
 
+// The magnitude of the input has to stay below 2^15, so that the Q15 products fit into 32 bits
+FixedComplex cnco_fixed(CncoVariables *cnco_vars, FixedComplex input) {
+    const int16_t *lo = cnco_vars->lo_q15 + 2 * cnco_vars->loi;
+    FixedComplex out;
+    out.re = (input.re * lo[0] - input.im * lo[1] + (1 << 14)) >> 15;
+    out.im = (input.re * lo[1] + input.im * lo[0] + (1 << 14)) >> 15;
+    cnco_vars->loi = (cnco_vars->loi + cnco_vars->f) % cnco_vars->fs;
+    return out;
+}
+
 std::complex<float> average(AveragingVariables *avg_vars, std::complex<float> input) {
     avg_vars->out -= avg_vars->buf[avg_vars->index];
     avg_vars->buf[avg_vars->index] = input;
@@ -50,6 +56,83 @@ bool average_dec(AveragingDecVariables *avg_dec_vars, std::complex<float> input,
     return performed;
 }
 
+// The comb of a CIC stage: the running sum is exact, it does not drift like the floating-point one
+FixedComplex average_fixed(AveragingFixedVariables *avg_vars, FixedComplex input) {
+    avg_vars->out.re += input.re - avg_vars->buf[avg_vars->index].re;
+    avg_vars->out.im += input.im - avg_vars->buf[avg_vars->index].im;
+    avg_vars->buf[avg_vars->index] = input;
+    avg_vars->index = ((avg_vars->index) + 1) % avg_vars->n;
+    return avg_vars->out;
+}
+
+// The integrate-and-dump of a CIC stage, it outputs the same sums as average_dec() without buffering the inputs
+bool average_dec_fixed(AveragingDecFixedVariables *avg_dec_vars, FixedComplex input, FixedComplex *output) {
+    bool performed = false;
+    if (avg_dec_vars->index == avg_dec_vars->n) {
+        avg_dec_vars->index = 0;
+        *output = avg_dec_vars->sum;
+        avg_dec_vars->sum = FixedComplex{0, 0};
+        performed = true;
+    }
+    avg_dec_vars->sum.re += input.re;
+    avg_dec_vars->sum.im += input.im;
+    avg_dec_vars->index++;
+    return performed;
+}
+
+// The front-end of SDRWorker: mixes an 8 bit SDR sample down and decimates it by 5
+bool decimate_5(CncoVariables *cnco_vars,
+    AveragingVariables *avg_vars,
+    AveragingDecVariables *avg_dec_vars,
+    uint8_t i,
+    uint8_t q,
+    std::complex<float> *output) {
+    std::complex<float> input(static_cast<float>(i - 127.5), static_cast<float>(q - 127.5)); // Removing DC
+    auto cncod = cnco(cnco_vars, input);
+    auto avgd_5 = average(avg_vars, cncod);
+    return average_dec(avg_dec_vars, avgd_5, output);
+}
+
+// Decimates a sample of decimate_5() by 20 for the spectogram
+bool decimate_20(AveragingVariables *avg_vars,
+    AveragingDecVariables *avg_dec_vars,
+    std::complex<float> input,
+    std::complex<float> *output) {
+    auto avgd_20 = average(avg_vars, input);
+    return average_dec(avg_dec_vars, avgd_20, output);
+}
+
+// The fixed-point decimate_5(), the output is in Q15, twice the floating-point one
+bool decimate_5(CncoVariables *cnco_vars,
+    AveragingFixedVariables *avg_vars,
+    AveragingDecFixedVariables *avg_dec_vars,
+    uint8_t i,
+    uint8_t q,
+    FixedComplex *output) {
+    auto cncod = cnco_fixed(cnco_vars, u8iq2fixed(i, q)); // Removing DC
+    auto avgd_5 = average_fixed(avg_vars, cncod);
+    if (!average_dec_fixed(avg_dec_vars, avgd_5, output)) {
+        return false;
+    }
+    output->re >>= S1DEM_SDR_FIXED_SHIFT;
+    output->im >>= S1DEM_SDR_FIXED_SHIFT;
+    return true;
+}
+
+// The fixed-point decimate_20(), the output is at the scale of the floating-point one
+bool decimate_20(AveragingFixedVariables *avg_vars,
+    AveragingDecFixedVariables *avg_dec_vars,
+    FixedComplex input,
+    std::complex<float> *output) {
+    auto avgd_20 = average_fixed(avg_vars, input);
+    FixedComplex avg_dec_output_20;
+    if (!average_dec_fixed(avg_dec_vars, avgd_20, &avg_dec_output_20)) {
+        return false;
+    }
+    *output = std::complex<float>(avg_dec_output_20.re, avg_dec_output_20.im) * 0.5f;
+    return true;
+}
+
 std::complex<float> smog_atl_demodulate(DemodulationVariables *demod_vars, std::complex<float> input) {
     float t = imag(input * conj(demod_vars->m));
     demod_vars->m = input;
@@ -57,6 +140,15 @@ std::complex<float> smog_atl_demodulate(DemodulationVariables *demod_vars, std::
     return std::complex<float>(t, demod_vars->x);
 }
 
+// The discriminator of smog_atl_demodulate() in 64 bit integers, returns the decision of make_hard_decision() for it
+uint8_t smog_atl_demodulate_fixed(DemodulationFixedVariables *demod_vars, FixedComplex input) {
+    const int64_t t =
+        static_cast<int64_t>(input.im) * demod_vars->m.re - static_cast<int64_t>(input.re) * demod_vars->m.im;
+    demod_vars->m = input;
+    demod_vars->x += (t - demod_vars->x) / S1DEM_LL;
+    return t > demod_vars->x;
+}
+
 /* Hard-decision by ha7wen
 // Input: 2 complex number / databit
 // (da) 1st shifted into a, (db) 2nd into b uint16
@@ -69,6 +161,11 @@ int make_hard_decision(DecisionVariables *dec_vars,
     unsigned long packet_length) {
     uint8_t da = (real(input_a) > imag(input_a));
     uint8_t db = (real(input_b) > imag(input_b));
+    return make_hard_decision_bits(dec_vars, da, db, packet_length);
+}
+
+// make_hard_decision() for decisions that have already been made, e.g. by smog_atl_demodulate_fixed()
+int make_hard_decision_bits(DecisionVariables *dec_vars, uint8_t da, uint8_t db, unsigned long packet_length) {
     int out = -1;
     long n = packet_length * 8;
     if (dec_vars->sm == 1) {
@@ -152,6 +249,42 @@ void reinitialize_dec_vars(DecisionVariables *dec_vars) {
     dec_vars->d = 0;
 }
 
+void reinitialize_avg_fixed_vars(AveragingFixedVariables *avg_vars, int n) {
+    avg_vars->n = n;
+    if (avg_vars->buf) {
+        free(avg_vars->buf);
+    }
+    avg_vars->buf = (FixedComplex *) malloc(sizeof(FixedComplex) * avg_vars->n);
+    if (avg_vars->buf == nullptr) {
+        printf("COULD NOT ALLOCATE MEMORY FOR AVG");
+        exit(1);
+    }
+    for (int i = 0; i < avg_vars->n; i++) {
+        avg_vars->buf[i] = FixedComplex{0, 0};
+    }
+    avg_vars->index = 0;
+    avg_vars->out = FixedComplex{0, 0};
+}
+
+void reinitialize_avg_dec_fixed_vars(AveragingDecFixedVariables *avg_dec_vars, int n) {
+    avg_dec_vars->n = n;
+    avg_dec_vars->sum = FixedComplex{0, 0};
+    avg_dec_vars->index = 0;
+}
+
+void reinitialize_demod_fixed_vars(DemodulationFixedVariables *demod_vars) {
+    demod_vars->m = FixedComplex{0, 0};
+    demod_vars->x = 0;
+}
+
+// Rounds lo into lo_q15 for cnco_fixed()
+static void update_cnco_q15(CncoVariables *cnco_vars) {
+    for (int i = 0; i < cnco_vars->fs; i++) {
+        cnco_vars->lo_q15[2 * i] = (int16_t) lroundf(cnco_vars->lo[i].real() * 32767);
+        cnco_vars->lo_q15[2 * i + 1] = (int16_t) lroundf(cnco_vars->lo[i].imag() * 32767);
+    }
+}
+
 void change_cnco_sampling_rate(CncoVariables *cnco_vars, long sampling_rate) {
     cnco_vars->fs = sampling_rate;
     cnco_vars->f = 0;
@@ -159,7 +292,11 @@ void change_cnco_sampling_rate(CncoVariables *cnco_vars, long sampling_rate) {
         free(cnco_vars->lo);
     }
     cnco_vars->lo = (std::complex<float> *) malloc(sizeof(std::complex<float>) * cnco_vars->fs);
-    if (cnco_vars->lo == nullptr) {
+    if (cnco_vars->lo_q15) {
+        free(cnco_vars->lo_q15);
+    }
+    cnco_vars->lo_q15 = (int16_t *) malloc(sizeof(int16_t) * 2 * cnco_vars->fs);
+    if (cnco_vars->lo == nullptr || cnco_vars->lo_q15 == nullptr) {
         printf("COULD NOT ALLOCATE MEMORY FOR CNCO");
         exit(1);
     }
@@ -175,6 +312,7 @@ void change_cnco_sampling_rate(CncoVariables *cnco_vars, long sampling_rate) {
     if (cnco_vars->f < 0) {
         cnco_vars->f *= -1;
     }
+    update_cnco_q15(cnco_vars);
     cnco_vars->loi = 0;
 }
 
@@ -192,4 +330,5 @@ void change_cnco_offset_frequency(CncoVariables *cnco_vars, long offset_frequenc
     if (cnco_vars->f < 0) {
         cnco_vars->f *= -1;
     }
+    update_cnco_q15(cnco_vars);
 }
@@ -3,21 +3,38 @@
 
 #include <complex>
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 
-#define S1DEM_ORIGINAL_AUDIO_SAMPLING_FREQ 44100
 #define S1DEM_AUDIO_BPS 1250
-#define S1DEM_AUDIO_SAMPLING_FREQ 42500
+#define S1DEM_AUDIO_SAMPLING_FREQ 50000
 #define S1DEM_SYNC 0x2dd4
 #define S1DEM_AUDIO_FREQ_CENTER_OFFSET 1500
 #define S1DEM_LL 64
+#define S1DEM_SDR_FIXED_SHIFT 6 // Brings the 5x decimation of the SDR (gain of 50) back to Q15 in the fixed-point chain
+
+// Complex sample of the fixed-point chain. The mixer takes and returns Q15 components, the averaging stages sum them
+// without scaling like an integer CIC filter, so the components grow by the gain of the stages. A demodulator of
+// MagicDemodulator has a gain of at most 800, its Q15 input can not overflow 32 bits.
+struct FixedComplex {
+    int32_t re;
+    int32_t im;
+};
+
+// The chain of the demodulators in the application, qmake CONFIG+=fixed_point_dsp selects the fixed-point one
+#ifdef S1DEM_FIXED_POINT
+typedef FixedComplex S1demSample;
+#else
+typedef std::complex<float> S1demSample;
+#endif
 
 struct CncoStruct {
     long fs;
     long f;
     std::complex<float> *lo = nullptr;
+    int16_t *lo_q15 = nullptr; // lo in Q15, real and imaginary parts interleaved
     long loi;
 };
 
@@ -39,6 +56,24 @@ struct DemodulationStruct {
     float x;
 };
 
+struct AveragingFixedStruct {
+    int n;
+    FixedComplex *buf = nullptr;
+    FixedComplex out;
+    int index;
+};
+
+struct AveragingDecFixedStruct {
+    int n;
+    FixedComplex sum;
+    int index;
+};
+
+struct DemodulationFixedStruct {
+    FixedComplex m;
+    int64_t x;
+};
+
 struct DecisionStruct {
     uint16_t a;
     uint16_t b;
@@ -53,6 +88,9 @@ typedef struct AveragingStruct AveragingVariables;
 typedef struct AveragingDecStruct AveragingDecVariables;
 typedef struct DemodulationStruct DemodulationVariables;
 typedef struct DecisionStruct DecisionVariables;
+typedef struct AveragingFixedStruct AveragingFixedVariables;
+typedef struct AveragingDecFixedStruct AveragingDecFixedVariables;
+typedef struct DemodulationFixedStruct DemodulationFixedVariables;
 
 void change_cnco_sampling_rate(CncoVariables *cnco_vars, long sampling_rate);
 void change_cnco_offset_frequency(CncoVariables *cnco_vars, long offset_frequency);
@@ -60,14 +98,47 @@ void reinitialize_avg_vars(AveragingVariables *avg_vars, int n);
 void reinitialize_avg_dec_vars(AveragingDecVariables *avg_dec_vars, int n);
 void reinitialize_demod_vars(DemodulationVariables *demod_vars);
 void reinitialize_dec_vars(DecisionVariables *dec_vars);
+void reinitialize_avg_fixed_vars(AveragingFixedVariables *avg_vars, int n);
+void reinitialize_avg_dec_fixed_vars(AveragingDecFixedVariables *avg_dec_vars, int n);
+void reinitialize_demod_fixed_vars(DemodulationFixedVariables *demod_vars);
 
 std::complex<float> s16le2cf(int16_t input);
-void rational_resample(std::complex<float> input[], std::complex<float> output[]);
 std::complex<float> cnco(CncoVariables *cnco_vars, std::complex<float> input);
 std::complex<float> average(AveragingVariables *avg_vars, std::complex<float> input);
 bool average_dec(AveragingDecVariables *avg_dec_vars, std::complex<float> input, std::complex<float> *output);
 std::complex<float> smog_atl_demodulate(DemodulationVariables *demod_vars, std::complex<float> input);
 int make_hard_decision(
     DecisionVariables *dec_vars, std::complex<float> input_a, std::complex<float> input_b, unsigned long packet_length);
+int make_hard_decision_bits(DecisionVariables *dec_vars, uint8_t da, uint8_t db, unsigned long packet_length);
+
+FixedComplex s16le2fixed(int16_t input);
+FixedComplex u8iq2fixed(uint8_t i, uint8_t q);
+FixedComplex cnco_fixed(CncoVariables *cnco_vars, FixedComplex input);
+FixedComplex average_fixed(AveragingFixedVariables *avg_vars, FixedComplex input);
+bool average_dec_fixed(AveragingDecFixedVariables *avg_dec_vars, FixedComplex input, FixedComplex *output);
+uint8_t smog_atl_demodulate_fixed(DemodulationFixedVariables *demod_vars, FixedComplex input);
+
+// The front-end of SDRWorker (250 kHz to the 50 kHz of the demodulators, and 2.5 kHz for the spectogram). The chains
+// are overloads, so the type of the state selects the one of S1demSample.
+bool decimate_5(CncoVariables *cnco_vars,
+    AveragingVariables *avg_vars,
+    AveragingDecVariables *avg_dec_vars,
+    uint8_t i,
+    uint8_t q,
+    std::complex<float> *output);
+bool decimate_20(AveragingVariables *avg_vars,
+    AveragingDecVariables *avg_dec_vars,
+    std::complex<float> input,
+    std::complex<float> *output);
+bool decimate_5(CncoVariables *cnco_vars,
+    AveragingFixedVariables *avg_vars,
+    AveragingDecFixedVariables *avg_dec_vars,
+    uint8_t i,
+    uint8_t q,
+    FixedComplex *output);
+bool decimate_20(AveragingFixedVariables *avg_vars,
+    AveragingDecFixedVariables *avg_dec_vars,
+    FixedComplex input,
+    std::complex<float> *output);
 
 #endif
@@ -0,0 +1,118 @@
+#include "rationalresampler.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+/**
+ * @brief Designs the filter for the resampling.
+ *
+ * The prototype filter runs at L * \p input_rate, it has L * \p taps_per_phase taps and a Blackman window. Its cutoff
+ * is at 40% of the lower rate, so with the default number of taps the transition band ends below the Nyquist frequency
+ * of the output and nothing is aliased back into it.
+ */
+RationalResampler::RationalResampler(long input_rate, long output_rate, int taps_per_phase)
+: taps_per_phase(taps_per_phase) {
+    long divisor = input_rate;
+    for (long rest = output_rate; rest != 0;) {
+        const long next = divisor % rest;
+        divisor = rest;
+        rest = next;
+    }
+    interpolation = output_rate / divisor;
+    decimation = input_rate / divisor;
+
+    const long length = interpolation * taps_per_phase;
+    const double cutoff = 0.4 * std::min(input_rate, output_rate) / (static_cast<double>(input_rate) * interpolation);
+    coefficients.resize(length);
+    for (long n = 0; n < length; n++) {
+        const double t = n - (length - 1) / 2.0;
+        const double sinc = t == 0 ? 2 * cutoff : std::sin(2 * M_PI * cutoff * t) / (M_PI * t);
+        const double window = 0.42 - 0.5 * std::cos(2 * M_PI * n / (length - 1)) +
+                              0.08 * std::cos(4 * M_PI * n / (length - 1));
+        // Tap k of phase p is the prototype tap p + k * L, the gain of L makes up for the upsampling
+        coefficients[(n % interpolation) * taps_per_phase + n / interpolation] =
+            static_cast<float>(interpolation * sinc * window);
+    }
+    // The taps are below 0.8, and the absolute sum of a phase is below 2, so its dot product fits into 32 bits
+    fixed_coefficients.resize(length);
+    std::transform(coefficients.begin(), coefficients.end(), fixed_coefficients.begin(), [](float coefficient) {
+        return static_cast<std::int16_t>(std::lround(coefficient * 32767));
+    });
+    clear();
+}
+
+/**
+ * @brief Returns the most outputs RationalResampler::process() returns for \p input_count inputs
+ */
+int RationalResampler::maximumOutputCount(int input_count) const {
+    return static_cast<int>((input_count * interpolation) / decimation + 1);
+}
+
+/**
+ * @brief Returns the group delay of the filter in input samples
+ */
+int RationalResampler::delay() const {
+    return taps_per_phase / 2;
+}
+
+/**
+ * @brief Resamples \p input_count samples of \p input into \p output.
+ * @param[out] output At least RationalResampler::maximumOutputCount() samples
+ * @return The number of samples written into \p output
+ */
+int RationalResampler::process(const float *input, int input_count, float *output) {
+    int output_count = 0;
+    float *delay_line = history.data();
+    for (int i = 0; i < input_count; i++) {
+        history_index = history_index == 0 ? taps_per_phase - 1 : history_index - 1;
+        delay_line[history_index] = input[i];
+        delay_line[history_index + taps_per_phase] = input[i];
+        const float *taps = delay_line + history_index;
+        while (phase < interpolation) {
+            const float *phase_coefficients = coefficients.constData() + phase * taps_per_phase;
+            output[output_count] = std::inner_product(taps, taps + taps_per_phase, phase_coefficients, 0.0f);
+            output_count++;
+            phase += decimation;
+        }
+        phase -= interpolation;
+    }
+    return output_count;
+}
+
+/**
+ * @brief Resamples \p input_count 16 bit samples of \p input into \p output, in fixed-point.
+ * @param[out] output At least RationalResampler::maximumOutputCount() samples
+ * @return The number of samples written into \p output
+ */
+int RationalResampler::process(const std::int16_t *input, int input_count, std::int16_t *output) {
+    int output_count = 0;
+    std::int16_t *delay_line = fixed_history.data();
+    for (int i = 0; i < input_count; i++) {
+        history_index = history_index == 0 ? taps_per_phase - 1 : history_index - 1;
+        delay_line[history_index] = input[i];
+        delay_line[history_index + taps_per_phase] = input[i];
+        const std::int16_t *taps = delay_line + history_index;
+        while (phase < interpolation) {
+            const std::int16_t *phase_coefficients = fixed_coefficients.constData() + phase * taps_per_phase;
+            std::int32_t sum = 1 << 14;
+            for (int k = 0; k < taps_per_phase; k++) {
+                sum += taps[k] * phase_coefficients[k];
+            }
+            output[output_count] = static_cast<std::int16_t>(qBound(-32768, sum >> 15, 32767));
+            output_count++;
+            phase += decimation;
+        }
+        phase -= interpolation;
+    }
+    return output_count;
+}
+
+/**
+ * @brief Clears the delay lines
+ */
+void RationalResampler::clear() {
+    history.fill(0.0f, 2 * taps_per_phase);
+    fixed_history.fill(0, 2 * taps_per_phase);
+    history_index = 0;
+    phase = 0;
+}
@@ -0,0 +1,42 @@
+#ifndef RATIONALRESAMPLER_H
+#define RATIONALRESAMPLER_H
+
+#include <QVector>
+#include <cstdint>
+
+/**
+ * @brief Streaming polyphase resampler from \p input_rate to \p output_rate, for any ratio of integer rates.
+ *
+ * The ratio is reduced to L / M. The input is upsampled by L, filtered with a windowed sinc low-pass and decimated by
+ * M, but only the outputs are computed: every output is the dot product of one of the L phases of the filter with the
+ * last taps_per_phase inputs. Blocks of any size can be processed, the delay line is kept between them, so the latency
+ * is only the group delay of the filter (taps_per_phase / 2 input samples).
+ *
+ * The 16 bit overload of process() filters with the coefficients rounded to Q15 and 32 bit accumulators, for the
+ * fixed-point chain. A stream has to be processed by one of the overloads only, they share the phase.
+ */
+class RationalResampler {
+public:
+    static constexpr int DEFAULT_TAPS_PER_PHASE = 32;
+
+    RationalResampler(long input_rate, long output_rate, int taps_per_phase = DEFAULT_TAPS_PER_PHASE);
+    int maximumOutputCount(int input_count) const;
+    int delay() const;
+    int process(const float *input, int input_count, float *output);
+    int process(const std::int16_t *input, int input_count, std::int16_t *output);
+    void clear();
+
+private:
+    long interpolation; //!< L
+    long decimation;    //!< M
+    int taps_per_phase;
+    QVector<float> coefficients; //!< The coefficients of phase p are at p * taps_per_phase, newest input first
+    QVector<float> history;      //!< The delay line, stored twice so that the taps are always contiguous
+    int history_index;           //!< Position of the newest input in \p history
+    long phase;                  //!< Phase of the next output, it is computed when it is below \p interpolation
+
+    QVector<std::int16_t> fixed_coefficients; //!< \p coefficients in Q15
+    QVector<std::int16_t> fixed_history;      //!< The delay line of the 16 bit overload, like \p history
+};
+
+#endif // RATIONALRESAMPLER_H
@@ -1,12 +1,17 @@
 
 #include "dependencies/obc-packet-helpers/packethelper.h"
+#include "source/audio/audiofilesource.h"
 #include "source/audio/audioindemodulatorthread.h"
 #include "source/audio/audiosampler.h"
 #include "source/command/gndconnection.h"
 #include "source/connection/uploadcontroller.h"
 #include "source/packet/packetdecoder.h"
+#include "source/packet/packetfiltermodel.h"
+#include "source/packet/packethistorymodel.h"
+#include "source/packet/packetrecord.h"
 #include "source/packet/packettablemodel.h"
 #include "source/packet/spectrumreceiver.h"
+#include "source/packet/telemetrystore.h"
 #include "source/predict/predictercontroller.h"
 #include "source/radios/ft817radio.h"
 #include "source/radios/ft847radio.h"
@@ -21,6 +26,7 @@
 #include "source/utilities/common.h"
 #include "source/utilities/devicediscovery.h"
 #include "source/utilities/eventfilter.h"
+#include "source/utilities/fftplanner.h"
 #include "source/utilities/logger.h"
 #include "source/utilities/messageproxy.h"
 #include "source/utilities/satellitechanger.h"
@@ -33,6 +39,7 @@
 #include <QQmlContext>
 #include <QQmlDebuggingEnabler>
 #include <QScopedPointer>
+#include <QStandardPaths>
 #include <QtQml>
 #include <source/command/commandtracker.h>
 
@@ -76,6 +83,7 @@ void myMessageHandler(QtMsgType type, const QMessageLogContext &context, const Q
     case QtFatalMsg:
         fprintf(stderr, "Fatal: %s (%s:%u, %s)\n", localMsg.constData(), context.file, context.line, context.function);
         logger.writeToLog("Fatal: " + QString(localMsg.constData()));
+        logger.flush();
         abort();
     }
 }
@@ -106,6 +114,8 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
     createOrClearDir(tleDirString, currentDir);
     QString downloadsDirString("downloads");
     createOrClearDir(downloadsDirString, currentDir);
+    QString telemetryDirString("telemetry");
+    createOrClearDir(telemetryDirString, currentDir);
 
     QApplication app(argc, argv);
     logger.setLogFolder(logDirString);
@@ -130,6 +140,12 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
     QApplication::setOrganizationName("SMOG-1 Team");
     QApplication::setApplicationName("SMOGGNDAPP");
 
+    // The FFTW plans are measured at the first launch only
+    QString fftwDirString = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
+    if (QDir().mkpath(fftwDirString)) {
+        FftPlanner::loadWisdom(fftwDirString + "/");
+    }
+
     SettingsHolder settingsHolder;
     SettingsProxy settingsProxy(&settingsHolder);
 
@@ -141,7 +157,11 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
     qRegisterMetaType<uint32_t>("uint32_t"); // has to be declared so that it can be used in queued connections
     qRegisterMetaType<QList<unsigned int>>("QList<uint>");
     qRegisterMetaType<SatelliteChanger::Satellites>("Satellites");
-    qRegisterMetaType<std::complex<float>>("std::complex<float>");
+    qRegisterMetaType<QVector<std::complex<float>>>("QVector<std::complex<float>>");
+    qRegisterMetaType<QVector<float>>("QVector<float>");
+    qRegisterMetaType<WidebandSpectrum *>("WidebandSpectrum*");
+    qRegisterMetaType<AudioSampleBlock>("AudioSampleBlock");
+    qRegisterMetaType<PacketRecord>("PacketRecord");
     qmlRegisterType<Spectogram>("hu.tt", 1, 0, "Spectogram");
     s1obc::registerObcPacketTypesQt();
 
@@ -163,15 +183,22 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
 
     QScopedPointer<PacketTableModel> ptm(new PacketTableModel(QApplication::clipboard(), &app));
     engine.rootContext()->setContextProperty("packetTableModel", ptm.data());
+    // Created before the decoder starts archiving, so that it can tell the segments of this session apart
+    PacketHistoryModel packetHistoryModel(logDirString, QApplication::clipboard());
+    PacketFilterModel packetFilterModel(&packetHistoryModel);
+    engine.rootContext()->setContextProperty("packetFilterModel", &packetFilterModel);
 
     QScopedPointer<QThread, QScopedPointerThreadDeleter> decoderThread(new QThread);
 
     SpectrumReceiver spectrumReceiver(downloadsDirString);
 
-    PacketDecoder packetDecoder(logDirString, "packets.txt", downloadsDirString, &spectrumReceiver);
+    PacketDecoder packetDecoder(logDirString, downloadsDirString, &spectrumReceiver);
     packetDecoder.moveToThread(decoderThread.data());
     decoderThread->start();
     QObject::connect(&packetDecoder, &PacketDecoder::newPacket, ptm.data(), &PacketTableModel::newPacket);
+    TelemetryStore telemetryStore(telemetryDirString);
+    QObject::connect(&packetDecoder, &PacketDecoder::newPacket, &telemetryStore, &TelemetryStore::newPacket);
+    engine.rootContext()->setContextProperty("telemetryStore", &telemetryStore);
     QObject::connect(&satelliteChanger, &SatelliteChanger::newFilePrefix, &packetDecoder, &PacketDecoder::changePrefix);
     QObject::connect(
         &satelliteChanger, &SatelliteChanger::newSatellite, &packetDecoder, &PacketDecoder::changeSatellite);
@@ -212,7 +239,8 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
 
     UploadController uploadController(
         QUrl("https://gnd.bme.hu:8080/api/"), uploadDirString, "upload_queue.txt", "rejected_packets.txt");
-    QObject::connect(&packetDecoder, &PacketDecoder::newPacketMinimal, &uploadController, &UploadController::newPacket);
+    QObject::connect(
+        &packetDecoder, &PacketDecoder::newPacketForUpload, &uploadController, &UploadController::newPacket);
     engine.rootContext()->setContextProperty("uploader", &uploadController);
 
     engine.rootContext()->setContextProperty("deviceDiscovery", &deviceDiscovery);
@@ -270,18 +298,40 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
 
     AudioSampler audioSampler;
     engine.rootContext()->setContextProperty("audioSampler", &audioSampler);
-    QScopedPointer<AudioInDemodulatorThread> adem1250Thread(new AudioInDemodulatorThread(&packetDecoder));
+    QScopedPointer<AudioInDemodulatorThread> audioDemodulatorThread(new AudioInDemodulatorThread(&packetDecoder));
     QObject::connect(&audioSampler,
-        &AudioSampler::audioSamplesReadyFor1250,
-        adem1250Thread.data(),
+        &AudioSampler::audioSamples,
+        audioDemodulatorThread.data(),
+        &AudioInDemodulatorThread::demodulate);
+    audioDemodulatorThread->start();
+
+    // Recordings are demodulated separately from the audio device, their packets carry their position in the recording
+    AudioFileSource audioFileSource;
+    engine.rootContext()->setContextProperty("audioFileSource", &audioFileSource);
+    QScopedPointer<AudioInDemodulatorThread> fileDemodulatorThread(
+        new AudioInDemodulatorThread(&packetDecoder, AudioInDemodulator::defaultDatarates(), "File", true));
+    QObject::connect(&audioFileSource,
+        &AudioFileSource::audioSamples,
+        fileDemodulatorThread.data(),
         &AudioInDemodulatorThread::demodulate);
-    adem1250Thread->start();
+    fileDemodulatorThread->start();
 
     Spectogram *spectogramptr =
         engine.rootObjects().at(0)->findChild<Spectogram *>("spectogramObject", Qt::FindChildrenRecursively);
     QObject::connect(&audioSampler, &AudioSampler::audioSamples, spectogramptr, &Spectogram::realSamplesReceived);
     QObject::connect(
-        sdrThread.data(), &SDRThread::complexSampleReady, spectogramptr, &Spectogram::complexSampleReceived);
+        sdrThread.data(), &SDRThread::complexSamplesReady, spectogramptr, &Spectogram::complexSamplesReceived);
+    QObject::connect(sdrThread->wideband(),
+        &WidebandSpectrum::spectrumReady,
+        spectogramptr,
+        &Spectogram::widebandSpectrumReceived);
+    // The wideband spectrum is only computed while it is plotted
+    WidebandSpectrum *widebandSpectrum = sdrThread->wideband();
+    const auto updateWideband = [spectogramptr, widebandSpectrum]() {
+        widebandSpectrum->setEnabled(spectogramptr->isRunning() && spectogramptr->inWidebandMode());
+    };
+    QObject::connect(spectogramptr, &Spectogram::isRunningChanged, updateWideband);
+    QObject::connect(spectogramptr, &Spectogram::modeChanged, updateWideband);
 
 #if defined(Q_OS_LINUX)
     // Initializing notifier on linux
@@ -292,5 +342,7 @@ Q_DECL_EXPORT int main(int argc, char *argv[]) {
     QTimer::singleShot(0, &deviceDiscovery, &DeviceDiscovery::startTimer);
 #endif
 
-    return app.exec();
+    const int exitCode = app.exec();
+    FftPlanner::saveWisdom();
+    return exitCode;
 }
@@ -0,0 +1,201 @@
+#include "archiveredecoder.h"
+#include "fecdecoder.h"
+#include <QAtomicInt>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+
+namespace {
+/**
+ * @brief Decodes frames of a batch on a worker thread until every frame has been taken by one of the workers
+ */
+template <typename Item> class BatchWorker : public QRunnable {
+public:
+    BatchWorker(QVector<Item> &batch, QAtomicInt &next) : batch_priv(batch), next_priv(next) {
+    }
+
+    void run() override {
+        for (int i = next_priv.fetchAndAddRelaxed(1); i < batch_priv.size(); i = next_priv.fetchAndAddRelaxed(1)) {
+            Item &item = batch_priv[i];
+            if (!item.fec) {
+                continue;
+            }
+            DecodedPacket result = FecDecoder::decode(item.frame.encoded);
+            item.success = result.getResult() == DecodedPacket::Success;
+            item.decoded = item.success ? result.getDecodedPacket() : QByteArray();
+        }
+    }
+
+private:
+    QVector<Item> &batch_priv;
+    QAtomicInt &next_priv;
+};
+} // namespace
+
+/**
+ * @brief Constructor for the class
+ * @param sourceDirString Directory of the archive that is decoded again
+ * @param targetDirString Directory of the new archive generation, created if it does not exist
+ */
+ArchiveRedecoder::ArchiveRedecoder(const QString &sourceDirString, const QString &targetDirString)
+    : sourceDirString_priv(sourceDirString), targetDirString_priv(targetDirString),
+      threadCount_priv(QThread::idealThreadCount()) {
+    if (!targetDirString_priv.isEmpty() && !targetDirString_priv.endsWith('/')) {
+        targetDirString_priv.append('/');
+    }
+    batch_priv.reserve(batchSize);
+}
+
+/**
+ * @brief Restricts the run to the frames that match \p query. Frames that do not match are not copied.
+ */
+void ArchiveRedecoder::setQuery(const PacketArchiveQuery &query) {
+    query_priv = query;
+}
+
+/**
+ * @brief Sets the number of decoder threads, every core is used by default
+ */
+void ArchiveRedecoder::setThreadCount(int threadCount) {
+    threadCount_priv = std::max(1, threadCount);
+}
+
+/**
+ * @brief Sets the function that is called with the counters after every batch
+ */
+void ArchiveRedecoder::setProgressCallback(const ProgressCallback &callback) {
+    progress_priv = callback;
+}
+
+/**
+ * @brief Decodes every matching frame of the source archive and writes the results to the target archive
+ * @return False if the target archive could not be created or written
+ */
+bool ArchiveRedecoder::run() {
+    statistics_priv = RedecodeStatistics();
+    QElapsedTimer timer;
+    timer.start();
+
+    const QString target = targetDirString_priv.isEmpty() ? QStringLiteral(".") : targetDirString_priv;
+    if (!QDir().mkpath(target)) {
+        qCritical() << "ArchiveRedecoder could not create" << target;
+        return false;
+    }
+    if (QFileInfo(target).canonicalFilePath() == QFileInfo(sourceDirString_priv).canonicalFilePath()) {
+        qCritical() << "ArchiveRedecoder can not write the new generation into the source archive";
+        return false;
+    }
+
+    const QStringList segments = PacketArchive::segmentFiles(sourceDirString_priv);
+    for (const auto &path : segments) {
+        PacketArchiveReader reader(path);
+        if (reader.open()) {
+            reader.forEach(query_priv, [this](const ArchivedFrame &) {
+                statistics_priv.totalFrames++;
+                return true;
+            });
+        }
+    }
+
+    FecDecoder::initTables();
+    QThreadPool pool;
+    pool.setMaxThreadCount(threadCount_priv);
+    PacketArchiveWriter writer(targetDirString_priv);
+    bool success = true;
+
+    const auto finishBatch = [&]() {
+        if (batch_priv.isEmpty()) {
+            return;
+        }
+        QAtomicInt next(0);
+        const int workers = std::min(threadCount_priv, batch_priv.size());
+        for (int i = 0; i < workers; i++) {
+            pool.start(new BatchWorker<Item>(batch_priv, next));
+        }
+        pool.waitForDone();
+        writeBatch(writer);
+        success = writer.flush() && success;
+        statistics_priv.elapsedMs = timer.elapsed();
+        if (progress_priv) {
+            progress_priv(statistics_priv);
+        }
+    };
+
+    for (const auto &path : segments) {
+        PacketArchiveReader reader(path);
+        if (!reader.open()) {
+            qWarning() << "ArchiveRedecoder skips" << path;
+            continue;
+        }
+        const QString name = QFileInfo(path).fileName();
+        const int prefixEnd = name.lastIndexOf(QStringLiteral("_packets_"));
+        writer.setPrefix(prefixEnd < 0 ? QStringLiteral("redecoded") : name.left(prefixEnd));
+
+        reader.forEach(query_priv, [&](const ArchivedFrame &frame) {
+            const bool fec = needsFec(frame);
+            batch_priv.append({frame, fec, !fec, frame.decoded});
+            if (fec) {
+                statistics_priv.encodedBytes += frame.encoded.size();
+            }
+            if (batch_priv.size() >= batchSize) {
+                finishBatch();
+            }
+            return true;
+        });
+        // The byte arrays of the batch point into the mapping of this segment
+        finishBatch();
+        writer.close();
+    }
+    statistics_priv.elapsedMs = timer.elapsed();
+    return success;
+}
+
+/**
+ * @brief Returns the counters of the current or last run
+ */
+const RedecodeStatistics &ArchiveRedecoder::statistics() const {
+    return statistics_priv;
+}
+
+/**
+ * @brief Returns true if \p frame was received with FEC and can be decoded again from its encoded bytes
+ */
+bool ArchiveRedecoder::needsFec(const ArchivedFrame &frame) {
+    return !frame.encoded.isEmpty() && (frame.encoding == QLatin1String("AO40") ||
+                                           frame.encoding == QLatin1String("AO40Short") ||
+                                           frame.encoding.startsWith(QLatin1String("RA")));
+}
+
+/**
+ * @brief Appends the decoded batch to \p writer in the original order, updates the counters and clears the batch
+ */
+void ArchiveRedecoder::writeBatch(PacketArchiveWriter &writer) {
+    for (const auto &item : batch_priv) {
+        const ArchivedFrame &frame = item.frame;
+        writer.append(frame.timestamp,
+            frame.source,
+            frame.encoding,
+            frame.satellite,
+            frame.rssi,
+            frame.encoded,
+            item.decoded,
+            frame.position);
+        statistics_priv.frames++;
+        if (!item.fec) {
+            statistics_priv.passedThrough++;
+            continue;
+        }
+        statistics_priv.redecoded++;
+        if (!item.success) {
+            statistics_priv.failed++;
+        }
+        if (item.decoded != frame.decoded) {
+            statistics_priv.changed++;
+        }
+    }
+    batch_priv.resize(0);
+}
@@ -0,0 +1,76 @@
+#ifndef ARCHIVEREDECODER_H
+#define ARCHIVEREDECODER_H
+
+#include "../packet/packetarchive.h"
+#include <QString>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief Counters of an ArchiveRedecoder run
+ */
+struct RedecodeStatistics {
+    qint64 totalFrames = 0;   //!< Frames in the source archive that match the query
+    qint64 frames = 0;        //!< Frames processed so far
+    qint64 redecoded = 0;     //!< Frames that were decoded again from their encoded bytes
+    qint64 passedThrough = 0; //!< Frames without FEC (e.g. PRE-DECODED), copied unchanged
+    qint64 failed = 0;        //!< Frames that the decoders could not decode, archived without decoded bytes
+    qint64 changed = 0;       //!< Frames whose decoded bytes differ from the archived ones
+    qint64 encodedBytes = 0;  //!< Encoded bytes sent through the decoders
+    qint64 elapsedMs = 0;     //!< Time since the start of the run [ms]
+
+    double framesPerSecond() const {
+        return elapsedMs > 0 ? frames * 1000.0 / elapsedMs : 0.0;
+    }
+};
+
+/**
+ * @brief Decodes the frames of a packet archive again and writes the results into a new archive generation.
+ *
+ * The source archive is streamed one segment at a time through memory mappings. Frames are collected into batches
+ * that are decoded on every core, every worker thread keeps its own decoder working memory (see FecDecoder), and the
+ * results are appended to the target archive in the original order. Every source segment becomes a segment of the
+ * target archive with the same prefix.
+ */
+class ArchiveRedecoder {
+public:
+    /**
+     * @brief Called after every batch with the counters of the run
+     */
+    typedef std::function<void(const RedecodeStatistics &statistics)> ProgressCallback;
+
+    ArchiveRedecoder(const QString &sourceDirString, const QString &targetDirString);
+
+    void setQuery(const PacketArchiveQuery &query);
+    void setThreadCount(int threadCount);
+    void setProgressCallback(const ProgressCallback &callback);
+    bool run();
+    const RedecodeStatistics &statistics() const;
+
+    static bool needsFec(const ArchivedFrame &frame);
+
+private:
+    /**
+     * @brief A frame of the current batch and the result of decoding it again
+     */
+    struct Item {
+        ArchivedFrame frame;
+        bool fec;
+        bool success;
+        QByteArray decoded;
+    };
+
+    static constexpr int batchSize = 2048; //!< Frames that are decoded at once
+
+    void writeBatch(PacketArchiveWriter &writer);
+
+    QString sourceDirString_priv;
+    QString targetDirString_priv;
+    PacketArchiveQuery query_priv;
+    int threadCount_priv;
+    ProgressCallback progress_priv;
+    RedecodeStatistics statistics_priv;
+    QVector<Item> batch_priv; //!< Frames of the current batch, their byte arrays point into the source mapping
+};
+
+#endif // ARCHIVEREDECODER_H
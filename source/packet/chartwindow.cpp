@@ -1,5 +1,9 @@
 #include "chartwindow.h"
+#include "telemetrystore.h"
 #include <QDebug>
+#include <QValueAxis>
+#include <algorithm>
+#include <limits>
 
 /**
  * @brief Initializes the ChartWindow.
@@ -21,6 +25,98 @@ void ChartWindow::setChart(QtCharts::QChart *chart) {
     this->setCentralWidget(chartView_priv.data());
 }
 
+/**
+ * @brief Charts the telemetry series \p key of \p store.
+ *
+ * The series is downsampled to one bucket per pixel, the mean of the buckets is drawn as a line, and their minimum
+ * and maximum as a band around it. Zooming in (selecting a range with the mouse) queries the visible range again, so
+ * the details appear without ever loading the whole series.
+ *
+ * @param store The store of the series, has to outlive the chart
+ * @param key Key of the series, see TelemetryStore::seriesKey()
+ */
+void ChartWindow::setTelemetry(const TelemetryStore *store, const QString &key) {
+    using namespace QtCharts;
+    store_priv = store;
+    seriesKey_priv = key;
+    setWindowTitle(key);
+
+    auto *chart = new QChart();
+    chart->setTitle(key);
+    chart->legend()->hide();
+    mean_priv = new QLineSeries(chart);
+    mean_priv->setUseOpenGL(true);
+    upper_priv = new QLineSeries(chart);
+    lower_priv = new QLineSeries(chart);
+    auto *band = new QAreaSeries(upper_priv, lower_priv);
+    band->setColor(QColor(0, 0, 0, 40));
+    band->setBorderColor(Qt::transparent);
+    chart->addSeries(band);
+    chart->addSeries(mean_priv);
+
+    auto *axisX = new QDateTimeAxis(chart);
+    axisX->setFormat("yyyy-MM-dd HH:mm");
+    auto *axisY = new QValueAxis(chart);
+    chart->addAxis(axisX, Qt::AlignBottom);
+    chart->addAxis(axisY, Qt::AlignLeft);
+    for (QAbstractSeries *series : chart->series()) {
+        series->attachAxis(axisX);
+        series->attachAxis(axisY);
+    }
+
+    setChart(chart);
+    chartView_priv->setRubberBand(QChartView::HorizontalRubberBand);
+
+    qint64 firstMs = 0;
+    qint64 lastMs = 0;
+    if (store_priv->timeRange(key, firstMs, lastMs)) {
+        axisX->setRange(QDateTime::fromMSecsSinceEpoch(firstMs, Qt::UTC),
+            QDateTime::fromMSecsSinceEpoch(std::max(lastMs, firstMs + 1), Qt::UTC));
+    }
+    refreshTelemetry(axisX->min(), axisX->max());
+    QObject::connect(axisX, &QDateTimeAxis::rangeChanged, this, &ChartWindow::refreshTelemetry);
+}
+
+/**
+ * @brief Queries the visible range of the telemetry series again and rescales the value axis
+ * @param from Start of the visible range
+ * @param to End of the visible range
+ */
+void ChartWindow::refreshTelemetry(const QDateTime &from, const QDateTime &to) {
+    if (store_priv == nullptr || mean_priv.isNull()) {
+        return;
+    }
+    const int buckets = std::max(1, chartView_priv->width());
+    const auto samples = store_priv->query(seriesKey_priv, from.toMSecsSinceEpoch(), to.toMSecsSinceEpoch(), buckets);
+    QVector<QPointF> means;
+    QVector<QPointF> uppers;
+    QVector<QPointF> lowers;
+    means.reserve(samples.size());
+    uppers.reserve(samples.size());
+    lowers.reserve(samples.size());
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    for (const auto &sample : samples) {
+        const double x = static_cast<double>(sample.timeMs);
+        means.append(QPointF(x, sample.mean));
+        uppers.append(QPointF(x, sample.max));
+        lowers.append(QPointF(x, sample.min));
+        min = std::min(min, sample.min);
+        max = std::max(max, sample.max);
+    }
+    // replace() redraws once, appending would redraw for every point
+    mean_priv->replace(means);
+    upper_priv->replace(uppers);
+    lower_priv->replace(lowers);
+    if (!samples.isEmpty()) {
+        const double margin = std::max((max - min) * 0.05, 1e-9);
+        const auto axes = chartView_priv->chart()->axes(Qt::Vertical);
+        if (!axes.isEmpty()) {
+            axes.first()->setRange(min - margin, max + margin);
+        }
+    }
+}
+
 void ChartWindow::renderPng(const QString &fileName) {
     if (!this->centralWidget()) {
         qWarning() << "Can't render chart without the central widget";
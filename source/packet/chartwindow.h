@@ -1,12 +1,19 @@
 #ifndef CHARTWINDOW_H
 #define CHARTWINDOW_H
 
+#include <QAreaSeries>
 #include <QChart>
 #include <QChartView>
 #include <QCloseEvent>
+#include <QDateTime>
+#include <QDateTimeAxis>
+#include <QLineSeries>
 #include <QMainWindow>
+#include <QPointer>
 #include <QScopedPointer>
 
+class TelemetryStore;
+
 /**
  * @brief The ChartWindow class instances are used to display various measurement diagrams
  */
@@ -15,13 +22,20 @@ class ChartWindow : public QMainWindow {
 
 private:
     QScopedPointer<QtCharts::QChartView> chartView_priv; //!< The Widget that is used to display the chart itself
+    const TelemetryStore *store_priv = nullptr;          //!< The store of the telemetry series that is shown
+    QString seriesKey_priv;                              //!< Key of the telemetry series that is shown
+    QPointer<QtCharts::QLineSeries> mean_priv;           //!< Means of the buckets of the telemetry series
+    QPointer<QtCharts::QLineSeries> upper_priv;          //!< Maximums of the buckets of the telemetry series
+    QPointer<QtCharts::QLineSeries> lower_priv;          //!< Minimums of the buckets of the telemetry series
+
+    void refreshTelemetry(const QDateTime &from, const QDateTime &to);
 
 public:
     explicit ChartWindow(QWidget *parent = nullptr);
     void setChart(QtCharts::QChart *chart);
+    void setTelemetry(const TelemetryStore *store, const QString &key);
     void renderPng(const QString &fileName);
 
-
 };
 
 #endif // CHARTWINDOW_H
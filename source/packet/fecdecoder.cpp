@@ -0,0 +1,142 @@
+#include "fecdecoder.h"
+#include <QDebug>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Fills the tables shared by the decoders.
+ *
+ * The Viterbi decoders fill their branch tables when the first one is created, which must not happen on several
+ * threads at once.
+ */
+void FecDecoder::initTables() {
+    ao40_delete_viterbi(ao40_create_viterbi(AO40_FRAMEBITS));
+    ao40short_delete_viterbi(ao40short_create_viterbi(AO40SHORT_FRAMEBITS));
+}
+
+/**
+ * @brief Decodes a received frame with the FEC that belongs to its length.
+ * @param encodedData The QByteArray containing the encoded data.
+ * @return Returns a DecodedPacket that contains the result of the operation.
+ */
+const DecodedPacket FecDecoder::decode(const QByteArray &encodedData) {
+    switch (encodedData.length()) {
+    case AO40_DOWNLINKLENGTH:
+        return decodeWithAO40LONG(encodedData);
+    case AO40SHORT_DOWNLINKLENGTH:
+        return decodeWithAO40SHORT(encodedData);
+    default:
+        return decodeWithRA(encodedData);
+    }
+}
+
+/**
+ * @brief Decodes \p encodedData with AO40 short and returns the result.
+ * @param encodedData The QByteArray containing the encoded data.
+ * @return Returns a DecodedPacket that contains the result of the operation.
+ */
+const DecodedPacket FecDecoder::decodeWithAO40SHORT(const QByteArray encodedData) {
+    uint8_t ao40short_dec_data[AO40SHORT_DECDOWNLINKLENGTH];
+    int8_t ao40short_error;
+
+    if (encodedData.length() < AO40SHORT_DOWNLINKLENGTH) {
+        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
+    }
+
+    // AO40 short decoding, unpacking the bits is part of the deinterleaving
+    ao40short_decode_packed(
+        reinterpret_cast<const uint8_t *>(encodedData.constData()), ao40short_dec_data, &ao40short_error);
+    QByteArray decoded = QByteArray(reinterpret_cast<char *>(ao40short_dec_data), AO40SHORT_DECDOWNLINKLENGTH);
+
+    return DecodedPacket(
+        (ao40short_error == -1) ? DecodedPacket::Failure : DecodedPacket::Success, 1, &ao40short_error, decoded);
+}
+
+/**
+ * @brief Decodes \p encodedData with AO40 long and returns the result.
+ * @param encodedData The QByteArray containing the encoded data.
+ * @return Returns a DecodedPacket that contains the result of the operation.
+ */
+const DecodedPacket FecDecoder::decodeWithAO40LONG(const QByteArray encodedData) {
+    uint8_t ao40_dec_data[AO40_DECDOWNLINKLENGTH];
+    int8_t ao40_error[2];
+
+    if (encodedData.length() < AO40_DOWNLINKLENGTH) {
+        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
+    }
+
+    // AO40 long decoding, unpacking the bits is part of the deinterleaving
+    ao40_decode_packed(reinterpret_cast<const uint8_t *>(encodedData.constData()), ao40_dec_data, ao40_error);
+    QByteArray decoded = QByteArray(reinterpret_cast<char *>(ao40_dec_data), AO40_DECDOWNLINKLENGTH);
+
+    return DecodedPacket(
+        (ao40_error[0] == -1 || ao40_error[1] == -1) ? (DecodedPacket::Failure) : (DecodedPacket::Success),
+        2,
+        ao40_error,
+        decoded);
+}
+
+static int findRacoderInputLength(int encodedLength) {
+    if (!encodedLength) {
+        return 0;
+    }
+
+    // The input length is a little less than, or maybe equal to, half of the encoded length
+    encodedLength >>= 1;
+
+    // We know that SMOG only uses racoder with power-of-2 sizes, so we find the closest
+    int ret = 1;
+    while (encodedLength >>= 1) {
+        ret <<= 1;
+    }
+    return ret;
+}
+
+/**
+ * @brief Decodes \p encodedData with RA and returns the result.
+ * @param encodedData The QByteArray containing the encoded data.
+ * @return Returns a DecodedPacket that contains the result of the operation.
+ */
+const DecodedPacket FecDecoder::decodeWithRA(const QByteArray encodedData) {
+    int inputLength = findRacoderInputLength(encodedData.length());
+    ra_index_t ra_length = static_cast<ra_index_t>(inputLength) / sizeof(ra_word_t);
+    ra_length_init(ra_length);
+
+    int encodedSize = ra_code_length * sizeof(ra_word_t);
+    if (encodedSize != encodedData.length()) {
+        qWarning() << "mismatching packet size for racoder: expected:" << encodedSize
+                   << "actual:" << encodedData.length();
+        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
+    }
+
+    const ra_word_t *ra_encoded_words = reinterpret_cast<const ra_word_t *>(encodedData.data());
+    std::vector<float> ra_encoded_bits(ra_code_length * RA_BITCOUNT, 0.0f);
+    std::vector<ra_word_t> ra_decoded_data(ra_length, 0);
+    // The working memory of the decoder is too large to allocate for every packet, each FEC worker keeps its own
+    static thread_local std::unique_ptr<ra_decoder_gen_t> ra_decoder(new ra_decoder_gen_t);
+
+    for (ra_index_t i = 0; i < ra_code_length; i++) {
+        ra_word_t word = ra_encoded_words[i];
+        for (int j = 0; j < RA_BITCOUNT; j++) {
+            if ((word & (1 << j)) == 0) {
+                ra_encoded_bits[RA_BITCOUNT * i + j] = 1.0;
+            }
+            else {
+                ra_encoded_bits[RA_BITCOUNT * i + j] = -1.0;
+            }
+        }
+    }
+
+    // Stops as soon as the decisions are stable and consistent with the received bits, noise runs all 20 passes
+    int passes = 0;
+    int mismatch = ra_decoder_gen_conv(ra_decoder.get(), ra_encoded_bits.data(), ra_decoded_data.data(), 20, &passes);
+    int codeBits = ra_code_length * RA_BITCOUNT;
+    if (mismatch * RA_MISMATCH_FRACTION > codeBits) {
+        qDebug() << "RA decoding did not converge after" << passes << "passes, mismatching bits:" << mismatch << "/"
+                 << codeBits;
+        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
+    }
+
+    QByteArray decoded = QByteArray(reinterpret_cast<char *>(ra_decoded_data.data()), inputLength);
+    return DecodedPacket(DecodedPacket::Success, 0, nullptr, decoded);
+}
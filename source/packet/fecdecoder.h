@@ -0,0 +1,29 @@
+#ifndef FECDECODER_H
+#define FECDECODER_H
+
+#define AO40_DOWNLINKLENGTH 650
+#define AO40_DECDOWNLINKLENGTH 256
+#define AO40SHORT_DOWNLINKLENGTH 333
+#define AO40SHORT_DECDOWNLINKLENGTH 128
+
+#include "../packet/decodedpacket.h"
+#include "dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_message.h"
+#include "dependencies/FEC-AO40/ao40/decode/ao40_decode_message.h"
+#include "dependencies/racoder/ra_decoder_gen.h"
+#include <QByteArray>
+
+/**
+ * @brief The forward error correction decoders of the downlink frames.
+ *
+ * Every function is safe to call from several threads at once, once FecDecoder::initTables has been called.
+ */
+class FecDecoder {
+public:
+    static void initTables();
+    static const DecodedPacket decode(const QByteArray &encodedData);
+    static const DecodedPacket decodeWithAO40SHORT(const QByteArray encodedData);
+    static const DecodedPacket decodeWithAO40LONG(const QByteArray encodedData);
+    static const DecodedPacket decodeWithRA(const QByteArray encodedData);
+};
+
+#endif // FECDECODER_H
@@ -0,0 +1,25 @@
+#include "fecjob.h"
+#include "packetdecoder.h"
+
+/**
+ * @brief Constructor for the class.
+ * @param decoder The PacketDecoder that receives the result
+ * @param sequence Sequence number of the frame
+ * @param encodedData The received, encoded frame
+ */
+FecJob::FecJob(PacketDecoder *decoder, quint64 sequence, const QByteArray &encodedData)
+: decoder_priv(decoder), sequence_priv(sequence), encodedData_priv(encodedData) {
+}
+
+/**
+ * @brief Decodes the frame and queues the result to the thread of the PacketDecoder.
+ */
+void FecJob::run() {
+    DecodedPacket result = FecDecoder::decode(encodedData_priv);
+    PacketDecoder *decoder = decoder_priv;
+    quint64 sequence = sequence_priv;
+    // The pool is owned by the decoder and waits for its jobs before the decoder is gone, and queued calls to a
+    // deleted receiver are discarded
+    QMetaObject::invokeMethod(
+        decoder, [decoder, sequence, result]() { decoder->fecJobFinished(sequence, result); }, Qt::QueuedConnection);
+}
@@ -0,0 +1,26 @@
+#ifndef FECJOB_H
+#define FECJOB_H
+
+#include <QByteArray>
+#include <QRunnable>
+
+class PacketDecoder;
+
+/**
+ * @brief Decodes a single received frame on a worker thread of PacketDecoder's FEC pool.
+ *
+ * The result is handed back to the thread of the PacketDecoder together with the sequence number of the frame, so that
+ * PacketDecoder can process the frames in the order they were received.
+ */
+class FecJob : public QRunnable {
+private:
+    PacketDecoder *decoder_priv;  //!< The PacketDecoder that receives the result
+    quint64 sequence_priv;        //!< Sequence number of the frame
+    QByteArray encodedData_priv;  //!< The received, encoded frame
+
+public:
+    FecJob(PacketDecoder *decoder, quint64 sequence, const QByteArray &encodedData);
+    void run() override;
+};
+
+#endif // FECJOB_H
@@ -0,0 +1,632 @@
+#include "packetarchive.h"
+#include <QDebug>
+#include <QDir>
+#include <QtEndian>
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace {
+/**
+ * @brief Appends \p value to \p buffer in little endian byte order
+ */
+template <typename T> void appendLittleEndian(QByteArray &buffer, T value) {
+    uchar bytes[sizeof(T)];
+    qToLittleEndian(value, bytes);
+    buffer.append(reinterpret_cast<const char *>(bytes), sizeof(T));
+}
+
+/**
+ * @brief Writes \p value in little endian byte order to \p buffer at \p offset
+ */
+template <typename T> void writeLittleEndian(QByteArray &buffer, int offset, T value) {
+    qToLittleEndian(value, reinterpret_cast<uchar *>(buffer.data() + offset));
+}
+
+/**
+ * @brief Reads a little endian value from \p data
+ */
+template <typename T> T readLittleEndian(const uchar *data) {
+    return qFromLittleEndian<T>(data);
+}
+
+/**
+ * @brief Returns the milliseconds since the epoch of \p dateTime, or \p fallback if \p dateTime is invalid
+ */
+qint64 toMs(const QDateTime &dateTime, qint64 fallback) {
+    return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : fallback;
+}
+} // namespace
+
+/**
+ * @brief Returns the code that represents \p satellite in the archive
+ */
+quint8 PacketArchive::satelliteCode(SatelliteChanger::Satellites satellite) {
+    switch (satellite) {
+    case SatelliteChanger::Satellites::SMOG1:
+    case SatelliteChanger::Satellites::SMOGP:
+    case SatelliteChanger::Satellites::ATL1:
+        return static_cast<quint8>(satellite);
+    case SatelliteChanger::Satellites::UNSET:
+        break;
+    }
+    return 0xFF;
+}
+
+/**
+ * @brief Returns the satellite that \p code represents in the archive
+ */
+SatelliteChanger::Satellites PacketArchive::satelliteFromCode(quint8 code) {
+    switch (code) {
+    case static_cast<quint8>(SatelliteChanger::Satellites::SMOG1):
+        return SatelliteChanger::Satellites::SMOG1;
+    case static_cast<quint8>(SatelliteChanger::Satellites::SMOGP):
+        return SatelliteChanger::Satellites::SMOGP;
+    case static_cast<quint8>(SatelliteChanger::Satellites::ATL1):
+        return SatelliteChanger::Satellites::ATL1;
+    default:
+        return SatelliteChanger::Satellites::UNSET;
+    }
+}
+
+/**
+ * @brief Returns the bit of \p satellite in satellite masks (index entries, PacketArchiveQuery::satelliteMask)
+ */
+quint8 PacketArchive::satelliteBit(SatelliteChanger::Satellites satellite) {
+    const quint8 code = satelliteCode(satellite);
+    return code < 7 ? static_cast<quint8>(1u << code) : 0x80;
+}
+
+/**
+ * @brief Computes the CRC-32 (IEEE 802.3) of \p data
+ * @param data The data
+ * @param length The number of bytes in \p data
+ * @return The checksum
+ */
+quint32 PacketArchive::crc32(const char *data, qint64 length) {
+    static const auto table = []() {
+        std::array<quint32, 256> t;
+        for (quint32 i = 0; i < 256; i++) {
+            quint32 c = i;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            }
+            t[i] = c;
+        }
+        return t;
+    }();
+    quint32 crc = 0xFFFFFFFFu;
+    for (qint64 i = 0; i < length; i++) {
+        crc = table[(crc ^ static_cast<quint8>(data[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @brief Returns the paths of the segments in \p dirString, oldest first
+ * @param dirString Directory of the archive
+ * @return The paths of the segment files
+ */
+QStringList PacketArchive::segmentFiles(const QString &dirString) {
+    QDir dir(dirString.isEmpty() ? QStringLiteral(".") : dirString);
+    auto entries = dir.entryInfoList(QStringList() << ("*" + segmentSuffix), QDir::Files, QDir::Name);
+    // Segment names end with their start time, prefixes only break ties
+    const auto startTime = [](const QFileInfo &info) {
+        const QString name = info.fileName();
+        return name.mid(name.lastIndexOf(QStringLiteral("_packets_")));
+    };
+    std::stable_sort(entries.begin(), entries.end(), [&](const QFileInfo &a, const QFileInfo &b) {
+        return startTime(a) < startTime(b);
+    });
+    QStringList paths;
+    for (const auto &entry : entries) {
+        paths << entry.filePath();
+    }
+    return paths;
+}
+
+/**
+ * @brief Constructor for the class
+ * @param dirString Directory of the archive, segments are created in it. Has to end with a separator unless empty.
+ */
+PacketArchiveWriter::PacketArchiveWriter(const QString &dirString)
+    : dirString_priv(dirString), prefix_priv("startup"), segmentSize_priv(0) {
+    buffer_priv.reserve(bufferSize + 1024);
+}
+
+PacketArchiveWriter::~PacketArchiveWriter() {
+    close();
+}
+
+/**
+ * @brief Sets the prefix of the segment names. The current segment is closed if the prefix changes.
+ * @param prefix The new prefix
+ */
+void PacketArchiveWriter::setPrefix(const QString &prefix) {
+    if (prefix != prefix_priv) {
+        close();
+        prefix_priv = prefix;
+    }
+}
+
+/**
+ * @brief Appends a frame to the archive
+ * @param timestamp Time of reception
+ * @param source Source of the frame
+ * @param encoding Encoding of the frame
+ * @param satellite The satellite that the frame was received for
+ * @param rssi The RSSI that the frame was received with
+ * @param encoded The received, still encoded bytes
+ * @param decoded The decoded bytes
+ * @param position Position in the recording that the frame was decoded from [samples], -1 if it was not
+ * @return False if the segment could not be written
+ */
+bool PacketArchiveWriter::append(const QDateTime &timestamp,
+    const QString &source,
+    const QString &encoding,
+    SatelliteChanger::Satellites satellite,
+    int rssi,
+    const QByteArray &encoded,
+    const QByteArray &decoded,
+    qint64 position) {
+    using namespace PacketArchive;
+    if (!segment_priv.isOpen() || segmentSize_priv >= maxSegmentSize) {
+        close();
+        if (!openSegment(timestamp)) {
+            return false;
+        }
+    }
+
+    const QByteArray sourceUtf8 = source.toUtf8().left(0xFF);
+    const QByteArray encodingUtf8 = encoding.toUtf8().left(0xFF);
+    const int encodedLength = std::min(encoded.size(), 0xFFFF);
+    const int decodedLength = std::min(decoded.size(), 0xFFFF);
+    const quint8 packetType = decoded.isEmpty() ? noPacketType : static_cast<quint8>(decoded.at(0));
+    const qint64 timestampMs = timestamp.toMSecsSinceEpoch();
+    const quint16 flags = position >= 0 ? framePositionFlag : 0;
+    const quint32 frameLength = frameHeaderSize + sourceUtf8.size() + encodingUtf8.size() + encodedLength +
+                                decodedLength + (position >= 0 ? framePositionSize : 0) + frameChecksumSize;
+
+    const int start = buffer_priv.size();
+    appendLittleEndian<quint32>(buffer_priv, frameMagic);
+    appendLittleEndian<quint32>(buffer_priv, frameLength);
+    appendLittleEndian<qint64>(buffer_priv, timestampMs);
+    appendLittleEndian<qint16>(buffer_priv, static_cast<qint16>(rssi));
+    appendLittleEndian<quint8>(buffer_priv, satelliteCode(satellite));
+    appendLittleEndian<quint8>(buffer_priv, packetType);
+    appendLittleEndian<quint8>(buffer_priv, static_cast<quint8>(sourceUtf8.size()));
+    appendLittleEndian<quint8>(buffer_priv, static_cast<quint8>(encodingUtf8.size()));
+    appendLittleEndian<quint16>(buffer_priv, static_cast<quint16>(encodedLength));
+    appendLittleEndian<quint16>(buffer_priv, static_cast<quint16>(decodedLength));
+    appendLittleEndian<quint16>(buffer_priv, flags);
+    buffer_priv.append(sourceUtf8);
+    buffer_priv.append(encodingUtf8);
+    buffer_priv.append(encoded.constData(), encodedLength);
+    buffer_priv.append(decoded.constData(), decodedLength);
+    if (flags & framePositionFlag) {
+        appendLittleEndian<qint64>(buffer_priv, position);
+    }
+    appendLittleEndian<quint32>(buffer_priv, crc32(buffer_priv.constData() + start, buffer_priv.size() - start));
+
+    if (block_priv.frameCount == 0) {
+        block_priv.offset = segmentSize_priv;
+        block_priv.firstMs = timestampMs;
+        block_priv.lastMs = timestampMs;
+    }
+    block_priv.size += frameLength;
+    block_priv.frameCount++;
+    block_priv.firstMs = std::min(block_priv.firstMs, timestampMs);
+    block_priv.lastMs = std::max(block_priv.lastMs, timestampMs);
+    block_priv.satelliteMask |= satelliteBit(satellite);
+    block_priv.packetTypes.set(packetType);
+    segmentSize_priv += frameLength;
+
+    bool success = true;
+    if (buffer_priv.size() >= bufferSize || sinceFlush_priv.elapsed() >= flushIntervalMs) {
+        success = flush();
+    }
+    if (block_priv.frameCount >= static_cast<quint32>(framesPerBlock)) {
+        // The block has to be on disk before its index entry
+        success = flush() && success;
+        writeIndexEntry();
+    }
+    return success;
+}
+
+/**
+ * @brief Writes the buffered frames to the segment
+ * @return False if the segment could not be written
+ */
+bool PacketArchiveWriter::flush() {
+    sinceFlush_priv.restart();
+    if (buffer_priv.isEmpty()) {
+        return true;
+    }
+    const qint64 written = segment_priv.write(buffer_priv);
+    const bool success = written == buffer_priv.size() && segment_priv.flush();
+    if (!success) {
+        qWarning() << "PacketArchiveWriter could not write" << segment_priv.fileName();
+    }
+    buffer_priv.resize(0);
+    return success;
+}
+
+/**
+ * @brief Writes the buffered frames and the index entry of the last block, then closes the current segment
+ */
+void PacketArchiveWriter::close() {
+    if (!segment_priv.isOpen()) {
+        return;
+    }
+    flush();
+    if (block_priv.frameCount > 0) {
+        writeIndexEntry();
+    }
+    segment_priv.close();
+    index_priv.close();
+}
+
+/**
+ * @brief Returns the path of the segment that frames are currently appended to, empty if no segment is open
+ */
+QString PacketArchiveWriter::currentSegment() const {
+    return segment_priv.isOpen() ? segment_priv.fileName() : QString();
+}
+
+/**
+ * @brief Creates a new segment and its index, named after \p timestamp
+ * @param timestamp Time of reception of the first frame in the segment
+ * @return False if the segment could not be created
+ */
+bool PacketArchiveWriter::openSegment(const QDateTime &timestamp) {
+    using namespace PacketArchive;
+    const QString baseName = dirString_priv + prefix_priv + "_packets_" +
+                             timestamp.toUTC().toString(QStringLiteral("yyyyMMdd'T'HHmmss'Z'"));
+    QString name = baseName + segmentSuffix;
+    for (int i = 1; QFile::exists(name); i++) {
+        name = baseName + "_" + QString::number(i) + segmentSuffix;
+    }
+    segment_priv.setFileName(name);
+    index_priv.setFileName(name + indexSuffix);
+    if (!segment_priv.open(QIODevice::WriteOnly) || !index_priv.open(QIODevice::WriteOnly)) {
+        qWarning() << "PacketArchiveWriter could not create" << name;
+        segment_priv.close();
+        index_priv.close();
+        return false;
+    }
+
+    QByteArray header;
+    appendLittleEndian<quint32>(header, segmentMagic);
+    appendLittleEndian<quint16>(header, version);
+    appendLittleEndian<quint16>(header, segmentHeaderSize);
+    appendLittleEndian<qint64>(header, QDateTime::currentMSecsSinceEpoch());
+    segment_priv.write(header);
+
+    QByteArray indexHeader;
+    appendLittleEndian<quint32>(indexHeader, indexMagic);
+    appendLittleEndian<quint16>(indexHeader, version);
+    appendLittleEndian<quint16>(indexHeader, indexEntrySize);
+    appendLittleEndian<quint32>(indexHeader, framesPerBlock);
+    appendLittleEndian<quint32>(indexHeader, 0);
+    index_priv.write(indexHeader);
+    index_priv.flush();
+
+    segmentSize_priv = segmentHeaderSize;
+    block_priv = Block();
+    sinceFlush_priv.start();
+    return true;
+}
+
+/**
+ * @brief Appends the summary of the current block to the index and starts a new block
+ */
+void PacketArchiveWriter::writeIndexEntry() {
+    using namespace PacketArchive;
+    QByteArray entry;
+    entry.reserve(indexEntrySize);
+    appendLittleEndian<quint64>(entry, static_cast<quint64>(block_priv.offset));
+    appendLittleEndian<quint32>(entry, static_cast<quint32>(block_priv.size));
+    appendLittleEndian<quint32>(entry, block_priv.frameCount);
+    appendLittleEndian<qint64>(entry, block_priv.firstMs);
+    appendLittleEndian<qint64>(entry, block_priv.lastMs);
+    appendLittleEndian<quint8>(entry, block_priv.satelliteMask);
+    entry.append(7, '\0');
+    for (int byte = 0; byte < 32; byte++) {
+        quint8 bits = 0;
+        for (int bit = 0; bit < 8; bit++) {
+            if (block_priv.packetTypes.test(byte * 8 + bit)) {
+                bits |= static_cast<quint8>(1u << bit);
+            }
+        }
+        appendLittleEndian<quint8>(entry, bits);
+    }
+    Q_ASSERT(entry.size() == indexEntrySize);
+    if (index_priv.write(entry) != indexEntrySize || !index_priv.flush()) {
+        qWarning() << "PacketArchiveWriter could not write" << index_priv.fileName();
+    }
+    block_priv = Block();
+}
+
+/**
+ * @brief Constructor for the class. Call PacketArchiveReader::open() before reading.
+ * @param segmentPath Path of the segment file
+ */
+PacketArchiveReader::PacketArchiveReader(const QString &segmentPath) : segment_priv(segmentPath) {
+}
+
+PacketArchiveReader::~PacketArchiveReader() {
+    close();
+}
+
+/**
+ * @brief Maps the segment into memory and loads its index
+ * @return False if the file is not a segment of a packet archive
+ */
+bool PacketArchiveReader::open() {
+    using namespace PacketArchive;
+    close();
+    if (!segment_priv.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    size_priv = segment_priv.size();
+    if (size_priv < segmentHeaderSize) {
+        close();
+        return false;
+    }
+    data_priv = segment_priv.map(0, size_priv);
+    const quint16 segmentVersion = data_priv != nullptr ? readLittleEndian<quint16>(data_priv + 4) : 0;
+    if (data_priv == nullptr || readLittleEndian<quint32>(data_priv) != segmentMagic ||
+        segmentVersion < oldestVersion || segmentVersion > version) {
+        qWarning() << "PacketArchiveReader could not open" << segment_priv.fileName();
+        close();
+        return false;
+    }
+    loadIndex();
+    return true;
+}
+
+/**
+ * @brief Unmaps and closes the segment. Frames returned earlier become invalid.
+ */
+void PacketArchiveReader::close() {
+    if (data_priv != nullptr) {
+        segment_priv.unmap(const_cast<uchar *>(data_priv));
+        data_priv = nullptr;
+    }
+    segment_priv.close();
+    size_priv = 0;
+    index_priv.clear();
+}
+
+/**
+ * @brief Calls \p callback with every frame of the segment that matches \p query, in the order they were written
+ * @param query Selects the frames
+ * @param callback Called with the frames, returning false stops the iteration
+ * @return False if the iteration was stopped by \p callback
+ */
+bool PacketArchiveReader::forEach(
+    const PacketArchiveQuery &query, const std::function<bool(const ArchivedFrame &)> &callback) const {
+    const qint64 fromMs = toMs(query.from, std::numeric_limits<qint64>::min());
+    const qint64 toMsValue = toMs(query.to, std::numeric_limits<qint64>::max());
+    ArchivedFrame frame;
+    for (const auto &entry : index_priv) {
+        if (!matches(entry, fromMs, toMsValue, query)) {
+            continue;
+        }
+        qint64 offset = entry.offset;
+        const qint64 end = entry.offset + entry.size;
+        while (offset < end) {
+            const qint64 length = readFrame(offset, frame);
+            if (length == 0) {
+                break;
+            }
+            offset += length;
+            const qint64 ms = frame.timestamp.toMSecsSinceEpoch();
+            if (ms < fromMs || ms > toMsValue || !(query.satelliteMask & PacketArchive::satelliteBit(frame.satellite)) ||
+                !query.packetTypes.test(frame.packetType)) {
+                continue;
+            }
+            if (!callback(frame)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Calls \p callback with the frames of the segment whose position is in [\p first, \p first + \p count).
+ *
+ * Positions count the valid frames of the segment in the order they were written. The blocks before \p first are
+ * skipped with the help of the index.
+ *
+ * @param first Position of the first frame
+ * @param count Number of frames
+ * @param callback Called with the frames, returning false stops the iteration
+ * @return False if the iteration was stopped by \p callback
+ */
+bool PacketArchiveReader::forRange(
+    qint64 first, qint64 count, const std::function<bool(const ArchivedFrame &)> &callback) const {
+    const qint64 last = first + count;
+    ArchivedFrame frame;
+    qint64 position = 0;
+    for (const auto &entry : index_priv) {
+        if (position >= last) {
+            break;
+        }
+        if (position + entry.frameCount <= first) {
+            position += entry.frameCount;
+            continue;
+        }
+        qint64 offset = entry.offset;
+        const qint64 end = entry.offset + entry.size;
+        qint64 framePosition = position;
+        while (offset < end && framePosition < last) {
+            const qint64 length = readFrame(offset, frame);
+            if (length == 0) {
+                break;
+            }
+            offset += length;
+            if (framePosition++ >= first && !callback(frame)) {
+                return false;
+            }
+        }
+        position += entry.frameCount;
+    }
+    return true;
+}
+
+/**
+ * @brief Returns the number of valid frames in the segment
+ */
+qint64 PacketArchiveReader::frameCount() const {
+    qint64 count = 0;
+    for (const auto &entry : index_priv) {
+        count += entry.frameCount;
+    }
+    return count;
+}
+
+/**
+ * @brief Calls \p callback with every frame in the archive that matches \p query, oldest segment first
+ * @param dirString Directory of the archive
+ * @param query Selects the frames
+ * @param callback Called with the frames, returning false stops the iteration
+ * @return The number of frames that \p callback was called with
+ */
+qint64 PacketArchiveReader::forEachInDirectory(const QString &dirString,
+    const PacketArchiveQuery &query,
+    const std::function<bool(const ArchivedFrame &)> &callback) {
+    qint64 count = 0;
+    for (const auto &path : PacketArchive::segmentFiles(dirString)) {
+        PacketArchiveReader reader(path);
+        if (!reader.open()) {
+            continue;
+        }
+        bool keepGoing = reader.forEach(query, [&](const ArchivedFrame &frame) {
+            count++;
+            return callback(frame);
+        });
+        if (!keepGoing) {
+            break;
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief Loads the sparse index of the segment, then scans the frames that are not covered by it
+ *
+ * Index entries that point outside of the segment (e.g. the segment was truncated) are dropped. The unindexed tail is
+ * summarized into one additional entry, so that PacketArchiveReader::forEach() only has to walk the entries.
+ */
+void PacketArchiveReader::loadIndex() {
+    using namespace PacketArchive;
+    qint64 indexedEnd = segmentHeaderSize;
+
+    QFile indexFile(segment_priv.fileName() + indexSuffix);
+    if (indexFile.open(QIODevice::ReadOnly)) {
+        const QByteArray indexData = indexFile.readAll();
+        const auto *bytes = reinterpret_cast<const uchar *>(indexData.constData());
+        if (indexData.size() >= indexHeaderSize && readLittleEndian<quint32>(bytes) == indexMagic &&
+            readLittleEndian<quint16>(bytes + 6) == indexEntrySize) {
+            for (int pos = indexHeaderSize; pos + indexEntrySize <= indexData.size(); pos += indexEntrySize) {
+                const uchar *e = bytes + pos;
+                IndexEntry entry;
+                entry.offset = static_cast<qint64>(readLittleEndian<quint64>(e));
+                entry.size = readLittleEndian<quint32>(e + 8);
+                entry.frameCount = readLittleEndian<quint32>(e + 12);
+                entry.firstMs = readLittleEndian<qint64>(e + 16);
+                entry.lastMs = readLittleEndian<qint64>(e + 24);
+                entry.satelliteMask = e[32];
+                for (int bit = 0; bit < 256; bit++) {
+                    entry.packetTypes.set(bit, (e[40 + bit / 8] >> (bit % 8)) & 1);
+                }
+                if (entry.offset != indexedEnd || entry.offset + entry.size > size_priv) {
+                    break;
+                }
+                indexedEnd = entry.offset + entry.size;
+                index_priv.append(entry);
+            }
+        }
+    }
+
+    IndexEntry tail;
+    tail.offset = indexedEnd;
+    tail.size = 0;
+    tail.frameCount = 0;
+    tail.firstMs = std::numeric_limits<qint64>::max();
+    tail.lastMs = std::numeric_limits<qint64>::min();
+    tail.satelliteMask = 0;
+    ArchivedFrame frame;
+    qint64 offset = indexedEnd;
+    while (qint64 length = readFrame(offset, frame)) {
+        const qint64 ms = frame.timestamp.toMSecsSinceEpoch();
+        tail.size += length;
+        tail.frameCount++;
+        tail.firstMs = std::min(tail.firstMs, ms);
+        tail.lastMs = std::max(tail.lastMs, ms);
+        tail.satelliteMask |= satelliteBit(frame.satellite);
+        tail.packetTypes.set(frame.packetType);
+        offset += length;
+    }
+    if (tail.frameCount > 0) {
+        index_priv.append(tail);
+    }
+}
+
+/**
+ * @brief Reads the frame at \p offset into \p frame. The byte arrays of \p frame point into the mapping.
+ * @param offset Offset of the frame in the segment
+ * @param frame The frame that is filled in
+ * @return The length of the frame, 0 if there is no valid frame at \p offset
+ */
+qint64 PacketArchiveReader::readFrame(qint64 offset, ArchivedFrame &frame) const {
+    using namespace PacketArchive;
+    if (offset + frameHeaderSize + frameChecksumSize > size_priv) {
+        return 0;
+    }
+    const uchar *f = data_priv + offset;
+    const quint32 length = readLittleEndian<quint32>(f + 4);
+    if (readLittleEndian<quint32>(f) != frameMagic || length < frameHeaderSize + frameChecksumSize ||
+        offset + length > size_priv) {
+        return 0;
+    }
+    const quint8 sourceLength = f[20];
+    const quint8 encodingLength = f[21];
+    const quint16 encodedLength = readLittleEndian<quint16>(f + 22);
+    const quint16 decodedLength = readLittleEndian<quint16>(f + 24);
+    const quint16 flags = readLittleEndian<quint16>(f + 26);
+    const int positionLength = (flags & framePositionFlag) ? framePositionSize : 0;
+    const quint32 expectedLength = frameHeaderSize + sourceLength + encodingLength + encodedLength + decodedLength +
+                                   positionLength + frameChecksumSize;
+    if (expectedLength != length ||
+        crc32(reinterpret_cast<const char *>(f), length - frameChecksumSize) !=
+            readLittleEndian<quint32>(f + length - frameChecksumSize)) {
+        return 0;
+    }
+
+    const char *payload = reinterpret_cast<const char *>(f + frameHeaderSize);
+    frame.timestamp = QDateTime::fromMSecsSinceEpoch(readLittleEndian<qint64>(f + 8), Qt::UTC);
+    frame.rssi = readLittleEndian<qint16>(f + 16);
+    frame.satellite = satelliteFromCode(f[18]);
+    frame.packetType = f[19];
+    frame.source = QString::fromUtf8(payload, sourceLength);
+    payload += sourceLength;
+    frame.encoding = QString::fromUtf8(payload, encodingLength);
+    payload += encodingLength;
+    frame.encoded = QByteArray::fromRawData(payload, encodedLength);
+    payload += encodedLength;
+    frame.decoded = QByteArray::fromRawData(payload, decodedLength);
+    payload += decodedLength;
+    frame.position = positionLength > 0 ? readLittleEndian<qint64>(reinterpret_cast<const uchar *>(payload)) : -1;
+    return length;
+}
+
+/**
+ * @brief Returns true if the block described by \p entry may contain frames that match the query
+ */
+bool PacketArchiveReader::matches(const IndexEntry &entry, qint64 fromMs, qint64 toMs, const PacketArchiveQuery &query) {
+    return entry.lastMs >= fromMs && entry.firstMs <= toMs && (entry.satelliteMask & query.satelliteMask) &&
+           (entry.packetTypes & query.packetTypes).any();
+}
@@ -0,0 +1,204 @@
+#ifndef PACKETARCHIVE_H
+#define PACKETARCHIVE_H
+
+#include "../utilities/satellitechanger.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <bitset>
+#include <functional>
+
+/*
+ * Binary packet archive
+ *
+ * The archive is a directory of append-only segment files ("<prefix>_packets_<UTC start>.s1pa"). A segment starts with
+ * a 16 byte header (magic "S1PA", version, header size, creation time) followed by frames. Every frame is:
+ *
+ *   offset  size  field
+ *        0     4  magic "S1FR"
+ *        4     4  length of the whole frame, including the checksum
+ *        8     8  reception time [ms since the epoch, UTC]
+ *       16     2  RSSI
+ *       18     1  satellite (see PacketArchive::satelliteCode())
+ *       19     1  packet type (first decoded byte, 0xFF if nothing was decoded)
+ *       20     1  source length
+ *       21     1  encoding length
+ *       22     2  encoded length
+ *       24     2  decoded length
+ *       26     2  flags (see PacketArchive::framePositionFlag)
+ *       28        source (UTF-8), encoding (UTF-8), encoded bytes, decoded bytes
+ *      ...     8  position in the recording that the frame was decoded from [samples], only with framePositionFlag
+ *      ...     4  CRC-32 of everything before it
+ *
+ * All integers are little endian. Version 1 segments are the same, except that their frames never have flags. Next
+ * to every segment there is a sparse index ("<segment>.idx", magic "S1PI") with one entry per block of
+ * PacketArchive::framesPerBlock frames. An entry holds the offset and size of the block, its time range, and masks of
+ * the satellites and packet types it contains, so that queries can skip whole blocks. The index is also append-only;
+ * frames after the last complete block (or all frames, if the index is missing) are found by scanning the segment.
+ */
+
+/**
+ * @brief Constants and helpers shared by PacketArchiveWriter and PacketArchiveReader.
+ */
+namespace PacketArchive {
+constexpr quint32 segmentMagic = 0x41503153;     //!< "S1PA"
+constexpr quint32 indexMagic = 0x49503153;       //!< "S1PI"
+constexpr quint32 frameMagic = 0x52463153;       //!< "S1FR"
+constexpr quint16 version = 2;                   //!< Format version of segments and indices
+constexpr quint16 oldestVersion = 1;             //!< Oldest format version that can still be read
+constexpr int segmentHeaderSize = 16;            //!< Size of the segment header [bytes]
+constexpr int indexHeaderSize = 16;              //!< Size of the index header [bytes]
+constexpr int indexEntrySize = 72;               //!< Size of an index entry [bytes]
+constexpr int frameHeaderSize = 28;              //!< Size of the fixed part of a frame [bytes]
+constexpr int frameChecksumSize = 4;             //!< Size of the frame checksum [bytes]
+constexpr int framePositionSize = 8;             //!< Size of the position of a frame in its recording [bytes]
+constexpr quint16 framePositionFlag = 0x0001;    //!< The frame ends with its position in the recording
+constexpr int framesPerBlock = 128;              //!< Number of frames that are summarized by an index entry
+constexpr qint64 maxSegmentSize = 64 * 1024 * 1024; //!< A new segment is started when a segment reaches this size
+constexpr quint8 noPacketType = 0xFF;            //!< Packet type of frames without decoded data
+const QString segmentSuffix = QStringLiteral(".s1pa");
+const QString indexSuffix = QStringLiteral(".idx");
+
+quint8 satelliteCode(SatelliteChanger::Satellites satellite);
+SatelliteChanger::Satellites satelliteFromCode(quint8 code);
+quint8 satelliteBit(SatelliteChanger::Satellites satellite);
+quint32 crc32(const char *data, qint64 length);
+QStringList segmentFiles(const QString &dirString);
+} // namespace PacketArchive
+
+/**
+ * @brief A frame read from the archive.
+ *
+ * The byte arrays of frames returned by PacketArchiveReader point into the memory mapped segment and are only valid
+ * while the reader is open. Copy them (e.g. with QByteArray::detach()) to keep them longer.
+ */
+struct ArchivedFrame {
+    QDateTime timestamp;                    //!< Time of reception (UTC)
+    QString source;                         //!< Source of the frame (audio, sdr, etc.)
+    QString encoding;                       //!< Encoding of the frame (AO40, AO40Short, RA128, etc.)
+    SatelliteChanger::Satellites satellite; //!< The satellite that the frame was received for
+    quint8 packetType;                      //!< The type of the decoded packet, PacketArchive::noPacketType if none
+    int rssi;                               //!< The RSSI that the frame was received with
+    qint64 position;                        //!< Position in the recording that it was decoded from, -1 if none
+    QByteArray encoded;                     //!< The received, still encoded bytes
+    QByteArray decoded;                     //!< The decoded bytes
+};
+
+/**
+ * @brief Selects the frames that PacketArchiveReader::forEach() returns. Default constructed queries match every frame.
+ */
+struct PacketArchiveQuery {
+    QDateTime from;                  //!< Earliest time of reception, unbounded if invalid
+    QDateTime to;                    //!< Latest time of reception, unbounded if invalid
+    quint8 satelliteMask = 0xFF;     //!< Bits of the accepted satellites, see PacketArchive::satelliteBit()
+    std::bitset<256> packetTypes;    //!< The accepted packet types
+
+    PacketArchiveQuery() {
+        packetTypes.set();
+    }
+};
+
+/**
+ * @brief Appends frames to the segments of a packet archive.
+ *
+ * Frames are collected in a buffer and written in one go when the buffer is full, at most a second after the previous
+ * write, or when the writer is flushed or closed. The owner calls flush() every flushIntervalMs so that frames are not
+ * held back while no new ones arrive. A new segment is started when the prefix changes or when the current segment
+ * reaches PacketArchive::maxSegmentSize.
+ */
+class PacketArchiveWriter {
+public:
+    static constexpr int flushIntervalMs = 1000; //!< Maximum time that a frame spends in the buffer [ms]
+
+    explicit PacketArchiveWriter(const QString &dirString);
+    ~PacketArchiveWriter();
+
+    void setPrefix(const QString &prefix);
+    bool append(const QDateTime &timestamp,
+        const QString &source,
+        const QString &encoding,
+        SatelliteChanger::Satellites satellite,
+        int rssi,
+        const QByteArray &encoded,
+        const QByteArray &decoded,
+        qint64 position = -1);
+    bool flush();
+    void close();
+    QString currentSegment() const;
+
+private:
+    /**
+     * @brief Summary of the frames of a block, written to the index when the block is complete
+     */
+    struct Block {
+        qint64 offset = 0;
+        qint64 size = 0;
+        quint32 frameCount = 0;
+        qint64 firstMs = 0;
+        qint64 lastMs = 0;
+        quint8 satelliteMask = 0;
+        std::bitset<256> packetTypes;
+    };
+
+    static constexpr int bufferSize = 64 * 1024; //!< Buffered bytes that trigger a write
+
+    bool openSegment(const QDateTime &timestamp);
+    void writeIndexEntry();
+
+    QString dirString_priv;    //!< Directory of the archive, including the separator
+    QString prefix_priv;       //!< Prefix of the segment names
+    QFile segment_priv;        //!< The segment that frames are appended to
+    QFile index_priv;          //!< The index of \p segment_priv
+    QByteArray buffer_priv;    //!< Frames that have not been written yet
+    qint64 segmentSize_priv;   //!< Size of the segment including \p buffer_priv [bytes]
+    Block block_priv;          //!< The block that frames are currently added to
+    QElapsedTimer sinceFlush_priv; //!< Time since the buffer was last written
+};
+
+/**
+ * @brief Reads a segment of a packet archive through a memory mapping.
+ */
+class PacketArchiveReader {
+public:
+    explicit PacketArchiveReader(const QString &segmentPath);
+    ~PacketArchiveReader();
+
+    bool open();
+    void close();
+    bool forEach(const PacketArchiveQuery &query, const std::function<bool(const ArchivedFrame &)> &callback) const;
+    bool forRange(qint64 first, qint64 count, const std::function<bool(const ArchivedFrame &)> &callback) const;
+    qint64 frameCount() const;
+
+    static qint64 forEachInDirectory(const QString &dirString,
+        const PacketArchiveQuery &query,
+        const std::function<bool(const ArchivedFrame &)> &callback);
+
+private:
+    /**
+     * @brief An entry of the sparse index
+     */
+    struct IndexEntry {
+        qint64 offset;
+        qint64 size;
+        quint32 frameCount;
+        qint64 firstMs;
+        qint64 lastMs;
+        quint8 satelliteMask;
+        std::bitset<256> packetTypes;
+    };
+
+    void loadIndex();
+    qint64 readFrame(qint64 offset, ArchivedFrame &frame) const;
+    static bool matches(const IndexEntry &entry, qint64 fromMs, qint64 toMs, const PacketArchiveQuery &query);
+
+    QFile segment_priv;               //!< The segment file
+    const uchar *data_priv = nullptr; //!< The memory mapped contents of \p segment_priv
+    qint64 size_priv = 0;             //!< Size of the mapping [bytes]
+    QVector<IndexEntry> index_priv;   //!< Blocks of the segment, the unindexed tail is added as a last entry
+};
+
+#endif // PACKETARCHIVE_H
@@ -1,4 +1,5 @@
 #include "packetdecoder.h"
+#include "fecjob.h"
 
 #ifdef CHECK_SIGNATURE
 
@@ -9,19 +10,15 @@
 /**
  * @brief Consturctor for the class.
  *
- * @param file The pointer to the file that packet log will be written to
+ * @param logDirString The folder that the packet archive will be written to
  * @param downloadDirString the folder that downloaded files will be written to
  * @param spectrumReceiver pointer to the Spectrum Receiver object
  * @param parent Parent QObject pointer, should be left empty
  */
-PacketDecoder::PacketDecoder(QString logDirString,
-    QString fileName,
-    QString downloadDirString,
-    SpectrumReceiver *spectrumReceiver,
-    QObject *parent)
-: QObject(parent) {
+PacketDecoder::PacketDecoder(
+    QString logDirString, QString downloadDirString, SpectrumReceiver *spectrumReceiver, QObject *parent)
+: QObject(parent), archive_priv(logDirString), archiveFlushTimer_priv(this) {
     this->logDirString = logDirString;
-    this->fileName = fileName;
     this->prefix = "startup";
     this->downloadDirString = downloadDirString;
     this->spectrumReceiver_priv = spectrumReceiver;
@@ -32,6 +29,9 @@ PacketDecoder::PacketDecoder(QString logDirString,
     fileDownload_priv.reset(new FileDownload("INITIAL_INVALID", 1, s1obc::FileType_Deleted));
     fileDownload_priv.data()->isFinished = true;
 
+    FecDecoder::initTables();
+    fecPool_priv.setMaxThreadCount(std::max(1, QThread::idealThreadCount() - 1));
+
     QObject::connect(&syncTimeoutTimer_priv, &QTimer::timeout, [this]() {
         qInfo() << "No packet received in time, waiting for sync packet";
         if (fileDownload_priv.data() && !fileDownload_priv.data()->isFinished) {
@@ -52,6 +52,11 @@ PacketDecoder::PacketDecoder(QString logDirString,
     });
     QTimer::singleShot(1000, [this]() { this->waitForSyncPacket(); });
     syncTimeoutTimer_priv.setSingleShot(true);
+
+    // The timer is a child of the decoder, so it moves to the decoder thread together with it and flush() runs on the
+    // same thread as append()
+    QObject::connect(&archiveFlushTimer_priv, &QTimer::timeout, this, [this]() { archive_priv.flush(); });
+    archiveFlushTimer_priv.start(PacketArchiveWriter::flushIntervalMs);
 }
 
 /**
@@ -107,261 +112,37 @@ void PacketDecoder::manualPacketInput(QString source, QString packetUpperHexStri
             return;
         }
         QByteArray received = QByteArray::fromHex(packetUpperHexString.toLocal8Bit());
-        processDecodedPacket(QDateTime::currentDateTimeUtc(), source, "PRE-DECODED", received, 0, packetUpperHexString);
+        processDecodedPacket(
+            QDateTime::currentDateTimeUtc(), source, "PRE-DECODED", received, 0, -1, packetUpperHexString);
     }
 }
 
 /**
- * @brief Takes an s1obc::SolarPanelTelemetryPacket and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processTelemetry1(const s1obc::SolarPanelTelemetryPacket &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry1) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Telemetry1 ===";
-    SolarPanelTelemetry spfront = packet.front();
-    SolarPanelTelemetry spback = packet.back();
-    SolarPanelTelemetry spright = packet.right();
-    SolarPanelTelemetry spleft = packet.left();
-    SolarPanelTelemetry sptop = packet.top();
-    SolarPanelTelemetry spbottom = packet.bottom();
-
-    QString first = QString(
-        "--- Front " + getDTSFromUint32UTC(spfront.timestamp()) + " ---\n" + extractSolarPanelTelemetry(spfront));
-    QString second =
-        QString("--- Back " + getDTSFromUint32UTC(spback.timestamp()) + " ---\n" + extractSolarPanelTelemetry(spback));
-    QString third = QString(
-        "--- Right " + getDTSFromUint32UTC(spright.timestamp()) + " ---\n" + extractSolarPanelTelemetry(spright));
-    QString fourth =
-        QString("--- Left " + getDTSFromUint32UTC(spleft.timestamp()) + " ---\n" + extractSolarPanelTelemetry(spleft));
-    QString fifth =
-        QString("--- Top " + getDTSFromUint32UTC(sptop.timestamp()) + " ---\n" + extractSolarPanelTelemetry(sptop));
-    QString sixth = QString(
-        "--- Bottom " + getDTSFromUint32UTC(spbottom.timestamp()) + " ---\n" + extractSolarPanelTelemetry(spbottom));
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n" + third + "\n" + fourth + "\n" + fifth + "\n" +
-                       sixth + "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::PcuTelemetryPacket and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processTelemetry2(const s1obc::PcuTelemetryPacket &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry2) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Telemetry2 ===";
-    PcuDeploymentTelemetry pcu1D = packet.deployment1();
-    PcuDeploymentTelemetry pcu2D = packet.deployment2();
-    PcuBatteryTelemetry pcu1Ba = packet.battery1();
-    PcuBatteryTelemetry pcu2Ba = packet.battery2();
-    PcuBusTelemetry pcu1Bu = packet.bus1();
-    PcuBusTelemetry pcu2Bu = packet.bus2();
-    PcuSdcTelemetry pcu1S = packet.sdc1();
-    PcuSdcTelemetry pcu2S = packet.sdc2();
-
-    QString first = QString(
-        "--- PCU1Depl " + getDTSFromUint32UTC(pcu1D.timestamp()) + " ---\n" + extractPCUDeploymentTelemetry(pcu1D));
-    QString second = QString(
-        "--- PCU2Depl " + getDTSFromUint32UTC(pcu2D.timestamp()) + " ---\n" + extractPCUDeploymentTelemetry(pcu2D));
-    QString third = QString(
-        "--- PCU1Battery " + getDTSFromUint32UTC(pcu1Ba.timestamp()) + " ---\n" + extractPCUBatteryTelemetry(pcu1Ba));
-    QString fourth = QString(
-        "--- PCU2Battery " + getDTSFromUint32UTC(pcu2Ba.timestamp()) + " ---\n" + extractPCUBatteryTelemetry(pcu2Ba));
-    QString fifth =
-        QString("--- PCU1Bus " + getDTSFromUint32UTC(pcu1Bu.timestamp()) + " ---\n" + extractPCUBusTelemetry(pcu1Bu));
-    QString sixth =
-        QString("--- PCU2Bus " + getDTSFromUint32UTC(pcu2Bu.timestamp()) + " ---\n" + extractPCUBusTelemetry(pcu2Bu));
-    QString seventh =
-        QString("--- PCU1SDC " + getDTSFromUint32UTC(pcu1S.timestamp()) + " ---\n" + extractPCUSDCTelemetry(pcu1S));
-    QString eighth =
-        QString("--- PCU2SDC " + getDTSFromUint32UTC(pcu2S.timestamp()) + " ---\n" + extractPCUSDCTelemetry(pcu2S));
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n" + third + "\n" + fourth + "\n" + fifth + "\n" +
-                       sixth + "\n" + seventh + "\n" + eighth + "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::PcuTelemetryPacket and processes it for ATL1, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processTelemetry2A(const s1obc::PcuTelemetryPacket &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry2) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Telemetry2 ===";
-    PcuDeploymentTelemetry pcu1D = packet.deployment1();
-    PcuDeploymentTelemetry pcu2D = packet.deployment2();
-    PcuBusTelemetry pcu1Bu = packet.bus1();
-    PcuBusTelemetry pcu2Bu = packet.bus2();
-    PcuSdcTelemetry pcu1S = packet.sdc1();
-    PcuSdcTelemetry pcu2S = packet.sdc2();
-
-    QString first = QString(
-        "--- PCU1Depl " + getDTSFromUint32UTC(pcu1D.timestamp()) + " ---\n" + extractPCUDeploymentTelemetry(pcu1D));
-    QString second = QString(
-        "--- PCU2Depl " + getDTSFromUint32UTC(pcu2D.timestamp()) + " ---\n" + extractPCUDeploymentTelemetry(pcu2D));
-    QString fifth =
-        QString("--- PCU1Bus " + getDTSFromUint32UTC(pcu1Bu.timestamp()) + " ---\n" + extractPCUBusTelemetry(pcu1Bu));
-    QString sixth =
-        QString("--- PCU2Bus " + getDTSFromUint32UTC(pcu2Bu.timestamp()) + " ---\n" + extractPCUBusTelemetry(pcu2Bu));
-    QString seventh =
-        QString("--- PCU1SDC " + getDTSFromUint32UTC(pcu1S.timestamp()) + " ---\n" + extractPCUSDCTelemetry(pcu1S));
-    QString eighth =
-        QString("--- PCU2SDC " + getDTSFromUint32UTC(pcu2S.timestamp()) + " ---\n" + extractPCUSDCTelemetry(pcu2S));
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n" + fifth + "\n" + sixth + "\n" + seventh + "\n" +
-                       eighth + "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::OnboardTelemetryPacket and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processTelemetry3(const s1obc::OnboardTelemetryPacket &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry3) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Telemetry3 ===";
-    ObcTelemetry obc = packet.obc();
-    ComTelemetry com = packet.com();
-    TidTelemetry tid1 = packet.tid1();
-    TidTelemetry tid2 = packet.tid2();
-
-    QString first = "--- OBC ---\n" + extractOBCTelemetry(obc);
-    QString second = "--- COM " + getDTSFromUint32UTC(com.timestamp()) + " ---\n" + extractCOMTelemetry(com);
-    QString third = "--- TID1 " + getDTSFromUint32UTC(tid1.timestamp()) + " ---\n" + extractTIDTelemetry(tid1);
-    QString fourth = "--- TID2 " + getDTSFromUint32UTC(tid2.timestamp()) + " ---\n" + extractTIDTelemetry(tid2);
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n" + third + "\n" + fourth + "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::OnboardTelemetryPacketPA and processes it for SMOGP, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processTelemetry3P(const s1obc::OnboardTelemetryPacketPA &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry3) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Telemetry3 ===";
-    ObcTelemetryPA obc = packet.obc();
-    ComTelemetry com = packet.com();
-    TidTelemetry tid1 = packet.tid1();
-    TidTelemetry tid2 = packet.tid2();
-
-    QString first = "--- OBC ---\n" + extractOBCTelemetryPA(obc);
-    QString second = "--- COM " + getDTSFromUint32UTC(com.timestamp()) + " ---\n" + extractCOMTelemetry(com);
-    QString third = "--- TID1 " + getDTSFromUint32UTC(tid1.timestamp()) + " ---\n" + extractTIDTelemetry(tid1);
-    QString fourth = "--- TID2 " + getDTSFromUint32UTC(tid2.timestamp()) + " ---\n" + extractTIDTelemetry(tid2);
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n" + third + "\n" + fourth + "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::OnboardTelemetryPacketPA and processes it for ATL1, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processTelemetry3A(const s1obc::OnboardTelemetryPacketPA &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry3) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Telemetry3 ===";
-    ObcTelemetryPA obc = packet.obc();
-    ComTelemetry com = packet.com();
-
-    QString first = "--- OBC ---\n" + extractOBCTelemetryPA(obc);
-    QString second = "--- COM " + getDTSFromUint32UTC(com.timestamp()) + " ---\n" + extractCOMTelemetry(com);
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::BeaconPacket and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processBeacon(const s1obc::BeaconPacket &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Beacon) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Beacon ===";
-    DiagnosticInfo diagnostic = packet.diagnosticInfo();
-
-    QString first = "--- DiagnosticInfo ---\n" + extractDiagnosticTelemetry(diagnostic);
-    BeaconMessage beacon = packet.message();
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + QString(reinterpret_cast<const char *>(beacon.characters)) + "\n\n" + first +
-                       "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::BeaconPacketPA and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processBeaconPA(const s1obc::BeaconPacketPA &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Beacon) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Beacon ===";
-    DiagnosticInfoPA diagnostic = packet.diagnosticInfo();
-
-    QString first = "--- DiagnosticInfo ---\n" + extractDiagnosticTelemetryPA(diagnostic);
-    BeaconMessage beacon = packet.message();
-    auto ack = packet.acknowledgedCommands();
-    QString ackLine = "ACK: " + processAcknowledgedCommands(ack);
-    QString allLines = zeroth + "\n\n" + QString(reinterpret_cast<const char *>(beacon.characters)) + "\n\n" + first +
-                       "\n\n" + ackLine;
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::SpectrumPacket and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
+ * @brief Processes acknowledged commands (s1obc::AcknowledgedCommands): Updates the last command id and emits
+ * PacketDecoder::newCommandAcknowledged() for each of them
+ * @param commands The commands to process
  */
-QString PacketDecoder::processSpectrumData(const s1obc::SpectrumPacket &packet) {
+void PacketDecoder::handleAcknowledgedCommands(const s1obc::AcknowledgedCommands &commands) {
     using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_SpectrumResult) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Spectrum ===";
-    uint8_t pi = packet.index();
-    uint8_t pc = packet.count();
-
-    emit newSpectrumPacket(packet);
-
-    QString allLines = zeroth + "\n\n" + QString("Part: %1 / %2").arg(pi + 1).arg(pc);
-    return allLines;
+    for (size_t i = 0; i < AcknowledgedCommands::max; i++) {
+        auto ackUplinkId = commands.commands[i].commandId();
+        newCommandId(ackUplinkId);
+        emit newCommandAcknowledged(ackUplinkId, getDateTimeString(QDateTime::currentDateTimeUtc()));
+    }
 }
 
 /**
- * @brief Takes an s1obc::FileDownloadPacket and processes it, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
+ * @brief Takes an s1obc::FileDownloadPacket and adds its fragment to the file that is being downloaded
+ * @param packet View of the packet
  */
-QString PacketDecoder::processFileDownload(const s1obc::FileDownloadPacket &packet) {
+void PacketDecoder::addFileFragment(const s1utils::PackView<s1obc::FileDownloadPacket> &packet) {
     using namespace s1obc;
-    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_FileDownload) == packet.packetType());
+    Q_ASSERT(s1obc::DownlinkPacketType_FileDownload == packet.get<0>());
     static constexpr size_t maxDataLength = FileDownloadData::maxLengthPerPacket;
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === FileDownload ===";
 
-    auto fe = packet.entry();
-    auto pc = packet.count();
-    auto pi = packet.index();
+    auto fe = packet.get<4>();
+    auto pc = packet.get<3>();
+    auto pi = packet.get<2>();
 
     // The second condition ensures that even if we miss the fragment with a 0 pi, we'll start a new file upon the
     // reception of a fragment
@@ -393,7 +174,7 @@ QString PacketDecoder::processFileDownload(const s1obc::FileDownloadPacket &pack
     }
     uint32_t filesize = fe.FileEntry::size();
     auto downloadsize = std::min(filesize - (pi * maxDataLength), maxDataLength);
-    QByteArray downloadbytes(reinterpret_cast<const char *>(packet.data().bytes), (int) downloadsize);
+    QByteArray downloadbytes(reinterpret_cast<const char *>(packet.itemBinary<5>()), (int) downloadsize);
 
     fileDownload_priv.data()->addFragment(pi, downloadbytes);
 
@@ -406,318 +187,6 @@ QString PacketDecoder::processFileDownload(const s1obc::FileDownloadPacket &pack
             // a partial file may have been created
         }
     }
-
-    QString allLines = zeroth + "\n\n" + fileEntryToQString(fe) + "\n" + QString("Part: %1 / %2").arg(pi + 1).arg(pc);
-    return allLines;
-}
-
-/**
- * @brief Takes an s1obc::BatteryPacketA and processes it for ATL1, returning the resulting QString
- * @param packet The packet
- * @return The QString that represents the packet's contents in an easily readable format.
- */
-QString PacketDecoder::processBattery(const s1obc::BatteryPacketA &packet) {
-    using namespace s1obc;
-    Q_ASSERT(static_cast<uint8_t>(s1obc::DownlinkPacketType_Telemetry3_A) == packet.packetType());
-    QString zeroth = getDTSFromUint32UTC(packet.timestamp()) + " === Battery telemetry ===";
-    BatteryTelemetryA panel1 = packet.panel1();
-    BatteryTelemetryA panel2 = packet.panel2();
-    BatteryTelemetryA panel3 = packet.panel3();
-    BatteryTelemetryA panel4 = packet.panel4();
-
-    QString first = getDTSFromUint32UTC(panel1.timestamp()) + "--- Panel 1 ---\n" + extractBatteryTelemetryA(panel1, 1);
-    QString second =
-        getDTSFromUint32UTC(panel2.timestamp()) + "--- Panel 2 ---\n" + extractBatteryTelemetryA(panel2, 2);
-    QString third = getDTSFromUint32UTC(panel3.timestamp()) + "--- Panel 3 ---\n" + extractBatteryTelemetryA(panel3, 3);
-    QString fourth =
-        getDTSFromUint32UTC(panel4.timestamp()) + "--- Panel 4 ---\n" + extractBatteryTelemetryA(panel4, 4);
-    QString allLines = zeroth + "\n\n" + first + "\n" + second + "\n" + third + "\n" + fourth + "\n";
-    return allLines;
-}
-
-/**
- * @brief Creates the QString representation of a solar panel (s1obc::SolarPanelTelemetry)
- * @param panel The solar panel to process
- * @return The QString representation
- */
-QString PacketDecoder::extractSolarPanelTelemetry(const s1obc::SolarPanelTelemetry &panel) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\tT[°C]:" + QString::number((panel.temperature_C10()) / 10.0);
-    ret += " Ii[mA]:" + QString::number(panel.inputCurrent_mA());
-    ret += " Io[mA]:" + QString::number(panel.outputCurrent_mA());
-    ret += " Vi[mV]:" + QString::number(panel.inputVoltage_mV());
-    ret += " Vo[mV]:" + QString::number(panel.outputVoltage_mV());
-    ret += " LSR[mV]:" + QString::number(panel.lightSensorReading_mV());
-    ret += " Status:" + QString::number(static_cast<uint8_t>(panel.status().antennaStatus()));
-    return ret;
-}
-
-/**
- * @brief Processes acknowledged commands (s1obc::AcknowledgedCommands) and creates the QString representation
- * @param commands The commands to process
- * @return The QString representation
- */
-QString PacketDecoder::processAcknowledgedCommands(const s1obc::AcknowledgedCommands &commands) {
-    using namespace s1obc;
-    QString ret;
-    for (size_t i = 0; i < AcknowledgedCommands::max; i++) {
-        auto ack = commands.commands[i];
-        auto ackUplinkId = ack.commandId();
-        newCommandId(ackUplinkId);
-        ret += QString::number(ackUplinkId);
-        ret += "(" + QString::number(commands.commands[i].receivedRssi()) + " dBm) ";
-        emit newCommandAcknowledged(ackUplinkId, getDateTimeString(QDateTime::currentDateTimeUtc()));
-    }
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a PCU deployment telemetry segment (s1obc::PcuDeploymentTelemetry)
- * @param panel The PCU deployment telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractPCUDeploymentTelemetry(const s1obc::PcuDeploymentTelemetry &deployment) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\tDEPSW1:" + QString::number(deployment.status().switch1());
-    ret += " DEPSW2:" + QString::number(deployment.status().switch2());
-    ret += " RBF:" + QString::number(deployment.status().removeBeforeFlight());
-    ret += " Deployment:" + QString::number(deployment.status().pcuDeploymentFlag());
-    ret += " Antenna open:" + QString::number(deployment.status().pcuAntennaFlag());
-    ret += " Boot counter:" + QString::number(deployment.pcuBootCounter());
-    ret += " Uptime[m]:" + QString::number(deployment.pcuUptimeMinutes());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a PCU battery telemetry segment (s1obc::PcuDeploymentTelemetry)
- * @param battery The PCU battery telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractPCUBatteryTelemetry(const s1obc::PcuBatteryTelemetry &battery) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\tV[mV]:" + QString::number(battery.voltage_mV());
-    ret += " Ic[mA]:" + QString::number(battery.chargeCurrent_mA());
-    ret += " Idc[mA]:" + QString::number(battery.dischargeCurrent_mA());
-    ret += " Charge:" + QString::number(battery.status().isChargeEnabled());
-    ret += " Discharge:" + QString::number(battery.status().isDischargeEnabled());
-    ret += "\n\tCharge Overcurrent:" + QString::number(battery.status().chargeOvercurrent());
-    ret += " Charge Overvoltage:" + QString::number(battery.status().chargeOvervoltage());
-    ret += " Discharge overcurrent:" + QString::number(battery.status().dischargeOvercurrent());
-    ret += " Discharge overvoltage:" + QString::number(battery.status().dischargeOvervoltage());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a PCU bus telemetry segment (s1obc::PcuDeploymentTelemetry)
- * @param battery The PCU bus telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractPCUBusTelemetry(const s1obc::PcuBusTelemetry &bus) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\tRBV[mV]:" + QString::number(bus.regulatedBusVoltage_mV());
-    ret += " URBV[mV]:" + QString::number(bus.unregulatedBusVoltage_mV());
-    ret += " OBC1I[mA]:" + QString::number(bus.obc1CurrentConsumption_mA());
-    ret += " OBC2I[mA]:" + QString::number(bus.obc2CurrentConsumption_mA());
-    ret += "\n\tOBC1 Limiter overcurrent:" + QString::number(bus.status().obc1Overcurrent());
-    ret += " OBC2 Limiter overcurrent:" + QString::number(bus.status().obc2Overcurrent());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a PCU SDC telemetry segment (s1obc::PcuDeploymentTelemetry)
- * @param battery The PCU SDC telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractPCUSDCTelemetry(const s1obc::PcuSdcTelemetry &sdc) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\t1Ii[mA]:" + QString::number(sdc.chain1InputCurrent_mA());
-    ret += " 1Io[mA]:" + QString::number(sdc.chain1OutputCurrent_mA());
-    ret += " 1Vo[mV]:" + QString::number(sdc.chain1OutputVoltage_mV());
-    ret += " 2Ii[mA]:" + QString::number(sdc.chain2InputCurrent_mA());
-    ret += " 2Io[mA]:" + QString::number(sdc.chain2OutputCurrent_mA());
-    ret += " 2Vo[mV]:" + QString::number(sdc.chain2OutputVoltage_mV());
-    ret += "\n\t1Overcurrent:" + QString::number(sdc.status().chain1Overcurrent());
-    ret += " 1Overvoltage:" + QString::number(sdc.status().chain1Overvoltage());
-    ret += " 2Overcurrent:" + QString::number(sdc.status().chain2Overcurrent());
-    ret += " 2Overvoltage:" + QString::number(sdc.status().chain1Overvoltage());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of an OBC telemetry segment (s1obc::ObcTelemetry)
- * @param battery The OBC telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractOBCTelemetry(const s1obc::ObcTelemetry &obc) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\tT[°C]:" + QString::number((obc.activeObcTemperature_C10()) / 10.0);
-    ret += " V[mV]:" + QString::number(obc.supplyVoltage_mV());
-    ret += " RTCC1T[°C]:" + QString::number((obc.rtcc1Temperature_C10()) / 10.0);
-    ret += " RTCC2T[°C]:" + QString::number((obc.rtcc2Temperature_C10()) / 10.0);
-    ret += " EPS2T1[°C]:" + QString::number((obc.eps2PanelATemperature1_C10()) / 10.0);
-    ret += " EPS2T2[°C]:" + QString::number((obc.eps2PanelATemperature2_C10()) / 10.0);
-    ret += "\n\tCOMItx[mA]:" + QString::number(obc.comTxCurrent_mA());
-    ret += " COMIrx[mA]:" + QString::number(obc.comRxCurrent_mA());
-    ret += " COMTXPL:" + QString::number(obc.comTxStatus().powerLevel(), 16);
-    ret += " COMTXDR:" + QString::number(obc.comTxStatus().dataRate(), 16);
-    ret += "\n\tMotion1:";
-    ret += "\n\t\tGyroscopeX[°/sec]" + QString::number(obc.motionSensor1().gyroscope().x(), 10);
-    ret += "\n\t\tGyroscopeY[°/sec]" + QString::number(obc.motionSensor1().gyroscope().y(), 10);
-    ret += "\n\t\tGyroscopeZ[°/sec]" + QString::number(obc.motionSensor1().gyroscope().z(), 10);
-    ret += "\n\t\tMagnetometerX[uT]" + QString::number(obc.motionSensor1().magnetometer().x(), 10);
-    ret += "\n\t\tMagnetometerY[uT]" + QString::number(obc.motionSensor1().magnetometer().y(), 10);
-    ret += "\n\t\tMagnetometerZ[uT]" + QString::number(obc.motionSensor1().magnetometer().z(), 10);
-    ret += "\n\t\tAccelerometerX[g]" + QString::number(obc.motionSensor1().accelerometer().x(), 10);
-    ret += "\n\t\tAccelerometerY[g]" + QString::number(obc.motionSensor1().accelerometer().y(), 10);
-    ret += "\n\t\tAccelerometerZ[g]" + QString::number(obc.motionSensor1().accelerometer().z(), 10);
-    ret += "\n\tMotion2:";
-    ret += "\n\t\tGyroscopeX[°/sec]" + QString::number(obc.motionSensor2().gyroscope().x(), 10);
-    ret += "\n\t\tGyroscopeY[°/sec]" + QString::number(obc.motionSensor2().gyroscope().y(), 10);
-    ret += "\n\t\tGyroscopeZ[°/sec]" + QString::number(obc.motionSensor2().gyroscope().z(), 10);
-    ret += "\n\t\tMagnetometerX[uT]" + QString::number(obc.motionSensor2().magnetometer().x(), 10);
-    ret += "\n\t\tMagnetometerY[uT]" + QString::number(obc.motionSensor2().magnetometer().y(), 10);
-    ret += "\n\t\tMagnetometerZ[uT]" + QString::number(obc.motionSensor2().magnetometer().z(), 10);
-    ret += "\n\t\tAccelerometerX[g]" + QString::number(obc.motionSensor2().accelerometer().x(), 10);
-    ret += "\n\t\tAccelerometerY[g]" + QString::number(obc.motionSensor2().accelerometer().y(), 10);
-    ret += "\n\t\tAccelerometerZ[g]" + QString::number(obc.motionSensor2().accelerometer().z(), 10);
-    ret += "\n\tOBC:" + QString::number(obc.obcBoardStatus().activeObc());
-    ret += " COM:" + QString::number(obc.obcBoardStatus().activeCom());
-    ret += " Flash1:" + QString::number(obc.obcBoardStatus().flash1Status());
-    ret += " Flash2:" + QString::number(obc.obcBoardStatus().flash2Status());
-    ret += " RTCC1:" + QString::number(obc.obcBoardStatus().rtcc1Status());
-    ret += " RTCC2:" + QString::number(obc.obcBoardStatus().rtcc2Status());
-    ret += " MS1:" + QString::number(obc.obcBoardStatus().motionSensor1Status());
-    ret += " MS2:" + QString::number(obc.obcBoardStatus().motionSensor2Status());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of an OBC telemetry segment (s1obc::ObcTelemetryPA)
- * @param battery The OBC telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractOBCTelemetryPA(const s1obc::ObcTelemetryPA &obc) {
-    using namespace s1obc;
-    QString ret;
-    ret += " V[mV]:" + QString::number(obc.supplyVoltage_mV());
-    ret += " RTCCT[°C]:" + QString::number(obc.rtccTemperature_C());
-    ret += " EPS2T1[°C]:" + QString::number((obc.eps2PanelATemperature1_C10()) / 10.0);
-    ret += " EPS2T2[°C]:" + QString::number((obc.eps2PanelATemperature2_C10()) / 10.0);
-    ret += "\n\tCOMItx[mA]:" + QString::number(obc.comTxCurrent_mA());
-    ret += " COMIrx[mA]:" + QString::number(obc.comRxCurrent_mA());
-    ret += " COMTXDR:" + QString::number(obc.comTxStatus().dataRate(), 16);
-    ret += "\n\tMotion:";
-    ret += "\n\t\tGyroscopeX[°/sec]" + QString::number(obc.motionSensor().gyroscope().x(), 10);
-    ret += "\n\t\tGyroscopeY[°/sec]" + QString::number(obc.motionSensor().gyroscope().y(), 10);
-    ret += "\n\t\tGyroscopeZ[°/sec]" + QString::number(obc.motionSensor().gyroscope().z(), 10);
-    ret += "\n\t\tMagnetometerX[uT]" + QString::number(obc.motionSensor().magnetometer().x(), 10);
-    ret += "\n\t\tMagnetometerY[uT]" + QString::number(obc.motionSensor().magnetometer().y(), 10);
-    ret += "\n\t\tMagnetometerZ[uT]" + QString::number(obc.motionSensor().magnetometer().z(), 10);
-    ret += "\n\t\tAccelerometerX[g]" + QString::number(obc.motionSensor().accelerometer().x(), 10);
-    ret += "\n\t\tAccelerometerY[g]" + QString::number(obc.motionSensor().accelerometer().y(), 10);
-    ret += "\n\t\tAccelerometerZ[g]" + QString::number(obc.motionSensor().accelerometer().z(), 10);
-    ret += "\n\tOBC:" + QString::number(obc.obcBoardStatus().activeObc());
-    ret += " COM:" + QString::number(obc.obcBoardStatus().activeCom());
-    ret += " Flash:" + QString::number(obc.obcBoardStatus().flashStatus());
-    ret += " RTCC:" + QString::number(obc.obcBoardStatus().rtccStatus());
-    ret += " MS:" + QString::number(obc.obcBoardStatus().motionSensorStatus());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a COM telemetry segment (s1obc::ComTelemetry)
- * @param battery The COM telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractCOMTelemetry(const s1obc::ComTelemetry &com) {
-    using namespace s1obc;
-    auto spStatus = com.spectrumAnalyzerStatus();
-    QString ret;
-    ret += "\tT[°C]:" + QString::number((com.activeComTemperature_C10()) / 10.0);
-    ret += " V[mV]:" + QString::number(com.activeComVoltage_mV());
-    ret += " LRSSI:" + QString::number(com.lastReceivedRssi());
-    ret += " SWR:" + QString::number(com.swrBridgeReading());
-    ret += " Spectrum:" + QString::number(spStatus & 0x01);
-    ret += " Spectrum V[mV]:" + QString::number((spStatus >> 1) * 30);
-    ret += " Spectrum T[°C]:" + QString::number((com.activeComSpectrumAnalyzerTemperature_C10()) / 10.0);
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a TID telemetry segment (s1obc::TidTelemetry)
- * @param tid The TID telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractTIDTelemetry(const s1obc::TidTelemetry &tid) {
-    using namespace s1obc;
-    QString ret;
-    ret += "\tT[°C]:" + QString::number((tid.temperature_C10()) / 10.0);
-    ret += " Supply voltage[mV]:" + QString::number(tid.supplyVoltage_mV());
-    ret += " R1[uV]:" + QString::number(tid.radfet1_uV());
-    ret += " R2[uV]:" + QString::number(tid.radfet2_uV());
-    ret += " SN:" + QString::number(tid.measurementSerial());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a DiagnosticInfo telemetry segment (s1obc::DiagnosticInfo)
- * @param diagnostic The Diagnostic telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractDiagnosticTelemetry(const s1obc::DiagnosticInfo &diagnostic) {
-    using namespace s1obc;
-    QString ret;
-    ret += ";Flashchecksum:" + QString::number(diagnostic.flashChecksum());
-    ret += ";LastUplinkTimestamp:" + getDTSFromUint32UTC(diagnostic.lastUplinkTimestamp());
-    ret += ";OBCUptime[Min]:" + QString::number(diagnostic.obcUptimeMin());
-    ret += ";COMUptime[Min]:" + QString::number(diagnostic.comUptimeMin());
-    ret += ";TXVoltageDrop[mV]:" + QString::number((diagnostic.txVoltageDrop_10mV()) * 10.0);
-    ret += ";TaskCount:" + QString::number(diagnostic.taskCount());
-    ret += ";EnergyMode:" + QString::number(diagnostic.diagnosticStatus().energyMode());
-    ret += ";TCXO works:" + QString::number(diagnostic.diagnosticStatus().tcxoWorks());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a DiagnosticInfoPA telemetry segment (s1obc::DiagnosticInfoPA)
- * @param diagnostic The Diagnostic telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractDiagnosticTelemetryPA(const s1obc::DiagnosticInfoPA &diagnostic) {
-    using namespace s1obc;
-    QString ret;
-    ret += ";ValidPackets:" + QString::number(diagnostic.validPackets());
-    ret += ";WrongSizedPackets:" + QString::number(diagnostic.wrongSizedPackets());
-    ret += ";PacketsWithFailedGolay:" + QString::number(diagnostic.packetsWithFailedGolayDecoding());
-    ret += ";PacketsWithWrongSignature:" + QString::number((diagnostic.packetsWithWrongSignature()) * 10.0);
-    ret += ";PacketsWithInvalidSerial:" + QString::number(diagnostic.packetsWithInvalidSerialNumber());
-    ret += ";UARTErrorCounter:" + QString::number(diagnostic.uartErrorCounter());
-    return ret;
-}
-
-/**
- * @brief Creates the QString representation of a BatteryTelemetryA telemetry segment (s1obc::BatteryTelemetryA)
- * @param diagnostic The Diagnostic telemetry segment to process
- * @return The QString representation
- */
-QString PacketDecoder::extractBatteryTelemetryA(const s1obc::BatteryTelemetryA &battery, uint8_t panel) {
-    using namespace s1obc;
-    QString ret;
-    ret += "Valid:" + QString::number(battery.valid());
-    ret += " ;One-wire bus:" + QString::number(battery.oneWireBus() + 1);
-    ret += " ;Current [mA]:" + QString::number(battery.current_mA()[panel - 1].toInt());
-    ret += " ;T1 [°C]:" + QString::number(battery.temperature1_mC()[panel - 1].toDouble() / 1000.0);
-    ret += " ;T2 [°C]:" + QString::number(battery.temperature2_mC()[panel - 1].toDouble() / 1000.0);
-    ret += " ;T3 [°C]:" + QString::number(battery.temperature3_mC()[panel - 1].toDouble() / 1000.0);
-    ret += " ;T4 [°C]:" + QString::number(battery.temperature4_mC()[panel - 1].toDouble() / 1000.0);
-    ret += " ;T5 [°C]:" + QString::number(battery.temperature5_mC()[panel - 1].toDouble() / 1000.0);
-    return ret;
 }
 
 /**
@@ -764,128 +233,71 @@ void PacketDecoder::startSyncPacketTimeout(unsigned int datarateBPS, s1sync::Ope
 }
 
 /**
- * @brief Decodes \p encodedData with AO40 short and returns the result.
- * @param encodedData The QByteArray containing the encoded data.
- * @return Returns a DecodedPacket that contains the result of the operation.
+ * @brief Sends a received frame to the FEC pool. The result is processed by PacketDecoder::fecJobFinished
+ * @param timestamp Timestamp of reception
+ * @param source Source of the packet
+ * @param encoding Encoding of the packet
+ * @param received The received, encoded frame
+ * @param rssi The RSSI that the packet was received with
+ * @param position Position in the recording that the packet was decoded from, -1 if it was not
+ * @param originalString The packet as an upper hex string
  */
-const DecodedPacket PacketDecoder::decodeWithAO40SHORT(const QByteArray encodedData) {
-    uint8_t ao40short_bits[AO40SHORT_DOWNLINKLENGTH * 8];
-    uint8_t ao40short_dec_data[AO40SHORT_DECDOWNLINKLENGTH];
-    int8_t ao40short_error;
-
-    if (encodedData.length() < AO40SHORT_DOWNLINKLENGTH) {
-        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
-    }
-
-    int bi = 0;
-    for (int i = 0; i < AO40SHORT_DOWNLINKLENGTH; i++) {
-        int j;
-        unsigned char t = 0x80;
-        for (j = 0; j < 8; j++) {
-            ao40short_bits[bi] = encodedData[i] & t ? 255 : 0;
-            t >>= 1;
-            bi++;
-        }
-    }
-
-    // bits size doesn't match decode_short_data input
-    // AO40 short decoding
-    ao40short_decode_data(ao40short_bits, ao40short_dec_data, &ao40short_error);
-    QByteArray decoded = QByteArray(reinterpret_cast<char *>(ao40short_dec_data), AO40SHORT_DECDOWNLINKLENGTH);
-
-    return DecodedPacket(
-        (ao40short_error == -1) ? DecodedPacket::Failure : DecodedPacket::Success, 1, &ao40short_error, decoded);
+void PacketDecoder::queueFecJob(const QDateTime &timestamp,
+    const QString &source,
+    const QString &encoding,
+    const QByteArray &received,
+    int rssi,
+    qint64 position,
+    const QString &originalString) {
+    quint64 sequence = nextSequence_priv++;
+    pendingFrames_priv.insert(
+        sequence, {timestamp, source, encoding, rssi, position, originalString, false, false, QByteArray()});
+    fecPool_priv.start(new FecJob(this, sequence, received));
 }
 
 /**
- * @brief Decodes \p encodedData with AO40 long and returns the result.
- * @param encodedData The QByteArray containing the encoded data.
- * @return Returns a DecodedPacket that contains the result of the operation.
+ * @brief Stores the result of an FEC job, then processes (or archives, if it could not be decoded) every finished frame
+ * that no earlier frame is waiting for.
+ *
+ * Frames are processed in the order they were received, because file downloads, spectrum results and the sync
+ * timeout depend on it.
+ *
+ * @param sequence Sequence number of the frame
+ * @param result Result of the decoding
  */
-const DecodedPacket PacketDecoder::decodeWithAO40LONG(const QByteArray encodedData) {
-    uint8_t ao40_bits[AO40_DOWNLINKLENGTH * 8];
-    uint8_t ao40_dec_data[AO40_DECDOWNLINKLENGTH];
-    int8_t ao40_error[2];
-
-    if (encodedData.length() < AO40_DOWNLINKLENGTH) {
-        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
+void PacketDecoder::fecJobFinished(quint64 sequence, const DecodedPacket &result) {
+    auto it = pendingFrames_priv.find(sequence);
+    if (it == pendingFrames_priv.end()) {
+        qWarning() << "FEC result arrived for an unknown frame:" << sequence;
+        return;
     }
-
-    int bi = 0;
-    for (int i = 0; i < AO40_DOWNLINKLENGTH; i++) {
-        int j;
-        unsigned char t = 0x80;
-        for (j = 0; j < 8; j++) {
-            ao40_bits[bi] = encodedData[i] & t ? 255 : 0;
-            t >>= 1;
-            bi++;
+    it->finished = true;
+    it->success = result.getResult() == DecodedPacket::Success;
+    it->decoded = result.getDecodedPacket();
+
+    while (!pendingFrames_priv.isEmpty() && pendingFrames_priv.first().finished) {
+        PendingFrame frame = pendingFrames_priv.take(pendingFrames_priv.firstKey());
+        if (frame.success) {
+            processDecodedPacket(frame.timestamp,
+                frame.source,
+                frame.encoding,
+                frame.decoded,
+                frame.rssi,
+                frame.position,
+                frame.originalString);
         }
-    }
-
-    // AO40 long decoding
-    ao40_decode_data(ao40_bits, ao40_dec_data, ao40_error);
-    QByteArray decoded = QByteArray(reinterpret_cast<char *>(ao40_dec_data), AO40_DECDOWNLINKLENGTH);
-
-    return DecodedPacket(
-        (ao40_error[0] == -1 || ao40_error[1] == -1) ? (DecodedPacket::Failure) : (DecodedPacket::Success),
-        2,
-        ao40_error,
-        decoded);
-}
-
-static int findRacoderInputLength(int encodedLength) {
-    if (!encodedLength) {
-        return 0;
-    }
-
-    // The input length is a little less than, or maybe equal to, half of the encoded length
-    encodedLength >>= 1;
-
-    // We know that SMOG only uses racoder with power-of-2 sizes, so we find the closest
-    int ret = 1;
-    while (encodedLength >>= 1) {
-        ret <<= 1;
-    }
-    return ret;
-}
-
-/**
- * @brief Decodes \p encodedData with RA and returns the result.
- * @param encodedData The QByteArray containing the encoded data.
- * @return Returns a DecodedPacket that contains the result of the operation.
- */
-const DecodedPacket PacketDecoder::decodeWithRA(const QByteArray encodedData) {
-    int inputLength = findRacoderInputLength(encodedData.length());
-    ra_index_t ra_length = static_cast<ra_index_t>(inputLength) / sizeof(ra_word_t);
-    ra_length_init(ra_length);
-
-    int encodedSize = ra_code_length * sizeof(ra_word_t);
-    if (encodedSize != encodedData.length()) {
-        qWarning() << "mismatching packet size for racoder: expected:" << encodedSize
-                   << "actual:" << encodedData.length();
-        return DecodedPacket(DecodedPacket::Failure, 0, nullptr, QByteArray());
-    }
-
-    const ra_word_t *ra_encoded_words = reinterpret_cast<const ra_word_t *>(encodedData.data());
-    std::vector<float> ra_encoded_bits(ra_code_length * RA_BITCOUNT, 0.0f);
-    std::vector<ra_word_t> ra_decoded_data(ra_length, 0);
-
-    for (ra_index_t i = 0; i < ra_code_length; i++) {
-        ra_word_t word = ra_encoded_words[i];
-        for (int j = 0; j < RA_BITCOUNT; j++) {
-            if ((word & (1 << j)) == 0) {
-                ra_encoded_bits[RA_BITCOUNT * i + j] = 1.0;
-            }
-            else {
-                ra_encoded_bits[RA_BITCOUNT * i + j] = -1.0;
-            }
+        else {
+            // Frames that could not be decoded are archived without decoded data, so that they can be decoded again
+            archive_priv.append(frame.timestamp,
+                frame.source,
+                frame.encoding,
+                currentSatellite,
+                frame.rssi,
+                QByteArray::fromHex(frame.originalString.toLatin1()),
+                QByteArray(),
+                frame.position);
         }
     }
-
-    ra_decoder_gen(ra_encoded_bits.data(), ra_decoded_data.data(), 20);
-
-    QByteArray decoded = QByteArray(reinterpret_cast<char *>(ra_decoded_data.data()), inputLength);
-    return DecodedPacket(DecodedPacket::Success, 0, nullptr, decoded);
 }
 
 /**
@@ -904,74 +316,44 @@ const QString PacketDecoder::getDateTimeString(QDateTime datetime) const {
  * @param encoding Encoding of the packet
  * @param decodedPacket The QByteArray containing the decoded data
  * @param rssi The RSSI that the packet was received with
+ * @param position Position in the recording that the packet was decoded from, -1 if it was not
+ * @param originalString The packet as an upper hex string
  */
 void PacketDecoder::processDecodedPacket(const QDateTime &timestamp,
     const QString &source,
     const QString &encoding,
     QByteArray &decodedPacket,
     int rssi,
+    qint64 position,
     QString originalString) {
     emit stopSyncTimeoutTimer();
-    unsigned int packetTypeSize = 0;
-    using namespace s1obc;
     if (!checkForAnomalies(decodedPacket)) {
         return;
     }
-    // Logging to file
-    QFile packetFile(this->logDirString + this->prefix + "_" + this->fileName);
-    packetFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text);
-    if (packetFile.isOpen()) {
-        QTextStream writer(&packetFile);
-        writer << "Timestamp: " << getDateTimeString(timestamp) << "\tSource: " << source
-               << "\tENCODED data: " << originalString << "\n";
-        writer.flush();
-        packetFile.close();
-    }
-    else {
-        qWarning() << "PacketDecoder could not open the file for writing";
-    }
-    uint8_t packetType = static_cast<uint8_t>(decodedPacket.at(0));
-    switch (packetType) {
-    case DownlinkPacketType_Telemetry1:
-        packetTypeSize = sizeof(SolarPanelTelemetryPacket);
-        break;
-    case DownlinkPacketType_Telemetry2:
-        packetTypeSize = sizeof(PcuTelemetryPacket);
-        break;
-    case DownlinkPacketType_Telemetry3:
-        packetTypeSize = sizeof(OnboardTelemetryPacket);
-        break;
-    case DownlinkPacketType_Beacon:
-        packetTypeSize = sizeof(BeaconPacket);
-        break;
-    case DownlinkPacketType_SpectrumResult:
-        packetTypeSize = sizeof(SpectrumPacket);
-        break;
-    case DownlinkPacketType_FileDownload:
-        packetTypeSize = sizeof(FileDownloadPacket);
-        break;
-    case DownlinkPacketType_FileInfo:
-    case DownlinkPacketType_Telemetry1_B:
-    case DownlinkPacketType_Telemetry2_B:
-    case DownlinkPacketType_Telemetry1_A:
-    case DownlinkPacketType_Telemetry2_A:
-    case DownlinkPacketType_Telemetry3_A:
-        packetTypeSize = 128;
-        break;
-    default:
+    // Archiving the frame, the encoded data is kept so that it can be decoded again later
+    archive_priv.append(timestamp,
+        source,
+        encoding,
+        currentSatellite,
+        rssi,
+        QByteArray::fromHex(originalString.toLatin1()),
+        decodedPacket,
+        position);
+
+    const DownlinkHandler *handler = findDownlinkHandler(static_cast<uint8_t>(decodedPacket.at(0)));
+    if (handler == nullptr) {
         // Invalid packet type
         qInfo() << "Invalid packet type";
         startSyncPacketTimeout(dataRate_priv, decodeMode_priv);
         return;
     }
-
-    if (static_cast<unsigned int>(decodedPacket.length()) < packetTypeSize) {
+    if (static_cast<unsigned int>(decodedPacket.length()) < handler->size) {
         // Packet was too short for its type
         qInfo() << "Packet was too short for its type";
         startSyncPacketTimeout(dataRate_priv, decodeMode_priv);
         return;
     }
-    else if (static_cast<unsigned int>(decodedPacket.length()) > packetTypeSize) {
+    else if (static_cast<unsigned int>(decodedPacket.length()) > handler->size) {
         // Packet was too long for its type
         qInfo() << "Packet was too long for its type";
         startSyncPacketTimeout(dataRate_priv, decodeMode_priv);
@@ -984,336 +366,353 @@ void PacketDecoder::processDecodedPacket(const QDateTime &timestamp,
         return;
     }
 #endif // CHECK_SIGNATURE
-    constexpr size_t signatureLength = sizeof(s1obc::DownlinkSignature);
-    if (DownlinkPacketType_Telemetry1 == packetType) {
-        SolarPanelTelemetryPacket p;
-        p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-        QByteArray auth = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-        if (currentSatellite == SatelliteChanger::Satellites::ATL1) {
-            // Front and left panels are swapped in ATL
-            auto old_left = p.left();
-            p.setLeft(p.front());
-            p.setFront(old_left);
-        }
-        QString readableQString = processTelemetry1(p);
-        packetSuccessfullyDecoded(timestamp,
-            source,
-            "Telemetry 1/4",
-            encoding,
-            auth,
-            decodedPacket,
-            readableQString,
-            QVariant::fromValue(p),
-            rssi);
+    const DecodedFrame frame = {timestamp, source, encoding, decodedPacket, rssi, position};
+    if ((this->*handler->handle)(frame)) {
+        startSyncPacketTimeout(dataRate_priv, decodeMode_priv);
     }
-    else if (DownlinkPacketType_Telemetry2 == packetType) {
-        switch (currentSatellite) {
-        case SatelliteChanger::Satellites::SMOG1:
-        case SatelliteChanger::Satellites::SMOGP: {
-            PcuTelemetryPacket p;
-            p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray auth = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQString = processTelemetry2(p);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 2/4",
-                encoding,
-                auth,
-                decodedPacket,
-                readableQString,
-                QVariant::fromValue(p),
-                rssi);
-            break;
-        }
-        case SatelliteChanger::Satellites::ATL1: {
-            PcuTelemetryPacket pa;
-            pa.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray autha = QByteArray(reinterpret_cast<char *>(pa.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQStringa = processTelemetry2A(pa);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 2/4",
-                encoding,
-                autha,
-                decodedPacket,
-                readableQStringa,
-                QVariant::fromValue(pa),
-                rssi);
-            break;
-        }
+}
+
+/**
+ * @brief Returns the entry of the packet type dispatch table that belongs to \p packetType
+ * @param packetType The first byte of a decoded packet
+ * @return The entry, or nullptr if \p packetType is not a downlink packet type
+ */
+const PacketDecoder::DownlinkHandler *PacketDecoder::findDownlinkHandler(uint8_t packetType) {
+    using namespace s1obc;
+    static_assert(sizeof(OnboardTelemetryPacket) == sizeof(OnboardTelemetryPacketPA) &&
+                      sizeof(BeaconPacket) == sizeof(BeaconPacketPA),
+        "The packet variants of the satellites must have the same size");
+    static constexpr DownlinkHandler handlers[] = {
+        {DownlinkPacketType_Telemetry1, sizeof(SolarPanelTelemetryPacket), &PacketDecoder::handleTelemetry1},
+        {DownlinkPacketType_Telemetry2, sizeof(PcuTelemetryPacket), &PacketDecoder::handleTelemetry2},
+        {DownlinkPacketType_Telemetry3, sizeof(OnboardTelemetryPacket), &PacketDecoder::handleTelemetry3},
+        {DownlinkPacketType_Beacon, sizeof(BeaconPacket), &PacketDecoder::handleBeacon},
+        {DownlinkPacketType_SpectrumResult, sizeof(SpectrumPacket), &PacketDecoder::handleSpectrumResult},
+        {DownlinkPacketType_FileDownload, sizeof(FileDownloadPacket), &PacketDecoder::handleFileDownload},
+        {DownlinkPacketType_FileInfo, 128, &PacketDecoder::handlePlainPacket},
+        {DownlinkPacketType_Telemetry1_B, 128, &PacketDecoder::handlePlainPacket},
+        {DownlinkPacketType_Telemetry2_B, 128, &PacketDecoder::handlePlainPacket},
+        {DownlinkPacketType_Telemetry1_A, 128, &PacketDecoder::handlePlainPacket},
+        {DownlinkPacketType_Telemetry2_A, 128, &PacketDecoder::handlePlainPacket},
+        {DownlinkPacketType_Telemetry3_A, sizeof(BatteryPacketA), &PacketDecoder::handlePlainPacket},
+    };
+    for (const auto &handler : handlers) {
+        if (handler.packetType == packetType) {
+            return &handler;
         }
     }
-    else if (DownlinkPacketType_Telemetry3 == packetType) {
-        switch (currentSatellite) {
-        case SatelliteChanger::Satellites::SMOG1: {
-            OnboardTelemetryPacket p;
-            p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray auth = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQString = processTelemetry3(p);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 3/4",
-                encoding,
-                auth,
-                decodedPacket,
-                readableQString,
-                QVariant::fromValue(p),
-                rssi);
-            break;
-        }
-        case SatelliteChanger::Satellites::SMOGP: {
-            OnboardTelemetryPacketPA pp;
-            pp.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray authp = QByteArray(reinterpret_cast<char *>(pp.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQStringp = processTelemetry3P(pp);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 3/4",
-                encoding,
-                authp,
-                decodedPacket,
-                readableQStringp,
-                QVariant::fromValue(pp),
-                rssi);
-            break;
-        }
-        case SatelliteChanger::Satellites::ATL1: {
-            OnboardTelemetryPacketPA pa;
-            pa.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray autha = QByteArray(reinterpret_cast<char *>(pa.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQStringa = processTelemetry3A(pa);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 3/4",
-                encoding,
-                autha,
-                decodedPacket,
-                readableQStringa,
-                QVariant::fromValue(pa),
-                rssi);
-            break;
-        }
-        }
+    return nullptr;
+}
+
+/**
+ * @brief Parses a frame that has been archived earlier into a packet record, see PacketDecoder::parsePacket()
+ * @param frame The archived frame, its byte arrays may point into the archive mapping
+ * @return The record, or a null record if the frame is not a valid packet of its satellite
+ */
+PacketRecord PacketDecoder::parseArchivedFrame(const ArchivedFrame &frame) {
+    // The record outlives the mapping of the archive
+    const QByteArray decoded(frame.decoded.constData(), frame.decoded.size());
+    const DecodedFrame decodedFrame = {
+        frame.timestamp, frame.source, frame.encoding, decoded, frame.rssi, frame.position};
+    return parsePacket(decodedFrame, frame.satellite);
+}
+
+/**
+ * @brief Creates the record of a packet that has been parsed into \p packet, \p packet is also used to render the
+ * readable text
+ * @param frame The decoded frame
+ * @param satellite The satellite that the frame was received for
+ * @param name Name of the packet type
+ * @param packet The parsed packet
+ */
+template <typename TPacket>
+PacketRecord PacketDecoder::makeRecord(const DecodedFrame &frame,
+    SatelliteChanger::Satellites satellite,
+    const QString &name,
+    const TPacket &packet) {
+    return PacketRecord(frame.timestamp,
+        frame.source,
+        name,
+        frame.encoding,
+        satellite,
+        frame.decoded.right(sizeof(s1obc::DownlinkSignature)),
+        frame.decoded,
+        &PacketFormatter::render,
+        QVariant::fromValue(packet),
+        frame.rssi,
+        frame.position);
+}
+
+/**
+ * @brief Parses a decoded frame into a packet record. Has no side effects, the handlers of the packet types do the
+ * rest of the processing.
+ *
+ * Packets that are known to the satellite are parsed into their gadget (see downlink.h), the packets of SMOG-P and
+ * ATL-1 that have no gadget only get a name. The gadget is a copy of the whole packet in the QVariant of the record:
+ * QML, PacketFormatter and TelemetryStore read every property of every packet, so reading them from the bytes on
+ * demand would not save the copy.
+ *
+ * @param frame The decoded frame
+ * @param satellite The satellite that the frame was received for
+ * @return The record, or a null record if the frame is not a valid packet of \p satellite
+ */
+PacketRecord PacketDecoder::parsePacket(const DecodedFrame &frame, SatelliteChanger::Satellites satellite) {
+    using namespace s1obc;
+    if (frame.decoded.isEmpty()) {
+        return PacketRecord();
     }
-    else if (DownlinkPacketType_Beacon == packetType) {
-        waitForSyncPacket();
-        switch (currentSatellite) {
-        case SatelliteChanger::Satellites::SMOG1: {
-            BeaconPacket p;
-            p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray auth = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQString = processBeacon(p);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 4/4",
-                encoding,
-                auth,
-                decodedPacket,
-                readableQString,
-                QVariant::fromValue(p),
-                rssi);
-            break;
-        }
-        case SatelliteChanger::Satellites::SMOGP:
-        case SatelliteChanger::Satellites::ATL1: {
-            BeaconPacketPA ppa;
-            ppa.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray authpa = QByteArray(reinterpret_cast<char *>(ppa.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQStringpa = processBeaconPA(ppa);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "Telemetry 4/4",
-                encoding,
-                authpa,
-                decodedPacket,
-                readableQStringpa,
-                QVariant::fromValue(ppa),
-                rssi);
-            break;
-        }
-        }
+    const uint8_t packetType = static_cast<uint8_t>(frame.decoded.at(0));
+    const DownlinkHandler *handler = findDownlinkHandler(packetType);
+    if (handler == nullptr || static_cast<unsigned int>(frame.decoded.length()) != handler->size) {
+        return PacketRecord();
     }
-    else if (DownlinkPacketType_SpectrumResult == packetType) {
-        SpectrumPacket p;
-        p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-        QByteArray auth = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-        QString readableQString = processSpectrumData(p);
-        QString packetName = QStringLiteral("Spectrum data ") + QString::number(p.index() + 1) + QStringLiteral("/") +
-                             QString::number(p.count());
-        packetSuccessfullyDecoded(timestamp,
-            source,
-            packetName,
-            encoding,
-            auth,
-            decodedPacket,
-            readableQString,
-            QVariant::fromValue(p),
-            rssi);
-        auto pi = p.index();
-        auto pc = p.count();
-        if (pi == pc - 1) {
-            waitForSyncPacket();
-            return; // Returning so that the sync packet timer does not restart
+
+    const bool unset = satellite == SatelliteChanger::Satellites::UNSET;
+    const bool smog1 = satellite == SatelliteChanger::Satellites::SMOG1;
+    const bool smogp = satellite == SatelliteChanger::Satellites::SMOGP;
+    const bool atl1 = satellite == SatelliteChanger::Satellites::ATL1;
+    switch (packetType) {
+    case DownlinkPacketType_Telemetry1: {
+        const s1utils::PackView<SolarPanelTelemetryPacket> view(frame.bytes());
+        SolarPanelTelemetryPacket p = view.load();
+        if (atl1) {
+            // Front and left panels are swapped in ATL
+            p.setLeft(view.get<3>());
+            p.setFront(view.get<5>());
         }
+        return makeRecord(frame, satellite, QStringLiteral("Telemetry 1/4"), p);
     }
-    else if (DownlinkPacketType_FileDownload == packetType) {
-        FileDownloadPacket p;
-        p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-        QByteArray auth = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-        QString readableQString = processFileDownload(p);
-        QString packetName = QStringLiteral("File download ") + QString::number(p.index() + 1) + QStringLiteral("/") +
-                             QString::number(p.count());
-        packetSuccessfullyDecoded(timestamp,
-            source,
-            packetName,
-            encoding,
-            auth,
-            decodedPacket,
-            readableQString,
-            QVariant::fromValue(p),
-            rssi);
-        auto pc = p.count();
-        auto pi = p.index();
-        if (pi == pc - 1) {
-            waitForSyncPacket();
-            return; // Returning so that the sync packet timer does not restart
+    case DownlinkPacketType_Telemetry2:
+        if (unset) {
+            return PacketRecord();
         }
-    }
-    else if (DownlinkPacketType_FileInfo == packetType) {
-        if (currentSatellite == SatelliteChanger::Satellites::ATL1 ||
-            currentSatellite == SatelliteChanger::Satellites::SMOGP) {
-            QByteArray auth = decodedPacket.right(signatureLength);
-            QString packetName = QStringLiteral("File info");
-            packetSuccessfullyDecoded(
-                timestamp, source, packetName, encoding, auth, decodedPacket, "", QVariant::fromValue(false), rssi);
+        return makeRecord(frame,
+            satellite,
+            QStringLiteral("Telemetry 2/4"),
+            s1utils::PackView<PcuTelemetryPacket>(frame.bytes()).load());
+    case DownlinkPacketType_Telemetry3:
+        if (smog1) {
+            return makeRecord(frame,
+                satellite,
+                QStringLiteral("Telemetry 3/4"),
+                s1utils::PackView<OnboardTelemetryPacket>(frame.bytes()).load());
         }
-        else {
-            // Invalid packet type for satellite
+        if (smogp || atl1) {
+            return makeRecord(frame,
+                satellite,
+                QStringLiteral("Telemetry 3/4"),
+                s1utils::PackView<OnboardTelemetryPacketPA>(frame.bytes()).load());
         }
-    }
-    else if (DownlinkPacketType_Telemetry1_B == packetType) {
-        if (currentSatellite == SatelliteChanger::Satellites::SMOGP) {
-            QByteArray auth = decodedPacket.right(signatureLength);
-            QString packetName = QStringLiteral("SMOG-P - Telemetry 1/2");
-            packetSuccessfullyDecoded(
-                timestamp, source, packetName, encoding, auth, decodedPacket, "", QVariant::fromValue(false), rssi);
+        return PacketRecord();
+    case DownlinkPacketType_Beacon:
+        if (smog1) {
+            return makeRecord(frame,
+                satellite,
+                QStringLiteral("Telemetry 4/4"),
+                s1utils::PackView<BeaconPacket>(frame.bytes()).load());
         }
-        else {
-            // Invalid packet type for satellite
+        if (smogp || atl1) {
+            return makeRecord(frame,
+                satellite,
+                QStringLiteral("Telemetry 4/4"),
+                s1utils::PackView<BeaconPacketPA>(frame.bytes()).load());
         }
+        return PacketRecord();
+    case DownlinkPacketType_SpectrumResult: {
+        const s1utils::PackView<SpectrumPacket> view(frame.bytes());
+        return makeRecord(frame,
+            satellite,
+            QStringLiteral("Spectrum data ") + QString::number(view.get<5>() + 1) + QStringLiteral("/") +
+                QString::number(view.get<6>()),
+            view.load());
     }
-    else if (DownlinkPacketType_Telemetry2_B == packetType) {
-        if (currentSatellite == SatelliteChanger::Satellites::SMOGP) {
-            QByteArray auth = decodedPacket.right(signatureLength);
-            QString packetName = QStringLiteral("SMOG-P - Telemetry 2/2");
-            packetSuccessfullyDecoded(
-                timestamp, source, packetName, encoding, auth, decodedPacket, "", QVariant::fromValue(false), rssi);
-        }
-        else {
-            // Invalid packet type for satellite
-        }
+    case DownlinkPacketType_FileDownload: {
+        const s1utils::PackView<FileDownloadPacket> view(frame.bytes());
+        return makeRecord(frame,
+            satellite,
+            QStringLiteral("File download ") + QString::number(view.get<2>() + 1) + QStringLiteral("/") +
+                QString::number(view.get<3>()),
+            view.load());
     }
-    else if (DownlinkPacketType_Telemetry1_A == packetType) {
-        if (currentSatellite == SatelliteChanger::Satellites::ATL1) {
-            QByteArray auth = decodedPacket.right(signatureLength);
-            QString packetName = QStringLiteral("ATL-1 - Telemetry 1/3");
-            packetSuccessfullyDecoded(
-                timestamp, source, packetName, encoding, auth, decodedPacket, "", QVariant::fromValue(false), rssi);
-        }
-        else {
+    case DownlinkPacketType_Telemetry3_A:
+        if (!atl1) {
             // Invalid packet type for satellite
+            return PacketRecord();
         }
+        return makeRecord(frame,
+            satellite,
+            QStringLiteral("ATL-1 - Telemetry 3/3"),
+            s1utils::PackView<BatteryPacketA>(frame.bytes()).load());
+    default:
+        break;
     }
-    else if (DownlinkPacketType_Telemetry2_A == packetType) {
-        if (currentSatellite == SatelliteChanger::Satellites::ATL1) {
-            QByteArray auth = decodedPacket.right(signatureLength);
-            QString packetName = QStringLiteral("ATL-1 - Telemetry 2/3");
-            packetSuccessfullyDecoded(
-                timestamp, source, packetName, encoding, auth, decodedPacket, "", QVariant::fromValue(false), rssi);
-        }
-        else {
-            // Invalid packet type for satellite
-        }
+
+    // Packets that are emitted without being parsed (file info, SMOG-P and ATL-1 telemetry)
+    QString packetName;
+    switch (packetType) {
+    case DownlinkPacketType_FileInfo:
+        packetName = (smogp || atl1) ? QStringLiteral("File info") : QString();
+        break;
+    case DownlinkPacketType_Telemetry1_B:
+        packetName = smogp ? QStringLiteral("SMOG-P - Telemetry 1/2") : QString();
+        break;
+    case DownlinkPacketType_Telemetry2_B:
+        packetName = smogp ? QStringLiteral("SMOG-P - Telemetry 2/2") : QString();
+        break;
+    case DownlinkPacketType_Telemetry1_A:
+        packetName = atl1 ? QStringLiteral("ATL-1 - Telemetry 1/3") : QString();
+        break;
+    case DownlinkPacketType_Telemetry2_A:
+        packetName = atl1 ? QStringLiteral("ATL-1 - Telemetry 2/3") : QString();
+        break;
+    default:
+        break;
     }
-    else if (DownlinkPacketType_Telemetry3_A == packetType) {
-        if (currentSatellite == SatelliteChanger::Satellites::ATL1) {
-            BatteryPacketA p;
-            p.loadBinary(reinterpret_cast<uint8_t *>(decodedPacket.data()));
-            QByteArray authp = QByteArray(reinterpret_cast<char *>(p.signature().bytes), sizeof(DownlinkSignature));
-            QString readableQString = processBattery(p);
-            packetSuccessfullyDecoded(timestamp,
-                source,
-                "ATL-1 - Telemetry 3/3",
-                encoding,
-                authp,
-                decodedPacket,
-                readableQString,
-                QVariant::fromValue(p),
-                rssi);
-        }
-        else {
-            // Invalid packet type for satellite
-        }
+    if (packetName.isNull()) {
+        // Invalid packet type for satellite
+        return PacketRecord();
     }
-    startSyncPacketTimeout(dataRate_priv, decodeMode_priv);
+    return PacketRecord(frame.timestamp,
+        frame.source,
+        packetName,
+        frame.encoding,
+        satellite,
+        frame.decoded.right(sizeof(DownlinkSignature)),
+        frame.decoded,
+        QString(),
+        QVariant::fromValue(false),
+        frame.rssi,
+        frame.position);
 }
 
 /**
- * @brief Called whenever a new packet has been decoded. Emits the packet data (that is received by PacketTableModel and
- * Uploader). Eliminates duplicates from the same source (e.g. SDR demodulates the same packet twice)
- * @param timestamp Timestamp of the packet
- * @param source Source of the packet
- * @param type Type of the packet
- * @param encoding Encoding of the packet
- * @param auth Authentication segment of the packet as a QByteArray (encapsulating a char array)
- * @param decodedData Complete decoded data as a QByteArray (encapsulating a char array)
- * @param readableQString The packets contents in an easily readable format
- * @param rssi The RSSI that the packet was received with
+ * @brief Parses \p frame for the current satellite and emits the record if the packet is valid
  */
-void PacketDecoder::packetSuccessfullyDecoded(QDateTime timestamp,
-    QString source,
-    QString type,
-    QString encoding,
-    QByteArray auth,
-    QByteArray decodedData,
-    QString readableQString,
-    QVariant packet,
-    int rssi) {
+void PacketDecoder::emitRecord(const DecodedFrame &frame) {
+    const PacketRecord record = parsePacket(frame, currentSatellite);
+    if (!record.isNull()) {
+        packetSuccessfullyDecoded(record);
+    }
+}
 
-    QString decodedQString = QString(decodedData.toHex()).toUpper();
-    QString authQString = QString(auth.toHex()).toUpper();
-    if (type.contains("Sync") || recentPackets_priv.take(source) != authQString) {
-        QString satelliteQString;
-        switch (currentSatellite) {
-        case SatelliteChanger::Satellites::SMOG1:
-            satelliteQString = "SMOG-1";
-            break;
-        case SatelliteChanger::Satellites::SMOGP:
-            satelliteQString = "SMOG-P";
-            break;
-        case SatelliteChanger::Satellites::ATL1:
-            satelliteQString = "ATL-1";
-            break;
-        case SatelliteChanger::Satellites::UNSET:
-            satelliteQString = "UNSET";
-            break;
-        }
-        emit newPacket(getDateTimeString(timestamp),
-            source,
-            type,
-            encoding,
-            authQString,
-            satelliteQString,
-            decodedQString,
-            readableQString,
-            packet,
-            rssi);
-        if (!(type.contains("Sync") || source == "QMLMANUAL" ||
-                currentSatellite == SatelliteChanger::Satellites::UNSET)) {
-            emit newPacketMinimal(decodedQString, this->currentSatellite);
+/**
+ * @brief Handles s1obc::SolarPanelTelemetryPacket
+ * @return True, the sync timeout is restarted
+ */
+bool PacketDecoder::handleTelemetry1(const DecodedFrame &frame) {
+    handleAcknowledgedCommands(s1utils::PackView<s1obc::SolarPanelTelemetryPacket>(frame.bytes()).get<8>());
+    emitRecord(frame);
+    return true;
+}
+
+/**
+ * @brief Handles s1obc::PcuTelemetryPacket, every satellite uses the same layout
+ * @return True, the sync timeout is restarted
+ */
+bool PacketDecoder::handleTelemetry2(const DecodedFrame &frame) {
+    if (currentSatellite == SatelliteChanger::Satellites::UNSET) {
+        return true;
+    }
+    handleAcknowledgedCommands(s1utils::PackView<s1obc::PcuTelemetryPacket>(frame.bytes()).get<10>());
+    emitRecord(frame);
+    return true;
+}
+
+/**
+ * @brief Handles s1obc::OnboardTelemetryPacket (SMOG-1) and s1obc::OnboardTelemetryPacketPA (SMOG-P, ATL-1)
+ * @return True, the sync timeout is restarted
+ */
+bool PacketDecoder::handleTelemetry3(const DecodedFrame &frame) {
+    switch (currentSatellite) {
+    case SatelliteChanger::Satellites::SMOG1:
+        handleAcknowledgedCommands(s1utils::PackView<s1obc::OnboardTelemetryPacket>(frame.bytes()).get<6>());
+        break;
+    case SatelliteChanger::Satellites::SMOGP:
+    case SatelliteChanger::Satellites::ATL1:
+        handleAcknowledgedCommands(s1utils::PackView<s1obc::OnboardTelemetryPacketPA>(frame.bytes()).get<6>());
+        break;
+    case SatelliteChanger::Satellites::UNSET:
+        return true;
+    }
+    emitRecord(frame);
+    return true;
+}
+
+/**
+ * @brief Handles s1obc::BeaconPacket (SMOG-1) and s1obc::BeaconPacketPA (SMOG-P, ATL-1). The beacon is the last packet
+ * before the next sync packet.
+ * @return True, the sync timeout is restarted
+ */
+bool PacketDecoder::handleBeacon(const DecodedFrame &frame) {
+    waitForSyncPacket();
+    switch (currentSatellite) {
+    case SatelliteChanger::Satellites::SMOG1:
+        handleAcknowledgedCommands(s1utils::PackView<s1obc::BeaconPacket>(frame.bytes()).get<5>());
+        break;
+    case SatelliteChanger::Satellites::SMOGP:
+    case SatelliteChanger::Satellites::ATL1:
+        handleAcknowledgedCommands(s1utils::PackView<s1obc::BeaconPacketPA>(frame.bytes()).get<4>());
+        break;
+    case SatelliteChanger::Satellites::UNSET:
+        return true;
+    }
+    emitRecord(frame);
+    return true;
+}
+
+/**
+ * @brief Handles s1obc::SpectrumPacket
+ * @return False after the last packet of the measurement, the receiver waits for the sync packet then
+ */
+bool PacketDecoder::handleSpectrumResult(const DecodedFrame &frame) {
+    const s1utils::PackView<s1obc::SpectrumPacket> view(frame.bytes());
+    emit newSpectrumPacket(view.load());
+    emitRecord(frame);
+    if (view.get<5>() == view.get<6>() - 1) {
+        waitForSyncPacket();
+        return false; // So that the sync packet timer does not restart
+    }
+    return true;
+}
+
+/**
+ * @brief Handles s1obc::FileDownloadPacket, the fragment is added to the file that is being downloaded
+ * @return False after the last fragment of the file, the receiver waits for the sync packet then
+ */
+bool PacketDecoder::handleFileDownload(const DecodedFrame &frame) {
+    const s1utils::PackView<s1obc::FileDownloadPacket> view(frame.bytes());
+    addFileFragment(view);
+    emitRecord(frame);
+    if (view.get<2>() == view.get<3>() - 1) {
+        waitForSyncPacket();
+        return false; // So that the sync packet timer does not restart
+    }
+    return true;
+}
+
+/**
+ * @brief Handles the packets that are only emitted (ATL-1 battery telemetry, file info, SMOG-P and ATL-1 telemetry)
+ * @return True, the sync timeout is restarted
+ */
+bool PacketDecoder::handlePlainPacket(const DecodedFrame &frame) {
+    emitRecord(frame);
+    return true;
+}
+
+/**
+ * @brief Called whenever a new packet has been decoded. Emits the packet record (that is received by PacketTableModel
+ * and Uploader). Eliminates duplicates from the same source (e.g. SDR demodulates the same packet twice)
+ * @param record The decoded packet
+ */
+void PacketDecoder::packetSuccessfullyDecoded(const PacketRecord &record) {
+    const bool isSync = record.type().contains("Sync");
+    if (isSync || recentPackets_priv.take(record.source()) != record.auth()) {
+        emit newPacket(record);
+        if (!(isSync || record.source() == "QMLMANUAL" || record.satellite() == SatelliteChanger::Satellites::UNSET)) {
+            emit newPacketForUpload(record);
         }
     }
-    recentPackets_priv[source] = authQString;
+    recentPackets_priv[record.source()] = record.auth();
 }
 
 /**
@@ -1403,64 +802,6 @@ void PacketDecoder::newCommandId(uint16_t newId) {
     // we may need to deal with overflow if necessary
 }
 
-/**
- * @brief Turns a FileType to QString
- * @param type the type
- * @return The QString describing \p type
- */
-QString PacketDecoder::fileTypeToQString(s1obc::FileType type) {
-    switch (type) {
-    case s1obc::FileType_Deleted:
-        return "Deleted";
-    case s1obc::FileType_Text:
-        return "Text";
-    case s1obc::FileType_Custom:
-        return "Custom";
-    case s1obc::FileType_Spectrum:
-        return "Spectrum";
-    case s1obc::FileType_UniversalMeasurement:
-        return "UniversalMeasurement";
-    default:
-        return "UNKNOWN";
-    }
-}
-
-/**
- * @brief Turns a FileEntry to a QString
- * @param entry the file entry
- * @return The QString describing \p entry
- */
-QString PacketDecoder::fileEntryToQString(s1obc::FileEntry entry) {
-    using namespace s1utils;
-    QString ret;
-    auto filename = QString(QByteArray(reinterpret_cast<const char *>(entry.name().characters), 10));
-    auto fn = filename.left(
-        filename.indexOf(QChar(static_cast<char>(0))) == -1 ? 10 : filename.indexOf(QChar(static_cast<char>(0))));
-    ret.append("name: ").append(fn);
-    ret.append(", type: ").append(fileTypeToQString((s1obc::FileType) entry.type()));
-    ret.append(QString(", size: %1").arg(static_cast<uint32_t>(entry.size())));
-    ret.append(", timestamp: ").append(getDTSFromUint32UTC(entry.timestamp()));
-    return ret;
-}
-
-/**
- * @brief Turns a file (FileId + FileEntry) to a QString
- * @param id id of the file
- * @param entry file entry
- * @return QString describing the file
- */
-QString PacketDecoder::fileToQString(uint8_t id, s1obc::FileEntry entry) {
-    using namespace s1utils;
-    if (id != 0) {
-        QString ret = QString("ID: %1").arg(id);
-        ret.append(" " + fileEntryToQString(entry));
-        return ret;
-    }
-    else {
-        return QString("File is missing");
-    }
-}
-
 /**
  * @brief Checks if \p timestamp appears to be invalid
  * @param timestamp The timestamp to check
@@ -1542,17 +883,18 @@ bool PacketDecoder::checkForAnomalies(QByteArray &decodedPacket) const {
 }
 
 /**
- * @brief A slot, that performs decoding on \p packet.
+ * @brief Performs decoding on \p packet. Called by the slots that received packets are connected to.
  *
  * Handles different types of packets accordingly.
  *
  * @param timestamp Timestamp of reception
  * @param source Source of the packet
  * @param packetUpperHexString QString that represents the data contained in the packet as an UPPERCASE Hex QString.
- * @param The RSSI that the packet was received with
+ * @param rssi The RSSI that the packet was received with
+ * @param position Position in the recording that the packet was decoded from, -1 if it was not
  */
-void PacketDecoder::decodablePacketReceivedWithRssi(
-    QDateTime timestamp, QString source, QString packetUpperHexString, int rssi) {
+void PacketDecoder::decodeReceivedPacket(
+    const QDateTime &timestamp, const QString &source, const QString &packetUpperHexString, int rssi, qint64 position) {
 
     if (packetUpperHexString.length() == 0) {
         qWarning() << "PacketDecoder received packetUpperHexString with a length of 0 from " << source;
@@ -1599,80 +941,71 @@ void PacketDecoder::decodablePacketReceivedWithRssi(
         }
 
         qInfo() << readableQString;
-        packetSuccessfullyDecoded(datetime,
+        packetSuccessfullyDecoded(PacketRecord(datetime,
             source,
             packetName,
             QStringLiteral("-"),
+            currentSatellite,
             QByteArray(),
             received,
             readableQString,
             QVariant(),
-            rssi);
+            rssi,
+            position));
         break;
     }
-    case 650: {
-        DecodedPacket ao40_result = decodeWithAO40LONG(received);
-        if (ao40_result.getResult() == DecodedPacket::Success) {
-            QByteArray decoded = ao40_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "AO40", decoded, rssi, packetUpperHexString);
-        }
+    case 650:
+        queueFecJob(timestamp, source, "AO40", received, rssi, position, packetUpperHexString);
         break;
-    }
-    case 333: {
-        DecodedPacket ao40short_result = decodeWithAO40SHORT(received);
-        if (ao40short_result.getResult() == DecodedPacket::Success) {
-            QByteArray decoded = ao40short_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "AO40Short", decoded, rssi, packetUpperHexString);
-        }
+    case 333:
+        queueFecJob(timestamp, source, "AO40Short", received, rssi, position, packetUpperHexString);
         break;
-    }
-    case 260: {
-        DecodedPacket ra_result = decodeWithRA(received);
-        if (ra_result.getResult() != DecodedPacket::Failure) {
-            QByteArray decoded = ra_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "RA128", decoded, rssi, packetUpperHexString);
-        }
+    case 260:
+        queueFecJob(timestamp, source, "RA128", received, rssi, position, packetUpperHexString);
         break;
-    }
-    case 514: {
-        DecodedPacket ra_result = decodeWithRA(received);
-        if (ra_result.getResult() != DecodedPacket::Failure) {
-            QByteArray decoded = ra_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "RA256", decoded, rssi, packetUpperHexString);
-        }
+    case 514:
+        queueFecJob(timestamp, source, "RA256", received, rssi, position, packetUpperHexString);
         break;
-    }
-    case 1028: {
-        DecodedPacket ra_result = decodeWithRA(received);
-        if (ra_result.getResult() != DecodedPacket::Failure) {
-            QByteArray decoded = ra_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "RA512", decoded, rssi, packetUpperHexString);
-        }
+    case 1028:
+        queueFecJob(timestamp, source, "RA512", received, rssi, position, packetUpperHexString);
         break;
-    }
-    case 2050: {
-        DecodedPacket ra_result = decodeWithRA(received);
-        if (ra_result.getResult() != DecodedPacket::Failure) {
-            QByteArray decoded = ra_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "RA1024", decoded, rssi, packetUpperHexString);
-        }
+    case 2050:
+        queueFecJob(timestamp, source, "RA1024", received, rssi, position, packetUpperHexString);
         break;
-    }
-    case 4100: {
-        DecodedPacket ra_result = decodeWithRA(received);
-        if (ra_result.getResult() != DecodedPacket::Failure) {
-            QByteArray decoded = ra_result.getDecodedPacket();
-            processDecodedPacket(timestamp, source, "RA2048", decoded, rssi, packetUpperHexString);
-        }
+    case 4100:
+        queueFecJob(timestamp, source, "RA2048", received, rssi, position, packetUpperHexString);
         break;
-    }
     default:
         qWarning() << "Unknown packet length";
     }
 }
 
 void PacketDecoder::decodablePacketReceived(QDateTime timestamp, QString source, QString packetUpperHexString) {
-    decodablePacketReceivedWithRssi(timestamp, source, packetUpperHexString, 0);
+    decodeReceivedPacket(timestamp, source, packetUpperHexString, 0, -1);
+}
+
+/**
+ * @brief A slot, that performs decoding on \p packet.
+ * @param timestamp Timestamp of reception
+ * @param source Source of the packet
+ * @param packetUpperHexString QString that represents the data contained in the packet as an UPPERCASE Hex QString.
+ * @param rssi The RSSI that the packet was received with
+ */
+void PacketDecoder::decodablePacketReceivedWithRssi(
+    QDateTime timestamp, QString source, QString packetUpperHexString, int rssi) {
+    decodeReceivedPacket(timestamp, source, packetUpperHexString, rssi, -1);
+}
+
+/**
+ * @brief A slot, that performs decoding on \p packet that was decoded from a recording.
+ * @param timestamp Timestamp of reception
+ * @param source Source of the packet
+ * @param packetUpperHexString QString that represents the data contained in the packet as an UPPERCASE Hex QString.
+ * @param position Position of the packet in the recording [samples]
+ */
+void PacketDecoder::decodablePacketReceivedAtPosition(
+    QDateTime timestamp, QString source, QString packetUpperHexString, qint64 position) {
+    decodeReceivedPacket(timestamp, source, packetUpperHexString, 0, position);
 }
 
 /**
@@ -1681,6 +1014,7 @@ void PacketDecoder::decodablePacketReceived(QDateTime timestamp, QString source,
  */
 void PacketDecoder::changePrefix(QString prefix) {
     this->prefix = prefix;
+    archive_priv.setPrefix(prefix);
 }
 
 /**
@@ -1,19 +1,15 @@
 #ifndef PACKETDECODER_H
 #define PACKETDECODER_H
 
-#define AO40_DOWNLINKLENGTH 650
-#define AO40_DECDOWNLINKLENGTH 256
-#define AO40SHORT_DOWNLINKLENGTH 333
-#define AO40SHORT_DECDOWNLINKLENGTH 128
-
 #include "../packet/decodedpacket.h"
+#include "../packet/fecdecoder.h"
+#include "../packet/packetarchive.h"
+#include "../packet/packetformatter.h"
+#include "../packet/packetrecord.h"
 #include "../packet/spectrumreceiver.h"
 #include "../utilities/common.h"
 #include "../utilities/satellitechanger.h"
-#include "dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_message.h"
-#include "dependencies/FEC-AO40/ao40/decode/ao40_decode_message.h"
 #include "dependencies/obc-packet-helpers/downlink.h"
-#include "dependencies/racoder/ra_decoder_gen.h"
 #ifdef UPLINK_ENABLED
 #include "dependencies/uplink-codec/signature.h"
 #endif
@@ -23,9 +19,11 @@
 #include <QDebug>
 #include <QFile>
 #include <QHash>
+#include <QMap>
 #include <QObject>
 #include <QRegularExpression>
 #include <QScopedPointer>
+#include <QThreadPool>
 #include <QTimeZone>
 #include <QTimer>
 #include <algorithm>
@@ -39,119 +37,140 @@
 class PacketDecoder : public QObject {
     Q_OBJECT
 public:
-    explicit PacketDecoder(QString logDirString,
-        QString fileName,
-        QString downloadDirString,
-        SpectrumReceiver *spectrumReceiver,
-        QObject *parent = 0);
+    explicit PacketDecoder(
+        QString logDirString, QString downloadDirString, SpectrumReceiver *spectrumReceiver, QObject *parent = 0);
     Q_INVOKABLE void manualPacketInput(QString source, QString packetUpperHexString);
 
+    static PacketRecord parseArchivedFrame(const ArchivedFrame &frame);
+
 private:
+    friend class FecJob;
+
+    /**
+     * @brief A received frame whose FEC decoding is in progress or that waits for an earlier frame to be processed
+     */
+    struct PendingFrame {
+        QDateTime timestamp;
+        QString source;
+        QString encoding;
+        int rssi;
+        qint64 position; //!< Position in the recording that the frame was decoded from, -1 if it was not
+        QString originalString;
+        bool finished;
+        bool success;
+        QByteArray decoded;
+    };
+
     QString logDirString;
-    QString fileName;
     QString prefix;
     QString downloadDirString;
     SpectrumReceiver *spectrumReceiver_priv;
+    PacketArchiveWriter archive_priv; //!< Archive of every received frame
+    QTimer archiveFlushTimer_priv;    //!< Writes the frames buffered by \p archive_priv periodically, a child of this
     SatelliteChanger::Satellites currentSatellite;
-    QHash<QString, QString> recentPackets_priv;
+    QHash<QString, QByteArray> recentPackets_priv; //!< Auth segment of the last packet from each source
     uint16_t lastCommandId_priv = 0;
     QTimer fileDownloadTimer_priv;
     QTimer syncTimeoutTimer_priv;
     unsigned int dataRate_priv;
     QScopedPointer<FileDownload> fileDownload_priv;
     s1sync::OperatingMode decodeMode_priv;
-    QString processTelemetry1(const s1obc::SolarPanelTelemetryPacket &packet);
-    QString processTelemetry2(const s1obc::PcuTelemetryPacket &packet);
-    QString processTelemetry2A(const s1obc::PcuTelemetryPacket &packet);
-    QString processTelemetry3(const s1obc::OnboardTelemetryPacket &packet);
-    QString processTelemetry3P(const s1obc::OnboardTelemetryPacketPA &packet);
-    QString processTelemetry3A(const s1obc::OnboardTelemetryPacketPA &packet);
-    QString processBeacon(const s1obc::BeaconPacket &packet);
-    QString processBeaconPA(const s1obc::BeaconPacketPA &packet);
-    QString processSpectrumData(const s1obc::SpectrumPacket &packet);
-    QString processFileDownload(const s1obc::FileDownloadPacket &packet);
-    QString processBattery(const s1obc::BatteryPacketA &packet);
-    QString extractSolarPanelTelemetry(const s1obc::SolarPanelTelemetry &panel);
-    QString processAcknowledgedCommands(const s1obc::AcknowledgedCommands &commands);
-    QString extractPCUDeploymentTelemetry(const s1obc::PcuDeploymentTelemetry &deployment);
-    QString extractPCUBatteryTelemetry(const s1obc::PcuBatteryTelemetry &battery);
-    QString extractPCUBusTelemetry(const s1obc::PcuBusTelemetry &bus);
-    QString extractPCUSDCTelemetry(const s1obc::PcuSdcTelemetry &sdc);
-    QString extractOBCTelemetry(const s1obc::ObcTelemetry &obc);
-    QString extractOBCTelemetryPA(const s1obc::ObcTelemetryPA &obc);
-    QString extractCOMTelemetry(const s1obc::ComTelemetry &com);
-    QString extractTIDTelemetry(const s1obc::TidTelemetry &tid);
-    QString extractDiagnosticTelemetry(const s1obc::DiagnosticInfo &diagnostic);
-    QString extractDiagnosticTelemetryPA(const s1obc::DiagnosticInfoPA &diagnostic);
-    QString extractBatteryTelemetryA(const s1obc::BatteryTelemetryA &battery, uint8_t panel);
+    QMap<quint64, PendingFrame> pendingFrames_priv; //!< Frames sent to the FEC pool, keyed by their sequence number
+    quint64 nextSequence_priv = 0;                  //!< Sequence number of the next frame sent to the FEC pool
+    QThreadPool fecPool_priv; //!< Worker threads of the FEC stage, destroyed (and waited for) first
+    /**
+     * @brief A decoded frame that is dispatched to the handler of its packet type
+     */
+    struct DecodedFrame {
+        const QDateTime &timestamp;
+        const QString &source;
+        const QString &encoding;
+        const QByteArray &decoded; //!< The decoded packet, the handlers read single fields of it through views
+        int rssi;
+        qint64 position; //!< Position in the recording that the frame was decoded from, -1 if it was not
+
+        const uint8_t *bytes() const {
+            return reinterpret_cast<const uint8_t *>(decoded.constData());
+        }
+    };
+
+    /**
+     * @brief Entry of the packet type dispatch table, see PacketDecoder::findDownlinkHandler()
+     */
+    struct DownlinkHandler {
+        uint8_t packetType;                                 //!< First byte of the packet
+        unsigned int size;                                  //!< Exact length of the packet [bytes]
+        bool (PacketDecoder::*handle)(const DecodedFrame &); //!< Returns false if the sync timeout must not restart
+    };
+
+    static const DownlinkHandler *findDownlinkHandler(uint8_t packetType);
+    template <typename TPacket>
+    static PacketRecord makeRecord(const DecodedFrame &frame,
+        SatelliteChanger::Satellites satellite,
+        const QString &name,
+        const TPacket &packet);
+    static PacketRecord parsePacket(const DecodedFrame &frame, SatelliteChanger::Satellites satellite);
+    void emitRecord(const DecodedFrame &frame);
+    bool handleTelemetry1(const DecodedFrame &frame);
+    bool handleTelemetry2(const DecodedFrame &frame);
+    bool handleTelemetry3(const DecodedFrame &frame);
+    bool handleBeacon(const DecodedFrame &frame);
+    bool handleSpectrumResult(const DecodedFrame &frame);
+    bool handleFileDownload(const DecodedFrame &frame);
+    bool handlePlainPacket(const DecodedFrame &frame);
+    void handleAcknowledgedCommands(const s1obc::AcknowledgedCommands &commands);
+    void addFileFragment(const s1utils::PackView<s1obc::FileDownloadPacket> &packet);
     void waitForSyncPacket();
     void startSyncPacketTimeout(unsigned int datarateBPS, s1sync::OperatingMode operatingMode);
-    const DecodedPacket decodeWithAO40SHORT(const QByteArray encodedData);
-    const DecodedPacket decodeWithAO40LONG(const QByteArray encodedData);
-    const DecodedPacket decodeWithRA(const QByteArray encodedData);
+    void queueFecJob(const QDateTime &timestamp,
+        const QString &source,
+        const QString &encoding,
+        const QByteArray &received,
+        int rssi,
+        qint64 position,
+        const QString &originalString);
+    void fecJobFinished(quint64 sequence, const DecodedPacket &result);
     const QString getDateTimeString(QDateTime datetime) const;
     void processDecodedPacket(const QDateTime &timestamp,
         const QString &source,
         const QString &encoding,
         QByteArray &decodedPacket,
         int rssi,
+        qint64 position,
         QString originalString);
-    void packetSuccessfullyDecoded(QDateTime timestamp,
-        QString source,
-        QString type,
-        QString encoding,
-        QByteArray auth,
-        QByteArray decodedData,
-        QString readableQString,
-        QVariant packet,
-        int rssi);
+    void packetSuccessfullyDecoded(const PacketRecord &record);
     void processSyncContents(unsigned int datarateBPS, s1sync::OperatingMode operatingMode);
     bool isUpperHexString(QString input) const;
     bool checkSignature(const QByteArray &data) const;
     void newCommandId(uint16_t newId);
-    QString fileTypeToQString(s1obc::FileType type);
-    QString fileEntryToQString(s1obc::FileEntry entry);
-    QString fileToQString(uint8_t id, s1obc::FileEntry entry);
 
     bool isTimestampValid(int32_t timestamp) const;
     bool checkForAnomalies(QByteArray &decodedPacket) const;
+    void decodeReceivedPacket(const QDateTime &timestamp,
+        const QString &source,
+        const QString &packetUpperHexString,
+        int rssi,
+        qint64 position);
 
 public slots:
     void decodablePacketReceived(QDateTime timestamp, QString source, QString packetUpperHexString);
     void decodablePacketReceivedWithRssi(QDateTime timestamp, QString source, QString packetUpperHexString, int rssi);
+    void decodablePacketReceivedAtPosition(
+        QDateTime timestamp, QString source, QString packetUpperHexString, qint64 position);
     void changePrefix(QString prefix);
     void changeSatellite(SatelliteChanger::Satellites satellite);
 
 signals:
     /**
-     * @brief Signal that is emmitted when a packet has been decoded
-     * @param decodedQString Full, decoded data of the packet as a QString
-     * @param satellite The satellite that the packet was received for
+     * @brief Signal that is emmitted when a packet has been decoded and it should be uploaded to the server
+     * @param record The decoded packet
      */
-    void newPacketMinimal(QString decodedQString, SatelliteChanger::Satellites satellite);
+    void newPacketForUpload(PacketRecord record);
     /**
      * @brief Signal that is emmitted when a packet has been decoded
-     * @param timestamp QString Timestamp for the packet
-     * @param source Source of the packet
-     * @param type Type of the packet
-     * @param encoding Encoding of the packet
-     * @param satelliteString The satellite as a QString
-     * @param authQString Authentication segment of the packet as a QString
-     * @param decodedQString Full, decoded data of the packet as a QString
-     * @param readableQString The contents of the packet as a readable QString
-     * @param packet Contents of the packet wrapped in a QVariant
-     * @package rssi The RSSI that the packet was received with
-     */
-    void newPacket(QString timestamp,
-        QString source,
-        QString type,
-        QString encoding,
-        QString authQString,
-        QString satelliteString,
-        QString decodedQString,
-        QString readableQString,
-        QVariant packet,
-        int rssi);
+     * @param record The decoded packet
+     */
+    void newPacket(PacketRecord record);
 
     /**
      * @brief Signal, that lets SpectrumReceiver know, that the spectrum analysis command was received by the satellite.
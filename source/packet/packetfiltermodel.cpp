@@ -0,0 +1,466 @@
+#include "packetfiltermodel.h"
+#include "../utilities/common.h"
+#include <algorithm>
+#include <iterator>
+
+/**
+ * @brief Constructor for the class. Indexes the rows that \p history already has.
+ * @param history The model that is filtered
+ * @param parent Parent QObject, should be left empty.
+ */
+PacketFilterModel::PacketFilterModel(PacketHistoryModel *history, QObject *parent)
+: QAbstractProxyModel(parent), history_priv(history), indexedRows_priv(0), generation_priv(0),
+  runningSearches_priv(0) {
+    Q_ASSERT(history != nullptr);
+    for (int column = 0; column < ColumnCount; column++) {
+        accepted_priv[column].set();
+        active_priv[column] = false;
+    }
+    // A single worker, so the results of the searches arrive in the order of the rows
+    pool_priv.setMaxThreadCount(1);
+    setSourceModel(history_priv);
+    QObject::connect(history_priv, &QAbstractItemModel::rowsInserted, this, &PacketFilterModel::sourceRowsInserted);
+    QObject::connect(history_priv, &QAbstractItemModel::dataChanged, this, &PacketFilterModel::sourceDataChanged);
+    QObject::connect(history_priv, &QAbstractItemModel::modelReset, this, &PacketFilterModel::sourceReset);
+    QObject::connect(history_priv, &PacketHistoryModel::optionsChanged, this, [this]() {
+        updateNamedFilters();
+        // The rows that brought the new sources or encodings have been checked against the old ones
+        if (!sourceFilter_priv.isEmpty() || !encodingFilter_priv.isEmpty()) {
+            applyFilters();
+        }
+        emit optionsChanged();
+    });
+    sourceReset();
+}
+
+QModelIndex PacketFilterModel::mapToSource(const QModelIndex &proxyIndex) const {
+    if (!proxyIndex.isValid() || proxyIndex.row() >= rows_priv.size()) {
+        return QModelIndex();
+    }
+    return history_priv->index(rows_priv.at(proxyIndex.row()), proxyIndex.column());
+}
+
+QModelIndex PacketFilterModel::mapFromSource(const QModelIndex &sourceIndex) const {
+    if (!sourceIndex.isValid()) {
+        return QModelIndex();
+    }
+    const auto it = std::lower_bound(rows_priv.begin(), rows_priv.end(), sourceIndex.row());
+    if (it == rows_priv.end() || *it != sourceIndex.row()) {
+        return QModelIndex();
+    }
+    return index(static_cast<int>(it - rows_priv.begin()), sourceIndex.column());
+}
+
+QModelIndex PacketFilterModel::index(int row, int column, const QModelIndex &parent) const {
+    return hasIndex(row, column, parent) ? createIndex(row, column) : QModelIndex();
+}
+
+QModelIndex PacketFilterModel::parent(const QModelIndex &child) const {
+    (void) child;
+    return QModelIndex();
+}
+
+int PacketFilterModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rows_priv.size();
+}
+
+int PacketFilterModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : history_priv->columnCount();
+}
+
+/**
+ * @brief Returns the roles of PacketHistoryModel
+ */
+QHash<int, QByteArray> PacketFilterModel::roleNames() const {
+    return history_priv->roleNames();
+}
+
+/**
+ * @brief Returns the sources that can be filtered on
+ */
+QStringList PacketFilterModel::sources() const {
+    return history_priv->sources();
+}
+
+/**
+ * @brief Returns the encodings that can be filtered on
+ */
+QStringList PacketFilterModel::encodings() const {
+    return history_priv->encodings();
+}
+
+/**
+ * @brief Returns true while the rows are being matched against the search text
+ */
+bool PacketFilterModel::searching() const {
+    return runningSearches_priv > 0;
+}
+
+/**
+ * @brief Only shows the packets whose type is in \p packetTypes (s1obc::DownlinkPacketType values)
+ * @param packetTypes The accepted packet types, every packet type is accepted if it is empty
+ */
+void PacketFilterModel::setTypeFilter(const QVariantList &packetTypes) {
+    std::bitset<256> accepted;
+    for (const auto &packetType : packetTypes) {
+        accepted.set(static_cast<quint8>(packetType.toUInt()));
+    }
+    setAccepted(TypeColumn, accepted, !packetTypes.isEmpty());
+    applyFilters();
+}
+
+/**
+ * @brief Only shows the packets of the satellites in \p satellites (SatelliteChanger::Satellites values)
+ * @param satellites The accepted satellites, every satellite is accepted if it is empty
+ */
+void PacketFilterModel::setSatelliteFilter(const QVariantList &satellites) {
+    std::bitset<256> accepted;
+    for (const auto &satellite : satellites) {
+        accepted.set(PacketArchive::satelliteCode(static_cast<SatelliteChanger::Satellites>(satellite.toInt())));
+    }
+    setAccepted(SatelliteColumn, accepted, !satellites.isEmpty());
+    applyFilters();
+}
+
+/**
+ * @brief Only shows the packets that were received from one of \p sources
+ * @param sources The accepted sources, every source is accepted if it is empty
+ */
+void PacketFilterModel::setSourceFilter(const QStringList &sources) {
+    sourceFilter_priv = sources;
+    updateNamedFilters();
+    applyFilters();
+}
+
+/**
+ * @brief Only shows the packets that were received with one of \p encodings
+ * @param encodings The accepted encodings, every encoding is accepted if it is empty
+ */
+void PacketFilterModel::setEncodingFilter(const QStringList &encodings) {
+    encodingFilter_priv = encodings;
+    updateNamedFilters();
+    applyFilters();
+}
+
+/**
+ * @brief Only shows the packets whose type or readable text contains \p text, ignoring the case
+ * @param text The text to search for, the search is off if it is empty
+ */
+void PacketFilterModel::setSearchText(const QString &text) {
+    if (searchText_priv == text) {
+        return;
+    }
+    searchText_priv = text;
+    applyFilters();
+}
+
+/**
+ * @brief Turns every filter and the search off
+ */
+void PacketFilterModel::clearFilters() {
+    for (int column = 0; column < ColumnCount; column++) {
+        setAccepted(column, std::bitset<256>(), false);
+    }
+    sourceFilter_priv.clear();
+    encodingFilter_priv.clear();
+    searchText_priv.clear();
+    applyFilters();
+}
+
+/**
+ * @brief Returns every available data about the packet in the row \p index, see
+ * PacketHistoryModel::detailedInformation()
+ */
+QList<QString> PacketFilterModel::detailedInformation(int index) const {
+    return history_priv->detailedInformation(sourceRow(index));
+}
+
+QString PacketFilterModel::readableQString(int index) const {
+    return history_priv->readableQString(sourceRow(index));
+}
+
+QVariant PacketFilterModel::getPacket(int index) const {
+    return history_priv->getPacket(sourceRow(index));
+}
+
+QString PacketFilterModel::getSatelliteName(int index) const {
+    return history_priv->getSatelliteName(sourceRow(index));
+}
+
+void PacketFilterModel::copyToClipboard(int index) const {
+    history_priv->copyToClipboard(sourceRow(index));
+}
+
+/**
+ * @brief Returns the value of \p column in \p key
+ */
+quint8 PacketFilterModel::keyValue(const PacketHistoryModel::RowKey &key, int column) {
+    switch (column) {
+    case TypeColumn:
+        return key.packetType;
+    case SatelliteColumn:
+        return key.satellite;
+    case SourceColumn:
+        return key.source;
+    default:
+        return key.encoding;
+    }
+}
+
+/**
+ * @brief Returns true if the row with the key \p key passes the column filters
+ */
+bool PacketFilterModel::accepts(const PacketHistoryModel::RowKey &key) const {
+    for (int column = 0; column < ColumnCount; column++) {
+        if (active_priv[column] && !accepted_priv[column].test(keyValue(key, column))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Sets the accepted values of \p column
+ * @param column The column
+ * @param accepted The accepted values
+ * @param active False if every value is accepted
+ */
+void PacketFilterModel::setAccepted(int column, const std::bitset<256> &accepted, bool active) {
+    accepted_priv[column] = accepted;
+    active_priv[column] = active;
+}
+
+/**
+ * @brief Converts the accepted sources and encodings to the indexes of PacketHistoryModel::sources() and
+ * PacketHistoryModel::encodings()
+ */
+void PacketFilterModel::updateNamedFilters() {
+    const auto toAccepted = [](const QStringList &names, const QStringList &values) {
+        std::bitset<256> accepted;
+        for (const auto &name : names) {
+            const int index = values.indexOf(name);
+            if (index >= 0) {
+                accepted.set(static_cast<size_t>(index));
+            }
+        }
+        return accepted;
+    };
+    setAccepted(
+        SourceColumn, toAccepted(sourceFilter_priv, history_priv->sources()), !sourceFilter_priv.isEmpty());
+    setAccepted(EncodingColumn,
+        toAccepted(encodingFilter_priv, history_priv->encodings()),
+        !encodingFilter_priv.isEmpty());
+}
+
+/**
+ * @brief Adds the source rows [\p first, \p last] to the inverted indexes
+ */
+void PacketFilterModel::indexRows(int first, int last) {
+    for (int row = first; row <= last; row++) {
+        const PacketHistoryModel::RowKey key = history_priv->rowKey(row);
+        for (int column = 0; column < ColumnCount; column++) {
+            indexes_priv[column][keyValue(key, column)].append(row);
+        }
+    }
+    indexedRows_priv = last + 1;
+}
+
+/**
+ * @brief Returns the source rows that pass the column filters, ascending.
+ *
+ * The rows of the accepted values of a filtered column are merged, then the results of the filtered columns are
+ * intersected, starting with the smallest.
+ */
+QVector<int> PacketFilterModel::candidates() const {
+    QVector<QVector<int>> columns;
+    for (int column = 0; column < ColumnCount; column++) {
+        if (!active_priv[column]) {
+            continue;
+        }
+        QVector<int> rows;
+        for (auto it = indexes_priv[column].constBegin(); it != indexes_priv[column].constEnd(); ++it) {
+            if (!accepted_priv[column].test(it.key())) {
+                continue;
+            }
+            QVector<int> merged;
+            merged.reserve(rows.size() + it.value().size());
+            std::merge(rows.begin(), rows.end(), it.value().begin(), it.value().end(), std::back_inserter(merged));
+            rows.swap(merged);
+        }
+        columns.append(rows);
+    }
+    if (columns.isEmpty()) {
+        QVector<int> rows(indexedRows_priv);
+        for (int row = 0; row < indexedRows_priv; row++) {
+            rows[row] = row;
+        }
+        return rows;
+    }
+    std::sort(columns.begin(), columns.end(), [](const QVector<int> &a, const QVector<int> &b) {
+        return a.size() < b.size();
+    });
+    QVector<int> result = columns.first();
+    for (int i = 1; i < columns.size() && !result.isEmpty(); i++) {
+        QVector<int> intersection;
+        std::set_intersection(result.begin(),
+            result.end(),
+            columns.at(i).begin(),
+            columns.at(i).end(),
+            std::back_inserter(intersection));
+        result.swap(intersection);
+    }
+    return result;
+}
+
+/**
+ * @brief Recomputes the rows after a filter has changed. Cancels the running search and starts a new one if there is a
+ * search text.
+ */
+void PacketFilterModel::applyFilters() {
+    generation_priv.fetchAndAddRelaxed(1);
+    const bool wasSearching = searching();
+    runningSearches_priv = 0;
+    const QVector<int> rows = candidates();
+    beginResetModel();
+    rows_priv = searchText_priv.isEmpty() ? rows : QVector<int>();
+    endResetModel();
+    if (!searchText_priv.isEmpty() && !rows.isEmpty()) {
+        startSearch(rows);
+    }
+    if (wasSearching != searching()) {
+        emit searchingChanged(searching());
+    }
+}
+
+/**
+ * @brief Matches the source rows \p rows against the search text on the worker thread, see
+ * PacketFilterModel::searchResult()
+ * @param rows Source rows that pass the column filters, ascending
+ */
+void PacketFilterModel::startSearch(const QVector<int> &rows) {
+    const bool wasSearching = searching();
+    runningSearches_priv++;
+    const int generation = generation_priv.loadAcquire();
+    const QString text = searchText_priv;
+    const QVector<PacketHistoryModel::Segment> segments = history_priv->segments();
+    QAtomicInt *currentGeneration = &generation_priv;
+    pool_priv.start(new FunctionJob([this, rows, generation, text, segments, currentGeneration]() {
+        for (int chunk = 0; chunk < rows.size(); chunk += searchChunkSize) {
+            if (currentGeneration->loadAcquire() != generation) {
+                return;
+            }
+            const int chunkEnd = std::min(chunk + searchChunkSize, rows.size());
+            QVector<int> matches;
+            int next = chunk;
+            PacketHistoryModel::forEachFrame(segments,
+                rows.at(chunk),
+                static_cast<qint64>(rows.at(chunkEnd - 1)) + 1,
+                [&](qint64 row, const ArchivedFrame &frame) {
+                    if (row != rows.at(next)) {
+                        return true;
+                    }
+                    const PacketRecord record = PacketHistoryModel::recordFromFrame(frame);
+                    if (record.type().contains(text, Qt::CaseInsensitive) ||
+                        record.readableQString().contains(text, Qt::CaseInsensitive)) {
+                        matches.append(static_cast<int>(row));
+                    }
+                    return ++next < chunkEnd;
+                });
+            const bool finished = chunkEnd == rows.size();
+            // The pool is owned by the model and waits for its jobs before the model is gone, and queued calls to a
+            // deleted receiver are discarded
+            QMetaObject::invokeMethod(
+                this, [this, generation, matches, finished]() { searchResult(generation, matches, finished); },
+                Qt::QueuedConnection);
+        }
+    }));
+    if (!wasSearching) {
+        emit searchingChanged(true);
+    }
+}
+
+/**
+ * @brief Appends the rows that matched the search text
+ * @param generation The generation of the filters that the search was started with, older results are dropped
+ * @param rows The matching source rows, after every row that has been appended so far
+ * @param finished True if this is the last result of the search job
+ */
+void PacketFilterModel::searchResult(int generation, const QVector<int> &rows, bool finished) {
+    if (generation != generation_priv.loadAcquire()) {
+        return;
+    }
+    if (!rows.isEmpty()) {
+        beginInsertRows(QModelIndex(), rows_priv.size(), rows_priv.size() + rows.size() - 1);
+        rows_priv += rows;
+        endInsertRows();
+    }
+    if (finished) {
+        runningSearches_priv--;
+        if (!searching()) {
+            emit searchingChanged(false);
+        }
+    }
+}
+
+/**
+ * @brief Indexes the new rows of PacketHistoryModel and appends the ones that pass the filters
+ */
+void PacketFilterModel::sourceRowsInserted(const QModelIndex &parent, int first, int last) {
+    if (parent.isValid() || last < indexedRows_priv) {
+        return;
+    }
+    first = std::max(first, indexedRows_priv);
+    indexRows(first, last);
+    QVector<int> accepted;
+    for (int row = first; row <= last; row++) {
+        if (accepts(history_priv->rowKey(row))) {
+            accepted.append(row);
+        }
+    }
+    if (accepted.isEmpty()) {
+        return;
+    }
+    if (!searchText_priv.isEmpty()) {
+        startSearch(accepted);
+        return;
+    }
+    beginInsertRows(QModelIndex(), rows_priv.size(), rows_priv.size() + accepted.size() - 1);
+    rows_priv += accepted;
+    endInsertRows();
+}
+
+/**
+ * @brief Forwards the change of the source rows (e.g. a page has been loaded) to the rows that show them
+ */
+void PacketFilterModel::sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight) {
+    const auto first = std::lower_bound(rows_priv.begin(), rows_priv.end(), topLeft.row());
+    const auto last = std::upper_bound(first, rows_priv.end(), bottomRight.row());
+    if (first == last) {
+        return;
+    }
+    emit dataChanged(index(static_cast<int>(first - rows_priv.begin()), topLeft.column()),
+        index(static_cast<int>(last - rows_priv.begin()) - 1, bottomRight.column()));
+}
+
+/**
+ * @brief Rebuilds the indexes from every row of PacketHistoryModel
+ */
+void PacketFilterModel::sourceReset() {
+    for (int column = 0; column < ColumnCount; column++) {
+        indexes_priv[column].clear();
+    }
+    indexedRows_priv = 0;
+    if (history_priv->rowCount() > 0) {
+        indexRows(0, history_priv->rowCount() - 1);
+    }
+    updateNamedFilters();
+    applyFilters();
+}
+
+/**
+ * @brief Returns the source row of the row \p row
+ */
+int PacketFilterModel::sourceRow(int row) const {
+    Q_ASSERT(row >= 0 && row < rows_priv.size());
+    return rows_priv.at(row);
+}
@@ -0,0 +1,112 @@
+#ifndef PACKETFILTERMODEL_H
+#define PACKETFILTERMODEL_H
+
+#include "../packet/packethistorymodel.h"
+#include <QAbstractProxyModel>
+#include <QAtomicInt>
+#include <QHash>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariant>
+#include <QVector>
+#include <bitset>
+
+/**
+ * @brief Filters the rows of PacketHistoryModel by packet type, satellite, source and encoding, and searches their
+ * readable text.
+ *
+ * Every column keeps an inverted index: the ascending list of rows for every value of the column (see
+ * PacketHistoryModel::RowKey). When a filter changes, the lists of the accepted values are merged and intersected, no
+ * row has to be loaded for that. New rows are added to the indexes and checked against the filters with a lookup per
+ * column as they arrive.
+ *
+ * The search text is matched against the type and the readable text of the rows that pass the column filters. Those
+ * rows have to be read from the archive, so the matching is done on a worker thread in chunks of
+ * PacketFilterModel::searchChunkSize rows. The matching rows are appended as the chunks finish, and a newer filter
+ * cancels the search that is running.
+ *
+ * The model has the same roles and invokable methods as PacketTableModel, the rows are mapped onto the rows of
+ * PacketHistoryModel.
+ */
+class PacketFilterModel : public QAbstractProxyModel {
+    Q_OBJECT
+    Q_PROPERTY(QStringList sources READ sources NOTIFY optionsChanged)
+    Q_PROPERTY(QStringList encodings READ encodings NOTIFY optionsChanged)
+    Q_PROPERTY(bool searching READ searching NOTIFY searchingChanged)
+
+public:
+    explicit PacketFilterModel(PacketHistoryModel *history, QObject *parent = 0);
+
+    QModelIndex mapToSource(const QModelIndex &proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex &sourceIndex) const override;
+    QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex &child) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    QStringList sources() const;
+    QStringList encodings() const;
+    bool searching() const;
+
+    Q_INVOKABLE void setTypeFilter(const QVariantList &packetTypes);
+    Q_INVOKABLE void setSatelliteFilter(const QVariantList &satellites);
+    Q_INVOKABLE void setSourceFilter(const QStringList &sources);
+    Q_INVOKABLE void setEncodingFilter(const QStringList &encodings);
+    Q_INVOKABLE void setSearchText(const QString &text);
+    Q_INVOKABLE void clearFilters();
+
+    Q_INVOKABLE QList<QString> detailedInformation(int index) const;
+    Q_INVOKABLE QString readableQString(int index) const;
+    Q_INVOKABLE QVariant getPacket(int index) const;
+    Q_INVOKABLE QString getSatelliteName(int index) const;
+    Q_INVOKABLE void copyToClipboard(int index) const;
+
+signals:
+    /**
+     * @brief Emitted when a frame with a new source or encoding has been found
+     */
+    void optionsChanged();
+
+    /**
+     * @brief Emitted when a search starts or finishes
+     */
+    void searchingChanged(bool searching);
+
+private:
+    /**
+     * @brief The columns that have an inverted index
+     */
+    enum Column { TypeColumn, SatelliteColumn, SourceColumn, EncodingColumn, ColumnCount };
+
+    static constexpr int searchChunkSize = 2048; //!< Rows that are matched before their result is reported
+
+    static quint8 keyValue(const PacketHistoryModel::RowKey &key, int column);
+    bool accepts(const PacketHistoryModel::RowKey &key) const;
+    void setAccepted(int column, const std::bitset<256> &accepted, bool active);
+    void updateNamedFilters();
+    void indexRows(int first, int last);
+    QVector<int> candidates() const;
+    void applyFilters();
+    void startSearch(const QVector<int> &rows);
+    void searchResult(int generation, const QVector<int> &rows, bool finished);
+    void sourceRowsInserted(const QModelIndex &parent, int first, int last);
+    void sourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+    void sourceReset();
+    int sourceRow(int row) const;
+
+    PacketHistoryModel *history_priv;
+    QHash<quint8, QVector<int>> indexes_priv[ColumnCount]; //!< Rows of every value of the columns, ascending
+    std::bitset<256> accepted_priv[ColumnCount];           //!< Accepted values of the columns
+    bool active_priv[ColumnCount];                         //!< True if the column is filtered
+    QStringList sourceFilter_priv;   //!< Accepted sources, the indexes may change when new sources appear
+    QStringList encodingFilter_priv; //!< Accepted encodings, the indexes may change when new encodings appear
+    int indexedRows_priv;            //!< Number of source rows in the indexes
+    QVector<int> rows_priv;          //!< Source rows that pass the filters, ascending
+    QString searchText_priv;         //!< Text that the rows have to contain, no search if empty
+    QAtomicInt generation_priv;      //!< Incremented when the filters change, cancels the running search
+    int runningSearches_priv;        //!< Search jobs of the current generation that have not finished
+    QThreadPool pool_priv; //!< Worker thread of the searches, destroyed (and waited for) first
+};
+
+#endif // PACKETFILTERMODEL_H
@@ -0,0 +1,650 @@
+#include "packetformatter.h"
+#include <cstdio>
+#include <cstring>
+
+/**
+ * @brief Renders \p packet as readable text
+ *
+ * Packets that are laid out differently on different satellites (e.g. s1obc::PcuTelemetryPacket) are rendered
+ * according to \p satellite.
+ *
+ * @param packet The decoded packet wrapped in a QVariant (see PacketRecord::packet())
+ * @param satellite The satellite that the packet was received for
+ * @return The QString that represents the packet's contents in an easily readable format. Empty for packets that have
+ * no readable representation.
+ */
+QString PacketFormatter::render(const QVariant &packet, SatelliteChanger::Satellites satellite) {
+    using namespace s1obc;
+    static thread_local QByteArray buffer;
+    if (buffer.capacity() < initialCapacity) {
+        buffer.reserve(initialCapacity);
+    }
+    buffer.resize(0);
+
+    PacketFormatter formatter(buffer);
+    const int type = packet.userType();
+    if (type == qMetaTypeId<SolarPanelTelemetryPacket>()) {
+        formatter.telemetry1(unwrap<SolarPanelTelemetryPacket>(packet));
+    }
+    else if (type == qMetaTypeId<PcuTelemetryPacket>()) {
+        if (satellite == SatelliteChanger::Satellites::ATL1) {
+            formatter.telemetry2A(unwrap<PcuTelemetryPacket>(packet));
+        }
+        else {
+            formatter.telemetry2(unwrap<PcuTelemetryPacket>(packet));
+        }
+    }
+    else if (type == qMetaTypeId<OnboardTelemetryPacket>()) {
+        formatter.telemetry3(unwrap<OnboardTelemetryPacket>(packet));
+    }
+    else if (type == qMetaTypeId<OnboardTelemetryPacketPA>()) {
+        if (satellite == SatelliteChanger::Satellites::ATL1) {
+            formatter.telemetry3A(unwrap<OnboardTelemetryPacketPA>(packet));
+        }
+        else {
+            formatter.telemetry3P(unwrap<OnboardTelemetryPacketPA>(packet));
+        }
+    }
+    else if (type == qMetaTypeId<BeaconPacket>()) {
+        formatter.beacon(unwrap<BeaconPacket>(packet));
+    }
+    else if (type == qMetaTypeId<BeaconPacketPA>()) {
+        formatter.beaconPA(unwrap<BeaconPacketPA>(packet));
+    }
+    else if (type == qMetaTypeId<SpectrumPacket>()) {
+        formatter.spectrumData(unwrap<SpectrumPacket>(packet));
+    }
+    else if (type == qMetaTypeId<FileDownloadPacket>()) {
+        formatter.fileDownload(unwrap<FileDownloadPacket>(packet));
+    }
+    else if (type == qMetaTypeId<BatteryPacketA>()) {
+        formatter.batteryPacket(unwrap<BatteryPacketA>(packet));
+    }
+    return QString::fromUtf8(buffer.constData(), buffer.size());
+}
+
+/**
+ * @brief Constructs a formatter that appends to \p buffer
+ * @param buffer The buffer that receives the UTF-8 text
+ */
+PacketFormatter::PacketFormatter(QByteArray &buffer) : buffer_priv(buffer) {
+}
+
+PacketFormatter &PacketFormatter::operator<<(const char *text) {
+    buffer_priv.append(text);
+    return *this;
+}
+
+/**
+ * @brief Appends \p value the same way as QString::number(double) does (format 'g', precision 6)
+ */
+PacketFormatter &PacketFormatter::operator<<(double value) {
+    // QByteArray::number() ignores the locale, unlike snprintf(), which would use a decimal comma in some of them
+    buffer_priv.append(QByteArray::number(value, 'g', 6));
+    return *this;
+}
+
+/**
+ * @brief Appends \p timestamp as an ISO 8601 UTC date and time, the same way as getDTSFromUint32UTC() does
+ *
+ * The date is computed directly from the number of days since the epoch, no QDateTime is constructed.
+ */
+PacketFormatter &PacketFormatter::operator<<(Utc timestamp) {
+    const uint32_t seconds = timestamp.time % 86400;
+    // Converts days since 1970-01-01 to a civil date, see http://howardhinnant.github.io/date_algorithms.html
+    const int64_t z = static_cast<int64_t>(timestamp.time / 86400) + 719468;
+    const int64_t era = z / 146097;
+    const int64_t dayOfEra = z - era * 146097;
+    const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+    const int day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+    const int month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+    const int year = static_cast<int>(yearOfEra + era * 400 + (month <= 2 ? 1 : 0));
+
+    char digits[32];
+    int length = std::snprintf(digits,
+        sizeof(digits),
+        "%04d-%02d-%02dT%02u:%02u:%02uZ",
+        year,
+        month,
+        day,
+        seconds / 3600,
+        (seconds / 60) % 60,
+        seconds % 60);
+    buffer_priv.append(digits, length);
+    return *this;
+}
+
+/**
+ * @brief Appends \p hex the same way as QString::number(value, 16) does
+ */
+PacketFormatter &PacketFormatter::operator<<(Hex hex) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%llx", hex.value);
+    buffer_priv.append(digits, length);
+    return *this;
+}
+
+PacketFormatter &PacketFormatter::appendInteger(qlonglong value) {
+    char digits[32];
+    int length = std::snprintf(digits, sizeof(digits), "%lld", value);
+    buffer_priv.append(digits, length);
+    return *this;
+}
+
+/**
+ * @brief Appends \p text, which is a character array that is not necessarily NUL terminated
+ * @param text The characters to append
+ * @param maxLength The size of the character array
+ */
+PacketFormatter &PacketFormatter::appendText(const char *text, size_t maxLength) {
+    const char *end = static_cast<const char *>(std::memchr(text, 0, maxLength));
+    buffer_priv.append(text, static_cast<int>(end ? static_cast<size_t>(end - text) : maxLength));
+    return *this;
+}
+
+/**
+ * @brief Renders an s1obc::SolarPanelTelemetryPacket
+ * @param packet The packet
+ */
+void PacketFormatter::telemetry1(const s1obc::SolarPanelTelemetryPacket &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry1) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Telemetry1 ===\n\n";
+    SolarPanelTelemetry spfront = packet.front();
+    SolarPanelTelemetry spback = packet.back();
+    SolarPanelTelemetry spright = packet.right();
+    SolarPanelTelemetry spleft = packet.left();
+    SolarPanelTelemetry sptop = packet.top();
+    SolarPanelTelemetry spbottom = packet.bottom();
+
+    *this << "--- Front " << Utc{spfront.timestamp()} << " ---\n";
+    solarPanelTelemetry(spfront);
+    *this << "\n--- Back " << Utc{spback.timestamp()} << " ---\n";
+    solarPanelTelemetry(spback);
+    *this << "\n--- Right " << Utc{spright.timestamp()} << " ---\n";
+    solarPanelTelemetry(spright);
+    *this << "\n--- Left " << Utc{spleft.timestamp()} << " ---\n";
+    solarPanelTelemetry(spleft);
+    *this << "\n--- Top " << Utc{sptop.timestamp()} << " ---\n";
+    solarPanelTelemetry(sptop);
+    *this << "\n--- Bottom " << Utc{spbottom.timestamp()} << " ---\n";
+    solarPanelTelemetry(spbottom);
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::PcuTelemetryPacket
+ * @param packet The packet
+ */
+void PacketFormatter::telemetry2(const s1obc::PcuTelemetryPacket &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry2) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Telemetry2 ===\n\n";
+    PcuDeploymentTelemetry pcu1D = packet.deployment1();
+    PcuDeploymentTelemetry pcu2D = packet.deployment2();
+    PcuBatteryTelemetry pcu1Ba = packet.battery1();
+    PcuBatteryTelemetry pcu2Ba = packet.battery2();
+    PcuBusTelemetry pcu1Bu = packet.bus1();
+    PcuBusTelemetry pcu2Bu = packet.bus2();
+    PcuSdcTelemetry pcu1S = packet.sdc1();
+    PcuSdcTelemetry pcu2S = packet.sdc2();
+
+    *this << "--- PCU1Depl " << Utc{pcu1D.timestamp()} << " ---\n";
+    pcuDeploymentTelemetry(pcu1D);
+    *this << "\n--- PCU2Depl " << Utc{pcu2D.timestamp()} << " ---\n";
+    pcuDeploymentTelemetry(pcu2D);
+    *this << "\n--- PCU1Battery " << Utc{pcu1Ba.timestamp()} << " ---\n";
+    pcuBatteryTelemetry(pcu1Ba);
+    *this << "\n--- PCU2Battery " << Utc{pcu2Ba.timestamp()} << " ---\n";
+    pcuBatteryTelemetry(pcu2Ba);
+    *this << "\n--- PCU1Bus " << Utc{pcu1Bu.timestamp()} << " ---\n";
+    pcuBusTelemetry(pcu1Bu);
+    *this << "\n--- PCU2Bus " << Utc{pcu2Bu.timestamp()} << " ---\n";
+    pcuBusTelemetry(pcu2Bu);
+    *this << "\n--- PCU1SDC " << Utc{pcu1S.timestamp()} << " ---\n";
+    pcuSdcTelemetry(pcu1S);
+    *this << "\n--- PCU2SDC " << Utc{pcu2S.timestamp()} << " ---\n";
+    pcuSdcTelemetry(pcu2S);
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::PcuTelemetryPacket for ATL1, which has no PCU battery telemetry
+ * @param packet The packet
+ */
+void PacketFormatter::telemetry2A(const s1obc::PcuTelemetryPacket &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry2) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Telemetry2 ===\n\n";
+    PcuDeploymentTelemetry pcu1D = packet.deployment1();
+    PcuDeploymentTelemetry pcu2D = packet.deployment2();
+    PcuBusTelemetry pcu1Bu = packet.bus1();
+    PcuBusTelemetry pcu2Bu = packet.bus2();
+    PcuSdcTelemetry pcu1S = packet.sdc1();
+    PcuSdcTelemetry pcu2S = packet.sdc2();
+
+    *this << "--- PCU1Depl " << Utc{pcu1D.timestamp()} << " ---\n";
+    pcuDeploymentTelemetry(pcu1D);
+    *this << "\n--- PCU2Depl " << Utc{pcu2D.timestamp()} << " ---\n";
+    pcuDeploymentTelemetry(pcu2D);
+    *this << "\n--- PCU1Bus " << Utc{pcu1Bu.timestamp()} << " ---\n";
+    pcuBusTelemetry(pcu1Bu);
+    *this << "\n--- PCU2Bus " << Utc{pcu2Bu.timestamp()} << " ---\n";
+    pcuBusTelemetry(pcu2Bu);
+    *this << "\n--- PCU1SDC " << Utc{pcu1S.timestamp()} << " ---\n";
+    pcuSdcTelemetry(pcu1S);
+    *this << "\n--- PCU2SDC " << Utc{pcu2S.timestamp()} << " ---\n";
+    pcuSdcTelemetry(pcu2S);
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::OnboardTelemetryPacket
+ * @param packet The packet
+ */
+void PacketFormatter::telemetry3(const s1obc::OnboardTelemetryPacket &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry3) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Telemetry3 ===\n\n";
+    ComTelemetry com = packet.com();
+    TidTelemetry tid1 = packet.tid1();
+    TidTelemetry tid2 = packet.tid2();
+
+    *this << "--- OBC ---\n";
+    obcTelemetry(packet.obc());
+    *this << "\n--- COM " << Utc{com.timestamp()} << " ---\n";
+    comTelemetry(com);
+    *this << "\n--- TID1 " << Utc{tid1.timestamp()} << " ---\n";
+    tidTelemetry(tid1);
+    *this << "\n--- TID2 " << Utc{tid2.timestamp()} << " ---\n";
+    tidTelemetry(tid2);
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::OnboardTelemetryPacketPA for SMOGP
+ * @param packet The packet
+ */
+void PacketFormatter::telemetry3P(const s1obc::OnboardTelemetryPacketPA &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry3) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Telemetry3 ===\n\n";
+    ComTelemetry com = packet.com();
+    TidTelemetry tid1 = packet.tid1();
+    TidTelemetry tid2 = packet.tid2();
+
+    *this << "--- OBC ---\n";
+    obcTelemetryPA(packet.obc());
+    *this << "\n--- COM " << Utc{com.timestamp()} << " ---\n";
+    comTelemetry(com);
+    *this << "\n--- TID1 " << Utc{tid1.timestamp()} << " ---\n";
+    tidTelemetry(tid1);
+    *this << "\n--- TID2 " << Utc{tid2.timestamp()} << " ---\n";
+    tidTelemetry(tid2);
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::OnboardTelemetryPacketPA for ATL1, which has no TID telemetry
+ * @param packet The packet
+ */
+void PacketFormatter::telemetry3A(const s1obc::OnboardTelemetryPacketPA &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Telemetry3) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Telemetry3 ===\n\n";
+    ComTelemetry com = packet.com();
+
+    *this << "--- OBC ---\n";
+    obcTelemetryPA(packet.obc());
+    *this << "\n--- COM " << Utc{com.timestamp()} << " ---\n";
+    comTelemetry(com);
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::BeaconPacket
+ * @param packet The packet
+ */
+void PacketFormatter::beacon(const s1obc::BeaconPacket &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Beacon) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Beacon ===\n\n";
+    BeaconMessage message = packet.message();
+    appendText(message.characters, BeaconMessage::length);
+    *this << "\n\n--- DiagnosticInfo ---\n";
+    diagnosticTelemetry(packet.diagnosticInfo());
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::BeaconPacketPA
+ * @param packet The packet
+ */
+void PacketFormatter::beaconPA(const s1obc::BeaconPacketPA &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_Beacon) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Beacon ===\n\n";
+    BeaconMessage message = packet.message();
+    appendText(message.characters, BeaconMessage::length);
+    *this << "\n\n--- DiagnosticInfo ---\n";
+    diagnosticTelemetryPA(packet.diagnosticInfo());
+    *this << "\n\nACK: ";
+    acknowledgedCommands(packet.acknowledgedCommands());
+}
+
+/**
+ * @brief Renders an s1obc::SpectrumPacket
+ * @param packet The packet
+ */
+void PacketFormatter::spectrumData(const s1obc::SpectrumPacket &packet) {
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_SpectrumResult) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Spectrum ===\n\n";
+    *this << "Part: " << packet.index() + 1 << " / " << packet.count();
+}
+
+/**
+ * @brief Renders an s1obc::FileDownloadPacket
+ * @param packet The packet
+ */
+void PacketFormatter::fileDownload(const s1obc::FileDownloadPacket &packet) {
+    Q_ASSERT(static_cast<char>(s1obc::DownlinkPacketType_FileDownload) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === FileDownload ===\n\n";
+    fileEntry(packet.entry());
+    *this << "\nPart: " << packet.index() + 1 << " / " << packet.count();
+}
+
+/**
+ * @brief Renders an s1obc::BatteryPacketA for ATL1
+ * @param packet The packet
+ */
+void PacketFormatter::batteryPacket(const s1obc::BatteryPacketA &packet) {
+    using namespace s1obc;
+    Q_ASSERT(static_cast<uint8_t>(s1obc::DownlinkPacketType_Telemetry3_A) == packet.packetType());
+    *this << Utc{packet.timestamp()} << " === Battery telemetry ===\n\n";
+    BatteryTelemetryA panel1 = packet.panel1();
+    BatteryTelemetryA panel2 = packet.panel2();
+    BatteryTelemetryA panel3 = packet.panel3();
+    BatteryTelemetryA panel4 = packet.panel4();
+
+    *this << Utc{panel1.timestamp()} << "--- Panel 1 ---\n";
+    batteryTelemetryA(panel1, 1);
+    *this << "\n" << Utc{panel2.timestamp()} << "--- Panel 2 ---\n";
+    batteryTelemetryA(panel2, 2);
+    *this << "\n" << Utc{panel3.timestamp()} << "--- Panel 3 ---\n";
+    batteryTelemetryA(panel3, 3);
+    *this << "\n" << Utc{panel4.timestamp()} << "--- Panel 4 ---\n";
+    batteryTelemetryA(panel4, 4);
+    *this << "\n";
+}
+
+/**
+ * @brief Renders acknowledged commands (s1obc::AcknowledgedCommands)
+ * @param commands The commands to render
+ */
+void PacketFormatter::acknowledgedCommands(const s1obc::AcknowledgedCommands &commands) {
+    for (size_t i = 0; i < s1obc::AcknowledgedCommands::max; i++) {
+        *this << commands.commands[i].commandId() << "(" << commands.commands[i].receivedRssi() << " dBm) ";
+    }
+}
+
+/**
+ * @brief Renders a solar panel (s1obc::SolarPanelTelemetry)
+ * @param panel The solar panel to render
+ */
+void PacketFormatter::solarPanelTelemetry(const s1obc::SolarPanelTelemetry &panel) {
+    *this << "\tT[°C]:" << panel.temperature_C10() / 10.0;
+    *this << " Ii[mA]:" << panel.inputCurrent_mA();
+    *this << " Io[mA]:" << panel.outputCurrent_mA();
+    *this << " Vi[mV]:" << panel.inputVoltage_mV();
+    *this << " Vo[mV]:" << panel.outputVoltage_mV();
+    *this << " LSR[mV]:" << panel.lightSensorReading_mV();
+    *this << " Status:" << static_cast<uint8_t>(panel.status().antennaStatus());
+}
+
+/**
+ * @brief Renders a PCU deployment telemetry segment (s1obc::PcuDeploymentTelemetry)
+ * @param deployment The PCU deployment telemetry segment to render
+ */
+void PacketFormatter::pcuDeploymentTelemetry(const s1obc::PcuDeploymentTelemetry &deployment) {
+    *this << "\tDEPSW1:" << deployment.status().switch1();
+    *this << " DEPSW2:" << deployment.status().switch2();
+    *this << " RBF:" << deployment.status().removeBeforeFlight();
+    *this << " Deployment:" << deployment.status().pcuDeploymentFlag();
+    *this << " Antenna open:" << deployment.status().pcuAntennaFlag();
+    *this << " Boot counter:" << deployment.pcuBootCounter();
+    *this << " Uptime[m]:" << deployment.pcuUptimeMinutes();
+}
+
+/**
+ * @brief Renders a PCU battery telemetry segment (s1obc::PcuBatteryTelemetry)
+ * @param battery The PCU battery telemetry segment to render
+ */
+void PacketFormatter::pcuBatteryTelemetry(const s1obc::PcuBatteryTelemetry &battery) {
+    *this << "\tV[mV]:" << battery.voltage_mV();
+    *this << " Ic[mA]:" << battery.chargeCurrent_mA();
+    *this << " Idc[mA]:" << battery.dischargeCurrent_mA();
+    *this << " Charge:" << battery.status().isChargeEnabled();
+    *this << " Discharge:" << battery.status().isDischargeEnabled();
+    *this << "\n\tCharge Overcurrent:" << battery.status().chargeOvercurrent();
+    *this << " Charge Overvoltage:" << battery.status().chargeOvervoltage();
+    *this << " Discharge overcurrent:" << battery.status().dischargeOvercurrent();
+    *this << " Discharge overvoltage:" << battery.status().dischargeOvervoltage();
+}
+
+/**
+ * @brief Renders a PCU bus telemetry segment (s1obc::PcuBusTelemetry)
+ * @param bus The PCU bus telemetry segment to render
+ */
+void PacketFormatter::pcuBusTelemetry(const s1obc::PcuBusTelemetry &bus) {
+    *this << "\tRBV[mV]:" << bus.regulatedBusVoltage_mV();
+    *this << " URBV[mV]:" << bus.unregulatedBusVoltage_mV();
+    *this << " OBC1I[mA]:" << bus.obc1CurrentConsumption_mA();
+    *this << " OBC2I[mA]:" << bus.obc2CurrentConsumption_mA();
+    *this << "\n\tOBC1 Limiter overcurrent:" << bus.status().obc1Overcurrent();
+    *this << " OBC2 Limiter overcurrent:" << bus.status().obc2Overcurrent();
+}
+
+/**
+ * @brief Renders a PCU SDC telemetry segment (s1obc::PcuSdcTelemetry)
+ * @param sdc The PCU SDC telemetry segment to render
+ */
+void PacketFormatter::pcuSdcTelemetry(const s1obc::PcuSdcTelemetry &sdc) {
+    *this << "\t1Ii[mA]:" << sdc.chain1InputCurrent_mA();
+    *this << " 1Io[mA]:" << sdc.chain1OutputCurrent_mA();
+    *this << " 1Vo[mV]:" << sdc.chain1OutputVoltage_mV();
+    *this << " 2Ii[mA]:" << sdc.chain2InputCurrent_mA();
+    *this << " 2Io[mA]:" << sdc.chain2OutputCurrent_mA();
+    *this << " 2Vo[mV]:" << sdc.chain2OutputVoltage_mV();
+    *this << "\n\t1Overcurrent:" << sdc.status().chain1Overcurrent();
+    *this << " 1Overvoltage:" << sdc.status().chain1Overvoltage();
+    *this << " 2Overcurrent:" << sdc.status().chain2Overcurrent();
+    *this << " 2Overvoltage:" << sdc.status().chain1Overvoltage();
+}
+
+/**
+ * @brief Renders an OBC telemetry segment (s1obc::ObcTelemetry)
+ * @param obc The OBC telemetry segment to render
+ */
+void PacketFormatter::obcTelemetry(const s1obc::ObcTelemetry &obc) {
+    *this << "\tT[°C]:" << obc.activeObcTemperature_C10() / 10.0;
+    *this << " V[mV]:" << obc.supplyVoltage_mV();
+    *this << " RTCC1T[°C]:" << obc.rtcc1Temperature_C10() / 10.0;
+    *this << " RTCC2T[°C]:" << obc.rtcc2Temperature_C10() / 10.0;
+    *this << " EPS2T1[°C]:" << obc.eps2PanelATemperature1_C10() / 10.0;
+    *this << " EPS2T2[°C]:" << obc.eps2PanelATemperature2_C10() / 10.0;
+    *this << "\n\tCOMItx[mA]:" << obc.comTxCurrent_mA();
+    *this << " COMIrx[mA]:" << obc.comRxCurrent_mA();
+    *this << " COMTXPL:" << Hex{static_cast<qulonglong>(obc.comTxStatus().powerLevel())};
+    *this << " COMTXDR:" << Hex{static_cast<qulonglong>(obc.comTxStatus().dataRate())};
+    *this << "\n\tMotion1:";
+    *this << "\n\t\tGyroscopeX[°/sec]" << obc.motionSensor1().gyroscope().x();
+    *this << "\n\t\tGyroscopeY[°/sec]" << obc.motionSensor1().gyroscope().y();
+    *this << "\n\t\tGyroscopeZ[°/sec]" << obc.motionSensor1().gyroscope().z();
+    *this << "\n\t\tMagnetometerX[uT]" << obc.motionSensor1().magnetometer().x();
+    *this << "\n\t\tMagnetometerY[uT]" << obc.motionSensor1().magnetometer().y();
+    *this << "\n\t\tMagnetometerZ[uT]" << obc.motionSensor1().magnetometer().z();
+    *this << "\n\t\tAccelerometerX[g]" << obc.motionSensor1().accelerometer().x();
+    *this << "\n\t\tAccelerometerY[g]" << obc.motionSensor1().accelerometer().y();
+    *this << "\n\t\tAccelerometerZ[g]" << obc.motionSensor1().accelerometer().z();
+    *this << "\n\tMotion2:";
+    *this << "\n\t\tGyroscopeX[°/sec]" << obc.motionSensor2().gyroscope().x();
+    *this << "\n\t\tGyroscopeY[°/sec]" << obc.motionSensor2().gyroscope().y();
+    *this << "\n\t\tGyroscopeZ[°/sec]" << obc.motionSensor2().gyroscope().z();
+    *this << "\n\t\tMagnetometerX[uT]" << obc.motionSensor2().magnetometer().x();
+    *this << "\n\t\tMagnetometerY[uT]" << obc.motionSensor2().magnetometer().y();
+    *this << "\n\t\tMagnetometerZ[uT]" << obc.motionSensor2().magnetometer().z();
+    *this << "\n\t\tAccelerometerX[g]" << obc.motionSensor2().accelerometer().x();
+    *this << "\n\t\tAccelerometerY[g]" << obc.motionSensor2().accelerometer().y();
+    *this << "\n\t\tAccelerometerZ[g]" << obc.motionSensor2().accelerometer().z();
+    *this << "\n\tOBC:" << obc.obcBoardStatus().activeObc();
+    *this << " COM:" << obc.obcBoardStatus().activeCom();
+    *this << " Flash1:" << obc.obcBoardStatus().flash1Status();
+    *this << " Flash2:" << obc.obcBoardStatus().flash2Status();
+    *this << " RTCC1:" << obc.obcBoardStatus().rtcc1Status();
+    *this << " RTCC2:" << obc.obcBoardStatus().rtcc2Status();
+    *this << " MS1:" << obc.obcBoardStatus().motionSensor1Status();
+    *this << " MS2:" << obc.obcBoardStatus().motionSensor2Status();
+}
+
+/**
+ * @brief Renders an OBC telemetry segment (s1obc::ObcTelemetryPA)
+ * @param obc The OBC telemetry segment to render
+ */
+void PacketFormatter::obcTelemetryPA(const s1obc::ObcTelemetryPA &obc) {
+    *this << " V[mV]:" << obc.supplyVoltage_mV();
+    *this << " RTCCT[°C]:" << obc.rtccTemperature_C();
+    *this << " EPS2T1[°C]:" << obc.eps2PanelATemperature1_C10() / 10.0;
+    *this << " EPS2T2[°C]:" << obc.eps2PanelATemperature2_C10() / 10.0;
+    *this << "\n\tCOMItx[mA]:" << obc.comTxCurrent_mA();
+    *this << " COMIrx[mA]:" << obc.comRxCurrent_mA();
+    *this << " COMTXDR:" << Hex{static_cast<qulonglong>(obc.comTxStatus().dataRate())};
+    *this << "\n\tMotion:";
+    *this << "\n\t\tGyroscopeX[°/sec]" << obc.motionSensor().gyroscope().x();
+    *this << "\n\t\tGyroscopeY[°/sec]" << obc.motionSensor().gyroscope().y();
+    *this << "\n\t\tGyroscopeZ[°/sec]" << obc.motionSensor().gyroscope().z();
+    *this << "\n\t\tMagnetometerX[uT]" << obc.motionSensor().magnetometer().x();
+    *this << "\n\t\tMagnetometerY[uT]" << obc.motionSensor().magnetometer().y();
+    *this << "\n\t\tMagnetometerZ[uT]" << obc.motionSensor().magnetometer().z();
+    *this << "\n\t\tAccelerometerX[g]" << obc.motionSensor().accelerometer().x();
+    *this << "\n\t\tAccelerometerY[g]" << obc.motionSensor().accelerometer().y();
+    *this << "\n\t\tAccelerometerZ[g]" << obc.motionSensor().accelerometer().z();
+    *this << "\n\tOBC:" << obc.obcBoardStatus().activeObc();
+    *this << " COM:" << obc.obcBoardStatus().activeCom();
+    *this << " Flash:" << obc.obcBoardStatus().flashStatus();
+    *this << " RTCC:" << obc.obcBoardStatus().rtccStatus();
+    *this << " MS:" << obc.obcBoardStatus().motionSensorStatus();
+}
+
+/**
+ * @brief Renders a COM telemetry segment (s1obc::ComTelemetry)
+ * @param com The COM telemetry segment to render
+ */
+void PacketFormatter::comTelemetry(const s1obc::ComTelemetry &com) {
+    auto spStatus = com.spectrumAnalyzerStatus();
+    *this << "\tT[°C]:" << com.activeComTemperature_C10() / 10.0;
+    *this << " V[mV]:" << com.activeComVoltage_mV();
+    *this << " LRSSI:" << com.lastReceivedRssi();
+    *this << " SWR:" << com.swrBridgeReading();
+    *this << " Spectrum:" << (spStatus & 0x01);
+    *this << " Spectrum V[mV]:" << (spStatus >> 1) * 30;
+    *this << " Spectrum T[°C]:" << com.activeComSpectrumAnalyzerTemperature_C10() / 10.0;
+}
+
+/**
+ * @brief Renders a TID telemetry segment (s1obc::TidTelemetry)
+ * @param tid The TID telemetry segment to render
+ */
+void PacketFormatter::tidTelemetry(const s1obc::TidTelemetry &tid) {
+    *this << "\tT[°C]:" << tid.temperature_C10() / 10.0;
+    *this << " Supply voltage[mV]:" << tid.supplyVoltage_mV();
+    *this << " R1[uV]:" << static_cast<uint32_t>(tid.radfet1_uV());
+    *this << " R2[uV]:" << static_cast<uint32_t>(tid.radfet2_uV());
+    *this << " SN:" << tid.measurementSerial();
+}
+
+/**
+ * @brief Renders a DiagnosticInfo telemetry segment (s1obc::DiagnosticInfo)
+ * @param diagnostic The Diagnostic telemetry segment to render
+ */
+void PacketFormatter::diagnosticTelemetry(const s1obc::DiagnosticInfo &diagnostic) {
+    *this << ";Flashchecksum:" << diagnostic.flashChecksum();
+    *this << ";LastUplinkTimestamp:" << Utc{diagnostic.lastUplinkTimestamp()};
+    *this << ";OBCUptime[Min]:" << static_cast<uint32_t>(diagnostic.obcUptimeMin());
+    *this << ";COMUptime[Min]:" << static_cast<uint32_t>(diagnostic.comUptimeMin());
+    *this << ";TXVoltageDrop[mV]:" << diagnostic.txVoltageDrop_10mV() * 10.0;
+    *this << ";TaskCount:" << diagnostic.taskCount();
+    *this << ";EnergyMode:" << diagnostic.diagnosticStatus().energyMode();
+    *this << ";TCXO works:" << diagnostic.diagnosticStatus().tcxoWorks();
+}
+
+/**
+ * @brief Renders a DiagnosticInfoPA telemetry segment (s1obc::DiagnosticInfoPA)
+ * @param diagnostic The Diagnostic telemetry segment to render
+ */
+void PacketFormatter::diagnosticTelemetryPA(const s1obc::DiagnosticInfoPA &diagnostic) {
+    *this << ";ValidPackets:" << diagnostic.validPackets();
+    *this << ";WrongSizedPackets:" << diagnostic.wrongSizedPackets();
+    *this << ";PacketsWithFailedGolay:" << diagnostic.packetsWithFailedGolayDecoding();
+    *this << ";PacketsWithWrongSignature:" << diagnostic.packetsWithWrongSignature() * 10.0;
+    *this << ";PacketsWithInvalidSerial:" << diagnostic.packetsWithInvalidSerialNumber();
+    *this << ";UARTErrorCounter:" << diagnostic.uartErrorCounter();
+}
+
+/**
+ * @brief Renders a BatteryTelemetryA telemetry segment (s1obc::BatteryTelemetryA)
+ * @param battery The battery telemetry segment to render
+ * @param panel The number of the panel (1-4) that the segment belongs to
+ */
+void PacketFormatter::batteryTelemetryA(const s1obc::BatteryTelemetryA &battery, uint8_t panel) {
+    *this << "Valid:" << battery.valid();
+    *this << " ;One-wire bus:" << battery.oneWireBus() + 1;
+    *this << " ;Current [mA]:" << battery.current_mA()[panel - 1].toInt();
+    *this << " ;T1 [°C]:" << battery.temperature1_mC()[panel - 1].toDouble() / 1000.0;
+    *this << " ;T2 [°C]:" << battery.temperature2_mC()[panel - 1].toDouble() / 1000.0;
+    *this << " ;T3 [°C]:" << battery.temperature3_mC()[panel - 1].toDouble() / 1000.0;
+    *this << " ;T4 [°C]:" << battery.temperature4_mC()[panel - 1].toDouble() / 1000.0;
+    *this << " ;T5 [°C]:" << battery.temperature5_mC()[panel - 1].toDouble() / 1000.0;
+}
+
+/**
+ * @brief Renders a FileEntry
+ * @param entry The file entry
+ */
+void PacketFormatter::fileEntry(const s1obc::FileEntry &entry) {
+    *this << "name: ";
+    appendText(entry.name().characters, s1obc::FileName::length);
+    *this << ", type: " << fileTypeName(static_cast<s1obc::FileType>(entry.type()));
+    *this << ", size: " << static_cast<uint32_t>(entry.size());
+    *this << ", timestamp: " << Utc{entry.timestamp()};
+}
+
+/**
+ * @brief Returns the name of a FileType
+ * @param type the type
+ * @return The name describing \p type
+ */
+const char *PacketFormatter::fileTypeName(s1obc::FileType type) {
+    switch (type) {
+    case s1obc::FileType_Deleted:
+        return "Deleted";
+    case s1obc::FileType_Text:
+        return "Text";
+    case s1obc::FileType_Custom:
+        return "Custom";
+    case s1obc::FileType_Spectrum:
+        return "Spectrum";
+    case s1obc::FileType_UniversalMeasurement:
+        return "UniversalMeasurement";
+    default:
+        return "UNKNOWN";
+    }
+}
@@ -0,0 +1,90 @@
+#ifndef PACKETFORMATTER_H
+#define PACKETFORMATTER_H
+
+#include "../utilities/satellitechanger.h"
+#include "dependencies/obc-packet-helpers/downlink.h"
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+#include <type_traits>
+
+/**
+ * @brief Renders decoded packets as readable text.
+ *
+ * Rendering is deferred until the text is first requested (see PacketRecord::readableQString()), so the decoder
+ * thread never formats telemetry that nobody looks at. The text is written into a per-thread buffer that is reserved
+ * once and reused, and is converted to a QString in a single step at the end.
+ */
+class PacketFormatter {
+public:
+    static QString render(const QVariant &packet, SatelliteChanger::Satellites satellite);
+
+private:
+    static constexpr int initialCapacity = 4096; //!< Bytes reserved for the buffer, enough for the longest packet
+
+    /**
+     * @brief Tag that formats a timestamp (seconds since the epoch) as an ISO 8601 UTC date and time.
+     */
+    struct Utc {
+        uint32_t time;
+    };
+
+    /**
+     * @brief Tag that formats a value in lowercase hexadecimal.
+     */
+    struct Hex {
+        qulonglong value;
+    };
+
+    /**
+     * @brief Returns the packet stored in \p packet without copying it. The type of \p packet must be \p T.
+     */
+    template <typename T> static const T &unwrap(const QVariant &packet) {
+        return *static_cast<const T *>(packet.constData());
+    }
+
+    explicit PacketFormatter(QByteArray &buffer);
+
+    PacketFormatter &operator<<(const char *text);
+    PacketFormatter &operator<<(double value);
+    PacketFormatter &operator<<(Utc timestamp);
+    PacketFormatter &operator<<(Hex hex);
+    template <typename T, typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, int>::type = 0>
+    PacketFormatter &operator<<(T value) {
+        return appendInteger(static_cast<qlonglong>(value));
+    }
+    PacketFormatter &appendInteger(qlonglong value);
+    PacketFormatter &appendText(const char *text, size_t maxLength);
+
+    void telemetry1(const s1obc::SolarPanelTelemetryPacket &packet);
+    void telemetry2(const s1obc::PcuTelemetryPacket &packet);
+    void telemetry2A(const s1obc::PcuTelemetryPacket &packet);
+    void telemetry3(const s1obc::OnboardTelemetryPacket &packet);
+    void telemetry3P(const s1obc::OnboardTelemetryPacketPA &packet);
+    void telemetry3A(const s1obc::OnboardTelemetryPacketPA &packet);
+    void beacon(const s1obc::BeaconPacket &packet);
+    void beaconPA(const s1obc::BeaconPacketPA &packet);
+    void spectrumData(const s1obc::SpectrumPacket &packet);
+    void fileDownload(const s1obc::FileDownloadPacket &packet);
+    void batteryPacket(const s1obc::BatteryPacketA &packet);
+    void acknowledgedCommands(const s1obc::AcknowledgedCommands &commands);
+    void solarPanelTelemetry(const s1obc::SolarPanelTelemetry &panel);
+    void pcuDeploymentTelemetry(const s1obc::PcuDeploymentTelemetry &deployment);
+    void pcuBatteryTelemetry(const s1obc::PcuBatteryTelemetry &battery);
+    void pcuBusTelemetry(const s1obc::PcuBusTelemetry &bus);
+    void pcuSdcTelemetry(const s1obc::PcuSdcTelemetry &sdc);
+    void obcTelemetry(const s1obc::ObcTelemetry &obc);
+    void obcTelemetryPA(const s1obc::ObcTelemetryPA &obc);
+    void comTelemetry(const s1obc::ComTelemetry &com);
+    void tidTelemetry(const s1obc::TidTelemetry &tid);
+    void diagnosticTelemetry(const s1obc::DiagnosticInfo &diagnostic);
+    void diagnosticTelemetryPA(const s1obc::DiagnosticInfoPA &diagnostic);
+    void batteryTelemetryA(const s1obc::BatteryTelemetryA &battery, uint8_t panel);
+    void fileEntry(const s1obc::FileEntry &entry);
+
+    static const char *fileTypeName(s1obc::FileType type);
+
+    QByteArray &buffer_priv; //!< UTF-8 text of the packet that is being rendered
+};
+
+#endif // PACKETFORMATTER_H
@@ -0,0 +1,418 @@
+#include "packethistorymodel.h"
+#include "../utilities/common.h"
+#include "packetdecoder.h"
+#include <algorithm>
+#include <limits>
+
+/**
+ * @brief Constructor for the class.
+ *
+ * Remembers the segments that are already in the archive, these belong to earlier sessions. Starts the timer that
+ * checks the archive for new frames.
+ *
+ * @param[in] logDirString Directory of the packet archive, see PacketDecoder
+ * @param[in] clipboard Pointer to the QClipboard objects that gives access to the clipboard
+ * @param[in] parent Parent QObject, should be left empty.
+ */
+PacketHistoryModel::PacketHistoryModel(const QString &logDirString, QClipboard *clipboard, QObject *parent)
+: QAbstractTableModel(parent), logDirString_priv(logDirString), clipboard(clipboard), rowCount_priv(0),
+  scanning_priv(false), pages_priv(maxPages) {
+    Q_ASSERT(clipboard != nullptr);
+    for (const auto &path : PacketArchive::segmentFiles(logDirString_priv)) {
+        previousSegments_priv.insert(path);
+    }
+    // A single worker, so pages are read in the order they were requested and scans never overlap
+    pool_priv.setMaxThreadCount(1);
+    QObject::connect(&refreshTimer_priv, &QTimer::timeout, this, &PacketHistoryModel::refresh);
+    refreshTimer_priv.start(refreshInterval);
+}
+
+/**
+ * @brief Returns the number of columns for the children of the given parent.
+ * @param[in] parent The parent whose children we get the number of columns for.
+ * @return Returns 6, the same columns as PacketTableModel.
+ */
+int PacketHistoryModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : 6;
+}
+
+/**
+ * @brief Returns the number of rows under the given parent, every frame of the session is a row.
+ * @param[in] parent The parent whose children we get the number of rows for.
+ * @return Returns 0 if \p parent is valid. Check Qt documentation for QAbstractItemModel.
+ */
+int PacketHistoryModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : rowCount_priv;
+}
+
+/**
+ * @brief Returns the data stored under the given role for the item referred to by the index.
+ *
+ * If the page of the row is not loaded yet, it is requested and an invalid QVariant is returned. The views are
+ * notified with dataChanged() when the page arrives.
+ *
+ * @param[in] index The index for the element that you want returned.
+ * @param[in] role The role for the element that you want returned.
+ * @return Returns a QVariant that represents the data for that role.
+ */
+QVariant PacketHistoryModel::data(const QModelIndex &index, int role) const {
+    Q_ASSERT(index.row() >= 0 && index.row() < rowCount_priv);
+    const PacketRecord *packet = record(index.row());
+    if (packet == nullptr) {
+        return QVariant();
+    }
+    switch (role) {
+    case timestampRole:
+        return packet->timestampString();
+    case sourceRole:
+        return packet->source();
+    case typeRole:
+        return packet->type();
+    case encodingRole:
+        return packet->encoding();
+    case authRole:
+        return packet->authHex();
+    case satelliteRole:
+        return packet->satelliteName();
+    case decodedDataRole:
+        return packet->dataHex();
+    case packetRole:
+        return packet->packet();
+    case rssiRole:
+        return packet->rssi();
+    case positionRole:
+        return packet->position() >= 0 ? QString::number(packet->position()) : QString();
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags PacketHistoryModel::flags(const QModelIndex &index) const {
+    if (index.row() < 0 || index.row() >= rowCount_priv) {
+        return Qt::NoItemFlags;
+    }
+    else {
+        return (Qt::ItemIsSelectable | Qt::ItemIsEnabled);
+    }
+}
+
+/**
+ * @brief Creates and returns a hash that contains the roles, the same names as the roles of PacketTableModel.
+ * @return The hash that contains the roles.
+ */
+QHash<int, QByteArray> PacketHistoryModel::roleNames() const {
+    QHash<int, QByteArray> retRoles;
+    retRoles[timestampRole] = "timestamp";
+    retRoles[sourceRole] = "source";
+    retRoles[typeRole] = "type";
+    retRoles[encodingRole] = "encoding";
+    retRoles[authRole] = "auth";
+    retRoles[satelliteRole] = "satellite";
+    retRoles[decodedDataRole] = "decodedData";
+    retRoles[packetRole] = "packet";
+    retRoles[rssiRole] = "rssi";
+    retRoles[positionRole] = "position";
+    return retRoles;
+}
+
+/**
+ * @brief Returns every available data (timestamp, source, type, encoding, auth, satellite, decodedData,
+ * readableQString - in this order) about the packet in the row \p index
+ * @param index Row of the packet
+ * @return Returns a QList<QString> with a length of 8, or an empty list if the page of the row is not loaded
+ */
+QList<QString> PacketHistoryModel::detailedInformation(int index) const {
+    Q_ASSERT(index >= 0 && index < rowCount_priv);
+    QList<QString> ret;
+    const PacketRecord *tmp = record(index);
+    if (tmp != nullptr) {
+        ret << tmp->timestampString() << tmp->source() << tmp->type();
+        ret << tmp->encoding() << tmp->authHex() << tmp->satelliteName() << tmp->dataHex() << tmp->readableQString();
+    }
+    return ret;
+}
+
+/**
+ * @brief Returns the readableQString of the packet in the row \p index
+ * @param index Row of the packet
+ */
+QString PacketHistoryModel::readableQString(int index) const {
+    Q_ASSERT(index >= 0 && index < rowCount_priv);
+    const PacketRecord *packet = record(index);
+    return packet != nullptr ? packet->readableQString() : QString();
+}
+
+QVariant PacketHistoryModel::getPacket(int index) const {
+    Q_ASSERT(index >= 0 && index < rowCount_priv);
+    const PacketRecord *packet = record(index);
+    return packet != nullptr ? packet->packet() : QVariant();
+}
+
+QString PacketHistoryModel::getSatelliteName(int index) const {
+    Q_ASSERT(index >= 0 && index < rowCount_priv);
+    const PacketRecord *packet = record(index);
+    return packet != nullptr ? packet->satelliteName() : QString();
+}
+
+/**
+ * @brief Copies the decodedData of the packet in the row \p index
+ * @param index Row of the packet
+ */
+void PacketHistoryModel::copyToClipboard(int index) const {
+    Q_ASSERT(index >= 0 && index < rowCount_priv);
+    const PacketRecord *packet = record(index);
+    if (packet != nullptr) {
+        clipboard->setText(packet->dataHex());
+    }
+}
+
+/**
+ * @brief Checks the archive for new frames on the worker thread, see PacketHistoryModel::scanFinished()
+ *
+ * Only the last known segment and the segments after it are counted again, the earlier segments are complete. The
+ * keys (see PacketHistoryModel::RowKey) are only read for the new frames.
+ */
+void PacketHistoryModel::refresh() {
+    if (scanning_priv) {
+        return;
+    }
+    scanning_priv = true;
+    const QString dirString = logDirString_priv;
+    const QSet<QString> previousSegments = previousSegments_priv;
+    ScanResult result = {segments_priv, QVector<RowKey>(), sources_priv, encodings_priv};
+    pool_priv.start(new FunctionJob([this, dirString, previousSegments, result]() mutable {
+        QVector<Segment> &segments = result.segments;
+        qint64 knownFrames = 0;
+        QString lastPath;
+        if (!segments.isEmpty()) {
+            knownFrames = segments.last().frameCount;
+            lastPath = segments.last().path;
+            segments.removeLast();
+        }
+        qint64 firstRow = segments.isEmpty() ? 0 : segments.last().firstRow + segments.last().frameCount;
+        const QStringList paths = PacketArchive::segmentFiles(dirString);
+        for (const auto &path : paths) {
+            if (previousSegments.contains(path)) {
+                continue;
+            }
+            bool counted = false;
+            for (const auto &segment : segments) {
+                counted = counted || segment.path == path;
+            }
+            if (counted) {
+                continue;
+            }
+            PacketArchiveReader reader(path);
+            const bool open = reader.open();
+            const qint64 frameCount = open ? reader.frameCount() : 0;
+            const qint64 firstNew = path == lastPath ? knownFrames : 0;
+            const int keysBefore = result.keys.size();
+            if (open && frameCount > firstNew) {
+                reader.forRange(firstNew, frameCount - firstNew, [&result](const ArchivedFrame &frame) {
+                    const RowKey key = {frame.packetType,
+                        PacketArchive::satelliteCode(frame.satellite),
+                        intern(result.sources, frame.source),
+                        intern(result.encodings, frame.encoding)};
+                    result.keys.append(key);
+                    return true;
+                });
+            }
+            // Frames that could not be read have the key of a frame without a packet
+            const RowKey unreadable = {PacketArchive::noPacketType, 0xFF, 0xFF, 0xFF};
+            while (result.keys.size() - keysBefore < frameCount - firstNew) {
+                result.keys.append(unreadable);
+            }
+            segments.append({path, firstRow, frameCount});
+            firstRow += frameCount;
+        }
+        // The pool is owned by the model and waits for its jobs before the model is gone, and queued calls to a
+        // deleted receiver are discarded
+        QMetaObject::invokeMethod(
+            this, [this, result]() { scanFinished(result); }, Qt::QueuedConnection);
+    }));
+}
+
+/**
+ * @brief Takes over the result of a scan and appends the new frames to the end of the table
+ * @param result Every segment of the session with its frame count, and the keys of the new frames
+ */
+void PacketHistoryModel::scanFinished(const ScanResult &result) {
+    scanning_priv = false;
+    const QVector<Segment> &segments = result.segments;
+    const qint64 frames = segments.isEmpty() ? 0 : segments.last().firstRow + segments.last().frameCount;
+    const int newRowCount = static_cast<int>(std::min<qint64>(frames, std::numeric_limits<int>::max()));
+    if (newRowCount <= rowCount_priv) {
+        return;
+    }
+    const bool newOptions = sources_priv.size() != result.sources.size() ||
+                            encodings_priv.size() != result.encodings.size();
+    // The last page may have been loaded before it was full
+    pages_priv.remove(rowCount_priv / pageSize);
+    beginInsertRows(QModelIndex(), rowCount_priv, newRowCount - 1);
+    segments_priv = segments;
+    keys_priv += result.keys.mid(0, newRowCount - rowCount_priv);
+    sources_priv = result.sources;
+    encodings_priv = result.encodings;
+    rowCount_priv = newRowCount;
+    endInsertRows();
+    if (newOptions) {
+        emit optionsChanged();
+    }
+}
+
+/**
+ * @brief Returns the index of \p value in \p values, appends it if it is not there yet
+ * @return The index, 0xFF if \p values is full
+ */
+quint8 PacketHistoryModel::intern(QStringList &values, const QString &value) {
+    int index = values.indexOf(value);
+    if (index < 0 && values.size() < 0xFF) {
+        values.append(value);
+        index = values.size() - 1;
+    }
+    return index < 0 ? 0xFF : static_cast<quint8>(index);
+}
+
+/**
+ * @brief Returns the key of the row \p row, it can be read without loading the page of the row
+ */
+PacketHistoryModel::RowKey PacketHistoryModel::rowKey(int row) const {
+    Q_ASSERT(row >= 0 && row < rowCount_priv);
+    return keys_priv.at(row);
+}
+
+/**
+ * @brief Returns the sources that the frames of the session were received from, indexed by RowKey::source
+ */
+const QStringList &PacketHistoryModel::sources() const {
+    return sources_priv;
+}
+
+/**
+ * @brief Returns the encodings of the frames of the session, indexed by RowKey::encoding
+ */
+const QStringList &PacketHistoryModel::encodings() const {
+    return encodings_priv;
+}
+
+/**
+ * @brief Returns the segments that the rows are read from. The copy can be used on any thread, see
+ * PacketHistoryModel::forEachFrame().
+ */
+QVector<PacketHistoryModel::Segment> PacketHistoryModel::segments() const {
+    return segments_priv;
+}
+
+/**
+ * @brief Calls \p callback with the frames of the rows [\p first, \p last) of \p segments, in the order of the rows
+ * @param segments The segments of the rows, see PacketHistoryModel::segments()
+ * @param first The first row
+ * @param last The row after the last row
+ * @param callback Called with the row and the frame, returning false stops the iteration
+ */
+void PacketHistoryModel::forEachFrame(const QVector<Segment> &segments,
+    qint64 first,
+    qint64 last,
+    const std::function<bool(qint64 row, const ArchivedFrame &frame)> &callback) {
+    for (const auto &segment : segments) {
+        const qint64 segmentEnd = segment.firstRow + segment.frameCount;
+        if (segmentEnd <= first || segment.firstRow >= last) {
+            continue;
+        }
+        PacketArchiveReader reader(segment.path);
+        if (!reader.open()) {
+            return;
+        }
+        const qint64 from = std::max(first, segment.firstRow);
+        const qint64 to = std::min(last, segmentEnd);
+        qint64 row = from;
+        const bool keepGoing = reader.forRange(from - segment.firstRow, to - from, [&](const ArchivedFrame &frame) {
+            return callback(row++, frame);
+        });
+        if (!keepGoing) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Returns the record of an archived frame. Frames that are not valid packets of their satellite (e.g. they
+ * were received while no satellite was selected) get a record without a parsed packet.
+ */
+PacketRecord PacketHistoryModel::recordFromFrame(const ArchivedFrame &frame) {
+    PacketRecord record = PacketDecoder::parseArchivedFrame(frame);
+    if (record.isNull()) {
+        record = PacketRecord(frame.timestamp,
+            frame.source,
+            QStringLiteral("Invalid packet"),
+            frame.encoding,
+            frame.satellite,
+            QByteArray(),
+            QByteArray(frame.decoded.constData(), frame.decoded.size()),
+            QString(),
+            QVariant::fromValue(false),
+            frame.rssi,
+            frame.position);
+    }
+    return record;
+}
+
+/**
+ * @brief Returns the packet in the row \p row if its page is loaded, otherwise requests the page
+ * @return The packet, or nullptr if the page is not loaded yet
+ */
+const PacketRecord *PacketHistoryModel::record(int row) const {
+    const int page = row / pageSize;
+    const QVector<PacketRecord> *records = pages_priv.object(page);
+    if (records == nullptr) {
+        requestPage(page);
+        return nullptr;
+    }
+    // Rows that could not be read from the archive stay empty
+    return row - page * pageSize < records->size() ? &records->at(row - page * pageSize) : nullptr;
+}
+
+/**
+ * @brief Loads the page \p page on the worker thread unless it is already being loaded, see
+ * PacketHistoryModel::pageLoaded()
+ */
+void PacketHistoryModel::requestPage(int page) const {
+    if (requestedPages_priv.contains(page)) {
+        return;
+    }
+    requestedPages_priv.insert(page);
+    const qint64 first = static_cast<qint64>(page) * pageSize;
+    const qint64 last = std::min<qint64>(first + pageSize, rowCount_priv);
+    const QVector<Segment> segments = segments_priv;
+    PacketHistoryModel *model = const_cast<PacketHistoryModel *>(this);
+    pool_priv.start(new FunctionJob([model, page, first, last, segments]() {
+        QVector<PacketRecord> records;
+        records.reserve(static_cast<int>(last - first));
+        forEachFrame(segments, first, last, [&records](qint64, const ArchivedFrame &frame) {
+            records.append(recordFromFrame(frame));
+            return true;
+        });
+        const int requested = static_cast<int>(last - first);
+        QMetaObject::invokeMethod(
+            model, [model, page, requested, records]() { model->pageLoaded(page, requested, records); },
+            Qt::QueuedConnection);
+    }));
+}
+
+/**
+ * @brief Stores a loaded page in the cache and notifies the views
+ * @param page Index of the page
+ * @param requested Number of rows that the page had when it was requested
+ * @param records The rows of the page, fewer than PacketHistoryModel::pageSize if the page is not full
+ */
+void PacketHistoryModel::pageLoaded(int page, int requested, const QVector<PacketRecord> &records) {
+    requestedPages_priv.remove(page);
+    const int first = page * pageSize;
+    // If rows were added to the page while it was loaded, it is requested again when the views ask for them
+    if (first + requested >= rowCount_priv || requested == pageSize) {
+        pages_priv.insert(page, new QVector<PacketRecord>(records));
+    }
+    if (records.size() > 0) {
+        emit dataChanged(index(first, 0), index(first + records.size() - 1, columnCount() - 1));
+    }
+}
@@ -0,0 +1,138 @@
+#ifndef PACKETHISTORYMODEL_H
+#define PACKETHISTORYMODEL_H
+
+#include "../packet/packetarchive.h"
+#include "../packet/packetrecord.h"
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QClipboard>
+#include <QSet>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVariant>
+#include <QVector>
+#include <functional>
+
+/**
+ * @brief Table of every packet of the session, read from the packet archive (see PacketArchiveWriter).
+ *
+ * The model has the same roles and invokable methods as PacketTableModel, but its rows are the frames of the archive
+ * segments that have been started since the model was created, the oldest first. Only the number of frames in each
+ * segment is kept in memory. Rows are decoded a page (PacketHistoryModel::pageSize rows) at a time on a worker thread
+ * and kept in a least recently used cache of PacketHistoryModel::maxPages pages, so the memory use does not depend on
+ * the length of the session. Rows of pages that are not loaded yet are empty, the views are notified when the page
+ * arrives.
+ *
+ * The archive is checked for new frames every PacketHistoryModel::refreshInterval milliseconds, new rows are
+ * appended to the end of the table. The scan also reads a four byte key of every new frame (packet type, satellite,
+ * source, encoding), which PacketFilterModel indexes without loading any page.
+ */
+class PacketHistoryModel : public QAbstractTableModel {
+    Q_OBJECT
+
+    /**
+     * @brief The roles that identify the fields in the table, the same as the roles of PacketTableModel
+     */
+    enum roles {
+        timestampRole = Qt::UserRole + 1, //!< Role that represents the timestamp
+        sourceRole,                       //!< Role that represents the source of the packet
+        typeRole,                         //!< Role that represents the type of the packet
+        encodingRole,                     //!< Role that represents the encoding used
+        authRole,                         //!< Role that represents the authentication segment
+        satelliteRole,                    //!< Role that represents the satellite
+        decodedDataRole,                  //!< Role that represents raw packet data
+        packetRole,                       //!< Role that represents the packet wrapped in a QVariant
+        rssiRole,                         //!< Role that represents the rssi
+        positionRole,                     //!< Role that represents the position in the recording, empty if live
+    };
+
+public:
+    /**
+     * @brief A segment of the archive and the rows of the table that its frames belong to
+     */
+    struct Segment {
+        QString path;
+        qint64 firstRow;   //!< Row of the first frame of the segment
+        qint64 frameCount; //!< Number of valid frames in the segment
+    };
+
+    /**
+     * @brief The fields of a row that can be filtered on, read from the frame headers
+     */
+    struct RowKey {
+        quint8 packetType; //!< First byte of the packet, PacketArchive::noPacketType if nothing was decoded
+        quint8 satellite;  //!< See PacketArchive::satelliteCode()
+        quint8 source;     //!< Index in PacketHistoryModel::sources()
+        quint8 encoding;   //!< Index in PacketHistoryModel::encodings()
+    };
+
+    PacketHistoryModel(const QString &logDirString, QClipboard *clipboard, QObject *parent = 0);
+
+    int columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE QList<QString> detailedInformation(int index) const;
+    Q_INVOKABLE QString readableQString(int index) const;
+    Q_INVOKABLE QVariant getPacket(int index) const;
+    Q_INVOKABLE QString getSatelliteName(int index) const;
+    Q_INVOKABLE void copyToClipboard(int index) const;
+
+    RowKey rowKey(int row) const;
+    const QStringList &sources() const;
+    const QStringList &encodings() const;
+    QVector<Segment> segments() const;
+    static void forEachFrame(const QVector<Segment> &segments,
+        qint64 first,
+        qint64 last,
+        const std::function<bool(qint64 row, const ArchivedFrame &frame)> &callback);
+    static PacketRecord recordFromFrame(const ArchivedFrame &frame);
+
+public slots:
+    void refresh();
+
+signals:
+    /**
+     * @brief Emitted when a frame with a new source or encoding has been found
+     */
+    void optionsChanged();
+
+private:
+    /**
+     * @brief Result of a scan of the archive, see PacketHistoryModel::refresh()
+     */
+    struct ScanResult {
+        QVector<Segment> segments;
+        QVector<RowKey> keys; //!< Keys of the frames that are new since the previous scan
+        QStringList sources;
+        QStringList encodings;
+    };
+
+    static constexpr int pageSize = 256;         //!< Rows that are loaded at once
+    static constexpr int maxPages = 64;          //!< Pages that are kept in the cache
+    static constexpr int refreshInterval = 1000; //!< Time between two checks of the archive [ms]
+
+    const PacketRecord *record(int row) const;
+    void requestPage(int page) const;
+    void pageLoaded(int page, int requested, const QVector<PacketRecord> &records);
+    void scanFinished(const ScanResult &result);
+    static quint8 intern(QStringList &values, const QString &value);
+
+    QString logDirString_priv;             //!< Directory of the archive
+    QSet<QString> previousSegments_priv;   //!< Segments of earlier sessions, they are not shown
+    QClipboard *clipboard;                 //!< Pointer to the clipboard
+    QVector<Segment> segments_priv;        //!< The segments of the session, the oldest first
+    int rowCount_priv;                     //!< Number of frames in \p segments_priv
+    QVector<RowKey> keys_priv;             //!< Keys of the rows
+    QStringList sources_priv;              //!< Sources of the frames, see RowKey::source
+    QStringList encodings_priv;            //!< Encodings of the frames, see RowKey::encoding
+    bool scanning_priv;                    //!< True while the archive is being checked for new frames
+    mutable QCache<int, QVector<PacketRecord>> pages_priv; //!< Loaded pages, keyed by their index
+    mutable QSet<int> requestedPages_priv; //!< Pages that are being loaded
+    QTimer refreshTimer_priv;              //!< The timer that starts PacketHistoryModel::refresh()
+    mutable QThreadPool pool_priv; //!< Worker thread of the scans and the page loads, destroyed (and waited for) first
+};
+
+#endif // PACKETHISTORYMODEL_H
@@ -0,0 +1,222 @@
+#include "packetrecord.h"
+
+namespace {
+/**
+ * @brief Returns the shared contents of every null record, so that the accessors never have to check for null.
+ */
+template <typename Data> const QSharedPointer<const Data> &emptyData() {
+    static const QSharedPointer<const Data> empty = QSharedPointer<Data>::create();
+    return empty;
+}
+} // namespace
+
+/**
+ * @brief Constructs a null record.
+ */
+PacketRecord::PacketRecord() : d_priv(emptyData<Data>()) {
+}
+
+/**
+ * @brief Constructs a record of a decoded packet whose readable text is already known.
+ * @param timestamp Time of reception
+ * @param source Source of the packet
+ * @param type Type of the packet
+ * @param encoding Encoding of the packet
+ * @param satellite The satellite that the packet was received for
+ * @param auth Authentication segment of the packet
+ * @param data Full, decoded data of the packet
+ * @param readableQString The contents of the packet as a readable QString
+ * @param packet Contents of the packet wrapped in a QVariant
+ * @param rssi The RSSI that the packet was received with
+ * @param position Position in the recording that the packet was decoded from [samples], -1 if it was not
+ */
+PacketRecord::PacketRecord(const QDateTime &timestamp,
+    const QString &source,
+    const QString &type,
+    const QString &encoding,
+    SatelliteChanger::Satellites satellite,
+    const QByteArray &auth,
+    const QByteArray &data,
+    const QString &readableQString,
+    const QVariant &packet,
+    int rssi,
+    qint64 position)
+    : PacketRecord(
+          timestamp, source, type, encoding, satellite, auth, data, Renderer(nullptr), packet, rssi, position) {
+    d_priv->readableQString = readableQString;
+}
+
+/**
+ * @brief Constructs a record of a decoded packet whose readable text is rendered by \p renderer on first access.
+ * @param timestamp Time of reception
+ * @param source Source of the packet
+ * @param type Type of the packet
+ * @param encoding Encoding of the packet
+ * @param satellite The satellite that the packet was received for
+ * @param auth Authentication segment of the packet
+ * @param data Full, decoded data of the packet
+ * @param renderer Renders the readable text from \p packet and \p satellite
+ * @param packet Contents of the packet wrapped in a QVariant
+ * @param rssi The RSSI that the packet was received with
+ * @param position Position in the recording that the packet was decoded from [samples], -1 if it was not
+ */
+PacketRecord::PacketRecord(const QDateTime &timestamp,
+    const QString &source,
+    const QString &type,
+    const QString &encoding,
+    SatelliteChanger::Satellites satellite,
+    const QByteArray &auth,
+    const QByteArray &data,
+    Renderer renderer,
+    const QVariant &packet,
+    int rssi,
+    qint64 position) {
+    auto d = QSharedPointer<Data>::create();
+    d->timestamp = timestamp;
+    d->source = source;
+    d->type = type;
+    d->encoding = encoding;
+    d->satellite = satellite;
+    d->auth = auth;
+    d->data = data;
+    d->renderer = renderer;
+    d->packet = packet;
+    d->rssi = rssi;
+    d->position = position;
+    d_priv = d;
+}
+
+/**
+ * @brief Returns true if the record was default constructed.
+ */
+bool PacketRecord::isNull() const {
+    return d_priv == emptyData<Data>();
+}
+
+const QDateTime &PacketRecord::timestamp() const {
+    return d_priv->timestamp;
+}
+
+const QString &PacketRecord::source() const {
+    return d_priv->source;
+}
+
+const QString &PacketRecord::type() const {
+    return d_priv->type;
+}
+
+const QString &PacketRecord::encoding() const {
+    return d_priv->encoding;
+}
+
+SatelliteChanger::Satellites PacketRecord::satellite() const {
+    return d_priv->satellite;
+}
+
+const QByteArray &PacketRecord::auth() const {
+    return d_priv->auth;
+}
+
+const QByteArray &PacketRecord::data() const {
+    return d_priv->data;
+}
+
+/**
+ * @brief Returns the contents of the packet as a readable QString. Rendered on first access.
+ */
+QString PacketRecord::readableQString() const {
+    if (!d_priv->renderer) {
+        return d_priv->readableQString;
+    }
+    return cached(d_priv->readableQString,
+        d_priv->cacheMutex,
+        [](const Data &d) { return d.renderer(d.packet, d.satellite); },
+        *d_priv);
+}
+
+const QVariant &PacketRecord::packet() const {
+    return d_priv->packet;
+}
+
+int PacketRecord::rssi() const {
+    return d_priv->rssi;
+}
+
+/**
+ * @brief Returns the position in the recording that the packet was decoded from [samples], -1 if it was not
+ */
+qint64 PacketRecord::position() const {
+    return d_priv->position;
+}
+
+/**
+ * @brief Returns the timestamp formatted as an ISO 8601 QString. Formatted on first access.
+ */
+QString PacketRecord::timestampString() const {
+    return cached(d_priv->timestampString,
+        d_priv->cacheMutex,
+        [](const Data &d) { return d.timestamp.toString(Qt::ISODate); },
+        *d_priv);
+}
+
+/**
+ * @brief Returns the authentication segment as an UPPERCASE hex encoded QString. Encoded on first access.
+ */
+QString PacketRecord::authHex() const {
+    return cached(d_priv->authHex,
+        d_priv->cacheMutex,
+        [](const Data &d) { return QString(d.auth.toHex()).toUpper(); },
+        *d_priv);
+}
+
+/**
+ * @brief Returns the decoded data as an UPPERCASE hex encoded QString. Encoded on first access.
+ */
+QString PacketRecord::dataHex() const {
+    return cached(d_priv->dataHex,
+        d_priv->cacheMutex,
+        [](const Data &d) { return QString(d.data.toHex()).toUpper(); },
+        *d_priv);
+}
+
+/**
+ * @brief Returns the name of the satellite that the packet was received for.
+ */
+QString PacketRecord::satelliteName() const {
+    return satelliteName(d_priv->satellite);
+}
+
+/**
+ * @brief Returns the display name of \p satellite.
+ * @param satellite The satellite
+ * @return The name of the satellite, "UNSET" if no satellite has been selected
+ */
+QString PacketRecord::satelliteName(SatelliteChanger::Satellites satellite) {
+    switch (satellite) {
+    case SatelliteChanger::Satellites::SMOG1:
+        return QStringLiteral("SMOG-1");
+    case SatelliteChanger::Satellites::SMOGP:
+        return QStringLiteral("SMOG-P");
+    case SatelliteChanger::Satellites::ATL1:
+        return QStringLiteral("ATL-1");
+    case SatelliteChanger::Satellites::UNSET:
+        break;
+    }
+    return QStringLiteral("UNSET");
+}
+
+/**
+ * @brief Returns \p cache, filling it with \p compute first if it is still empty.
+ * @param cache The cached string form inside the shared data
+ * @param mutex The mutex that guards \p cache
+ * @param compute Computes the string form from the shared data
+ * @param d The shared data
+ * @return The cached string form
+ */
+QString PacketRecord::cached(QString &cache, QMutex &mutex, QString (*compute)(const Data &), const Data &d) {
+    QMutexLocker locker(&mutex);
+    if (cache.isNull()) {
+        cache = compute(d);
+    }
+    return cache;
+}
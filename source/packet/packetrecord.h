@@ -0,0 +1,104 @@
+#ifndef PACKETRECORD_H
+#define PACKETRECORD_H
+
+#include "../utilities/satellitechanger.h"
+#include <QByteArray>
+#include <QDateTime>
+#include <QMetaType>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVariant>
+
+/**
+ * @brief Immutable record of a packet that has been decoded.
+ *
+ * The record is implicitly shared: copies only bump a reference count, so the table, the uploader and QML all
+ * reference the same decoded bytes. The string forms that are only needed for display or upload (timestamp, hex
+ * encoded data and auth, readable text) are computed on first access and cached. The record can be read from any
+ * thread.
+ */
+class PacketRecord {
+public:
+    /**
+     * @brief Renders the readable text of a packet from its typed contents, see PacketFormatter::render()
+     */
+    typedef QString (*Renderer)(const QVariant &packet, SatelliteChanger::Satellites satellite);
+
+    PacketRecord();
+    PacketRecord(const QDateTime &timestamp,
+        const QString &source,
+        const QString &type,
+        const QString &encoding,
+        SatelliteChanger::Satellites satellite,
+        const QByteArray &auth,
+        const QByteArray &data,
+        const QString &readableQString,
+        const QVariant &packet,
+        int rssi,
+        qint64 position = -1);
+    PacketRecord(const QDateTime &timestamp,
+        const QString &source,
+        const QString &type,
+        const QString &encoding,
+        SatelliteChanger::Satellites satellite,
+        const QByteArray &auth,
+        const QByteArray &data,
+        Renderer renderer,
+        const QVariant &packet,
+        int rssi,
+        qint64 position = -1);
+
+    bool isNull() const;
+
+    const QDateTime &timestamp() const;
+    const QString &source() const;
+    const QString &type() const;
+    const QString &encoding() const;
+    SatelliteChanger::Satellites satellite() const;
+    const QByteArray &auth() const;
+    const QByteArray &data() const;
+    QString readableQString() const;
+    const QVariant &packet() const;
+    int rssi() const;
+    qint64 position() const;
+
+    QString timestampString() const;
+    QString authHex() const;
+    QString dataHex() const;
+    QString satelliteName() const;
+
+    static QString satelliteName(SatelliteChanger::Satellites satellite);
+
+private:
+    /**
+     * @brief The shared, immutable contents of a record. Only the cached string forms are written after construction.
+     */
+    struct Data {
+        QDateTime timestamp;                    //!< Time of reception
+        QString source;                         //!< Source of the packet (audio, sdr, etc.)
+        QString type;                           //!< Type of the packet (telemetry1, etc.)
+        QString encoding;                       //!< Encoding of the packet (ao40short, ao40, racoder)
+        SatelliteChanger::Satellites satellite = SatelliteChanger::Satellites::UNSET; //!< Satellite of the packet
+        QByteArray auth;                        //!< The authentication segment of the packet
+        QByteArray data;                        //!< The decoded bytes of the packet
+        Renderer renderer = nullptr;            //!< Renders \p readableQString on first access if set
+        QVariant packet;                        //!< Contents of the packet wrapped in a QVariant
+        int rssi = 0;                           //!< The RSSI that the packet was received with
+        qint64 position = -1;                   //!< Position in the recording that it was decoded from, -1 if none
+
+        mutable QMutex cacheMutex;       //!< Guards the cached string forms below
+        mutable QString timestampString; //!< Cached ISO 8601 form of \p timestamp
+        mutable QString authHex;         //!< Cached UPPERCASE hex form of \p auth
+        mutable QString dataHex;         //!< Cached UPPERCASE hex form of \p data
+        mutable QString readableQString; //!< Contents of the packet as a readable QString, rendered by \p renderer
+    };
+
+    static QString cached(QString &cache, QMutex &mutex, QString (*compute)(const Data &), const Data &d);
+
+    QSharedPointer<const Data> d_priv;
+};
+
+Q_DECLARE_METATYPE(PacketRecord)
+
+#endif // PACKETRECORD_H
@@ -3,8 +3,8 @@
 /**
  * @brief Constructor for the class.
  *
- * Sets \p PacketTableModel::clipboard to \p clipboard and initializes \p insertAtEnd_priv to true.
- * Starts \p PPSTimer_priv.
+ * Sets \p PacketTableModel::clipboard to \p clipboard and initializes \p insertAtEnd_priv to false.
+ * Allocates the ring buffer and starts \p PPSTimer_priv.
  *
  * @param[in] clipboard Pointer to the QClipboard objects that gives access to the clipboard
  * @param[in] parent Parent QObject, should be left empty.
@@ -15,6 +15,12 @@ PacketTableModel::PacketTableModel(QClipboard *clipboard, QObject *parent) : QAb
     insertAtEnd_priv = false;
     selectedRow_priv = -1;
     PPS_priv = 0;
+    packets_priv.resize(MAXPACKETSLEN);
+    head_priv = 0;
+    count_priv = 0;
+    flushTimer_priv.setSingleShot(true);
+    flushTimer_priv.setInterval(frameInterval);
+    QObject::connect(&flushTimer_priv, &QTimer::timeout, this, &PacketTableModel::flushPending);
     QObject::connect(&PPSTimer_priv, &QTimer::timeout, [&]() {
         PPS_priv = 0;
         emit currentPPSChanged(PPS_priv);
@@ -43,13 +49,13 @@ int PacketTableModel::columnCount(const QModelIndex &parent) const {
  * @return Returns 0 if \p parent is valid. Check Qt documentation for QAbstractItemModel.
  */
 int PacketTableModel::rowCount(const QModelIndex &parent) const {
-    return parent.isValid() ? 0 : packets_priv.length();
+    return parent.isValid() ? 0 : count_priv;
 }
 
 /**
  * @brief Returns the data stored under the given role for the item referred to by the index.
  *
- * Return the corresponding \p index th element from \p packets_priv.
+ * Return the corresponding \p index th row from \p packets_priv.
  *
  * @param[in] index The index for the element that you want returned.
  * @param[in] role The role for the element that you want returned.
@@ -57,33 +63,36 @@ int PacketTableModel::rowCount(const QModelIndex &parent) const {
  * QVariant if the role was invalid.
  */
 QVariant PacketTableModel::data(const QModelIndex &index, int role) const {
-    Q_ASSERT(index.row() >= 0 && index.row() < packets_priv.length());
+    Q_ASSERT(index.row() >= 0 && index.row() < count_priv);
+    const PacketRecord &record = at(index.row());
     switch (role) {
     case timestampRole:
-        return packets_priv.at(index.row()).timestamp;
+        return record.timestampString();
     case sourceRole:
-        return packets_priv.at(index.row()).source;
+        return record.source();
     case typeRole:
-        return packets_priv.at(index.row()).type;
+        return record.type();
     case encodingRole:
-        return packets_priv.at(index.row()).encoding;
+        return record.encoding();
     case authRole:
-        return packets_priv.at(index.row()).auth;
+        return record.authHex();
     case satelliteRole:
-        return packets_priv.at(index.row()).satellite;
+        return record.satelliteName();
     case decodedDataRole:
-        return packets_priv.at(index.row()).decodedData;
+        return record.dataHex();
     case packetRole:
-        return packets_priv.at(index.row()).packet;
+        return record.packet();
     case rssiRole:
-        return packets_priv.at(index.row()).rssi;
+        return record.rssi();
+    case positionRole:
+        return record.position() >= 0 ? QString::number(record.position()) : QString();
     default:
         return QVariant();
     }
 }
 
 Qt::ItemFlags PacketTableModel::flags(const QModelIndex &index) const {
-    if (index.row() < 0 || index.row() >= packets_priv.length()) {
+    if (index.row() < 0 || index.row() >= count_priv) {
         return Qt::NoItemFlags;
     }
     else {
@@ -92,72 +101,94 @@ Qt::ItemFlags PacketTableModel::flags(const QModelIndex &index) const {
 }
 
 /**
- * @brief Add a new row to the table with the data \p newData.
+ * @brief Queues a new row with the data \p newData.
  *
- * Depending on \p insertAtEnd_priv it is either appended to the end or inserted to the beginning of \p packets_priv.
+ * The queued rows are inserted by PacketTableModel::flushPending() at the next display frame, so a burst of packets
+ * is a single insertion for the views. \p packetAdded is still emitted for every packet.
  *
- * @param[in] newData New packet that should be added to \p packets.
+ * @param[in] newData New packet that should be added to \p packets_priv.
  */
-void PacketTableModel::addData(PacketData newData) {
-    emit packetAdded(newData.packet);
+void PacketTableModel::addData(const PacketRecord &newData) {
+    emit packetAdded(newData.packet());
 
     PPS_priv += 1;
+    pending_priv.append(newData);
+    if (!flushTimer_priv.isActive()) {
+        flushTimer_priv.start();
+    }
+}
+
+/**
+ * @brief Inserts the queued packets into the ring buffer.
+ *
+ * Depending on \p insertAtEnd_priv they appear at the end or at the beginning of the table. If the table is full, the
+ * oldest packets are removed first. The selected row moves with the packet it refers to, and it is set to -1 if that
+ * packet has been removed.
+ */
+void PacketTableModel::flushPending() {
+    if (pending_priv.isEmpty()) {
+        return;
+    }
     emit currentPPSChanged(PPS_priv);
-    if (insertAtEnd_priv) {
-        if (packets_priv.length() >= MAXPACKETSLEN) {
-            beginRemoveRows(QModelIndex(), 0, 0);
-            packets_priv.removeFirst();
-            endRemoveRows();
+
+    // Packets that would be removed in the same batch are not inserted at all
+    const int skipped = std::max(0, pending_priv.size() - MAXPACKETSLEN);
+    const int inserted = pending_priv.size() - skipped;
+    const int removed = std::max(0, count_priv + inserted - MAXPACKETSLEN);
+
+    if (removed > 0) {
+        if (insertAtEnd_priv) {
+            beginRemoveRows(QModelIndex(), 0, removed - 1);
         }
-        beginInsertRows(QModelIndex(),
-            std::max(0, packets_priv.length() - 1),
-            std::max(0, packets_priv.length() - 1)); // A lot less CPU consumption since we don't have to draw as much
-        packets_priv.append(newData);
-    }
-    else {
-        if (packets_priv.length() >= MAXPACKETSLEN) {
-            beginRemoveRows(QModelIndex(), packets_priv.length() - 1, packets_priv.length() - 1);
-            packets_priv.removeLast();
-            endRemoveRows();
+        else {
+            beginRemoveRows(QModelIndex(), count_priv - removed, count_priv - 1);
         }
-        beginInsertRows(QModelIndex(), 0, 0); // Uses a lot of CPU time due to the constant drawing
-        packets_priv.prepend(newData);
+        for (int i = 0; i < removed; i++) {
+            packets_priv[(head_priv + i) % MAXPACKETSLEN] = PacketRecord();
+        }
+        head_priv = (head_priv + removed) % MAXPACKETSLEN;
+        count_priv -= removed;
+        endRemoveRows();
     }
-    endInsertRows();
-    auto sr = selectedRow();
-    // If no row is selected, then no row should be selected after inserting
-    // If the insertion is top insertion, then the selected row should shift "down" (unless it's at the end)
-    // If the insertion is bottom insertion, then the selected row should not change
-    // When the list is full and an insertion occurs, the selected row needs to shift regardless of insertion type
-    // If the selected row gets out of range, it is set to -1
-    if (sr == -1) {
-        // Intentionally no operation when no row is selected
+
+    if (insertAtEnd_priv) {
+        beginInsertRows(QModelIndex(), count_priv, count_priv + inserted - 1);
     }
     else {
-        if (packets_priv.length() >= MAXPACKETSLEN) {
-            if (insertAtEnd_priv) {
-                if (sr <= 0) {
-                    setSelectedRow(-1);
-                }
-                else {
-                    setSelectedRow(sr - 1);
-                }
-            }
-            else {
-                if (selectedRow() == MAXPACKETSLEN - 1) {
-                    setSelectedRow(-1);
-                }
-                else {
-                    setSelectedRow(sr + 1);
-                }
-            }
-        }
-        else {
-            setSelectedRow(insertAtEnd_priv ? sr : sr + 1);
-        }
+        beginInsertRows(QModelIndex(), 0, inserted - 1);
+    }
+    for (int i = skipped; i < pending_priv.size(); i++) {
+        packets_priv[(head_priv + count_priv) % MAXPACKETSLEN] = pending_priv.at(i);
+        count_priv++;
+    }
+    pending_priv.clear();
+    endInsertRows();
+
+    // With top insertion the selected row shifts "down" by the number of new rows, with bottom insertion it shifts
+    // "up" by the number of removed rows. If the selected row gets out of range, it is set to -1.
+    const int sr = selectedRow();
+    if (sr != -1) {
+        const int row = insertAtEnd_priv ? sr - removed : sr + inserted;
+        setSelectedRow(row >= 0 && row < count_priv ? row : -1);
     }
 }
 
+/**
+ * @brief Maps a row of the table onto an index of the ring buffer \p packets_priv
+ * @param row Row of the table, 0 is the newest packet unless \p insertAtEnd_priv is set
+ */
+int PacketTableModel::physicalIndex(int row) const {
+    const int offset = insertAtEnd_priv ? row : count_priv - 1 - row;
+    return (head_priv + offset) % MAXPACKETSLEN;
+}
+
+/**
+ * @brief Returns the packet in the row \p row of the table
+ */
+const PacketRecord &PacketTableModel::at(int row) const {
+    return packets_priv.at(physicalIndex(row));
+}
+
 /**
  * @brief Returns the value of \p _insertAtEnd.
  * @return Returns the value of \p _insertAtEnd.
@@ -167,14 +198,20 @@ bool PacketTableModel::insertAtEnd() const {
 }
 
 /**
- * @brief Sets \p _insertAtEnd to \p value. ALWAYS SETS TO FALSE
+ * @brief Sets \p _insertAtEnd to \p value.
+ *
+ * The rows are mapped onto the ring buffer in the opposite order afterwards, so the model is reset and the selection
+ * is cleared.
+ *
  * @param[in] value The new value for \p _insertAtEnd.
  */
 void PacketTableModel::setInsertAtEnd(bool value) {
-    (void) value;
-    insertAtEnd_priv = false;
-    // insertAtEnd_priv = value; // functionality disabled until the UI has been fixed
-    // inserting a row at the bottom displays incorrect values in the table!
+    if (insertAtEnd_priv != value) {
+        beginResetModel();
+        insertAtEnd_priv = value;
+        endResetModel();
+        setSelectedRow(-1);
+    }
     emit insertAtEndChanged(insertAtEnd_priv);
 }
 
@@ -211,6 +248,7 @@ QHash<int, QByteArray> PacketTableModel::roleNames() const {
     retRoles[decodedDataRole] = "decodedData";
     retRoles[packetRole] = "packet";
     retRoles[rssiRole] = "rssi";
+    retRoles[positionRole] = "position";
     return retRoles;
 }
 
@@ -221,11 +259,11 @@ QHash<int, QByteArray> PacketTableModel::roleNames() const {
  * @return Returns a QList<QString> with a length of 8
  */
 QList<QString> PacketTableModel::detailedInformation(int index) const {
-    Q_ASSERT(index >= 0 && index < packets_priv.length());
+    Q_ASSERT(index >= 0 && index < count_priv);
     QList<QString> ret;
-    PacketData tmp = packets_priv.at(index);
-    ret << tmp.timestamp << tmp.source << tmp.type;
-    ret << tmp.encoding << tmp.auth << tmp.satellite << tmp.decodedData << tmp.readableQString;
+    const PacketRecord &tmp = at(index);
+    ret << tmp.timestampString() << tmp.source() << tmp.type();
+    ret << tmp.encoding() << tmp.authHex() << tmp.satelliteName() << tmp.dataHex() << tmp.readableQString();
     return ret;
 }
 
@@ -235,18 +273,18 @@ QList<QString> PacketTableModel::detailedInformation(int index) const {
  * @return
  */
 QString PacketTableModel::readableQString(int index) const {
-    Q_ASSERT(index >= 0 && index < packets_priv.length());
-    return packets_priv.at(index).readableQString;
+    Q_ASSERT(index >= 0 && index < count_priv);
+    return at(index).readableQString();
 }
 
 QVariant PacketTableModel::getPacket(int index) const {
-    Q_ASSERT(index >= 0 && index < packets_priv.length());
-    return packets_priv.at(index).packet;
+    Q_ASSERT(index >= 0 && index < count_priv);
+    return at(index).packet();
 }
 
 QString PacketTableModel::getSatelliteName(int index) const {
-    Q_ASSERT(index >= 0 && index < packets_priv.length());
-    return packets_priv.at(index).satellite;
+    Q_ASSERT(index >= 0 && index < count_priv);
+    return at(index).satelliteName();
 }
 
 /**
@@ -254,46 +292,14 @@ QString PacketTableModel::getSatelliteName(int index) const {
  * @param index Index of the packet in \p packets_priv
  */
 void PacketTableModel::copyToClipboard(int index) const {
-    Q_ASSERT(index >= 0 && index < packets_priv.length());
-    clipboard->setText(packets_priv.at(index).decodedData);
+    Q_ASSERT(index >= 0 && index < count_priv);
+    clipboard->setText(at(index).dataHex());
 }
 
 /**
  * @brief Slot that is used to add new packets to the list. Calls PacketTableModel::addData()
- * @param timestamp QString Timestamp for the packet
- * @param source Source of the packet
- * @param type Type of the packet
- * @param encoding Encoding of the packet
- * @param authQString Authentication segment of the packet as a QString
- * @param satelliteString The satellite as a QString
- * @param decodedQString Full, decoded data of the packet as a QString
- * @param readableQString The contents of the packet as a readable QString
- * @param packet The full packet wrapped in a QVariant
- * @param rssi The rssi that the packet was received with
+ * @param record The decoded packet
  */
-void PacketTableModel::newPacket(QString timestamp,
-    QString source,
-    QString type,
-    QString encoding,
-    QString authQString,
-    QString satelliteString,
-    QString decodedQString,
-    QString readableQString,
-    QVariant packet,
-    int rssi) {
-
-    PacketData packetData = {
-        timestamp,
-        source,
-        type,
-        encoding,
-        authQString,
-        satelliteString,
-        decodedQString,
-        readableQString,
-        packet,
-        rssi
-    };
-
-    addData(packetData);
+void PacketTableModel::newPacket(PacketRecord record) {
+    addData(record);
 }
@@ -1,5 +1,6 @@
 #ifndef PACKETTABLEMODEL_H
 #define PACKETTABLEMODEL_H
+#include "packetrecord.h"
 #include <QAbstractTableModel>
 #include <QClipboard>
 #include <QDateTime>
@@ -9,28 +10,17 @@
 #include <QTextStream>
 #include <QTimer>
 #include <QVariant>
-
-/**
- * @brief Struct that stores information in a packet that has been decoded.
- */
-struct PacketData {
-
-    QString timestamp;       //!< Timestamp for the packet (as QString!)
-    QString source;          //!< Source of the packet (audio, sdr, etc.)
-    QString type;            //!< Type of the packet (telemetry1, etc.)
-    QString encoding;        //!< Encoding of the packet (ao40short, ao40, racoder)
-    QString auth;            //!< The authentication segment of the packet
-    QString satellite;       //!< The satellite
-    QString decodedData;     //!< Decoded data in the packet as an UPPERCASE Hex encoded QString
-    QString readableQString; //!< Contents of the packet as a readable QString
-    QVariant packet;         //!< Contents of the packet wrapped in a QVariant
-    int rssi;                //!< The rssi that the packet was received with
-};
+#include <QVector>
 
 /**
  * @brief Custom TableModel for storing timestamps and packet data.
  *
  * Every row represents a packet. There is also a timestamp for each packet.
+ *
+ * The last PacketTableModel::MAXPACKETSLEN packets are kept in a ring buffer, rows are mapped onto it depending on
+ * \p insertAtEnd_priv, so neither an insertion nor dropping the oldest packet moves the other packets. New packets
+ * are collected and inserted at most once per display frame (PacketTableModel::frameInterval), a burst of packets
+ * costs the views a single insertion and removal.
  */
 class PacketTableModel : public QAbstractTableModel {
     Q_OBJECT
@@ -51,6 +41,7 @@ class PacketTableModel : public QAbstractTableModel {
         decodedDataRole,                  //!< Role that represents raw packet data
         packetRole,                       //!< Role that represents the packet wrapped in a QVariant
         rssiRole,                         //!< Role that represents the rssi
+        positionRole,                     //!< Role that represents the position in the recording, empty if live
     };
 
 public:
@@ -61,7 +52,7 @@ public:
     int rowCount(const QModelIndex &parent = QModelIndex()) const;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
     Qt::ItemFlags flags(const QModelIndex &index) const;
-    void addData(PacketData newData);
+    void addData(const PacketRecord &newData);
 
     bool insertAtEnd() const;
     void setInsertAtEnd(bool value);
@@ -77,26 +68,27 @@ public:
     Q_INVOKABLE void copyToClipboard(int index) const;
 
 private:
-    const int MAXPACKETSLEN = 200;
-    QList<PacketData> packets_priv; //!< The list that is used to store the received PacketData objects.
-    bool insertAtEnd_priv;          //!< Defines where new packets will be added on the list (start/end)
-    QTimer PPSTimer_priv;           //!< The timer that updates the PPS value.
-    int selectedRow_priv;           //!< Index of the row that is currently selected on the UI
+    static constexpr int MAXPACKETSLEN = 200;
+    static constexpr int frameInterval = 16; //!< Minimum time between two insertions [ms]
+
+    void flushPending();
+    int physicalIndex(int row) const;
+    const PacketRecord &at(int row) const;
+
+    QVector<PacketRecord> packets_priv;  //!< Ring buffer of the received packets, MAXPACKETSLEN long
+    int head_priv;                       //!< Index of the oldest packet in \p packets_priv
+    int count_priv;                      //!< Number of packets in \p packets_priv
+    QVector<PacketRecord> pending_priv;  //!< Packets that have not been inserted yet, the oldest first
+    QTimer flushTimer_priv;              //!< Single shot timer that inserts \p pending_priv
+    bool insertAtEnd_priv;               //!< Defines where new packets will be added on the list (start/end)
+    QTimer PPSTimer_priv;                //!< The timer that updates the PPS value.
+    int selectedRow_priv;             //!< Index of the row that is currently selected on the UI
     int PPS_priv; //!< We keep a record of the packets per second metric in order to avoid too much writing on the
                   //!< screen.
     QClipboard *clipboard; //!< Pointer to the clipboard
 
 public slots:
-    void newPacket(QString timestamp,
-        QString source,
-        QString type,
-        QString encoding,
-        QString authQString,
-        QString satelliteString,
-        QString decodedQString,
-        QString readableQString,
-        QVariant packet,
-        int rssi);
+    void newPacket(PacketRecord record);
 
 signals:
     /**
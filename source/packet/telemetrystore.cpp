@@ -0,0 +1,503 @@
+#include "telemetrystore.h"
+#include "../utilities/common.h"
+#include "dependencies/obc-packet-helpers/downlink.h"
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QMetaProperty>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+/**
+ * @brief Running minimum, maximum and sum of a bucket
+ */
+struct Accumulator {
+    double min = std::numeric_limits<double>::max();
+    double max = std::numeric_limits<double>::lowest();
+    double sum = 0;
+    qint64 count = 0;
+
+    void add(double value) {
+        min = std::min(min, value);
+        max = std::max(max, value);
+        sum += value;
+        count++;
+    }
+};
+
+/**
+ * @brief Returns true if \p type is a numeric type that can be stored in a series
+ */
+bool isNumeric(int type) {
+    switch (type) {
+    case QMetaType::Bool:
+    case QMetaType::Char:
+    case QMetaType::SChar:
+    case QMetaType::UChar:
+    case QMetaType::Short:
+    case QMetaType::UShort:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::Long:
+    case QMetaType::ULong:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+    case QMetaType::Float:
+    case QMetaType::Double:
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+/**
+ * @brief Constructor for the class. Loads the chunk summaries of the series stored in \p dirString.
+ * @param dirString Directory of the column files, has to end with a separator unless empty
+ * @param parent The parent QObject, should be left empty
+ */
+TelemetryStore::TelemetryStore(const QString &dirString, QObject *parent)
+: QObject(parent), dirString_priv(dirString), flushTimer_priv(this) {
+    QDir dir(dirString.isEmpty() ? QStringLiteral(".") : dirString);
+    const auto entries = dir.entryInfoList(QStringList() << "*.col", QDir::Files);
+    for (const auto &entry : entries) {
+        loadColumn(entry.completeBaseName(), entry.filePath());
+    }
+    // A single worker, so the chunks of a file are appended in order
+    pool_priv.setMaxThreadCount(1);
+    QObject::connect(&flushTimer_priv, &QTimer::timeout, this, &TelemetryStore::flush);
+    flushTimer_priv.start(flushIntervalMs);
+}
+
+/**
+ * @brief Destructor for the class. Waits for the worker, then writes the values that are not in a chunk yet.
+ */
+TelemetryStore::~TelemetryStore() {
+    flushTimer_priv.stop();
+    bool sealing;
+    do {
+        pool_priv.waitForDone();
+        // Delivers the results of the finished writes, the values of the failed ones return to their columns
+        QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+        sealing = false;
+        for (const auto &column : columns_priv) {
+            sealing = sealing || column.sealing;
+        }
+    } while (sealing);
+    for (auto &column : columns_priv) {
+        Chunk chunk;
+        if (!column.times.isEmpty() && !writeChunk(column.filePath, column.times, column.values, chunk)) {
+            qWarning() << "TelemetryStore lost" << column.times.size() << "values of" << column.filePath;
+        }
+    }
+}
+
+/**
+ * @brief Returns the key of a series
+ * @param satellite The satellite that sent the packet
+ * @param packetType Name of the packet class, without the namespace
+ * @param fieldPath Path of the property in the packet, separated with dots
+ */
+QString TelemetryStore::seriesKey(
+    SatelliteChanger::Satellites satellite, const QString &packetType, const QString &fieldPath) {
+    return PacketRecord::satelliteName(satellite) + '.' + packetType + '.' + fieldPath;
+}
+
+/**
+ * @brief Returns the keys of every series, sorted
+ */
+QStringList TelemetryStore::seriesKeys() const {
+    QStringList keys = columns_priv.keys();
+    keys.sort();
+    return keys;
+}
+
+/**
+ * @brief Returns the time of the first and the last value of the series \p key
+ * @return False if there is no such series
+ */
+bool TelemetryStore::timeRange(const QString &key, qint64 &firstMs, qint64 &lastMs) const {
+    auto it = columns_priv.constFind(key);
+    if (it == columns_priv.constEnd() ||
+        (it->chunks.isEmpty() && it->sealingTimes.isEmpty() && it->times.isEmpty())) {
+        return false;
+    }
+    firstMs = std::numeric_limits<qint64>::max();
+    lastMs = std::numeric_limits<qint64>::min();
+    for (const auto &chunk : it->chunks) {
+        firstMs = std::min(firstMs, chunk.firstMs);
+        lastMs = std::max(lastMs, chunk.lastMs);
+    }
+    for (const auto *times : {&it->sealingTimes, &it->times}) {
+        for (qint64 time : *times) {
+            firstMs = std::min(firstMs, time);
+            lastMs = std::max(lastMs, time);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Downsamples the values of the series \p key between \p fromMs and \p toMs into \p buckets buckets
+ * @param key Key of the series
+ * @param fromMs Start of the range [ms since the epoch]
+ * @param toMs End of the range [ms since the epoch]
+ * @param buckets Number of buckets, e.g. the width of the chart in pixels
+ * @return The buckets that contain at least one value, in time order
+ */
+QVector<TelemetrySample> TelemetryStore::query(const QString &key, qint64 fromMs, qint64 toMs, int buckets) const {
+    QVector<TelemetrySample> samples;
+    auto it = columns_priv.constFind(key);
+    if (it == columns_priv.constEnd() || buckets <= 0 || toMs < fromMs) {
+        return samples;
+    }
+    const Column &column = *it;
+    const qint64 width = std::max<qint64>(1, (toMs - fromMs) / buckets + 1);
+    QVector<Accumulator> accumulators(buckets);
+    const auto bucketOf = [&](qint64 timeMs) { return static_cast<int>((timeMs - fromMs) / width); };
+    const auto addValues = [&](const QVector<qint64> &times, const QVector<double> &values) {
+        for (int i = 0; i < times.size(); i++) {
+            if (times[i] >= fromMs && times[i] <= toMs) {
+                accumulators[bucketOf(times[i])].add(values[i]);
+            }
+        }
+    };
+
+    for (int i = 0; i < column.chunks.size(); i++) {
+        const Chunk &chunk = column.chunks[i];
+        if (chunk.lastMs < fromMs || chunk.firstMs > toMs) {
+            continue;
+        }
+        if (chunk.firstMs >= fromMs && chunk.lastMs <= toMs && bucketOf(chunk.firstMs) == bucketOf(chunk.lastMs)) {
+            // The whole chunk falls into one bucket, its summary is enough
+            Accumulator &accumulator = accumulators[bucketOf(chunk.firstMs)];
+            accumulator.min = std::min(accumulator.min, chunk.min);
+            accumulator.max = std::max(accumulator.max, chunk.max);
+            accumulator.sum += chunk.sum;
+            accumulator.count += chunk.count;
+            continue;
+        }
+        if (readChunk(column, i)) {
+            addValues(column.cachedTimes, column.cachedValues);
+        }
+    }
+    addValues(column.sealingTimes, column.sealingValues);
+    addValues(column.times, column.values);
+
+    for (int i = 0; i < buckets; i++) {
+        const Accumulator &accumulator = accumulators[i];
+        if (accumulator.count > 0) {
+            samples.append({fromMs + i * width + width / 2,
+                accumulator.min,
+                accumulator.max,
+                accumulator.sum / accumulator.count,
+                accumulator.count});
+        }
+    }
+    return samples;
+}
+
+/**
+ * @brief Opens a window that charts the series \p key
+ */
+void TelemetryStore::openChart(const QString &key) {
+    if (!columns_priv.contains(key)) {
+        qWarning() << "TelemetryStore has no series" << key;
+        return;
+    }
+    if (chartWindow_priv.isNull()) {
+        chartWindow_priv.reset(new ChartWindow());
+    }
+    chartWindow_priv->setTelemetry(this, key);
+    chartWindow_priv->show();
+    chartWindow_priv->raise();
+}
+
+/**
+ * @brief Starts writing the values that are not in a chunk yet into (partial) chunks. Called every flushIntervalMs.
+ */
+void TelemetryStore::flush() {
+    for (auto it = columns_priv.begin(); it != columns_priv.end(); ++it) {
+        if (!it->times.isEmpty()) {
+            sealChunk(it.key(), *it);
+        }
+    }
+}
+
+/**
+ * @brief The slot that decoded packets are connected to. Appends every numeric property of the packet to its series.
+ * @param record The decoded packet
+ */
+void TelemetryStore::newPacket(PacketRecord record) {
+    const QVariant &packet = record.packet();
+    const int type = packet.userType();
+    if (type == qMetaTypeId<s1obc::SpectrumPacket>() || type == qMetaTypeId<s1obc::FileDownloadPacket>()) {
+        // Not telemetry
+        return;
+    }
+    const QMetaObject *metaObject = QMetaType::metaObjectForType(type);
+    if (metaObject == nullptr || !(QMetaType::typeFlags(type) & QMetaType::IsGadget)) {
+        return;
+    }
+    QString packetType = QString::fromLatin1(QMetaType::typeName(type));
+    packetType.remove(QStringLiteral("s1obc::"));
+    extractFields(metaObject,
+        packet.constData(),
+        QString(),
+        record.timestamp().toMSecsSinceEpoch(),
+        seriesKey(record.satellite(), packetType, QString()));
+}
+
+/**
+ * @brief Appends the numeric properties of \p gadget to their series, recursing into nested gadgets
+ * @param metaObject The meta object of \p gadget
+ * @param gadget The gadget
+ * @param path Property path of \p gadget in the packet, empty for the packet itself
+ * @param timeMs Reception time of the packet
+ * @param keyPrefix The series key of the packet with an empty field path
+ */
+void TelemetryStore::extractFields(const QMetaObject *metaObject,
+    const void *gadget,
+    const QString &path,
+    qint64 timeMs,
+    const QString &keyPrefix) {
+    for (int i = metaObject->propertyOffset(); i < metaObject->propertyCount(); i++) {
+        const QMetaProperty property = metaObject->property(i);
+        const QString name = QString::fromLatin1(property.name());
+        if (path.isEmpty() && name == QLatin1String("packetType")) {
+            continue;
+        }
+        const QString fieldPath = path.isEmpty() ? name : path + '.' + name;
+        const QVariant value = property.readOnGadget(gadget);
+        const int type = value.userType();
+        if (property.isEnumType()) {
+            append(keyPrefix + fieldPath, timeMs, value.toInt());
+        }
+        else if (isNumeric(type)) {
+            append(keyPrefix + fieldPath, timeMs, value.toDouble());
+        }
+        else if (QMetaType::typeFlags(type) & QMetaType::IsGadget) {
+            const QMetaObject *nested = QMetaType::metaObjectForType(type);
+            if (nested != nullptr) {
+                extractFields(nested, value.constData(), fieldPath, timeMs, keyPrefix);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Appends a value to the series \p key, the series is created if it does not exist
+ */
+void TelemetryStore::append(const QString &key, qint64 timeMs, double value) {
+    auto it = columns_priv.find(key);
+    if (it == columns_priv.end()) {
+        it = columns_priv.insert(key, Column());
+        it->filePath = dirString_priv + key + ".col";
+        it->times.reserve(chunkSize);
+        it->values.reserve(chunkSize);
+    }
+    it->times.append(timeMs);
+    it->values.append(value);
+    if (it->times.size() >= chunkSize) {
+        sealChunk(key, *it);
+    }
+}
+
+/**
+ * @brief Reads the chunk summaries of a column file. A torn chunk at the end of the file is ignored.
+ * @param key Key of the series
+ * @param filePath Path of the column file
+ */
+void TelemetryStore::loadColumn(const QString &key, const QString &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    quint32 magic;
+    quint16 version;
+    quint16 reserved;
+    stream >> magic >> version >> reserved;
+    if (stream.status() != QDataStream::Ok || magic != fileMagic || version != fileVersion) {
+        qWarning() << "TelemetryStore ignores" << filePath;
+        return;
+    }
+
+    Column column;
+    column.filePath = filePath;
+    const qint64 fileSize = file.size();
+    while (file.pos() + chunkHeaderSize <= fileSize) {
+        Chunk chunk;
+        stream >> chunk.count >> chunk.firstMs >> chunk.lastMs >> chunk.min >> chunk.max >> chunk.sum >>
+            chunk.compressedSize;
+        chunk.payloadOffset = file.pos();
+        if (stream.status() != QDataStream::Ok || chunk.payloadOffset + chunk.compressedSize > fileSize) {
+            break;
+        }
+        column.chunks.append(chunk);
+        file.seek(chunk.payloadOffset + chunk.compressedSize);
+    }
+    columns_priv.insert(key, column);
+}
+
+/**
+ * @brief Starts writing the values of \p column that are not in a chunk yet as a chunk on the worker thread.
+ *
+ * Does nothing while the previous chunk of the column is being written, or until TelemetryStore::Column::retryAtMs
+ * after a failed write.
+ */
+void TelemetryStore::sealChunk(const QString &key, Column &column) {
+    if (column.sealing || QDateTime::currentMSecsSinceEpoch() < column.retryAtMs) {
+        return;
+    }
+    column.sealing = true;
+    column.sealingTimes.swap(column.times);
+    column.sealingValues.swap(column.values);
+    column.times.resize(0);
+    column.values.resize(0);
+    const QString filePath = column.filePath;
+    const QVector<qint64> times = column.sealingTimes;
+    const QVector<double> values = column.sealingValues;
+    pool_priv.start(new FunctionJob([this, key, filePath, times, values]() {
+        Chunk chunk;
+        const bool success = writeChunk(filePath, times, values, chunk);
+        QMetaObject::invokeMethod(
+            this, [this, key, chunk, success]() { chunkSealed(key, chunk, success); }, Qt::QueuedConnection);
+    }));
+}
+
+/**
+ * @brief Takes the result of a write started by TelemetryStore::sealChunk(). After a failure the values return to
+ * the column and the next write waits 1 s, doubled after every further failure up to maxRetryDelayMs.
+ */
+void TelemetryStore::chunkSealed(const QString &key, const Chunk &chunk, bool success) {
+    auto it = columns_priv.find(key);
+    if (it == columns_priv.end()) {
+        return;
+    }
+    it->sealing = false;
+    if (success) {
+        it->chunks.append(chunk);
+        it->failedSeals = 0;
+        it->retryAtMs = 0;
+    }
+    else {
+        it->sealingTimes += it->times;
+        it->sealingValues += it->values;
+        it->times.swap(it->sealingTimes);
+        it->values.swap(it->sealingValues);
+        qint64 delayMs = maxRetryDelayMs;
+        if (it->failedSeals < 16) {
+            delayMs = qint64(1000) << it->failedSeals;
+            if (delayMs > maxRetryDelayMs) {
+                delayMs = maxRetryDelayMs;
+            }
+        }
+        it->failedSeals++;
+        it->retryAtMs = QDateTime::currentMSecsSinceEpoch() + delayMs;
+    }
+    it->sealingTimes.resize(0);
+    it->sealingValues.resize(0);
+    if (it->times.size() >= chunkSize) {
+        sealChunk(key, *it);
+    }
+}
+
+/**
+ * @brief Compresses \p times and \p values, and appends them to the file \p filePath as a chunk. Thread safe.
+ * @param chunk Set to the summary of the written chunk
+ * @return False if the file could not be written
+ */
+bool TelemetryStore::writeChunk(
+    const QString &filePath, const QVector<qint64> &times, const QVector<double> &values, Chunk &chunk) {
+    Accumulator accumulator;
+    chunk.count = static_cast<quint32>(times.size());
+    chunk.firstMs = std::numeric_limits<qint64>::max();
+    chunk.lastMs = std::numeric_limits<qint64>::min();
+    QByteArray payload;
+    {
+        QDataStream stream(&payload, QIODevice::WriteOnly);
+        stream.setByteOrder(QDataStream::LittleEndian);
+        stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+        qint64 previous = 0;
+        for (qint64 time : times) {
+            // Consecutive times are close, the small deltas compress well
+            stream << static_cast<qint64>(time - previous);
+            previous = time;
+            chunk.firstMs = std::min(chunk.firstMs, time);
+            chunk.lastMs = std::max(chunk.lastMs, time);
+        }
+        for (double value : values) {
+            stream << value;
+            accumulator.add(value);
+        }
+    }
+    const QByteArray compressed = qCompress(payload);
+    chunk.compressedSize = static_cast<quint32>(compressed.size());
+    chunk.min = accumulator.min;
+    chunk.max = accumulator.max;
+    chunk.sum = accumulator.sum;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning() << "TelemetryStore could not open" << filePath;
+        return false;
+    }
+    QDataStream stream(&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    if (file.size() == 0) {
+        stream << fileMagic << fileVersion << quint16(0);
+    }
+    stream << chunk.count << chunk.firstMs << chunk.lastMs << chunk.min << chunk.max << chunk.sum
+           << chunk.compressedSize;
+    chunk.payloadOffset = file.pos();
+    if (stream.writeRawData(compressed.constData(), compressed.size()) != compressed.size()) {
+        qWarning() << "TelemetryStore could not write" << filePath;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decompresses the chunk \p index of \p column into the chunk cache of the column
+ * @return False if the chunk could not be read
+ */
+bool TelemetryStore::readChunk(const Column &column, int index) const {
+    if (column.cachedChunk == index) {
+        return true;
+    }
+    const Chunk &chunk = column.chunks[index];
+    QFile file(column.filePath);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(chunk.payloadOffset)) {
+        return false;
+    }
+    const QByteArray payload = qUncompress(file.read(chunk.compressedSize));
+    if (payload.size() != static_cast<int>(chunk.count * 2 * sizeof(qint64))) {
+        qWarning() << "TelemetryStore found a corrupt chunk in" << column.filePath;
+        return false;
+    }
+    QDataStream stream(payload);
+    stream.setByteOrder(QDataStream::LittleEndian);
+    stream.setFloatingPointPrecision(QDataStream::DoublePrecision);
+    column.cachedTimes.resize(static_cast<int>(chunk.count));
+    column.cachedValues.resize(static_cast<int>(chunk.count));
+    qint64 time = 0;
+    for (auto &cachedTime : column.cachedTimes) {
+        qint64 delta;
+        stream >> delta;
+        time += delta;
+        cachedTime = time;
+    }
+    for (auto &cachedValue : column.cachedValues) {
+        stream >> cachedValue;
+    }
+    column.cachedChunk = index;
+    return true;
+}
@@ -0,0 +1,120 @@
+#ifndef TELEMETRYSTORE_H
+#define TELEMETRYSTORE_H
+
+#include "../packet/chartwindow.h"
+#include "../packet/packetrecord.h"
+#include <QFile>
+#include <QHash>
+#include <QMetaObject>
+#include <QObject>
+#include <QScopedPointer>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
+#include <QVector>
+
+/**
+ * @brief A bucket of a downsampled telemetry series, see TelemetryStore::query()
+ */
+struct TelemetrySample {
+    qint64 timeMs; //!< Middle of the bucket [ms since the epoch]
+    double min;
+    double max;
+    double mean;
+    qint64 count; //!< Number of values in the bucket
+};
+
+/**
+ * @brief Columnar store of the numeric telemetry values of decoded packets.
+ *
+ * Every numeric property of the packet gadgets (see downlink.h) becomes a series, keyed by satellite, packet type and
+ * property path, e.g. "SMOG-1.OnboardTelemetryPacket.obc.boardStatus.temperature". A series is an append-only pair
+ * of columns (reception times and values) that is kept in memory until it reaches TelemetryStore::chunkSize values,
+ * or for at most TelemetryStore::flushIntervalMs. Then the values are compressed on a worker thread and appended to
+ * the file of the series as a chunk, together with their count, time range, minimum, maximum and sum. Range queries
+ * use these summaries for every chunk that falls into a single bucket, so only the chunks at the bucket edges are
+ * decompressed, and charting millions of points costs about as much as the number of buckets.
+ *
+ * Column file ("<key>.col"): a 8 byte header (magic "S1TC", version, reserved), followed by chunks. A chunk is a 48
+ * byte header (count, first and last time, min, max, sum, compressed size) and the qCompress()ed, delta encoded times
+ * and the values. Everything is little endian.
+ */
+class TelemetryStore : public QObject {
+    Q_OBJECT
+public:
+    explicit TelemetryStore(const QString &dirString, QObject *parent = nullptr);
+    ~TelemetryStore() override;
+
+    static QString seriesKey(
+        SatelliteChanger::Satellites satellite, const QString &packetType, const QString &fieldPath);
+    Q_INVOKABLE QStringList seriesKeys() const;
+    bool timeRange(const QString &key, qint64 &firstMs, qint64 &lastMs) const;
+    QVector<TelemetrySample> query(const QString &key, qint64 fromMs, qint64 toMs, int buckets) const;
+    Q_INVOKABLE void openChart(const QString &key);
+    void flush();
+
+public slots:
+    void newPacket(PacketRecord record);
+
+private:
+    /**
+     * @brief Summary of a compressed chunk of a series
+     */
+    struct Chunk {
+        qint64 payloadOffset; //!< Offset of the compressed payload in the column file
+        quint32 compressedSize;
+        quint32 count;
+        qint64 firstMs;
+        qint64 lastMs;
+        double min;
+        double max;
+        double sum;
+    };
+
+    /**
+     * @brief A series: the summaries of its chunks on disk and the values that are not compressed yet
+     */
+    struct Column {
+        QString filePath;
+        QVector<Chunk> chunks;
+        QVector<qint64> times;         //!< Reception times of the values that are not in a chunk yet
+        QVector<double> values;        //!< The values that are not in a chunk yet
+        QVector<qint64> sealingTimes;  //!< Reception times of the values that the worker is writing as a chunk
+        QVector<double> sealingValues; //!< The values that the worker is writing as a chunk
+        bool sealing = false;          //!< True while the worker writes \p sealingValues
+        int failedSeals = 0;           //!< Number of failed writes in a row
+        qint64 retryAtMs = 0;          //!< After a failed write, no chunk is written before this time [ms]
+        mutable int cachedChunk = -1;
+        mutable QVector<qint64> cachedTimes;
+        mutable QVector<double> cachedValues;
+    };
+
+    static constexpr int chunkSize = 4096;            //!< Values per chunk
+    static constexpr quint32 fileMagic = 0x43543153;  //!< "S1TC"
+    static constexpr quint16 fileVersion = 1;         //!< Format version of the column files
+    static constexpr int chunkHeaderSize = 48;        //!< Size of a chunk header [bytes]
+    static constexpr int flushIntervalMs = 60000;     //!< Partial chunks are written this often [ms]
+    static constexpr qint64 maxRetryDelayMs = 60000;  //!< Longest wait after failed writes [ms]
+
+    void extractFields(const QMetaObject *metaObject,
+        const void *gadget,
+        const QString &path,
+        qint64 timeMs,
+        const QString &keyPrefix);
+    void append(const QString &key, qint64 timeMs, double value);
+    void loadColumn(const QString &key, const QString &filePath);
+    void sealChunk(const QString &key, Column &column);
+    void chunkSealed(const QString &key, const Chunk &chunk, bool success);
+    static bool writeChunk(
+        const QString &filePath, const QVector<qint64> &times, const QVector<double> &values, Chunk &chunk);
+    bool readChunk(const Column &column, int index) const;
+
+    QString dirString_priv;                       //!< Directory of the column files, including the separator
+    QHash<QString, Column> columns_priv;          //!< The series, keyed by TelemetryStore::seriesKey()
+    QScopedPointer<ChartWindow> chartWindow_priv; //!< The window opened by TelemetryStore::openChart()
+    QTimer flushTimer_priv;                       //!< Writes the partial chunks every flushIntervalMs
+    QThreadPool pool_priv; //!< Worker thread that compresses and writes the chunks, destroyed (and waited for) first
+};
+
+#endif // TELEMETRYSTORE_H
@@ -17,10 +17,85 @@ Column {
     anchors.fill: parent
     anchors.margins: 10
 
+    // Filters of the session history, see PacketFilterModel
+    Row {
+        id: filterRow
+        visible: mainWindow.showPacketHistory
+        spacing: 10
+        bottomPadding: 10
+
+        ComboBox {
+            id: typeFilterCombo
+            property var packetTypes: [
+                [],
+                [OBC.DownlinkPacketType_Telemetry1, OBC.DownlinkPacketType_Telemetry2, OBC.DownlinkPacketType_Telemetry3,
+                 OBC.DownlinkPacketType_Telemetry1_B, OBC.DownlinkPacketType_Telemetry2_B,
+                 OBC.DownlinkPacketType_Telemetry1_A, OBC.DownlinkPacketType_Telemetry2_A,
+                 OBC.DownlinkPacketType_Telemetry3_A],
+                [OBC.DownlinkPacketType_Beacon],
+                [OBC.DownlinkPacketType_SpectrumResult],
+                [OBC.DownlinkPacketType_FileInfo],
+                [OBC.DownlinkPacketType_FileDownload]
+            ]
+            width: 160
+            model: [qsTr("All packet types"), qsTr("Telemetry"), qsTr("Beacon"), qsTr("Spectrum data"),
+                qsTr("File info"), qsTr("File download")]
+            onActivated: packetFilterModel.setTypeFilter(packetTypes[index])
+        }
+
+        ComboBox {
+            width: 140
+            model: [qsTr("All satellites"), "SMOG-1", "SMOG-P", "ATL-1"]
+            onActivated: packetFilterModel.setSatelliteFilter(index === 0 ? [] : [index - 1])
+        }
+
+        ComboBox {
+            property string selected
+            width: 140
+            model: [qsTr("All sources")].concat(packetFilterModel.sources)
+            onModelChanged: currentIndex = Math.max(0, find(selected))
+            onActivated: {
+                selected = index === 0 ? "" : model[index]
+                packetFilterModel.setSourceFilter(index === 0 ? [] : [model[index]])
+            }
+        }
+
+        ComboBox {
+            property string selected
+            width: 140
+            model: [qsTr("All encodings")].concat(packetFilterModel.encodings)
+            onModelChanged: currentIndex = Math.max(0, find(selected))
+            onActivated: {
+                selected = index === 0 ? "" : model[index]
+                packetFilterModel.setEncodingFilter(index === 0 ? [] : [model[index]])
+            }
+        }
+
+        TextField {
+            id: searchField
+            width: 200
+            placeholderText: qsTr("Search packet contents")
+            selectByMouse: true
+            onTextChanged: searchTimer.restart()
+
+            Timer {
+                id: searchTimer
+                interval: 300
+                onTriggered: packetFilterModel.setSearchText(searchField.text)
+            }
+        }
+
+        BusyIndicator {
+            height: searchField.height
+            width: height
+            running: packetFilterModel.searching
+        }
+    }
+
     Row {
         id: row
         width: parent.width
-        height: parent.height
+        height: parent.height - (filterRow.visible ? filterRow.height : 0)
         spacing: 10
 
         CustomTableView {
@@ -74,9 +149,20 @@ Column {
                     width: 80
                     movable: false
                 }
+                ListElement {
+                    role: "position"
+                    title: qsTr("Sample")
+                    width: 100
+                    movable: false
+                }
             }
 
-            model: packetTableModel
+            model: mainWindow.showPacketHistory ? packetFilterModel : packetTableModel
+
+            onModelChanged: {
+                currentIndex = -1
+                currentPacket = null
+            }
 
             // Change coming from the UI
             onCurrentIndexChanged: {
@@ -84,10 +170,11 @@ Column {
                 if (currRow === -1)
                     return
 
-                // Set packetTableModel value to reflect the UI change
-                packetTableModel.selectedRow = currRow
+                // Set packetTableModel value to reflect the UI change, the rows of the history do not move
+                if (model === packetTableModel)
+                    packetTableModel.selectedRow = currRow
 
-                var newpacket = packetTableModel.getPacket(currRow)
+                var newpacket = model.getPacket(currRow)
 
                 // Check if packets exist and timestamp+type match
                 var samePacket = !!newpacket && !!currentPacket
@@ -106,8 +193,8 @@ Column {
                 // Only update the UI if the packet is not the same
                 if (!samePacket) {
                     currentPacket = newpacket
-                    currentPacketString = packetTableModel.readableQString(currRow)
-                    currentPacketSatelliteName = packetTableModel.getSatelliteName(currRow)
+                    currentPacketString = model.readableQString(currRow)
+                    currentPacketSatelliteName = model.getSatelliteName(currRow)
                 }
 
             }
@@ -116,7 +203,7 @@ Column {
             Connections {
                 target: packetTableModel
                 onSelectedRowChanged: {
-                    if (tv.currentIndex === -1)
+                    if (tv.currentIndex === -1 || tv.model !== packetTableModel)
                         return
 
                     if (tv.currentIndex !== packetTableModel.selectedRow) {
@@ -202,7 +289,7 @@ Column {
                             text: "Copy raw packet to clipboard"
                             onTriggered: {
                                 if (tv.currentIndex !== -1) {
-                                    packetTableModel.copyToClipboard(tv.currentIndex)
+                                    tv.model.copyToClipboard(tv.currentIndex)
                                 }
                             }
                         }
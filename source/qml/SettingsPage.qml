@@ -24,6 +24,7 @@ ScrollView {
         } else {
             settingsHolder.sdn = "unspecified";
         }        
+        settingsHolder.ssf = audioSamplingRateCombo.model[audioSamplingRateCombo.currentIndex];
 
         settingsHolder.tsi = parseInt(satIdInput.text);
         if (!latitudeInput.acceptableInput){
@@ -293,6 +294,7 @@ ScrollView {
                 }
             }
             newAudioInputDeviceCombo.currentIndex = dnIndex;
+            audioSamplingRateCombo.currentIndex = Math.max(0, audioSamplingRateCombo.model.indexOf(samplingFrequency));
         }
         onLoadMiscSettings:{
             if (newPacketsAtEnd){
@@ -358,7 +360,7 @@ ScrollView {
 
                 Switch {
                     id: spectogramSwitch
-                    enabled: spectogramRadio.checked || spectogramSDR.checked
+                    enabled: spectogramRadio.checked || spectogramSDR.checked || spectogramWideband.checked
                     text: enabled ? qsTr("Plot"): '<font color="red">Spectogram plotting is only allowed if a device is selected</font>'
                     onEnabledChanged: if (!enabled) checked = false
                     onCheckedChanged: {
@@ -399,6 +401,17 @@ ScrollView {
                         onCheckedChanged : if (checked) spectogramComponent.changeToSDR()
                         onEnabledChanged: if (!enabled) checked = false
                     }
+                    RadioButton {
+                        id: spectogramWideband
+                        text: qsTr("SDR wideband")
+                        enabled: sdrEnabledSwitch.checked
+                        onCheckedChanged : if (checked) spectogramComponent.changeToWideband()
+                        onEnabledChanged: if (!enabled) checked = false
+                        ToolTip.delay: 1000
+                        ToolTip.timeout: 5000
+                        ToolTip.visible: hovered
+                        ToolTip.text: qsTr("The whole passband of the SDR around its center frequency")
+                    }
 
                 }
             }
@@ -459,6 +472,62 @@ ScrollView {
                         textRole: "display"
                         enabled: newAudioInputDeviceCombo.count > 0 && !soundcardInReceivePackets.checked
                     }
+
+                    Label {
+                        text: qsTr("Sampling rate")
+                    }
+                    ComboBox {
+                        id: audioSamplingRateCombo
+                        width: 275
+                        model: [48000, 96000]
+                        displayText: currentText + " Hz"
+                        enabled: !soundcardInReceivePackets.checked
+                        onCurrentIndexChanged: audioSampler.samplingFrequency = model[currentIndex]
+                        ToolTip.delay: 1000
+                        ToolTip.timeout: 5000
+                        ToolTip.visible: hovered
+                        ToolTip.text: qsTr("1250, 2500 and 5000 BPS are demodulated at both rates")
+                    }
+                }
+
+                Row {
+                    x: soundcardInReceivePackets.indicator.width + soundcardInReceivePackets.padding * 2
+                    spacing: 10
+
+                    Button {
+                        text: audioFileSource.running ? qsTr("Stop decoding") : qsTr("Decode recording...")
+                        onClicked: {
+                            if (audioFileSource.running) {
+                                audioFileSource.stop()
+                            } else {
+                                audioRecordingDialog.open()
+                            }
+                        }
+                        ToolTip.delay: 1000
+                        ToolTip.timeout: 5000
+                        ToolTip.visible: hovered
+                        ToolTip.text: qsTr("Demodulates a WAV recording of a receiver, the source of the packets tells which sample of the recording they end at")
+                    }
+                    CheckBox {
+                        id: audioRecordingRealTime
+                        text: qsTr("Real-time")
+                        enabled: !audioFileSource.running
+                        anchors.verticalCenter: parent.verticalCenter
+                    }
+                    ProgressBar {
+                        value: audioFileSource.progress
+                        visible: audioFileSource.running
+                        anchors.verticalCenter: parent.verticalCenter
+                    }
+
+                    Connections {
+                        target: audioFileSource
+                        onFileError: {
+                            logger.writeToLog("Audio file error: " + message);
+                            audioFileError.text = message;
+                            audioFileError.open();
+                        }
+                    }
                 }
             }
         }
@@ -1648,11 +1717,23 @@ ScrollView {
             title: qsTr("Error with audio device")
             text: qsTr("The audio device has been disconnected.\nPlease verify that it is connected properly and retry the operation.")
         }
+        Dialogs1.FileDialog {
+            id: audioRecordingDialog
+            title: qsTr("Choose a recording")
+            nameFilters: [qsTr("WAV files (*.wav)"), qsTr("All files (*)")]
+            selectExisting: true
+            onAccepted: audioFileSource.start(audioRecordingDialog.fileUrl.toString(), audioRecordingRealTime.checked)
+        }
+        Dialogs1.MessageDialog {
+            id: audioFileError
+            icon: Dialogs1.StandardIcon.Critical
+            title: qsTr("Error with recording")
+        }
         Dialogs1.MessageDialog {
             id: audioDeviceFailedError
             icon: Dialogs1.StandardIcon.Critical
             title: qsTr("Error with sound card")
-            text: qsTr("We couldn't start the audio input device.\nPlease verify that audio input is configured correctly on your computer and it supports 44100Hz, then retry the operation.")
+            text: qsTr("We couldn't start the audio input device.\nPlease verify that audio input is configured correctly on your computer and it supports the selected sampling rate, then retry the operation.")
         }
         Dialogs1.MessageDialog {
             id: sdrErrorSDRDisconnected
@@ -13,6 +13,10 @@ Column {
         spectogram.switchToSDRMode()
     }
 
+    function changeToWideband() {
+        spectogram.switchToWidebandMode()
+    }
+
     function start() {
         spectogram.startSpectogram()
     }
@@ -106,17 +110,43 @@ Column {
         Label {
             text: qsTr("Scaling factor")
             anchors.verticalCenter: parent.verticalCenter
-            visible: spectogram.inSDRMode
+            visible: spectogram.inSDRMode || spectogram.inWidebandMode
         }
         SpinBox{
             id: sdrSensitivityScale
             anchors.verticalCenter: parent.verticalCenter
-            visible: spectogram.inSDRMode
+            visible: spectogram.inSDRMode || spectogram.inWidebandMode
 
             from: 10
             to: 99999
             stepSize: 10
             value: 100
         }
+        Label {
+            text: qsTr("RBW [Hz]")
+            anchors.verticalCenter: parent.verticalCenter
+            visible: spectogram.inWidebandMode
+            ToolTip.delay: 1000
+            ToolTip.timeout: 5000
+            ToolTip.visible: hovered
+            ToolTip.text: qsTr("Resolution bandwidth, FFT size: %1").arg(sdrThread.wideband.fftSize)
+        }
+        SpinBox{
+            id: widebandResolution
+            anchors.verticalCenter: parent.verticalCenter
+            visible: spectogram.inWidebandMode
+
+            from: 10
+            to: 1000
+            stepSize: 10
+            value: 250
+            onValueModified: sdrThread.wideband.resolutionBandwidth = value
+        }
+        Button {
+            text: qsTr("Reset peak")
+            anchors.verticalCenter: parent.verticalCenter
+            visible: spectogram.inWidebandMode
+            onClicked: sdrThread.wideband.resetPeakHold()
+        }
     }
 }
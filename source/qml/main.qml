@@ -17,6 +17,7 @@ ApplicationWindow {
 
     property int margin: 10
     property bool showBottomSection: true
+    property bool showPacketHistory: false
     property int currentSatellite: 0
 
     property var lastTelemetry1packet_smog1: Packet.createDownlink(OBC.DownlinkPacketType_Telemetry1, 0)
@@ -261,6 +262,13 @@ ApplicationWindow {
                         onTriggered: manualPacketInputLoader.open();
                     }
 
+                    Action {
+                        text: (showPacketHistory ? "Show latest packets" : "Show session history")
+                              + " (" + shortcut + ")"
+                        shortcut: "Ctrl+Y"
+                        onTriggered: showPacketHistory = !showPacketHistory
+                    }
+
                     Action {
                         id: hideCommandMenuMenuItem
                         property var sp: null
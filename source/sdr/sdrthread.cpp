@@ -23,8 +23,10 @@ SDRThread::SDRThread(PacketDecoder *pd, PredicterController *predicter) : QThrea
     baseOffset_priv = 0;
     dataRateBPS_priv = 1250;
     packetLengthBytes_priv = 70;
+    wideband_priv.reset(new WidebandSpectrum());
     sdrWorker.reset(
         new SDRWorker(mut_priv.data(), canRun_priv.data(), ds_priv.data(), pl_priv.data(), dr_priv.data(), pd));
+    sdrWorker->wideband_spectrum = wideband_priv.data();
     QObject::connect(sdrWorker.data(), &SDRWorker::dataReady, this, &SDRThread::decodablePacketReceivedSlot);
     QObject::connect(this, &SDRThread::decodablePacketReceivedSignal, pd, &PacketDecoder::decodablePacketReceived);
     sdrWorker->moveToThread(this); // may be unnecessary because the object itself was created on this thread
@@ -44,8 +46,8 @@ SDRThread::SDRThread(PacketDecoder *pd, PredicterController *predicter) : QThrea
     // base frequency change
     QObject::connect(this, &SDRThread::newBaseFrequencies, sdrWorker.data(), &SDRWorker::newBaseFrequencies);
 
-    // Forwarding complex sample for spectogram
-    QObject::connect(sdrWorker.data(), &SDRWorker::complexSampleReady, this, &SDRThread::complexSampleReady);
+    // Forwarding complex sample blocks for spectogram
+    QObject::connect(sdrWorker.data(), &SDRWorker::complexSamplesReady, this, &SDRThread::complexSamplesReady);
 
     QTimer::singleShot(150, [&]() { refreshSdrDevices(); });
 }
@@ -154,6 +156,13 @@ long SDRThread::currentFrequency() {
     return baseFrequency_priv + baseOffset_priv + dynamic_shift_priv;
 }
 
+/**
+ * @brief Returns the wideband spectrum of the raw SDR samples
+ */
+WidebandSpectrum *SDRThread::wideband() {
+    return wideband_priv.data();
+}
+
 /**
  * @brief The slot receives a signal when the SDR couldn't be started.
  *
@@ -22,6 +22,7 @@ public:
 
     Q_PROPERTY(QStringListModel *sdrDevices READ sdrDevices NOTIFY sdrDevicesChanged)
     Q_PROPERTY(long currentFrequency READ currentFrequency NOTIFY currentFrequencyChanged)
+    Q_PROPERTY(WidebandSpectrum *wideband READ wideband CONSTANT)
 
     Q_INVOKABLE void startReading(int device_index, double ppm, int gain, bool automaticDF);
     Q_INVOKABLE void stopReading();
@@ -36,7 +37,10 @@ public:
 
     long currentFrequency();
 
+    WidebandSpectrum *wideband();
+
 private:
+    QScopedPointer<WidebandSpectrum> wideband_priv; //!< The wideband spectrum of the raw SDR samples
     QScopedPointer<SDRWorker> sdrWorker; //!< Pointer to the SDRWorker that demodulates the incoming signal.
     QScopedPointer<QMutex> mut_priv;     //!< Pointer to the QMmutex that is used to handle multi-thread execution.
     QScopedPointer<bool> canRun_priv;    //!< Pointer to the bool that indicates whether the device should be read.
@@ -107,7 +111,7 @@ signals:
 
     void currentFrequencyChanged();
 
-    void complexSampleReady(std::complex<float> sample);
+    void complexSamplesReady(QVector<std::complex<float>> samples);
 
 private slots:
     void newDataRateSlot(unsigned int newDataRateBPS);
@@ -26,28 +26,34 @@ void rtlsdr_callback(unsigned char *buf, unsigned int len, void *ctx) {
             change_cnco_offset_frequency(&worker->cnco_vars, worker->baseOffset + worker->ds_freq);
         }
         worker->mutex_priv->unlock();
+        // The wideband spectrum gets a copy of the raw buffer when its worker is idle
+        if (worker->wideband_spectrum != nullptr && worker->wideband_spectrum->wantsSamples()) {
+            worker->wideband_spectrum->addSamples(
+                QByteArray(reinterpret_cast<const char *>(buf), static_cast<int>(len)));
+        }
         for (int i = 0; i < (long) len; i += 2) {
-            std::complex<float> input(static_cast<float>(static_cast<uint8_t>(buf[i]) - 127.5),
-                static_cast<float>(static_cast<uint8_t>(buf[i + 1]) - 127.5)); // Removing DC
-            auto cncod = cnco(&worker->cnco_vars, input);
-            // 5x AVG_DEC
-            auto avgd_5 = average(&worker->avg_vars_5, cncod);
-            std::complex<float> avg_dec_output_5;
-            bool avg_dec_5_performed = average_dec(&worker->avg_dec_vars_5, avgd_5, &avg_dec_output_5);
-            if (avg_dec_5_performed) {
+            S1demSample avg_dec_output_5;
+            if (decimate_5(&worker->cnco_vars,
+                    &worker->avg_vars_5,
+                    &worker->avg_dec_vars_5,
+                    buf[i],
+                    buf[i + 1],
+                    &avg_dec_output_5)) {
                 // Parallel demodulation
                 worker->magic_demod_1250.addSample(avg_dec_output_5);
                 worker->magic_demod_2500.addSample(avg_dec_output_5);
                 worker->magic_demod_5000.addSample(avg_dec_output_5);
                 worker->magic_demod_12500.addSample(avg_dec_output_5);
 
-                // 20x AVG_DEC
-                auto avgd_20 = average(&worker->avg_vars_20, avg_dec_output_5);
                 std::complex<float> avg_dec_output_20;
-                bool avg_dec_20_performed = average_dec(&worker->avg_dec_vars_20, avgd_20, &avg_dec_output_20);
-                if (avg_dec_20_performed) {
-                    // Emit to spectogram
-                    emit worker->complexSampleReady(avg_dec_output_20);
+                if (decimate_20(&worker->avg_vars_20, &worker->avg_dec_vars_20, avg_dec_output_5, &avg_dec_output_20)) {
+                    // Emit to spectogram in blocks, the receivers share the buffer of the block
+                    worker->spectogram_block.append(avg_dec_output_20);
+                    if (worker->spectogram_block.size() == SDRWorker::spectogram_block_size) {
+                        emit worker->complexSamplesReady(worker->spectogram_block);
+                        worker->spectogram_block = QVector<std::complex<float>>();
+                        worker->spectogram_block.reserve(SDRWorker::spectogram_block_size);
+                    }
                 }
             }
         }
@@ -83,6 +89,15 @@ SDRWorker::SDRWorker(QMutex *mutex, bool *canRun, int *ds, long *pl, long *dr, P
     // Setting up CNCO vars
     change_cnco_sampling_rate(&cnco_vars, 250000);
 
+#ifdef S1DEM_FIXED_POINT
+    // Setting up avg vars and avg dec vars for the first, 5x decimation
+    reinitialize_avg_fixed_vars(&avg_vars_5, 10);
+    reinitialize_avg_dec_fixed_vars(&avg_dec_vars_5, 5);
+
+    // Setting up avg vars and avg dec vars for the second, 20x decimation
+    reinitialize_avg_fixed_vars(&avg_vars_20, 40);
+    reinitialize_avg_dec_fixed_vars(&avg_dec_vars_20, 20);
+#else
     // Setting up avg vars and avg dec vars for the first, 5x decimation
     reinitialize_avg_vars(&avg_vars_5, 10);
     reinitialize_avg_dec_vars(&avg_dec_vars_5, 5);
@@ -90,6 +105,8 @@ SDRWorker::SDRWorker(QMutex *mutex, bool *canRun, int *ds, long *pl, long *dr, P
     // Setting up avg vars and avg dec vars for the second, 20x decimation
     reinitialize_avg_vars(&avg_vars_20, 40);
     reinitialize_avg_dec_vars(&avg_dec_vars_20, 20);
+#endif
+    spectogram_block.reserve(spectogram_block_size);
 
     QObject::connect(&magic_demod_1250, &MagicDemodulator::dataReady, this, &SDRWorker::dataReady);
     QObject::connect(&magic_demod_2500, &MagicDemodulator::dataReady, this, &SDRWorker::dataReady);
@@ -114,10 +131,13 @@ SDRWorker::~SDRWorker() {
  */
 void SDRWorker::cleanup() {
     free(cnco_vars.lo);
+    free(cnco_vars.lo_q15);
     free(avg_vars_5.buf);
-    free(avg_dec_vars_5.buf);
     free(avg_vars_20.buf);
+#ifndef S1DEM_FIXED_POINT
+    free(avg_dec_vars_5.buf);
     free(avg_dec_vars_20.buf);
+#endif
 }
 
 /**
@@ -171,10 +191,17 @@ bool SDRWorker::readFromSDR(int device_index, long samplesPerSecond, double ppm,
     // Setting initial cnco offset frequency
     change_cnco_offset_frequency(&cnco_vars, baseOffset + ds_freq);
     // Resetting AVG vars
+#ifdef S1DEM_FIXED_POINT
+    reinitialize_avg_fixed_vars(&avg_vars_5, 10);
+    reinitialize_avg_dec_fixed_vars(&avg_dec_vars_5, 5);
+    reinitialize_avg_fixed_vars(&avg_vars_20, 40);
+    reinitialize_avg_dec_fixed_vars(&avg_dec_vars_20, 20);
+#else
     reinitialize_avg_vars(&avg_vars_5, 10);
     reinitialize_avg_dec_vars(&avg_dec_vars_5, 5);
     reinitialize_avg_vars(&avg_vars_20, 40);
     reinitialize_avg_dec_vars(&avg_dec_vars_20, 20);
+#endif
     // Resetting MagicDemodulators
     magic_demod_1250.clear();
     magic_demod_2500.clear();
@@ -5,6 +5,7 @@
 #include "../demod/newsmog1dem.h"
 #include "../packet/packetdecoder.h"
 #include "convenience.h"
+#include "widebandspectrum.h"
 #include "rtl-sdr.h"
 #include <QDateTime>
 #include <QDebug>
@@ -43,13 +44,25 @@ public:
     bool dem_a_set;
     QVector<char> packet_characters;
 
+    static constexpr int spectogram_block_size = 256; //!< Samples that are sent to the spectogram at once
+    QVector<std::complex<float>> spectogram_block;    //!< Samples collected for the spectogram
+    WidebandSpectrum *wideband_spectrum = nullptr;    //!< Receives raw buffers when it wants them, owned by SDRThread
+
     CncoVariables cnco_vars;
 
+#ifdef S1DEM_FIXED_POINT
+    AveragingFixedVariables avg_vars_5;
+    AveragingDecFixedVariables avg_dec_vars_5;
+
+    AveragingFixedVariables avg_vars_20;
+    AveragingDecFixedVariables avg_dec_vars_20;
+#else
     AveragingVariables avg_vars_5;
     AveragingDecVariables avg_dec_vars_5;
 
     AveragingVariables avg_vars_20;
     AveragingDecVariables avg_dec_vars_20;
+#endif
 
     MagicDemodulator magic_demod_1250{50000, 1250, "SDR 1250 BPS"};
     MagicDemodulator magic_demod_2500{50000, 2500, "SDR 2500 BPS"};
@@ -73,10 +86,11 @@ signals:
     void dataReady(QDateTime timestamp, QString source, QString packetUpperHexString);
 
     /**
-     * @brief Signal that is emitted when a new sample has been received for the spectogram
-     * @param sample The sample
+     * @brief Signal that is emitted when SDRWorker::spectogram_block_size samples have been collected for the
+     * spectogram
+     * @param samples The samples, shared with the receivers
      */
-    void complexSampleReady(std::complex<float> sample);
+    void complexSamplesReady(QVector<std::complex<float>> samples);
 
     /**
      * @brief Signal that is emitted when the program could not connect to a SDR, e.g. there are not any.
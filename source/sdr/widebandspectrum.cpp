@@ -0,0 +1,186 @@
+#include "widebandspectrum.h"
+#include "../utilities/fftplanner.h"
+#include <QDebug>
+#include <QMetaObject>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constructor for the class. The resolution bandwidth is 250 Hz by default.
+ * @param[in] parent The parent QObject, should be left empty.
+ */
+WidebandSpectrum::WidebandSpectrum(QObject *parent)
+: QObject(parent), resolutionBandwidth_priv(0), enabled_priv(0), busy_priv(0), fftSize_priv(minimumFftSize),
+  peakGeneration_priv(0), planSize_priv(0), workerPeakGeneration_priv(0), plan_priv(nullptr), in_priv(nullptr),
+  out_priv(nullptr), windowGain_priv(1.0f) {
+    pool_priv.setMaxThreadCount(1);
+    setResolutionBandwidth(250);
+}
+
+/**
+ * @brief Waits for the worker, then frees the FFTW plan and buffers
+ */
+WidebandSpectrum::~WidebandSpectrum() {
+    pool_priv.waitForDone();
+    fftwf_free(in_priv);
+    fftwf_free(out_priv);
+}
+
+double WidebandSpectrum::resolutionBandwidth() const {
+    return resolutionBandwidth_priv;
+}
+
+/**
+ * @brief Sets the resolution bandwidth. The FFT size is the smallest size that is fast (see FftPlanner::goodSize())
+ * and whose bins are narrow enough, taking the 1.5 bin equivalent noise bandwidth of the Hann window into account.
+ * @param resolutionBandwidth The resolution bandwidth [Hz]
+ */
+void WidebandSpectrum::setResolutionBandwidth(double resolutionBandwidth) {
+    if (resolutionBandwidth <= 0) {
+        qWarning() << "Invalid resolution bandwidth" << resolutionBandwidth;
+        return;
+    }
+    const double bins = std::ceil(1.5 * sampleRate / resolutionBandwidth);
+    const int size = FftPlanner::goodSize(static_cast<int>(qBound<double>(minimumFftSize, bins, maximumFftSize)));
+    resolutionBandwidth_priv = resolutionBandwidth;
+    fftSize_priv.storeRelease(size);
+    emit resolutionBandwidthChanged();
+}
+
+/**
+ * @brief Returns the FFT size of the resolution bandwidth, the bins are sampleRate / fftSize wide
+ */
+int WidebandSpectrum::fftSize() const {
+    return fftSize_priv.loadAcquire();
+}
+
+/**
+ * @brief Enables or disables the spectrum. The peak-hold is reset when it is enabled.
+ */
+void WidebandSpectrum::setEnabled(bool enabled) {
+    if (enabled && enabled_priv.loadAcquire() == 0) {
+        resetPeakHold();
+    }
+    enabled_priv.storeRelease(enabled ? 1 : 0);
+}
+
+/**
+ * @brief Resets the peak-hold, the next spectrum starts a new one
+ */
+void WidebandSpectrum::resetPeakHold() {
+    peakGeneration_priv.fetchAndAddRelease(1);
+}
+
+/**
+ * @brief Returns true if the spectrum is enabled and the worker is idle. Called by the SDR callback before it copies
+ * its buffer.
+ */
+bool WidebandSpectrum::wantsSamples() const {
+    return enabled_priv.loadAcquire() != 0 && busy_priv.loadAcquire() == 0;
+}
+
+/**
+ * @brief Queues a raw buffer of the SDR (interleaved unsigned 8 bit I/Q samples) for the worker. The buffer is dropped
+ * if the worker is busy.
+ */
+void WidebandSpectrum::addSamples(const QByteArray &samples) {
+    if (!busy_priv.testAndSetAcquire(0, 1)) {
+        return;
+    }
+    const int size = fftSize_priv.loadAcquire();
+    const int peakGeneration = peakGeneration_priv.loadAcquire();
+    pool_priv.start(new FunctionJob([this, samples, size, peakGeneration]() {
+        process(samples, size, peakGeneration);
+        busy_priv.storeRelease(0);
+    }));
+}
+
+/**
+ * @brief Gets the plan and creates the buffers and the window for \p size if the current ones have a different size
+ */
+void WidebandSpectrum::preparePlan(int size) {
+    if (size == planSize_priv) {
+        return;
+    }
+    fftwf_free(in_priv);
+    fftwf_free(out_priv);
+    in_priv = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex) * size);
+    out_priv = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex) * size);
+    plan_priv = FftPlanner::complexPlanFloat(size);
+    planSize_priv = size;
+
+    window_priv.resize(size);
+    double sum = 0;
+    for (int k = 0; k < size; k++) {
+        const double w = 0.5 * (1 - std::cos(2 * M_PI * k / size));
+        sum += w;
+        window_priv[k] = static_cast<float>(w / 127.5);
+    }
+    windowGain_priv = static_cast<float>(sum * sum);
+    power_priv.resize(size);
+    peak_priv.clear();
+}
+
+/**
+ * @brief Cuts a raw buffer into frames and computes their spectra. Called by the worker.
+ */
+void WidebandSpectrum::process(const QByteArray &samples, int size, int peakGeneration) {
+    preparePlan(size);
+    if (peakGeneration != workerPeakGeneration_priv) {
+        workerPeakGeneration_priv = peakGeneration;
+        peak_priv.clear();
+    }
+    const int count = samples.size() / 2;
+    const int frames = qMax(1, count / qMax(sampleRate / maximumFrameRate, size));
+    const int frameLength = count / frames;
+    if (frameLength < size) {
+        return;
+    }
+    const uchar *raw = reinterpret_cast<const uchar *>(samples.constData());
+    for (int frame = 0; frame < frames; frame++) {
+        computeFrame(raw + 2 * frame * frameLength, frameLength);
+    }
+}
+
+/**
+ * @brief Estimates the power spectrum of \p count samples with Welch's method and emits it. Called by the worker.
+ */
+void WidebandSpectrum::computeFrame(const uchar *samples, int count) {
+    const int size = planSize_priv;
+    const int step = size / 2;
+    const float *window = window_priv.constData();
+    float *power = power_priv.data();
+    std::fill(power, power + size, 0.0f);
+    int segments = 0;
+    for (int start = 0; start + size <= count; start += step) {
+        const uchar *segment = samples + 2 * start;
+        for (int k = 0; k < size; k++) {
+            in_priv[k][0] = (static_cast<float>(segment[2 * k]) - 127.5f) * window[k]; // Removing DC
+            in_priv[k][1] = (static_cast<float>(segment[2 * k + 1]) - 127.5f) * window[k];
+        }
+        fftwf_execute_dft(plan_priv, in_priv, out_priv);
+        for (int k = 0; k < size; k++) {
+            power[k] += out_priv[k][0] * out_priv[k][0] + out_priv[k][1] * out_priv[k][1];
+        }
+        segments++;
+    }
+
+    QVector<float> average(size);
+    const float scale = 1.0f / (segments * windowGain_priv);
+    for (int k = 0; k < size; k++) {
+        // The negative frequencies come first
+        average[k] = 10 * std::log10(power[(k + step) % size] * scale + 1e-20f);
+    }
+    if (peak_priv.size() != size) {
+        peak_priv = average;
+    }
+    else {
+        float *peak = peak_priv.data();
+        for (int k = 0; k < size; k++) {
+            peak[k] = std::max(peak[k], average[k]);
+        }
+    }
+    const QVector<float> peak = peak_priv;
+    QMetaObject::invokeMethod(
+        this, [this, average, peak]() { emit spectrumReady(average, peak); }, Qt::QueuedConnection);
+}
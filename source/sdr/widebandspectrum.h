@@ -0,0 +1,81 @@
+#ifndef WIDEBANDSPECTRUM_H
+#define WIDEBANDSPECTRUM_H
+
+#include "../utilities/common.h"
+#include <../../3rdparty/fftw3/fftw3.h>
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QObject>
+#include <QThreadPool>
+#include <QVector>
+
+/**
+ * @brief Computes the power spectrum of the whole SDR passband (250 kS/s) for the wideband mode of Spectogram.
+ *
+ * The SDR callback hands over its raw buffer only if WidebandSpectrum::wantsSamples() returns true, i.e. the wideband
+ * mode is enabled and the worker is idle, so nothing is copied otherwise. The worker thread cuts the buffer into frames
+ * of 1 / WidebandSpectrum::maximumFrameRate seconds and estimates the spectrum of every frame with Welch's method:
+ * Hann windowed segments with 50% overlap are transformed with single precision FFTW and their power is averaged.
+ * The FFT size follows from the resolution bandwidth, the plans are shared through FftPlanner. The spectra are emitted
+ * in dBFS, together with their peak-hold.
+ */
+class WidebandSpectrum : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(double resolutionBandwidth READ resolutionBandwidth WRITE setResolutionBandwidth NOTIFY
+            resolutionBandwidthChanged)
+    Q_PROPERTY(int fftSize READ fftSize NOTIFY resolutionBandwidthChanged)
+
+public:
+    static constexpr int sampleRate = 250000;    //!< Sampling rate of the SDR [S/s]
+    static constexpr int maximumFrameRate = 10;  //!< Spectra computed per second at most
+    static constexpr int minimumFftSize = 512;   //!< Not smaller than the width of Spectogram
+    static constexpr int maximumFftSize = 65536;
+
+    explicit WidebandSpectrum(QObject *parent = 0);
+    ~WidebandSpectrum() override;
+
+    double resolutionBandwidth() const;
+    void setResolutionBandwidth(double resolutionBandwidth);
+    int fftSize() const;
+    void setEnabled(bool enabled);
+    Q_INVOKABLE void resetPeakHold();
+
+    bool wantsSamples() const;
+    void addSamples(const QByteArray &samples);
+
+signals:
+    void resolutionBandwidthChanged();
+
+    /**
+     * @brief Emitted for every frame
+     * @param average The Welch estimate of the power spectrum [dBFS], from -sampleRate / 2 to sampleRate / 2
+     * @param peak The maximum of \p average since the peak-hold was reset [dBFS]
+     */
+    void spectrumReady(QVector<float> average, QVector<float> peak);
+
+private:
+    void preparePlan(int size);
+    void process(const QByteArray &samples, int size, int peakGeneration);
+    void computeFrame(const uchar *samples, int count);
+
+    double resolutionBandwidth_priv; //!< The requested resolution bandwidth [Hz]
+    QAtomicInt enabled_priv;         //!< Set while the wideband mode of Spectogram is running
+    QAtomicInt busy_priv;            //!< Set while the worker processes a buffer
+    QAtomicInt fftSize_priv;         //!< FFT size of the resolution bandwidth
+    QAtomicInt peakGeneration_priv;  //!< Incremented to reset the peak-hold
+
+    // Used by the worker thread only
+    int planSize_priv;             //!< Size of \p plan_priv, 0 if there is no plan
+    int workerPeakGeneration_priv; //!< The peak-hold generation of \p peak_priv
+    fftwf_plan plan_priv; //!< Shared plan, see FftPlanner
+    fftwf_complex *in_priv;
+    fftwf_complex *out_priv;
+    QVector<float> window_priv; //!< Hann window, scaled to convert the samples to [-1, 1]
+    float windowGain_priv;      //!< Square of the sum of the window, a full scale tone has 0 dBFS
+    QVector<float> power_priv;  //!< Power of the segments of a frame
+    QVector<float> peak_priv;   //!< Peak-hold [dBFS]
+
+    QThreadPool pool_priv; //!< Worker thread of the spectra, destroyed (and waited for) first
+};
+
+#endif // WIDEBANDSPECTRUM_H
@@ -29,8 +29,9 @@ class SettingsHolder : public QObject {
     Q_OBJECT
 
     // Soundcard settings group
-    // settings in order: deviceName
+    // settings in order: deviceName, samplingFrequency
     GENPROPERTY(QString, sdn)
+    GENPROPERTY(int, ssf)
 
     // Tracking settings group
     // settings in order: satelliteId, stationLat, stationLon, stationElev
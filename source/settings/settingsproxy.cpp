@@ -17,6 +17,7 @@ SettingsProxy::SettingsProxy(SettingsHolder *settingsHolder, QObject *parent) :
 bool SettingsProxy::saveSettings() {
     settings.beginGroup("Soundcard");
     settings.setValue("deviceName", sh->sdn());
+    settings.setValue("samplingFrequency", sh->ssf());
     qInfo() << "Successfully saved Soundcard settings";
     settings.endGroup();
 
@@ -100,8 +101,9 @@ bool SettingsProxy::loadSettings(bool emits) {
 
     settings.beginGroup("Soundcard");
     sh->set_sdn(settings.value("deviceName", "").toString());
+    sh->set_ssf(settings.value("samplingFrequency", 48000).toInt());
     if (emits) {
-        emit loadSoundcardSettings(sh->sdn());
+        emit loadSoundcardSettings(sh->sdn(), sh->ssf());
         qInfo() << "Emitted Soundcard settings";
     }
     settings.endGroup();
@@ -28,8 +28,9 @@ signals:
     /**
      * @brief Signal, that emits the soundcard settings after loading it from persistent storage.
      * @param deviceName Name of audio device that should be selected.
+     * @param samplingFrequency The sampling rate the audio device should be opened with.
      */
-    void loadSoundcardSettings(QString deviceName);
+    void loadSoundcardSettings(QString deviceName, int samplingFrequency);
 
     /**
      * @brief Signal, that emits the SDR settings after loading it from persistent storage.
@@ -1,10 +1,12 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include <QRunnable>
 #include <QString>
 #include <QThread>
 #include <QTimeZone>
 #include <bitset>
+#include <functional>
 
 #define INVALIDATE 50000
 
@@ -23,6 +25,22 @@ struct QScopedPointerThreadDeleter {
     }
 };
 
+/**
+ * @brief Runs a function on a thread of a QThreadPool
+ */
+class FunctionJob : public QRunnable {
+public:
+    explicit FunctionJob(const std::function<void()> &function) : function_priv(function) {
+    }
+
+    void run() override {
+        function_priv();
+    }
+
+private:
+    std::function<void()> function_priv;
+};
+
 inline unsigned int count_ones(uint8_t byte) {
     return std::bitset<8>(byte).count();
 }
@@ -0,0 +1,174 @@
+#include "fftplanner.h"
+#include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <cstdlib>
+#include <initializer_list>
+
+namespace {
+const char *wisdomFileName = "fftw_wisdom.txt";       //!< Wisdom of the double precision plans
+const char *floatWisdomFileName = "fftwf_wisdom.txt"; //!< Wisdom of the single precision plans
+
+/**
+ * @brief The plans of the application, destroyed after main() has returned
+ */
+struct PlanCache {
+    QMutex mutex;
+    QString dirString; //!< The folder of the wisdom files, empty if the wisdom is not saved
+    QHash<int, fftw_plan> complexPlans;
+    QHash<int, fftw_plan> realPlans;
+    QHash<int, fftwf_plan> complexFloatPlans;
+
+    ~PlanCache() {
+        for (auto plan : complexPlans) {
+            fftw_destroy_plan(plan);
+        }
+        for (auto plan : realPlans) {
+            fftw_destroy_plan(plan);
+        }
+        for (auto plan : complexFloatPlans) {
+            fftwf_destroy_plan(plan);
+        }
+    }
+};
+
+PlanCache &planCache() {
+    static PlanCache cache;
+    return cache;
+}
+
+/**
+ * @brief Creates a plan of \p size points with \p create. Up to FftPlanner::patientSizeLimit points the planner is
+ * patient, the plans of such sizes are executed continuously. The buffers are only used for the planning, the
+ * measuring overwrites them.
+ */
+template <typename TPlan, typename TCreate> TPlan createPlan(int size, TCreate create) {
+    return create(size <= FftPlanner::patientSizeLimit ? FFTW_PATIENT : FFTW_MEASURE);
+}
+
+/**
+ * @brief Imports the wisdom saved in \p fileName with \p import, does nothing if the file does not exist
+ */
+void importWisdom(const QString &fileName, int (*import)(const char *)) {
+    QFile file(fileName);
+    if (!file.exists()) {
+        return;
+    }
+    if (!file.open(QIODevice::ReadOnly) || import(file.readAll().constData()) == 0) {
+        qWarning() << "Could not import FFTW wisdom from" << fileName;
+    }
+}
+
+/**
+ * @brief Saves the wisdom returned by \p exportFunction into \p fileName
+ */
+void exportWisdom(const QString &fileName, char *(*exportFunction)()) {
+    char *wisdom = exportFunction();
+    QFile file(fileName);
+    if (wisdom == nullptr || !file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(wisdom) < 0) {
+        qWarning() << "Could not save FFTW wisdom into" << fileName;
+    }
+    free(wisdom);
+}
+} // namespace
+
+/**
+ * @brief Returns the smallest size that is at least \p minimumSize and has no prime factors other than 2, 3, 5 and 7.
+ * FFTW is the fastest for such sizes.
+ */
+int FftPlanner::goodSize(int minimumSize) {
+    for (int size = qMax(1, minimumSize);; size++) {
+        int rest = size;
+        for (int factor : {2, 3, 5, 7}) {
+            while (rest % factor == 0) {
+                rest /= factor;
+            }
+        }
+        if (rest == 1) {
+            return size;
+        }
+    }
+}
+
+/**
+ * @brief Loads the wisdom saved in \p dirString, FftPlanner::saveWisdom() saves it there. Has to be called before the
+ * first plan is created.
+ * @param dirString The folder of the wisdom files, ending with a "/"
+ */
+void FftPlanner::loadWisdom(const QString &dirString) {
+    PlanCache &cache = planCache();
+    QMutexLocker locker(&cache.mutex);
+    cache.dirString = dirString;
+    importWisdom(dirString + wisdomFileName, fftw_import_wisdom_from_string);
+    importWisdom(dirString + floatWisdomFileName, fftwf_import_wisdom_from_string);
+}
+
+/**
+ * @brief Saves the wisdom of the plans created so far into the folder set by FftPlanner::loadWisdom()
+ */
+void FftPlanner::saveWisdom() {
+    PlanCache &cache = planCache();
+    QMutexLocker locker(&cache.mutex);
+    if (cache.dirString.isEmpty()) {
+        return;
+    }
+    exportWisdom(cache.dirString + wisdomFileName, fftw_export_wisdom_to_string);
+    exportWisdom(cache.dirString + floatWisdomFileName, fftwf_export_wisdom_to_string);
+}
+
+/**
+ * @brief Returns the plan of the forward complex transform of \p size points, execute it with fftw_execute_dft()
+ */
+fftw_plan FftPlanner::complexPlan(int size) {
+    PlanCache &cache = planCache();
+    QMutexLocker locker(&cache.mutex);
+    if (!cache.complexPlans.contains(size)) {
+        fftw_complex *in = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * size);
+        fftw_complex *out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * size);
+        cache.complexPlans.insert(size, createPlan<fftw_plan>(size, [size, in, out](unsigned int flags) {
+            return fftw_plan_dft_1d(size, in, out, FFTW_FORWARD, flags);
+        }));
+        fftw_free(out);
+        fftw_free(in);
+    }
+    return cache.complexPlans.value(size);
+}
+
+/**
+ * @brief Returns the plan of the real to complex transform of \p size points, execute it with fftw_execute_dft_r2c()
+ */
+fftw_plan FftPlanner::realPlan(int size) {
+    PlanCache &cache = planCache();
+    QMutexLocker locker(&cache.mutex);
+    if (!cache.realPlans.contains(size)) {
+        double *in = (double *) fftw_malloc(sizeof(double) * size);
+        fftw_complex *out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (size / 2 + 1));
+        cache.realPlans.insert(size, createPlan<fftw_plan>(size, [size, in, out](unsigned int flags) {
+            return fftw_plan_dft_r2c_1d(size, in, out, flags);
+        }));
+        fftw_free(out);
+        fftw_free(in);
+    }
+    return cache.realPlans.value(size);
+}
+
+/**
+ * @brief Returns the single precision plan of the forward complex transform of \p size points, execute it with
+ * fftwf_execute_dft()
+ */
+fftwf_plan FftPlanner::complexPlanFloat(int size) {
+    PlanCache &cache = planCache();
+    QMutexLocker locker(&cache.mutex);
+    if (!cache.complexFloatPlans.contains(size)) {
+        fftwf_complex *in = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex) * size);
+        fftwf_complex *out = (fftwf_complex *) fftwf_malloc(sizeof(fftwf_complex) * size);
+        cache.complexFloatPlans.insert(size, createPlan<fftwf_plan>(size, [size, in, out](unsigned int flags) {
+            return fftwf_plan_dft_1d(size, in, out, FFTW_FORWARD, flags);
+        }));
+        fftwf_free(out);
+        fftwf_free(in);
+    }
+    return cache.complexFloatPlans.value(size);
+}
@@ -0,0 +1,32 @@
+#ifndef FFTPLANNER_H
+#define FFTPLANNER_H
+
+#include <../../3rdparty/fftw3/fftw3.h>
+#include <QString>
+
+/**
+ * @brief Creates and shares the FFTW plans of the application and keeps their wisdom between launches.
+ *
+ * A plan is created once per transform and size, with FFTW_PATIENT up to FftPlanner::patientSizeLimit points and with
+ * FFTW_MEASURE above. The plans are shared by every FFT user: they are executed with the new-array functions
+ * (fftw_execute_dft() etc.) on the buffers of the user, which have to be allocated with fftw_malloc() so that their
+ * alignment matches. Executing a plan is thread-safe, creating one is not, so every plan is created through this class
+ * under a mutex. The planning can take seconds, so the plans should be requested off the GUI thread.
+ *
+ * The wisdom is loaded by FftPlanner::loadWisdom() at startup and saved by FftPlanner::saveWisdom() at exit, so the
+ * measuring is only done at the first launch. The plans are destroyed after main() has returned.
+ */
+class FftPlanner {
+public:
+    static constexpr int patientSizeLimit = 8192; //!< Larger plans are only measured, being patient takes too long
+
+    static int goodSize(int minimumSize);
+    static void loadWisdom(const QString &dirString);
+    static void saveWisdom();
+
+    static fftw_plan complexPlan(int size);
+    static fftw_plan realPlan(int size);
+    static fftwf_plan complexPlanFloat(int size);
+};
+
+#endif // FFTPLANNER_H
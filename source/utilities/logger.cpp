@@ -1,25 +1,49 @@
 #include "logger.h"
 #include "QDebug"
+#include <QElapsedTimer>
+#include <QMutexLocker>
 
 /**
  * @brief Constructor for the class.
  *
- * Initializes \p fileName.
+ * Initializes \p fileName and the slots of the message queue. Messages can be logged right away, they are written
+ * once the log folder has been set.
  *
  * @param[in] parent The parent QObject, should be left empty.
  */
-Logger::Logger(QObject *parent) : QObject(parent) {
+Logger::Logger(QObject *parent)
+: QObject(parent), queue_priv(new Slot[queueCapacity]), enqueuePosition_priv(0), dequeuePosition_priv(0),
+  queuedBytes_priv(0), dropped_priv(0), accepted_priv(0), written_priv(0), stopping_priv(0) {
     this->logDirString = "";
     this->prefix = "startup";
     this->fileName = QDateTime::currentDateTimeUtc().toString(QString("yyyyMMdd"));
+    for (quint32 i = 0; i < queueCapacity; i++) {
+        queue_priv[i].sequence.store(i);
+    }
+}
+
+/**
+ * @brief Writes the queued messages, then stops the writer thread
+ */
+Logger::~Logger() {
+    if (writer_priv) {
+        stopping_priv.storeRelease(1);
+        writer_priv->wait();
+    }
 }
 
 /**
- * @brief Sets the log folder string that is used for file names
+ * @brief Sets the log folder string that is used for file names and starts the writer thread
  * @param logDirString The log folder string
  */
 void Logger::setLogFolder(QString logDirString) {
+    if (writer_priv) {
+        qWarning() << "The log folder can only be set once";
+        return;
+    }
     this->logDirString = logDirString;
+    writer_priv.reset(new WriterThread(this));
+    writer_priv->start(QThread::LowPriority);
 }
 
 /**
@@ -27,33 +51,177 @@ void Logger::setLogFolder(QString logDirString) {
  * @param prefix The new prefix to use
  */
 void Logger::changePrefix(QString prefix) {
+    QMutexLocker locker(&prefixMutex_priv);
     this->prefix = prefix;
 }
 
 /**
- * @brief Appends the current logfile with a timestamp and \p message.
+ * @brief Queues \p message with the current time, it is appended to the current logfile by the writer thread.
  *
  * Creates a new file if the date(UTC) has changed.
- * Time timestamp has a yyyy.MM.dd. HH:mm:ss format.
+ * Time timestamp has a yyyy-MM-ddTHH:mm:ssZ format.
  *
  * @param[in] message The message to log.
- * @return Returns true if \p message was succesfully logged, returns false otherwise.
+ * @return Returns true if \p message was queued, returns false if it was dropped because the queue is full.
  */
 bool Logger::writeToLog(QString message) {
-    QString timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-    if (!((timestamp.left(4).compare(fileName.left(4)) == 0) &&
-            (timestamp.mid(5, 2).compare(fileName.mid(4, 2)) == 0) &&
-            (timestamp.mid(8, 2).compare(fileName.mid(6, 2)) == 0))) {
-        fileName = timestamp.left(4) + timestamp.mid(5, 2) + timestamp.mid(8, 2);
-    }
-    QFile f(logDirString + prefix + "_" + fileName + ".txt");
-    if (f.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
-        QTextStream out(&f);
-        out << timestamp << ": " << message << "\n";
-        out.flush();
-        f.close();
-        return true;
-    }
-    qWarning() << "Could not write log file";
-    return false;
+    return enqueue(QDateTime::currentMSecsSinceEpoch(), message);
+}
+
+/**
+ * @brief Waits until the messages queued so far have been written, at most a second. Used before the application is
+ * aborted.
+ */
+void Logger::flush() {
+    if (!writer_priv || !writer_priv->isRunning()) {
+        return;
+    }
+    const quint64 accepted = accepted_priv.loadAcquire();
+    QElapsedTimer timer;
+    timer.start();
+    while (written_priv.loadAcquire() < accepted && timer.elapsed() < 1000) {
+        QThread::msleep(1);
+    }
+}
+
+/**
+ * @brief Puts a message into the queue, can be called by any number of threads at the same time.
+ *
+ * The queue is a ring of slots. A producer claims the position \p enqueuePosition_priv by incrementing it, if the
+ * sequence number of the slot equals the position (the writer has freed it). It stores the message, then publishes it
+ * by setting the sequence number to position + 1. The writer frees the slot by setting it to position + capacity.
+ *
+ * @return False if the message was dropped
+ */
+bool Logger::enqueue(qint64 timeMs, const QString &message) {
+    const int bytes = message.size() * static_cast<int>(sizeof(QChar));
+    if (queuedBytes_priv.fetchAndAddRelaxed(bytes) + bytes > queueBudget) {
+        queuedBytes_priv.fetchAndAddRelaxed(-bytes);
+        dropped_priv.fetchAndAddRelaxed(1);
+        return false;
+    }
+    quint32 position = enqueuePosition_priv.load();
+    Slot *slot;
+    for (;;) {
+        slot = &queue_priv[position & (queueCapacity - 1)];
+        const qint32 difference = static_cast<qint32>(slot->sequence.loadAcquire() - position);
+        if (difference == 0) {
+            if (enqueuePosition_priv.testAndSetRelaxed(position, position + 1, position)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+            // The writer has not freed the slot of the previous round yet, the queue is full
+            queuedBytes_priv.fetchAndAddRelaxed(-bytes);
+            dropped_priv.fetchAndAddRelaxed(1);
+            return false;
+        }
+        else {
+            position = enqueuePosition_priv.load();
+        }
+    }
+    slot->timeMs = timeMs;
+    slot->message = message;
+    slot->sequence.storeRelease(position + 1);
+    accepted_priv.fetchAndAddRelease(1);
+    return true;
+}
+
+/**
+ * @brief Takes the oldest message from the queue, only called by the writer thread
+ * @return False if the queue is empty
+ */
+bool Logger::dequeue(qint64 &timeMs, QString &message) {
+    Slot &slot = queue_priv[dequeuePosition_priv & (queueCapacity - 1)];
+    if (slot.sequence.loadAcquire() != dequeuePosition_priv + 1) {
+        return false;
+    }
+    timeMs = slot.timeMs;
+    message.swap(slot.message);
+    slot.message.clear();
+    queuedBytes_priv.fetchAndAddRelaxed(-message.size() * static_cast<int>(sizeof(QChar)));
+    slot.sequence.storeRelease(dequeuePosition_priv + queueCapacity);
+    dequeuePosition_priv++;
+    return true;
+}
+
+/**
+ * @brief Formats the queued messages and appends them to the log file.
+ *
+ * The file is reopened when the date (UTC) of a message or the prefix differs from the ones of the open file.
+ *
+ * @return The number of messages written
+ */
+int Logger::writeQueued() {
+    QByteArray batch;
+    int count = 0;
+    qint64 timeMs;
+    QString message;
+    const auto writeBatch = [&]() {
+        if (!batch.isEmpty() && file_priv.isOpen()) {
+            file_priv.write(batch);
+        }
+        batch.clear();
+    };
+    const auto openFile = [&](const QString &timestamp) {
+        QString currentPrefix;
+        {
+            QMutexLocker locker(&prefixMutex_priv);
+            currentPrefix = prefix;
+        }
+        const QString date = timestamp.left(4) + timestamp.mid(5, 2) + timestamp.mid(8, 2);
+        const QString path = logDirString + currentPrefix + "_" + date + ".txt";
+        if (file_priv.isOpen() && file_priv.fileName() == path) {
+            return;
+        }
+        writeBatch();
+        file_priv.close();
+        fileName = date;
+        file_priv.setFileName(path);
+        if (!file_priv.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+            fprintf(stderr, "Could not write log file %s\n", qPrintable(path));
+        }
+    };
+
+    while (dequeue(timeMs, message)) {
+        const QString timestamp = QDateTime::fromMSecsSinceEpoch(timeMs, Qt::UTC).toString(Qt::ISODate);
+        const QString date = timestamp.left(4) + timestamp.mid(5, 2) + timestamp.mid(8, 2);
+        if (count == 0 || batch.size() >= batchSize || date != fileName) {
+            writeBatch();
+            openFile(timestamp);
+        }
+        batch += timestamp.toUtf8() + ": " + message.toUtf8() + "\n";
+        count++;
+    }
+    const quint32 dropped = dropped_priv.fetchAndStoreRelaxed(0);
+    if (dropped > 0) {
+        const QString timestamp = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        if (count == 0) {
+            openFile(timestamp);
+        }
+        batch += timestamp.toUtf8() + ": Warning: " + QByteArray::number(dropped) +
+                 " log messages were dropped, the log queue was full\n";
+    }
+    writeBatch();
+    if (file_priv.isOpen()) {
+        file_priv.flush();
+    }
+    written_priv.fetchAndAddRelease(static_cast<quint64>(count));
+    return count;
+}
+
+/**
+ * @brief Main loop of the writer thread: writes the queued messages until the logger is destroyed
+ */
+void Logger::writerLoop() {
+    for (;;) {
+        const bool stopping = stopping_priv.loadAcquire();
+        if (writeQueued() == 0) {
+            if (stopping) {
+                break;
+            }
+            QThread::msleep(idleSleepMs);
+        }
+    }
+    file_priv.close();
 }
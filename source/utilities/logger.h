@@ -1,28 +1,88 @@
 #ifndef LOGGER_H
 #define LOGGER_H
+#include <QAtomicInteger>
 #include <QDateTime>
 #include <QFile>
+#include <QMutex>
 #include <QObject>
+#include <QScopedArrayPointer>
+#include <QScopedPointer>
 #include <QString>
-#include <QTextStream>
+#include <QThread>
 
 /**
  * @brief Logs messages into a file.
  *
  * Automatically logs messages with timestamps into a file. The file's name depends on the current date.
  * UTC is used in the timestamps and filenames.
+ *
+ * Logger::writeToLog() can be called from any thread and never blocks: the message is put into a bounded lock-free
+ * queue (Logger::queueCapacity messages, at most Logger::queueBudget bytes) and a single writer thread formats the
+ * queued messages and appends them to the log file in batches. The file is kept open until the date or the prefix
+ * changes. Messages that do not fit into the queue are dropped and counted, the number of dropped messages is written
+ * to the log. The queue is written out when the logger is destroyed and by Logger::flush().
  */
 class Logger : public QObject {
     Q_OBJECT
 private:
+    /**
+     * @brief A slot of the message queue. The sequence number tells whether the slot is free or holds a message of the
+     * current round, see Logger::enqueue().
+     */
+    struct Slot {
+        QAtomicInteger<quint32> sequence;
+        qint64 timeMs; //!< Time of logging [ms since the epoch]
+        QString message;
+    };
+
+    /**
+     * @brief The thread that writes the queued messages
+     */
+    class WriterThread : public QThread {
+    public:
+        explicit WriterThread(Logger *logger) : logger_priv(logger) {
+        }
+
+    protected:
+        void run() override {
+            logger_priv->writerLoop();
+        }
+
+    private:
+        Logger *logger_priv;
+    };
+
+    static constexpr quint32 queueCapacity = 8192;      //!< Number of slots in the queue, a power of 2
+    static constexpr int queueBudget = 4 * 1024 * 1024; //!< Maximum size of the queued messages [bytes]
+    static constexpr int batchSize = 64 * 1024;         //!< Formatted bytes that are written at once
+    static constexpr int idleSleepMs = 50;              //!< Time that the writer waits when the queue is empty [ms]
+
+    bool enqueue(qint64 timeMs, const QString &message);
+    bool dequeue(qint64 &timeMs, QString &message);
+    int writeQueued();
+    void writerLoop();
+
     QString logDirString; //!< The folder that the log files will be written to.
     QString fileName;     //!< QString that stores the current filename.
     QString prefix;       //!< QString that stores the fileName prefix that will be prepended to the file name.
+    QMutex prefixMutex_priv;              //!< Guards \p prefix, it is read by the writer thread
+    QScopedArrayPointer<Slot> queue_priv; //!< The slots of the message queue
+    QAtomicInteger<quint32> enqueuePosition_priv; //!< Position of the next message that is queued
+    quint32 dequeuePosition_priv;                 //!< Position of the next message that is written, writer only
+    QAtomicInt queuedBytes_priv;                  //!< Size of the queued messages [bytes]
+    QAtomicInteger<quint32> dropped_priv;         //!< Messages dropped since they were last reported
+    QAtomicInteger<quint64> accepted_priv;        //!< Messages queued so far
+    QAtomicInteger<quint64> written_priv;         //!< Messages written so far
+    QAtomicInt stopping_priv;                     //!< Set when the writer has to finish
+    QFile file_priv;                              //!< The open log file, writer only
+    QScopedPointer<WriterThread> writer_priv;     //!< The writer thread, started by Logger::setLogFolder()
 
 public:
     explicit Logger(QObject *parent = 0);
+    ~Logger() override;
     void setLogFolder(QString logDirString);
     Q_INVOKABLE bool writeToLog(QString message);
+    void flush();
 
 public slots:
     void changePrefix(QString prefix);
@@ -14,16 +14,24 @@
 // Copyright (c) 2014 Timur Kristóf
 
 #include "spectogram.h"
+#include "../sdr/widebandspectrum.h"
+#include "../utilities/fftplanner.h"
+#include <QOpenGLContext>
+#include <algorithm>
 
 void Spectogram::clear() {
-    complex_sample_count = 0;
-    real_sample_count = 0;
+    // The worker drops the samples of the previous generation
+    generation++;
 
     // Clearing the screen
-    image->fill(QColor(255, 255, 255));
-    image_line = image->height();
-    image2->fill(QColor(255, 255, 255));
-    image_node_texture2_expired = true;
+    ring_image.fill(QColor(255, 255, 255));
+    ring_row = 0;
+    dirty_rows.clear();
+    for (int row = 0; row < row_count; row++) {
+        dirty_rows.append(row);
+    }
+    average_trace.clear();
+    peak_trace.clear();
     update();
 }
 
@@ -63,7 +71,8 @@ QVector<float> Spectogram::getProcessedAmplitudes(SpectogramMode mode, fftw_comp
     }
 }
 
-QVector<int> Spectogram::getColorIndices(SpectogramMode mode, QVector<float> processed_amplitudes) const {
+QVector<int> Spectogram::getColorIndices(
+    SpectogramMode mode, QVector<float> processed_amplitudes, float scaling) const {
     QVector<int> results;
     switch (mode) {
     case SpectogramMode::radio: {
@@ -83,13 +92,7 @@ QVector<int> Spectogram::getColorIndices(SpectogramMode mode, QVector<float> pro
 
             color_index = (int) ((color_count - 1) / (max - min) * (amplitude - min));
 
-            if (color_index < 0) {
-                color_index = 0;
-            }
-            else if (color_index >= color_count) {
-                color_index = color_count - 1;
-            }
-            results.append(color_index);
+            results.append(qBound(0, color_index, color_count - 1));
         }
         return results;
     }
@@ -101,15 +104,9 @@ QVector<int> Spectogram::getColorIndices(SpectogramMode mode, QVector<float> pro
             amplitude += SDR_DYNAMIC_RANGE; // Offset for visualization
             int color_index;
 
-            color_index = amplitude * sdr_visualization_scaling / SDR_DYNAMIC_RANGE * (color_count - 1);
+            color_index = amplitude * scaling / SDR_DYNAMIC_RANGE * (color_count - 1);
 
-            if (color_index < 0) {
-                color_index = 0;
-            }
-            else if (color_index >= color_count) {
-                color_index = color_count - 1;
-            }
-            results.append(color_index);
+            results.append(qBound(0, color_index, color_count - 1));
         }
         return results;
     }
@@ -119,6 +116,148 @@ QVector<int> Spectogram::getColorIndices(SpectogramMode mode, QVector<float> pro
     }
 }
 
+/**
+ * @brief Maps \p color_indices to the pixels of a row, every index covers the same number of pixels
+ */
+QVector<QRgb> Spectogram::getRow(const QVector<int> &color_indices) const {
+    QVector<QRgb> row(item_width, qRgb(255, 255, 255));
+    if (color_indices.isEmpty()) {
+        return row;
+    }
+    // Plain lookups over contiguous arrays, the compiler can vectorize the loop
+    const int unit_width = static_cast<int>(item_width) / color_indices.size();
+    const int width = unit_width * color_indices.size();
+    const int *indices = color_indices.constData();
+    const QRgb *palette = colors.data();
+    QRgb *pixels = row.data();
+    for (int x = 0; x < width; x++) {
+        pixels[x] = palette[indices[x / unit_width]];
+    }
+    return row;
+}
+
+/**
+ * @brief Drops the samples collected by the worker if \p generation is newer than theirs. Called by the worker.
+ */
+void Spectogram::startGeneration(int generation) {
+    if (generation != worker_generation) {
+        worker_generation = generation;
+        complex_sample_count = 0;
+        real_sample_count = 0;
+    }
+}
+
+/**
+ * @brief Collects audio samples and computes a row of the spectogram from every Spectogram::sample_target_audio
+ * samples. The FFT is twice as long above 48 kHz, so the bins are equally wide at every rate of the device. Called by
+ * the worker.
+ */
+void Spectogram::processRealSamples(int generation, const AudioSampleBlock &samples) {
+    startGeneration(generation);
+    const int fft_size = samples.sampleRate() > 48000 ? maximum_sample_target_audio : sample_target_audio;
+    if (fft_size != real_fft_size) {
+        real_fft_size = fft_size;
+        real_plan = nullptr;
+        real_sample_count = 0;
+    }
+    for (auto sample : samples) {
+        real_samples[real_sample_count] = static_cast<double>(sample);
+        real_sample_count++;
+        if (real_sample_count == real_fft_size) {
+            if (real_plan == nullptr) {
+                real_plan = FftPlanner::realPlan(real_fft_size);
+            }
+            fftw_execute_dft_r2c(real_plan, real_samples, real_fftw_out);
+            const QVector<QRgb> row = getRow(getColorIndices(
+                SpectogramMode::radio, getProcessedAmplitudes(SpectogramMode::radio, real_fftw_out), 1.0f));
+            QMetaObject::invokeMethod(
+                this, [this, generation, row]() { rowReady(generation, row); }, Qt::QueuedConnection);
+            real_sample_count = 0;
+        }
+    }
+}
+
+/**
+ * @brief Collects SDR samples and computes a row of the spectogram from every Spectogram::sample_target_sdr samples.
+ * Called by the worker.
+ */
+void Spectogram::processComplexSamples(int generation, float scaling, const QVector<std::complex<float>> &samples) {
+    startGeneration(generation);
+    for (const auto &sample : samples) {
+        complex_samples[complex_sample_count][0] = static_cast<double>(sample.real());
+        complex_samples[complex_sample_count][1] = static_cast<double>(sample.imag());
+        complex_sample_count++;
+        if (complex_sample_count == sample_target_sdr) {
+            if (complex_plan == nullptr) {
+                complex_plan = FftPlanner::complexPlan(sample_target_sdr);
+            }
+            fftw_execute_dft(complex_plan, complex_samples, complex_fftw_out);
+            const QVector<QRgb> row = getRow(getColorIndices(
+                SpectogramMode::sdr, getProcessedAmplitudes(SpectogramMode::sdr, complex_fftw_out), scaling));
+            QMetaObject::invokeMethod(
+                this, [this, generation, row]() { rowReady(generation, row); }, Qt::QueuedConnection);
+            complex_sample_count = 0;
+        }
+    }
+}
+
+/**
+ * @brief Reduces the bins of a wideband spectrum to the columns of the spectogram by their maximum, then computes the
+ * row and the levels of the traces. Called by the worker.
+ */
+void Spectogram::processWidebandSpectrum(
+    int generation, float scaling, const QVector<float> &average, const QVector<float> &peak) {
+    const int columns = static_cast<int>(item_width);
+    const int bins = average.size();
+    if (bins < columns || peak.size() != bins) {
+        return;
+    }
+    QVector<int> color_indices(columns);
+    QVector<float> average_levels(columns);
+    QVector<float> peak_levels(columns);
+    for (int x = 0; x < columns; x++) {
+        // The bin count is rarely a multiple of the column count, so each column covers [x*N/columns, (x+1)*N/columns)
+        const auto first = static_cast<int>(static_cast<qint64>(x) * bins / columns);
+        const auto last = static_cast<int>(static_cast<qint64>(x + 1) * bins / columns);
+        const float average_db = *std::max_element(average.constBegin() + first, average.constBegin() + last);
+        const float peak_db = *std::max_element(peak.constBegin() + first, peak.constBegin() + last);
+        const float average_level = (average_db - WIDEBAND_FLOOR) * scaling / WIDEBAND_DYNAMIC_RANGE;
+        const float peak_level = (peak_db - WIDEBAND_FLOOR) * scaling / WIDEBAND_DYNAMIC_RANGE;
+        color_indices[x] = qBound(0, static_cast<int>(average_level * (color_count - 1)), color_count - 1);
+        average_levels[x] = qBound(0.0f, average_level, 1.0f);
+        peak_levels[x] = qBound(0.0f, peak_level, 1.0f);
+    }
+    const QVector<QRgb> row = getRow(color_indices);
+    QMetaObject::invokeMethod(this,
+        [this, generation, row, average_levels, peak_levels]() {
+            widebandRowReady(generation, row, average_levels, peak_levels);
+        },
+        Qt::QueuedConnection);
+}
+
+/**
+ * @brief Draws a row computed by the worker unless the spectogram has been cleared since
+ */
+void Spectogram::rowReady(int generation, const QVector<QRgb> &row) {
+    if (generation != this->generation || !is_running) {
+        return;
+    }
+    draw(row);
+}
+
+/**
+ * @brief Draws a wideband row and updates the traces unless the spectogram has been cleared since
+ */
+void Spectogram::widebandRowReady(
+    int generation, const QVector<QRgb> &row, const QVector<float> &average, const QVector<float> &peak) {
+    if (generation != this->generation || !is_running) {
+        return;
+    }
+    average_trace = average;
+    peak_trace = peak;
+    draw(row);
+}
+
 Spectogram::Spectogram(QQuickItem *parent) : QQuickItem(parent) {
     this->setWidth(item_width);
     this->setHeight(item_height);
@@ -126,15 +265,15 @@ Spectogram::Spectogram(QQuickItem *parent) : QQuickItem(parent) {
     this->setVisible(true);
     this->setFlag(QQuickItem::ItemHasContents);
 
-    image.reset(new QImage((int) this->width(), (int) this->height(), QImage::Format_RGB32));
-    image->fill(QColor(255, 255, 255));
-    image_line = image->height();
-    image_node = nullptr;
-    image2.reset(new QImage((int) this->width(), (int) this->height(), QImage::Format_RGB32));
-    image2->fill(QColor(255, 255, 255));
-    image_node2 = nullptr;
-    image_node_texture2_expired = false;
+    ring_image = QImage(item_width, row_count, QImage::Format_RGB32);
+    ring_image.fill(QColor(255, 255, 255));
+    ring_row = 0;
     clip_node = nullptr;
+    top_node = nullptr;
+    bottom_node = nullptr;
+    texture = nullptr;
+    average_node = nullptr;
+    peak_node = nullptr;
 
     // Generate displayable colors
     QImage img(item_width, 1, QImage::Format_RGB32);
@@ -163,28 +302,28 @@ Spectogram::Spectogram(QQuickItem *parent) : QQuickItem(parent) {
     // Repaint this item
     update();
 
+    // The plans are shared, the worker gets them from FftPlanner when they are first needed
     // Complex FFTW
     // http://www.fftw.org/doc/Complex-One_002dDimensional-DFTs.html
     complex_samples = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (sample_target_sdr));
     complex_fftw_out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (sample_target_sdr));
-    complex_plan = fftw_plan_dft_1d(sample_target_sdr, complex_samples, complex_fftw_out, FFTW_FORWARD, FFTW_ESTIMATE);
 
     // Real FFTW
-    real_samples = (double *) fftw_malloc(sizeof(double) * (sample_target_audio));
-    real_fftw_out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (sample_target_audio / 2 + 1));
-    real_plan = fftw_plan_dft_r2c_1d(sample_target_audio, real_samples, real_fftw_out, FFTW_ESTIMATE);
+    real_samples = (double *) fftw_malloc(sizeof(double) * (maximum_sample_target_audio));
+    real_fftw_out = (fftw_complex *) fftw_malloc(sizeof(fftw_complex) * (maximum_sample_target_audio / 2 + 1));
+
+    // The samples of a mode have to be processed in order
+    pool_priv.setMaxThreadCount(1);
 }
 
 Spectogram::~Spectogram() {
-    fftw_destroy_plan(complex_plan);
+    pool_priv.waitForDone();
+
     fftw_free(complex_fftw_out);
     fftw_free(complex_samples);
 
-    fftw_destroy_plan(real_plan);
     fftw_free(real_fftw_out);
     fftw_free(real_samples);
-
-    fftw_cleanup();
 }
 
 bool Spectogram::isRunning() const {
@@ -199,6 +338,10 @@ bool Spectogram::inRadioMode() const {
     return current_mode == SpectogramMode::radio;
 }
 
+bool Spectogram::inWidebandMode() const {
+    return current_mode == SpectogramMode::wideband;
+}
+
 long Spectogram::minimumFrequency() const {
     return minimum_frequency;
 }
@@ -215,6 +358,10 @@ void Spectogram::switchToSDRMode() {
     changeSettings(SpectogramMode::sdr);
 }
 
+void Spectogram::switchToWidebandMode() {
+    changeSettings(SpectogramMode::wideband);
+}
+
 void Spectogram::startSpectogram() {
     if (current_mode == SpectogramMode::unset) {
         qWarning() << "Can not start spectogram in unset mode";
@@ -239,15 +386,20 @@ void Spectogram::setSdrScaling(float value) {
 void Spectogram::changeSettings(SpectogramMode mode) {
     switch (mode) {
     case SpectogramMode::radio:
-        // Sampling rate is 44.1kHz for audio
-        minimum_frequency = 300;  // Not exactly accurate
-        maximum_frequency = 3050; // Not exactly accurate
+        // The bins are 11.7 Hz wide for audio (4096 points at 48 kHz, 8192 points at 96 kHz)
+        minimum_frequency = 330;  // Not exactly accurate
+        maximum_frequency = 3330; // Not exactly accurate
         break;
     case SpectogramMode::sdr:
         // Sampling rate is 2.5kHz for SDR spectogram
         minimum_frequency = -1250;
         maximum_frequency = 1250; // Not exactly accurate
         break;
+    case SpectogramMode::wideband:
+        // The whole passband of the SDR, around its center frequency
+        minimum_frequency = -WidebandSpectrum::sampleRate / 2;
+        maximum_frequency = WidebandSpectrum::sampleRate / 2;
+        break;
     default:
         qWarning() << "Can not set mode to unset";
         return;
@@ -260,41 +412,58 @@ void Spectogram::changeSettings(SpectogramMode mode) {
     clear();
 }
 
-void Spectogram::realSamplesReceived(int16_t *samples, int sample_count) {
-    QScopedArrayPointer<std::int16_t> samples_received(samples);
+void Spectogram::realSamplesReceived(AudioSampleBlock samples) {
     if (!is_running || current_mode != SpectogramMode::radio) {
         return;
     }
-    for (int i = 0; i < sample_count; i++) {
-        real_samples[real_sample_count] = static_cast<double>(samples_received[i]);
-        real_sample_count++;
-        if (real_sample_count == sample_target_audio) {
-            fftw_execute(real_plan);
-            draw(getColorIndices(current_mode, getProcessedAmplitudes(current_mode, real_fftw_out)));
-            real_sample_count = 0;
-        }
-    }
+    const int generation = this->generation;
+    pool_priv.start(new FunctionJob([this, generation, samples]() { processRealSamples(generation, samples); }));
 }
 
-void Spectogram::complexSampleReceived(std::complex<float> sample) {
+void Spectogram::complexSamplesReceived(QVector<std::complex<float>> samples) {
     if (!isRunning() || current_mode != SpectogramMode::sdr) {
         return;
     }
+    const int generation = this->generation;
+    const float scaling = sdr_visualization_scaling;
+    pool_priv.start(new FunctionJob(
+        [this, generation, scaling, samples]() { processComplexSamples(generation, scaling, samples); }));
+}
 
-    complex_samples[complex_sample_count][0] = static_cast<double>(sample.real());
-    complex_samples[complex_sample_count][1] = static_cast<double>(sample.imag());
-    complex_sample_count++;
-    if (complex_sample_count == sample_target_sdr) {
-        fftw_execute(complex_plan);
-        draw(getColorIndices(current_mode, getProcessedAmplitudes(current_mode, complex_fftw_out)));
-        complex_sample_count = 0;
+void Spectogram::widebandSpectrumReceived(QVector<float> average, QVector<float> peak) {
+    if (!isRunning() || current_mode != SpectogramMode::wideband) {
+        return;
     }
+    const int generation = this->generation;
+    const float scaling = sdr_visualization_scaling;
+    pool_priv.start(new FunctionJob([this, generation, scaling, average, peak]() {
+        processWidebandSpectrum(generation, scaling, average, peak);
+    }));
 }
 
+/**
+ * @brief Updates the scene graph on the render thread while the GUI thread is blocked.
+ *
+ * Only the rows drawn since the last update are passed to the texture. The ring is shown by two nodes: the newest row
+ * and the ones after it in the ring come first, then the oldest rows from the start of the ring. Scrolling only moves
+ * the source rectangles of the nodes.
+ */
 QSGNode *Spectogram::updatePaintNode(QSGNode *mainNode, UpdatePaintNodeData *) {
     if (nullptr == mainNode) {
         mainNode = new QSGNode();
         mainNode->setFlag(QSGNode::OwnedByParent);
+        // The nodes and the texture of a previous scene graph have been deleted
+        clip_node = nullptr;
+        top_node = nullptr;
+        bottom_node = nullptr;
+        texture = nullptr;
+        average_node = nullptr;
+        peak_node = nullptr;
+        fallback_texture.reset();
+        dirty_rows.clear();
+        for (int row = 0; row < row_count; row++) {
+            dirty_rows.append(row);
+        }
     }
 
     if (nullptr == clip_node) {
@@ -305,82 +474,108 @@ QSGNode *Spectogram::updatePaintNode(QSGNode *mainNode, UpdatePaintNodeData *) {
         mainNode->appendChildNode(clip_node);
     }
 
-    QQuickWindow::CreateTextureOptions textureOptions = 0;
-#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
-    textureOptions = QQuickWindow::TextureIsOpaque;
-#endif
-
-    image_node_texture.reset(this->window()->createTextureFromImage(*image, textureOptions));
-
-    // Scene graph node of first texture
-    if (nullptr == image_node) {
-        image_node = new QSGSimpleTextureNode();
-        image_node->setFlag(QSGNode::OwnedByParent);
-        clip_node->appendChildNode(image_node);
+    if (nullptr == top_node) {
+        top_node = this->window()->createImageNode();
+        top_node->setFlag(QSGNode::OwnedByParent);
+        top_node->setFiltering(QSGTexture::Nearest);
+        clip_node->appendChildNode(top_node);
+        bottom_node = this->window()->createImageNode();
+        bottom_node->setFlag(QSGNode::OwnedByParent);
+        bottom_node->setFiltering(QSGTexture::Nearest);
+        clip_node->appendChildNode(bottom_node);
+
+        if (QOpenGLContext::currentContext() != nullptr) {
+            texture = new WaterfallTexture(item_width, row_count);
+            top_node->setTexture(texture);
+            top_node->setOwnsTexture(true);
+            bottom_node->setTexture(texture);
+        }
     }
 
-    image_node->setTexture(image_node_texture.data());
-    qreal ycoord = -image_line;
-    image_node->setRect(0, ycoord, this->width(), this->height());
-
-    if (nullptr == image_node_texture2 || image_node_texture2_expired) {
-        image_node_texture2.reset(this->window()->createTextureFromImage(*image2, textureOptions));
+    if (nullptr != texture) {
+        for (int row : dirty_rows) {
+            texture->uploadRow(row, reinterpret_cast<const QRgb *>(ring_image.constScanLine(row)));
+        }
     }
-
-    image_node_texture2_expired = false;
-
-    // Scene graph node of second texture
-    if (nullptr == image_node2) {
-        image_node2 = new QSGSimpleTextureNode();
-        image_node2->setFlag(QSGNode::OwnedByParent);
-        clip_node->appendChildNode(image_node2);
+    else if (!dirty_rows.isEmpty() || fallback_texture.isNull()) {
+        // Without OpenGL the whole ring has to be uploaded
+        QQuickWindow::CreateTextureOptions textureOptions = 0;
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
+        textureOptions = QQuickWindow::TextureIsOpaque;
+#endif
+        fallback_texture.reset(this->window()->createTextureFromImage(ring_image, textureOptions));
+        top_node->setTexture(fallback_texture.data());
+        bottom_node->setTexture(fallback_texture.data());
     }
-
-    image_node2->setTexture(image_node_texture2.data());
-    image_node2->setRect(0, ycoord + image->height(), this->width(), this->height());
+    dirty_rows.clear();
+
+    const int top_rows = row_count - ring_row;
+    top_node->setSourceRect(QRectF(0, ring_row, item_width, top_rows));
+    top_node->setRect(QRectF(0, 0, this->width(), top_rows * unit_height));
+    bottom_node->setSourceRect(QRectF(0, 0, item_width, ring_row));
+    bottom_node->setRect(QRectF(0, top_rows * unit_height, this->width(), ring_row * unit_height));
+
+    if (nullptr == average_node) {
+        peak_node = createTraceNode(QColor(255, 255, 0));
+        clip_node->appendChildNode(peak_node);
+        average_node = createTraceNode(QColor(255, 255, 255));
+        clip_node->appendChildNode(average_node);
+    }
+    updateTraceNode(average_node, average_trace);
+    updateTraceNode(peak_node, peak_trace);
 
     return mainNode;
 }
 
-void Spectogram::draw(QVector<int> color_indices) {
-    // Get raw image data (1 pixel = 0xffRRGGBB)
-    QRgb *imgData = (QRgb *) image->bits();
-
-    int yystart = image_line - unit_height;
-    if (yystart < 0) {
-        yystart = 0;
-    }
-    int yyend = image_line;
-    int imgWidth = image->width();
-    int unit_width = imgWidth / color_indices.size();
-
-    for (int x = 0; x < color_indices.size(); x++) {
-        int color_index = color_indices[x];
-
-        // Draw a colored rectangle by directly manipulating the image pixels
-        // It is implemented this way in order to increase performance
-
-        int xxstart = x * unit_width;
-        int xxend = xxstart + unit_width;
-        QRgb pixelColor = colors[color_index];
+/**
+ * @brief Creates a node that draws a trace of the wideband spectrum as a line strip
+ */
+QSGGeometryNode *Spectogram::createTraceNode(const QColor &color) const {
+    QSGGeometryNode *node = new QSGGeometryNode();
+    QSGGeometry *geometry = new QSGGeometry(QSGGeometry::defaultAttributes_Point2D(), 0);
+    geometry->setDrawingMode(QSGGeometry::DrawLineStrip);
+    geometry->setLineWidth(1);
+    node->setGeometry(geometry);
+    QSGFlatColorMaterial *material = new QSGFlatColorMaterial();
+    material->setColor(color);
+    node->setMaterial(material);
+    node->setFlags(QSGNode::OwnsGeometry | QSGNode::OwnsMaterial | QSGNode::OwnedByParent);
+    return node;
+}
 
-        for (int yy = yystart; yy < yyend; yy++) {
-            QRgb *line = imgData + (yy * imgWidth);
-            for (int xx = xxstart; xx < xxend; xx++) {
-                *(line + xx) = pixelColor;
-            }
-        }
+/**
+ * @brief Sets the vertices of a trace node from the levels of the columns, an empty trace is not drawn
+ */
+void Spectogram::updateTraceNode(QSGGeometryNode *node, const QVector<float> &trace) const {
+    QSGGeometry *geometry = node->geometry();
+    geometry->allocate(trace.size());
+    QSGGeometry::Point2D *vertices = geometry->vertexDataAsPoint2D();
+    const float column_width = static_cast<float>(this->width()) / qMax(1, trace.size());
+    const float height = static_cast<float>(this->height());
+    for (int x = 0; x < trace.size(); x++) {
+        vertices[x].set((x + 0.5f) * column_width, (1.0f - trace[x]) * height);
     }
+    node->markDirty(QSGNode::DirtyGeometry);
+}
 
-    image_line -= unit_height;
-
-    // When first image is full, swap them
-    if (image_line <= 0) {
-        image.swap(image2);
-        image_line = image->height();
-        image_node_texture2_expired = true;
-    }
+/**
+ * @brief Adds \p row to the top of the waterfall, the oldest row is overwritten
+ */
+void Spectogram::draw(const QVector<QRgb> &row) {
+    ring_row = (ring_row + row_count - 1) % row_count;
+    std::copy(row.constBegin(), row.constBegin() + ring_image.width(),
+        reinterpret_cast<QRgb *>(ring_image.scanLine(ring_row)));
+    markRowDirty(ring_row);
 
     // Redraw the item
     update();
 }
+
+/**
+ * @brief Marks \p row of the ring to be uploaded by the next Spectogram::updatePaintNode()
+ */
+void Spectogram::markRowDirty(int row) {
+    if (!dirty_rows.contains(row)) {
+        dirty_rows.append(row);
+    }
+}
@@ -1,31 +1,50 @@
 #ifndef SPECTOGRAM_H
 #define SPECTOGRAM_H
 
+#include "../audio/audiosampleblock.h"
+#include "../utilities/common.h"
+#include "waterfalltexture.h"
 #include <../../3rdparty/fftw3/fftw3.h>
 #include <QImage>
 #include <QPainter>
 #include <QQuickItem>
 #include <QQuickWindow>
 #include <QSGClipNode>
+#include <QSGFlatColorMaterial>
+#include <QSGGeometryNode>
+#include <QSGImageNode>
 #include <QSGNode>
-#include <QSGSimpleTextureNode>
 #include <QSGTexture>
 #include <QScopedPointer>
+#include <QThreadPool>
+#include <QVector>
 #include <complex>
 
-enum SpectogramMode { radio, sdr, unset };
+enum SpectogramMode { radio, sdr, wideband, unset };
 
 /**
  * @brief This class handles FFTW operations and the drawing of the result.
  *
  * This component runs FFTW when the given number of samples have arrived and performs no other checking related to
  * samples.
+ *
+ * The samples arrive in blocks. The FFTs and the color mapping are computed on a worker thread, only the finished rows
+ * of pixels are passed back to the GUI thread to be drawn. The FFTW buffers and sample counters belong to the worker
+ * thread. Changing the mode or clearing the spectogram starts a new generation: the worker drops the samples of the
+ * previous one and the GUI thread drops its rows.
+ *
+ * The waterfall is a ring of Spectogram::row_count rows in a texture. A new row overwrites the oldest one and only that
+ * row is uploaded, the waterfall is scrolled by changing the texture coordinates of the nodes that show the ring.
+ *
+ * In wideband mode the spectra of WidebandSpectrum are shown: the bins are reduced to the columns by their maximum, and
+ * the current spectrum and its peak-hold are drawn as traces over the waterfall.
  */
 class Spectogram : public QQuickItem {
     Q_OBJECT
     Q_PROPERTY(bool running READ isRunning NOTIFY isRunningChanged)
     Q_PROPERTY(bool inRadioMode READ inRadioMode NOTIFY modeChanged)
     Q_PROPERTY(bool inSDRMode READ inSDRMode NOTIFY modeChanged)
+    Q_PROPERTY(bool inWidebandMode READ inWidebandMode NOTIFY modeChanged)
     Q_PROPERTY(long minimumFrequency READ minimumFrequency NOTIFY minimumFrequencyChanged)
     Q_PROPERTY(long maximumFrequency READ maximumFrequency NOTIFY maximumFrequencyChanged)
     Q_PROPERTY(float sdrScaling READ sdrScaling WRITE setSdrScaling)
@@ -39,45 +58,72 @@ class Spectogram : public QQuickItem {
     void setMaximumFrequency(long maximum_frequency);
     void changeSettings(SpectogramMode mode);
 
-    // FFTW related variables
-    fftw_plan complex_plan;
+    int generation = 0; //!< Incremented when the spectogram is cleared, rows of older generations are dropped
+
+    // FFTW related variables, used by the worker thread only
+    int worker_generation = 0; //!< The generation of the samples collected by the worker
+    fftw_plan complex_plan = nullptr; //!< Shared plan, see FftPlanner
     fftw_complex *complex_samples = nullptr;
     int complex_sample_count = 0;
     fftw_complex *complex_fftw_out;
 
-    fftw_plan real_plan;
+    fftw_plan real_plan = nullptr; //!< Shared plan, see FftPlanner
+    int real_fft_size = sample_target_audio; //!< Follows the rate of the audio device
     double *real_samples = nullptr;
     int real_sample_count = 0;
     fftw_complex *real_fftw_out;
 
     static constexpr int SDR_DYNAMIC_RANGE = 60;
+    static constexpr int WIDEBAND_DYNAMIC_RANGE = 80; //!< Shown range of the wideband spectrum [dB]
+    static constexpr int WIDEBAND_FLOOR = -100;       //!< Lowest shown level of the wideband spectrum [dBFS]
     float sdr_visualization_scaling = 1.0f;
 
     static constexpr int sample_target_sdr = 1024;
-    static constexpr int sample_target_audio = 4098;
+    static constexpr int sample_target_audio = 4096; //!< A power of 2, FFTW is slow for sizes with large prime factors
+    static constexpr int maximum_sample_target_audio = 2 * sample_target_audio; //!< Used at 96 kHz
 
     // Drawing related variables
     static constexpr unsigned int item_width = 512;  //!< The height of the item
     static constexpr unsigned int item_height = 150; //!< The height of the item
     static constexpr int unit_height = 4;            //!< The height of each row in pixels
 
-    QScopedArrayPointer<QRgb> colors;
+    static constexpr int row_count = (item_height + unit_height - 1) / unit_height; //!< Rows in the waterfall
+
+    QScopedArrayPointer<QRgb> colors; //!< The palette, indexed by the color indices
     static constexpr int color_count = item_width;
-    QSGClipNode *clip_node; //!< Pointer to the SQGClipNode object, its parent will delete it
-    QScopedPointer<QImage> image;
-    QSGSimpleTextureNode *image_node; // This class is deprecated! Its parent will delete it
-    QScopedPointer<QSGTexture, QScopedPointerDeleteLater> image_node_texture;
-    int image_line;
-    QScopedPointer<QImage> image2;
-    QSGSimpleTextureNode *image_node2; // This class is deprecated! Its parent will delete it
-    QScopedPointer<QSGTexture, QScopedPointerDeleteLater> image_node_texture2;
-    bool image_node_texture2_expired;
+    QSGClipNode *clip_node;    //!< Pointer to the SQGClipNode object, its parent will delete it
+    QSGImageNode *top_node;    //!< Shows the rows from \p ring_row to the end of the ring, its parent will delete it
+    QSGImageNode *bottom_node; //!< Shows the rows before \p ring_row, its parent will delete it
+    WaterfallTexture *texture; //!< The ring of rows on the GPU, owned by \p top_node
+    QScopedPointer<QSGTexture, QScopedPointerDeleteLater> fallback_texture; //!< Used without OpenGL
+    QImage ring_image;       //!< The ring of rows, one row of pixels per row of the waterfall
+    int ring_row;            //!< The row of \p ring_image that holds the newest row
+    QVector<int> dirty_rows; //!< Rows of \p ring_image that have not been uploaded yet
+
+    QSGGeometryNode *average_node; //!< Trace of the wideband spectrum, its parent will delete it
+    QSGGeometryNode *peak_node;    //!< Trace of the wideband peak-hold, its parent will delete it
+    QVector<float> average_trace;  //!< Levels of the columns in the wideband spectrum [0, 1]
+    QVector<float> peak_trace;     //!< Levels of the columns in the wideband peak-hold [0, 1]
+
+    QThreadPool pool_priv; //!< The worker thread of the FFTs, destroyed (and waited for) first
 
     void clear(); //!< Clears the image
     void setIsRunning(bool is_running);
     QVector<float> getProcessedAmplitudes(SpectogramMode mode, fftw_complex *fftw_out) const;
-    QVector<int> getColorIndices(SpectogramMode mode, QVector<float> processed_amplitudes) const;
-    void draw(QVector<int> color_indices);
+    QVector<int> getColorIndices(SpectogramMode mode, QVector<float> processed_amplitudes, float scaling) const;
+    QVector<QRgb> getRow(const QVector<int> &color_indices) const;
+    void startGeneration(int generation);
+    void processRealSamples(int generation, const AudioSampleBlock &samples);
+    void processComplexSamples(int generation, float scaling, const QVector<std::complex<float>> &samples);
+    void processWidebandSpectrum(
+        int generation, float scaling, const QVector<float> &average, const QVector<float> &peak);
+    void rowReady(int generation, const QVector<QRgb> &row);
+    void widebandRowReady(
+        int generation, const QVector<QRgb> &row, const QVector<float> &average, const QVector<float> &peak);
+    QSGGeometryNode *createTraceNode(const QColor &color) const;
+    void updateTraceNode(QSGGeometryNode *node, const QVector<float> &trace) const;
+    void draw(const QVector<QRgb> &row);
+    void markRowDirty(int row);
 
 public:
     explicit Spectogram(QQuickItem *parent = nullptr);
@@ -87,11 +133,13 @@ public:
     bool isRunning() const;
     bool inSDRMode() const;
     bool inRadioMode() const;
+    bool inWidebandMode() const;
     long minimumFrequency() const;
     long maximumFrequency() const;
 
     Q_INVOKABLE void switchToRadioMode();
     Q_INVOKABLE void switchToSDRMode();
+    Q_INVOKABLE void switchToWidebandMode();
     Q_INVOKABLE void startSpectogram();
     Q_INVOKABLE void stopSpectogram();
 
@@ -99,8 +147,9 @@ public:
     void setSdrScaling(float value);
 
 public slots:
-    void realSamplesReceived(int16_t *samples, int sample_count);
-    void complexSampleReceived(std::complex<float> sample);
+    void realSamplesReceived(AudioSampleBlock samples);
+    void complexSamplesReceived(QVector<std::complex<float>> samples);
+    void widebandSpectrumReceived(QVector<float> average, QVector<float> peak);
 signals:
     void isRunningChanged();
     void minimumFrequencyChanged();
@@ -0,0 +1,86 @@
+#include "waterfalltexture.h"
+#include <QOpenGLContext>
+#include <QtEndian>
+
+/**
+ * @brief Constructor for the class. The texture is created when it is first used, filled with white.
+ * @param width Width of the rows [pixels]
+ * @param rows Number of rows
+ */
+WaterfallTexture::WaterfallTexture(int width, int rows)
+: QSGTexture(), size_priv(width, rows), id_priv(0), bound_priv(false), rgba_priv(width) {
+}
+
+/**
+ * @brief Deletes the texture, called on the render thread by the node that owns it
+ */
+WaterfallTexture::~WaterfallTexture() {
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (id_priv != 0 && context != nullptr) {
+        context->functions()->glDeleteTextures(1, &id_priv);
+    }
+}
+
+int WaterfallTexture::textureId() const {
+    return static_cast<int>(id_priv);
+}
+
+QSize WaterfallTexture::textureSize() const {
+    return size_priv;
+}
+
+bool WaterfallTexture::hasAlphaChannel() const {
+    return false;
+}
+
+bool WaterfallTexture::hasMipmaps() const {
+    return false;
+}
+
+/**
+ * @brief Creates the texture, filled with white
+ */
+void WaterfallTexture::create(QOpenGLFunctions *gl) {
+    const QVector<quint32> white(size_priv.width() * size_priv.height(), 0xffffffff);
+    gl->glGenTextures(1, &id_priv);
+    gl->glBindTexture(GL_TEXTURE_2D, id_priv);
+    gl->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size_priv.width(), size_priv.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE,
+        white.constData());
+}
+
+/**
+ * @brief Binds the texture, called on the render thread
+ */
+void WaterfallTexture::bind() {
+    QOpenGLFunctions *gl = QOpenGLContext::currentContext()->functions();
+    if (id_priv == 0) {
+        create(gl);
+    }
+    else {
+        gl->glBindTexture(GL_TEXTURE_2D, id_priv);
+    }
+    // The filtering and wrap mode have to be set on the first bind, even if the texture was created by an upload
+    updateBindOptions(!bound_priv);
+    bound_priv = true;
+}
+
+/**
+ * @brief Uploads the pixels of \p row. Called on the render thread while the GUI thread is blocked.
+ * @param row The row of the texture
+ * @param pixels WaterfallTexture::textureSize().width() pixels
+ */
+void WaterfallTexture::uploadRow(int row, const QRgb *pixels) {
+    QOpenGLFunctions *gl = QOpenGLContext::currentContext()->functions();
+    if (id_priv == 0) {
+        create(gl);
+    }
+    else {
+        gl->glBindTexture(GL_TEXTURE_2D, id_priv);
+    }
+    quint32 *rgba = rgba_priv.data();
+    for (int x = 0; x < size_priv.width(); x++) {
+        // 0xAARRGGBB -> R, G, B, A bytes regardless of the endianness
+        rgba[x] = qToBigEndian<quint32>((pixels[x] << 8) | (pixels[x] >> 24));
+    }
+    gl->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, row, size_priv.width(), 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+}
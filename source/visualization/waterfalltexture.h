@@ -0,0 +1,39 @@
+#ifndef WATERFALLTEXTURE_H
+#define WATERFALLTEXTURE_H
+
+#include <QOpenGLFunctions>
+#include <QRgb>
+#include <QSGTexture>
+#include <QSize>
+#include <QVector>
+
+/**
+ * @brief An OpenGL texture that is used as a ring of rows by the waterfall of Spectogram.
+ *
+ * The rows are uploaded one by one with glTexSubImage2D() from Spectogram::updatePaintNode(), where the OpenGL context
+ * of the scene graph is current. The texture is created by the first upload or bind and deleted with the node that owns
+ * it, both on the render thread.
+ */
+class WaterfallTexture : public QSGTexture {
+public:
+    WaterfallTexture(int width, int rows);
+    ~WaterfallTexture() override;
+
+    int textureId() const override;
+    QSize textureSize() const override;
+    bool hasAlphaChannel() const override;
+    bool hasMipmaps() const override;
+    void bind() override;
+
+    void uploadRow(int row, const QRgb *pixels);
+
+private:
+    void create(QOpenGLFunctions *gl);
+
+    QSize size_priv;
+    GLuint id_priv;
+    bool bound_priv;            //!< True if the bind options have been set
+    QVector<quint32> rgba_priv; //!< A row in RGBA8888 byte order, reused by the uploads
+};
+
+#endif // WATERFALLTEXTURE_H
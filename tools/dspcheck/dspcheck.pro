@@ -0,0 +1,58 @@
+# Compares the fixed-point DSP chain with the floating-point one, built separately from the application
+# (or with tools/tools.pro):
+#   qmake tools/dspcheck/dspcheck.pro && make && ./dspcheck --output results.json
+
+TEMPLATE = app
+TARGET = dspcheck
+
+QT = core
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+ROOT = $$PWD/../..
+INCLUDEPATH += $$ROOT
+
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic
+
+# MagicDemodulator keeps both chains
+DEFINES += S1DEM_BOTH_CHAINS
+
+HEADERS += \
+    $$ROOT/source/demod/magicdemodulator.h \
+    $$ROOT/source/demod/newsmog1dem.h \
+    $$ROOT/source/demod/rationalresampler.h \
+    $$ROOT/source/packet/decodedpacket.h \
+    $$ROOT/source/packet/fecdecoder.h \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_message.h \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_rs.h \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_spiral-vit_scalar_1280.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_message.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_spiral-vit_scalar.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_rs.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/encode/ao40_encode_message.h \
+    $$ROOT/dependencies/FEC-AO40/common/ao40_unpack.h \
+    $$ROOT/dependencies/racoder/ra_config.h \
+    $$ROOT/dependencies/racoder/ra_decoder_gen.h \
+    $$ROOT/dependencies/racoder/ra_encoder.h \
+    $$ROOT/dependencies/racoder/ra_lfsr.h \
+
+SOURCES += \
+    main.cpp \
+    $$ROOT/source/demod/magicdemodulator.cpp \
+    $$ROOT/source/demod/newsmog1dem.cpp \
+    $$ROOT/source/demod/rationalresampler.cpp \
+    $$ROOT/source/packet/decodedpacket.cpp \
+    $$ROOT/source/packet/fecdecoder.cpp \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_message.c \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_rs.c \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_spiral-vit_scalar_1280.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_message.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_spiral-vit_scalar.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_rs.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/encode/ao40_encode_message.c \
+    $$ROOT/dependencies/FEC-AO40/common/ao40_unpack.c \
+    $$ROOT/dependencies/racoder/ra_config.c \
+    $$ROOT/dependencies/racoder/ra_decoder_gen.c \
+    $$ROOT/dependencies/racoder/ra_encoder.c \
+    $$ROOT/dependencies/racoder/ra_lfsr.c \
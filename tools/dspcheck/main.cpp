@@ -0,0 +1,478 @@
+#include "dependencies/FEC-AO40/ao40/encode/ao40_encode_message.h"
+#include "source/demod/magicdemodulator.h"
+#include "source/demod/newsmog1dem.h"
+#include "source/demod/rationalresampler.h"
+#include "source/packet/fecdecoder.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QTextStream>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+static constexpr long sdrSamplingRate = 250000; //!< The rate SDRWorker reads the SDR at
+static constexpr long sdrCarrier = 12000;       //!< Offset of the signal from the center of the SDR [Hz]
+static constexpr double sdrNoise = 20.0;        //!< Noise per component, in steps of the 8 bit SDR samples
+static constexpr double audioNoise = 2000.0;    //!< Noise, in steps of the 16 bit audio samples
+static constexpr int audioBlockSize = 4096;     //!< Samples per block, like AudioFileSource
+
+/**
+ * @brief The front-end a signal is received through
+ */
+enum class Path { SDR, Audio };
+
+/**
+ * @brief Counters of a single Eb/N0 point, for both chains
+ */
+struct PointResult {
+    int frames = 0;
+    int floatDecoded = 0;      //!< Frames the floating-point chain received without errors after the FEC
+    int fixedDecoded = 0;      //!< Frames the fixed-point chain received without errors after the FEC
+    bool identical = false;    //!< Both chains demodulated the same frames, bit by bit
+    qint64 decisions = 0;      //!< Hard decisions of the floating-point chain
+    qint64 equalDecisions = 0; //!< Hard decisions of the fixed-point chain that are the same
+    qint64 samples = 0;        //!< Input samples
+    qint64 floatNs = 0;
+    qint64 fixedNs = 0;
+};
+
+/**
+ * @brief A MagicDemodulator of the AO40 frames, with a copy of its hard decisions
+ */
+class Receiver {
+public:
+    explicit Receiver(long datarate) : demodulator(S1DEM_AUDIO_SAMPLING_FREQ, datarate, "dspcheck") {
+        QObject::connect(
+            &demodulator, &MagicDemodulator::dataReady, [this](QDateTime, QString, QString packetUpperHexString) {
+                const QByteArray frame = QByteArray::fromHex(packetUpperHexString.toLatin1());
+                if (frame.length() == AO40_DOWNLINKLENGTH) {
+                    frames.append(frame);
+                }
+            });
+        demodulator.setDecisionLog(&decisions);
+    }
+
+    template <typename Sample>
+    void add(Sample sample) {
+        demodulator.addSample(sample);
+    }
+
+    QList<QByteArray> frames;   //!< The demodulated frames
+    QVector<uint8_t> decisions; //!< The hard decisions, two per bit
+
+private:
+    MagicDemodulator demodulator;
+};
+
+/**
+ * @brief The front-end of SDRWorker or AudioInDemodulator in floating-point or fixed-point, with a Receiver
+ */
+class Chain {
+public:
+    Chain(Path path, long datarate, long audioRate, bool fixed)
+    : receiver(datarate), fixed(fixed), resampler(audioRate, S1DEM_AUDIO_SAMPLING_FREQ, audioTaps(audioRate)) {
+        if (path == Path::SDR) {
+            change_cnco_sampling_rate(&cnco_vars, sdrSamplingRate);
+            change_cnco_offset_frequency(&cnco_vars, sdrCarrier);
+        }
+        else {
+            change_cnco_sampling_rate(&cnco_vars, S1DEM_AUDIO_SAMPLING_FREQ);
+            change_cnco_offset_frequency(&cnco_vars, S1DEM_AUDIO_FREQ_CENTER_OFFSET);
+        }
+        reinitialize_avg_vars(&avg_vars_5, 10);
+        reinitialize_avg_dec_vars(&avg_dec_vars_5, 5);
+        reinitialize_avg_fixed_vars(&avg_fixed_vars_5, 10);
+        reinitialize_avg_dec_fixed_vars(&avg_dec_fixed_vars_5, 5);
+    }
+
+    ~Chain() {
+        free(cnco_vars.lo);
+        free(cnco_vars.lo_q15);
+        free(avg_vars_5.buf);
+        free(avg_dec_vars_5.buf);
+        free(avg_fixed_vars_5.buf);
+    }
+
+    /**
+     * @brief Processes 8 bit I/Q samples like the callback of SDRWorker
+     */
+    void processSdr(const QByteArray &iq) {
+        const uint8_t *buf = reinterpret_cast<const uint8_t *>(iq.constData());
+        for (int i = 0; i < iq.length(); i += 2) {
+            if (fixed) {
+                FixedComplex output;
+                if (decimate_5(&cnco_vars, &avg_fixed_vars_5, &avg_dec_fixed_vars_5, buf[i], buf[i + 1], &output)) {
+                    receiver.add(output);
+                }
+            }
+            else {
+                std::complex<float> output;
+                if (decimate_5(&cnco_vars, &avg_vars_5, &avg_dec_vars_5, buf[i], buf[i + 1], &output)) {
+                    receiver.add(output);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Processes 16 bit audio samples in blocks, like AudioInDemodulator
+     */
+    void processAudio(const QVector<std::int16_t> &samples) {
+        for (int offset = 0; offset < samples.size(); offset += audioBlockSize) {
+            const int count = std::min(samples.size() - offset, audioBlockSize);
+            if (fixed) {
+                fixed_buffer.resize(resampler.maximumOutputCount(count));
+                const int resampled = resampler.process(samples.constData() + offset, count, fixed_buffer.data());
+                for (int i = 0; i < resampled; i++) {
+                    receiver.add(cnco_fixed(&cnco_vars, s16le2fixed(fixed_buffer[i])));
+                }
+            }
+            else {
+                input_buffer.resize(count);
+                output_buffer.resize(resampler.maximumOutputCount(count));
+                for (int i = 0; i < count; i++) {
+                    input_buffer[i] = s16le2cf(samples[offset + i]).real();
+                }
+                const int resampled = resampler.process(input_buffer.constData(), count, output_buffer.data());
+                for (int i = 0; i < resampled; i++) {
+                    receiver.add(cnco(&cnco_vars, std::complex<float>(output_buffer[i], 0)));
+                }
+            }
+        }
+    }
+
+    Receiver receiver;
+
+private:
+    /**
+     * @brief Returns the taps per phase AudioInDemodulator designs its resampler with for \p audioRate
+     */
+    static int audioTaps(long audioRate) {
+        const long ratio = (audioRate + S1DEM_AUDIO_SAMPLING_FREQ - 1) / S1DEM_AUDIO_SAMPLING_FREQ;
+        return RationalResampler::DEFAULT_TAPS_PER_PHASE * static_cast<int>(std::max(1L, ratio));
+    }
+
+    bool fixed;
+    CncoVariables cnco_vars;
+    AveragingVariables avg_vars_5;
+    AveragingDecVariables avg_dec_vars_5;
+    AveragingFixedVariables avg_fixed_vars_5;
+    AveragingDecFixedVariables avg_dec_fixed_vars_5;
+    RationalResampler resampler;
+    QVector<float> input_buffer;
+    QVector<float> output_buffer;
+    QVector<std::int16_t> fixed_buffer;
+};
+
+/**
+ * @brief Continuous-phase 2-FSK modulator, the deviation is a quarter of the datarate (MSK)
+ */
+class Modulator {
+public:
+    Modulator(double samplingRate, double carrier, long datarate)
+    : samplingRate(samplingRate), carrier(carrier), deviation(datarate / 4.0), bitStep(datarate / samplingRate) {}
+
+    /**
+     * @brief Returns the phase of every sample of \p bytes, sent MSB first, continuing the previous call
+     */
+    QVector<double> modulate(const QByteArray &bytes) {
+        QVector<double> phases;
+        phases.reserve(static_cast<int>(bytes.length() * 8 / bitStep) + 1);
+        for (char byte : bytes) {
+            for (int bit = 7; bit >= 0; bit--) {
+                const double frequency = carrier + ((byte >> bit) & 1 ? deviation : -deviation);
+                for (; bitClock < 1.0; bitClock += bitStep) {
+                    phase = std::fmod(phase + 2 * M_PI * frequency / samplingRate, 2 * M_PI);
+                    phases.append(phase);
+                }
+                bitClock -= 1.0;
+            }
+        }
+        return phases;
+    }
+
+private:
+    double samplingRate;
+    double carrier;
+    double deviation;
+    double bitStep; //!< Bits per sample
+    double phase = 0.0;
+    double bitClock = 0.0; //!< Part of the current bit that has been sent
+};
+
+/**
+ * @brief Returns the transmission of \p frame: \p idleBytes random bytes, the preamble, the sync word and the frame
+ */
+static QByteArray transmission(const QByteArray &frame, int idleBytes, std::mt19937 &rng) {
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    QByteArray bytes;
+    for (int i = 0; i < idleBytes; i++) {
+        bytes.append(static_cast<char>(byteDistribution(rng)));
+    }
+    bytes.append(QByteArray(8, 0x55));
+    bytes.append(static_cast<char>(S1DEM_SYNC >> 8));
+    bytes.append(static_cast<char>(S1DEM_SYNC & 0xFF));
+    return bytes + frame;
+}
+
+/**
+ * @brief Returns the 8 bit I/Q samples an SDR would read for \p phases, with \p amplitude and noise
+ */
+static QByteArray sdrSamples(const QVector<double> &phases, double amplitude, std::mt19937 &rng) {
+    std::normal_distribution<double> noise(0.0, sdrNoise);
+    QByteArray iq(2 * phases.size(), 0);
+    for (int i = 0; i < phases.size(); i++) {
+        const double in_phase = 127.5 + amplitude * std::cos(phases[i]) + noise(rng);
+        const double quadrature = 127.5 + amplitude * std::sin(phases[i]) + noise(rng);
+        iq[2 * i] = static_cast<char>(qBound(0L, std::lround(in_phase), 255L));
+        iq[2 * i + 1] = static_cast<char>(qBound(0L, std::lround(quadrature), 255L));
+    }
+    return iq;
+}
+
+/**
+ * @brief Returns the 16 bit samples a sound card would record for \p phases, with \p amplitude and noise
+ */
+static QVector<std::int16_t> audioSamples(const QVector<double> &phases, double amplitude, std::mt19937 &rng) {
+    std::normal_distribution<double> noise(0.0, audioNoise);
+    QVector<std::int16_t> samples(phases.size());
+    for (int i = 0; i < phases.size(); i++) {
+        samples[i] = static_cast<std::int16_t>(
+            qBound(-32768L, std::lround(amplitude * std::cos(phases[i]) + noise(rng)), 32767L));
+    }
+    return samples;
+}
+
+/**
+ * @brief Counts the frames that \p receiver has received and FecDecoder could decode into one of \p payloads
+ */
+static int decodedFrames(const Receiver &receiver, const QList<QByteArray> &payloads) {
+    QList<QByteArray> decoded;
+    for (const QByteArray &frame : receiver.frames) {
+        const DecodedPacket packet = FecDecoder::decode(frame);
+        if (packet.getResult() == DecodedPacket::Success) {
+            decoded.append(packet.getDecodedPacket());
+        }
+    }
+    int count = 0;
+    for (const QByteArray &payload : payloads) {
+        count += decoded.contains(payload);
+    }
+    return count;
+}
+
+/**
+ * @brief Sends \p frames AO40 frames at a single Eb/N0 point through both chains of \p path
+ * @param path The front-end
+ * @param datarate The datarate of the frames and the demodulators
+ * @param audioRate The sampling rate of the sound card
+ * @param ebn0Db Energy per channel bit over noise density [dB]
+ * @param frames Number of frames
+ * @param rng The random generator
+ * @return The counters of the point
+ */
+static PointResult runPoint(Path path, long datarate, long audioRate, double ebn0Db, int frames, std::mt19937 &rng) {
+    PointResult result;
+    const double ebn0 = std::pow(10.0, ebn0Db / 10.0);
+    const double samplingRate = path == Path::SDR ? sdrSamplingRate : audioRate;
+    // The noise is fixed, like the noise floor of a receiver, the amplitude of the signal gives the Eb/N0
+    const double amplitude = path == Path::SDR ? sdrNoise * std::sqrt(2.0 * datarate * ebn0 / samplingRate)
+                                               : audioNoise * std::sqrt(4.0 * datarate * ebn0 / samplingRate);
+    Modulator modulator(samplingRate, path == Path::SDR ? sdrCarrier : S1DEM_AUDIO_FREQ_CENTER_OFFSET, datarate);
+    Chain floatChain(path, datarate, audioRate, false);
+    Chain fixedChain(path, datarate, audioRate, true);
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    QList<QByteArray> payloads;
+    QElapsedTimer timer;
+
+    for (int f = 0; f <= frames; f++) {
+        QByteArray bytes;
+        if (f < frames) {
+            QByteArray payload(AO40_DECDOWNLINKLENGTH, 0);
+            for (int i = 0; i < payload.length(); i++) {
+                payload[i] = static_cast<char>(byteDistribution(rng));
+            }
+            payloads.append(payload);
+            QByteArray frame(AO40_DOWNLINKLENGTH, 0);
+            ao40_encode_data(
+                reinterpret_cast<const uint8_t *>(payload.constData()), reinterpret_cast<uint8_t *>(frame.data()));
+            // The demodulators settle during the first idle bytes
+            bytes = transmission(frame, f == 0 ? 16 : 4, rng);
+        }
+        else {
+            bytes = QByteArray(4, 0x55); // Flushes the last frame out of the filters
+        }
+        const QVector<double> phases = modulator.modulate(bytes);
+        result.samples += phases.size();
+        if (path == Path::SDR) {
+            const QByteArray iq = sdrSamples(phases, amplitude, rng);
+            timer.start();
+            floatChain.processSdr(iq);
+            result.floatNs += timer.nsecsElapsed();
+            timer.start();
+            fixedChain.processSdr(iq);
+            result.fixedNs += timer.nsecsElapsed();
+        }
+        else {
+            const QVector<std::int16_t> samples = audioSamples(phases, amplitude, rng);
+            timer.start();
+            floatChain.processAudio(samples);
+            result.floatNs += timer.nsecsElapsed();
+            timer.start();
+            fixedChain.processAudio(samples);
+            result.fixedNs += timer.nsecsElapsed();
+        }
+    }
+
+    result.frames = frames;
+    result.floatDecoded = decodedFrames(floatChain.receiver, payloads);
+    result.fixedDecoded = decodedFrames(fixedChain.receiver, payloads);
+    result.identical = floatChain.receiver.frames == fixedChain.receiver.frames;
+    const QVector<uint8_t> &floatDecisions = floatChain.receiver.decisions;
+    const QVector<uint8_t> &fixedDecisions = fixedChain.receiver.decisions;
+    result.decisions = floatDecisions.size();
+    for (int i = 0; i < qMin(floatDecisions.size(), fixedDecisions.size()); i++) {
+        result.equalDecisions += floatDecisions[i] == fixedDecisions[i];
+    }
+    return result;
+}
+
+/**
+ * @brief Converts \p result into the JSON object of a point
+ */
+static QJsonObject pointToJson(double ebn0Db, const PointResult &result) {
+    QJsonObject point;
+    point["ebn0_db"] = ebn0Db;
+    point["frames"] = result.frames;
+    point["float_fer"] = static_cast<double>(result.frames - result.floatDecoded) / result.frames;
+    point["fixed_fer"] = static_cast<double>(result.frames - result.fixedDecoded) / result.frames;
+    point["identical_frames"] = result.identical;
+    point["decision_agreement"] = static_cast<double>(result.equalDecisions) / qMax<qint64>(1, result.decisions);
+    point["float_ns_per_sample"] = static_cast<double>(result.floatNs) / result.samples;
+    point["fixed_ns_per_sample"] = static_cast<double>(result.fixedNs) / result.samples;
+    return point;
+}
+
+/**
+ * @brief Sends AO40 frames at a sweep of Eb/N0 values through the SDR and the audio front-ends, then demodulates them
+ * with the floating-point and the fixed-point chain of newsmog1dem, like SDRWorker and AudioInDemodulator do. Writes
+ * the frame error rates, the agreement of the hard decisions and the speed of the chains as JSON.
+ *
+ * Returns 1 if the fixed-point chain is worse than the floating-point one anywhere: if less than --agreement of its
+ * hard decisions are the same, or its frame error rate is higher by more than --tolerance.
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("dspcheck");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Fixed-point and floating-point DSP chain comparison");
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Frames per Eb/N0 point.", "count", "20");
+    QCommandLineOption fromOption("from", "First Eb/N0 point [dB].", "dB", "4");
+    QCommandLineOption toOption("to", "Last Eb/N0 point [dB].", "dB", "14");
+    QCommandLineOption stepOption("step", "Eb/N0 step [dB].", "dB", "2");
+    QCommandLineOption seedOption("seed", "Seed of the random generator.", "seed", "1");
+    QCommandLineOption audioRateOption("audio-rate", "Sampling rate of the sound card [Hz].", "Hz", "48000");
+    QCommandLineOption toleranceOption(
+        "tolerance", "Frame error rate the fixed-point chain may lose at a point.", "rate", "0.1");
+    QCommandLineOption agreementOption(
+        "agreement", "Part of the hard decisions that have to be the same at a point.", "part", "0.999");
+    QCommandLineOption outputOption("output", "Write the JSON results to this file instead of stdout.", "file");
+    parser.addOptions({framesOption,
+        fromOption,
+        toOption,
+        stepOption,
+        seedOption,
+        audioRateOption,
+        toleranceOption,
+        agreementOption,
+        outputOption});
+    parser.process(app);
+
+    int frames = parser.value(framesOption).toInt();
+    double from = parser.value(fromOption).toDouble();
+    double to = parser.value(toOption).toDouble();
+    double step = parser.value(stepOption).toDouble();
+    unsigned int seed = parser.value(seedOption).toUInt();
+    long audioRate = parser.value(audioRateOption).toLong();
+    double tolerance = parser.value(toleranceOption).toDouble();
+    double agreement = parser.value(agreementOption).toDouble();
+    if (frames <= 0 || step <= 0 || to < from || audioRate <= 0) {
+        qCritical() << "Invalid sweep";
+        return 1;
+    }
+
+    // The RA decoder logs every frame that does not converge
+    QLoggingCategory::setFilterRules("*.debug=false");
+    FecDecoder::initTables();
+
+    const QList<QPair<Path, long>> chains = {{Path::SDR, 1250},
+        {Path::SDR, 2500},
+        {Path::SDR, 5000},
+        {Path::SDR, 12500},
+        {Path::Audio, 1250},
+        {Path::Audio, 2500},
+        {Path::Audio, 5000}};
+
+    std::mt19937 rng(seed);
+    QTextStream progress(stderr);
+    QJsonArray chainsJson;
+    bool passed = true;
+    for (const QPair<Path, long> &chain : chains) {
+        const QString name = QString("%1 %2 BPS").arg(chain.first == Path::SDR ? "SDR" : "Audio").arg(chain.second);
+        QJsonArray points;
+        for (int i = 0; from + i * step <= to + 1e-9; i++) {
+            double ebn0Db = from + i * step;
+            PointResult result = runPoint(chain.first, chain.second, audioRate, ebn0Db, frames, rng);
+            QJsonObject point = pointToJson(ebn0Db, result);
+            points.append(point);
+            const bool pointPassed = point["decision_agreement"].toDouble() >= agreement &&
+                                     point["fixed_fer"].toDouble() - point["float_fer"].toDouble() <= tolerance;
+            passed = passed && pointPassed;
+            progress << name << " " << ebn0Db << " dB: FER " << point["float_fer"].toDouble() << " / "
+                     << point["fixed_fer"].toDouble() << ", decisions " << point["decision_agreement"].toDouble()
+                     << (result.identical ? ", identical" : "") << (pointPassed ? "" : ", FAILED") << "\n";
+            progress.flush();
+        }
+        QJsonObject chainJson;
+        chainJson["name"] = name;
+        chainJson["datarate"] = static_cast<double>(chain.second);
+        chainJson["sampling_rate"] = static_cast<double>(chain.first == Path::SDR ? sdrSamplingRate : audioRate);
+        chainJson["points"] = points;
+        chainsJson.append(chainJson);
+    }
+
+    QJsonObject root;
+    root["benchmark"] = "dspcheck";
+    root["qt_version"] = qVersion();
+    root["frames_per_point"] = frames;
+    root["seed"] = static_cast<double>(seed);
+    root["passed"] = passed;
+    root["chains"] = chainsJson;
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Could not open" << file.fileName() << "for writing";
+            return 1;
+        }
+        file.write(json);
+    }
+    else {
+        QTextStream(stdout) << json;
+    }
+    if (!passed) {
+        qCritical() << "The fixed-point chain is worse than the floating-point one";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "alloccount.h"
+#include <errno.h>
+#include <stddef.h>
+#include <stdlib.h>
+
+#ifdef __GLIBC__
+
+/* The executable's definitions take precedence over the C library for every
+ * shared library too, so allocations made by Qt are counted as well. The
+ * memory still comes from the glibc allocator, free needs no wrapper. */
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+
+static long fecbench_count = 0;
+
+static inline void fecbench_count_one(void) {
+  __atomic_add_fetch(&fecbench_count, 1, __ATOMIC_RELAXED);
+}
+
+void *malloc(size_t size) {
+  fecbench_count_one();
+  return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+  fecbench_count_one();
+  return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+  fecbench_count_one();
+  return __libc_realloc(ptr, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+  fecbench_count_one();
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) {
+  void *ptr;
+
+  fecbench_count_one();
+  ptr = __libc_memalign(alignment, size);
+  if (ptr == NULL)
+    return ENOMEM;
+  *memptr = ptr;
+  return 0;
+}
+
+long fecbench_allocations(void) {
+  return __atomic_load_n(&fecbench_count, __ATOMIC_RELAXED);
+}
+
+#else
+
+long fecbench_allocations(void) {
+  return -1;
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef ALLOCCOUNT_H
+#define ALLOCCOUNT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Number of heap allocations made by the whole process so far, or -1 where
+ * the C library cannot be interposed */
+long fecbench_allocations(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ALLOCCOUNT_H
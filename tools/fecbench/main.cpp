@@ -0,0 +1,291 @@
+#include "alloccount.h"
+#include "dependencies/FEC-AO40/ao40-short/encode/ao40short_encode_message.h"
+#include "dependencies/FEC-AO40/ao40/encode/ao40_encode_message.h"
+#include "dependencies/racoder/ra_encoder.h"
+#include "source/packet/fecdecoder.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QStringList>
+#include <QTextStream>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <vector>
+
+/**
+ * @brief A downlink code under test
+ */
+struct Codec {
+    QString name;                                          //!< Name, as PacketDecoder reports the encoding
+    int dataLength;                                        //!< Payload length [bytes]
+    std::function<QByteArray(const QByteArray &)> encode; //!< Encodes a payload into a frame
+};
+
+/**
+ * @brief Counters of a single Eb/N0 point
+ */
+struct PointResult {
+    int frames = 0;
+    int failed = 0;           //!< Frames that the decoder reported as failed
+    int undetected = 0;       //!< Frames that the decoder reported as successful, but were wrong
+    qint64 bitErrors = 0;     //!< Payload bit errors
+    qint64 channelErrors = 0; //!< Bits flipped by the channel
+    qint64 channelBits = 0;
+    qint64 decodeNs = 0;
+    qint64 allocations = 0;
+};
+
+/**
+ * @brief Encodes \p data with AO40
+ * @param data 256 bytes of payload
+ * @return The 650 byte frame
+ */
+static QByteArray encodeAO40(const QByteArray &data) {
+    QByteArray frame(AO40_DOWNLINKLENGTH, 0);
+    ao40_encode_data(reinterpret_cast<const uint8_t *>(data.constData()), reinterpret_cast<uint8_t *>(frame.data()));
+    return frame;
+}
+
+/**
+ * @brief Encodes \p data with AO40 short
+ * @param data 128 bytes of payload
+ * @return The 333 byte frame
+ */
+static QByteArray encodeAO40Short(const QByteArray &data) {
+    QByteArray frame(AO40SHORT_DOWNLINKLENGTH, 0);
+    ao40short_encode_data(
+        reinterpret_cast<const uint8_t *>(data.constData()), reinterpret_cast<uint8_t *>(frame.data()));
+    return frame;
+}
+
+/**
+ * @brief Encodes \p data with the RA code of its length
+ * @param data The payload, a power of 2 bytes long
+ * @return The frame, in the byte order FecDecoder::decodeWithRA expects
+ */
+static QByteArray encodeRA(const QByteArray &data) {
+    ra_index_t words = static_cast<ra_index_t>(data.length() / sizeof(ra_word_t));
+    ra_length_init(words);
+    std::vector<ra_word_t> packet(words);
+    std::vector<ra_word_t> code(ra_code_length);
+    memcpy(packet.data(), data.constData(), static_cast<size_t>(data.length()));
+    ra_encoder(packet.data(), code.data());
+    return QByteArray(reinterpret_cast<const char *>(code.data()), ra_code_length * sizeof(ra_word_t));
+}
+
+/**
+ * @brief Sends \p frame over a BPSK channel with additive white Gaussian noise and hard decisions.
+ * @param frame The frame, modified in place
+ * @param sigma Standard deviation of the noise, for symbols of unit amplitude
+ * @param rng The random generator
+ * @return The number of flipped bits
+ */
+static qint64 transmit(QByteArray &frame, double sigma, std::mt19937 &rng) {
+    std::normal_distribution<double> noise(0.0, sigma);
+    qint64 flipped = 0;
+    for (int i = 0; i < frame.length(); i++) {
+        char byte = frame.at(i);
+        for (int bit = 0; bit < 8; bit++) {
+            // The noise is symmetric, so a decision error has the same probability for both symbols
+            if (noise(rng) > 1.0) {
+                byte ^= static_cast<char>(1 << bit);
+                flipped++;
+            }
+        }
+        frame[i] = byte;
+    }
+    return flipped;
+}
+
+/**
+ * @brief Counts the bits in which \p a and \p b differ
+ */
+static qint64 bitDifference(const QByteArray &a, const QByteArray &b) {
+    qint64 count = 0;
+    for (int i = 0; i < a.length(); i++) {
+        count += __builtin_popcount(static_cast<uint8_t>(a.at(i) ^ b.at(i)));
+    }
+    return count;
+}
+
+/**
+ * @brief Runs \p frames frames of \p codec at a single Eb/N0 point
+ * @param codec The code under test
+ * @param ebn0Db Energy per payload bit over noise density [dB]
+ * @param frames Number of frames
+ * @param rng The random generator
+ * @return The counters of the point
+ */
+static PointResult runPoint(const Codec &codec, double ebn0Db, int frames, std::mt19937 &rng) {
+    PointResult result;
+    std::uniform_int_distribution<int> byteDistribution(0, 255);
+    QByteArray data(codec.dataLength, 0);
+    QElapsedTimer timer;
+
+    for (int f = 0; f < frames; f++) {
+        for (int i = 0; i < data.length(); i++) {
+            data[i] = static_cast<char>(byteDistribution(rng));
+        }
+        QByteArray frame = codec.encode(data);
+        double rate = static_cast<double>(codec.dataLength) / frame.length();
+        double sigma = std::sqrt(1.0 / (2.0 * rate * std::pow(10.0, ebn0Db / 10.0)));
+        result.channelErrors += transmit(frame, sigma, rng);
+        result.channelBits += frame.length() * 8;
+
+        long allocationsBefore = fecbench_allocations();
+        timer.start();
+        DecodedPacket decoded = FecDecoder::decode(frame);
+        result.decodeNs += timer.nsecsElapsed();
+        result.allocations += fecbench_allocations() - allocationsBefore;
+
+        QByteArray payload = decoded.getDecodedPacket();
+        qint64 errors = 0;
+        if (payload.length() == data.length()) {
+            errors = bitDifference(payload, data);
+        }
+        else {
+            // Nothing to compare, the receiver could only guess the bits
+            errors = codec.dataLength * 8 / 2;
+        }
+        result.bitErrors += errors;
+        result.frames++;
+        if (decoded.getResult() != DecodedPacket::Success) {
+            result.failed++;
+        }
+        else if (errors) {
+            result.undetected++;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Converts \p result into the JSON object of a point
+ */
+static QJsonObject pointToJson(double ebn0Db, const PointResult &result, int dataLength) {
+    double dataBits = static_cast<double>(result.frames) * dataLength * 8;
+    double seconds = result.decodeNs / 1e9;
+    QJsonObject point;
+    point["ebn0_db"] = ebn0Db;
+    point["frames"] = result.frames;
+    point["channel_ber"] = static_cast<double>(result.channelErrors) / result.channelBits;
+    point["ber"] = result.bitErrors / dataBits;
+    point["fer"] = static_cast<double>(result.failed + result.undetected) / result.frames;
+    point["failed_frames"] = result.failed;
+    point["undetected_frames"] = result.undetected;
+    point["frames_per_second"] = seconds > 0 ? result.frames / seconds : 0.0;
+    point["ns_per_bit"] = result.decodeNs / dataBits;
+    point["allocations_per_frame"] =
+        fecbench_allocations() < 0 ? -1.0 : static_cast<double>(result.allocations) / result.frames;
+    return point;
+}
+
+/**
+ * @brief Encodes random payloads with every downlink code, adds noise at a sweep of Eb/N0 values and decodes them
+ * through FecDecoder, the same code PacketDecoder uses. Writes the speed and the BER / FER curves as JSON.
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("fecbench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("FEC decoder speed and BER / FER benchmark");
+    parser.addHelpOption();
+    QCommandLineOption framesOption("frames", "Frames per Eb/N0 point.", "count", "100");
+    QCommandLineOption fromOption("from", "First Eb/N0 point [dB].", "dB", "0");
+    QCommandLineOption toOption("to", "Last Eb/N0 point [dB].", "dB", "8");
+    QCommandLineOption stepOption("step", "Eb/N0 step [dB].", "dB", "0.5");
+    QCommandLineOption seedOption("seed", "Seed of the random generator.", "seed", "1");
+    QCommandLineOption codecsOption("codecs",
+        "Comma separated list of codes, default is all: AO40,AO40Short,RA128,RA256,RA512,RA1024,RA2048.",
+        "codecs");
+    QCommandLineOption outputOption("output", "Write the JSON results to this file instead of stdout.", "file");
+    parser.addOptions({framesOption, fromOption, toOption, stepOption, seedOption, codecsOption, outputOption});
+    parser.process(app);
+
+    int frames = parser.value(framesOption).toInt();
+    double from = parser.value(fromOption).toDouble();
+    double to = parser.value(toOption).toDouble();
+    double step = parser.value(stepOption).toDouble();
+    unsigned int seed = parser.value(seedOption).toUInt();
+    if (frames <= 0 || step <= 0 || to < from) {
+        qCritical() << "Invalid sweep";
+        return 1;
+    }
+
+    QList<Codec> codecs = {
+        {"AO40", AO40_DECDOWNLINKLENGTH, encodeAO40},
+        {"AO40Short", AO40SHORT_DECDOWNLINKLENGTH, encodeAO40Short},
+    };
+    for (int length = 128; length <= 2048; length *= 2) {
+        codecs.append(Codec{"RA" + QString::number(length), length, encodeRA});
+    }
+    if (parser.isSet(codecsOption)) {
+        QStringList selected = parser.value(codecsOption).split(',');
+        QList<Codec> filtered;
+        for (const Codec &codec : codecs) {
+            if (selected.contains(codec.name)) {
+                filtered.append(codec);
+            }
+        }
+        codecs = filtered;
+    }
+
+    // The RA decoder logs every frame that does not converge, the failure counts already include them
+    QLoggingCategory::setFilterRules("*.debug=false");
+    FecDecoder::initTables();
+
+    std::mt19937 rng(seed);
+    QTextStream progress(stderr);
+    QJsonArray codecsJson;
+    for (const Codec &codec : codecs) {
+        QJsonArray points;
+        int frameLength = codec.encode(QByteArray(codec.dataLength, 0)).length();
+        for (int i = 0; from + i * step <= to + 1e-9; i++) {
+            double ebn0Db = from + i * step;
+            PointResult result = runPoint(codec, ebn0Db, frames, rng);
+            QJsonObject point = pointToJson(ebn0Db, result, codec.dataLength);
+            points.append(point);
+            progress << codec.name << " " << ebn0Db << " dB: FER " << point["fer"].toDouble() << ", "
+                     << point["frames_per_second"].toDouble() << " frames/s\n";
+            progress.flush();
+        }
+        QJsonObject codecJson;
+        codecJson["name"] = codec.name;
+        codecJson["data_bytes"] = codec.dataLength;
+        codecJson["frame_bytes"] = frameLength;
+        codecJson["rate"] = static_cast<double>(codec.dataLength) / frameLength;
+        codecJson["points"] = points;
+        codecsJson.append(codecJson);
+    }
+
+    QJsonObject root;
+    root["benchmark"] = "fecbench";
+    root["qt_version"] = qVersion();
+    root["frames_per_point"] = frames;
+    root["seed"] = static_cast<double>(seed);
+    root["allocations_counted"] = fecbench_allocations() >= 0;
+    root["codecs"] = codecsJson;
+    QByteArray json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+
+    if (parser.isSet(outputOption)) {
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical() << "Could not open" << file.fileName() << "for writing";
+            return 1;
+        }
+        file.write(json);
+    }
+    else {
+        QTextStream(stdout) << json;
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "source/packet/archiveredecoder.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QTextStream>
+
+/**
+ * @brief Parses a date and time given on the command line, interpreted as UTC unless it has an offset
+ */
+static QDateTime parseDateTime(const QString &text) {
+    QDateTime dateTime = QDateTime::fromString(text, Qt::ISODate);
+    if (dateTime.isValid() && dateTime.timeSpec() == Qt::LocalTime) {
+        dateTime.setTimeSpec(Qt::UTC);
+    }
+    return dateTime;
+}
+
+/**
+ * @brief Decodes the frames of a packet archive again with the current FEC decoders and writes them into a new
+ * archive generation. Reports the progress and the throughput on stderr.
+ */
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("redecode");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Decodes an archive of received frames again into a new archive generation");
+    parser.addHelpOption();
+    parser.addPositionalArgument("source", "Directory of the archive, e.g. logs/");
+    parser.addPositionalArgument("target", "Directory of the new generation, must differ from the source");
+    QCommandLineOption threadsOption("threads", "Decoder threads, default is every core.", "count");
+    QCommandLineOption fromOption("from", "Only frames received at or after this ISO 8601 time (UTC).", "time");
+    QCommandLineOption toOption("to", "Only frames received at or before this ISO 8601 time (UTC).", "time");
+    parser.addOptions({threadsOption, fromOption, toOption});
+    parser.process(app);
+
+    const QStringList arguments = parser.positionalArguments();
+    if (arguments.size() != 2) {
+        parser.showHelp(1);
+    }
+
+    PacketArchiveQuery query;
+    if (parser.isSet(fromOption)) {
+        query.from = parseDateTime(parser.value(fromOption));
+    }
+    if (parser.isSet(toOption)) {
+        query.to = parseDateTime(parser.value(toOption));
+    }
+    if ((parser.isSet(fromOption) && !query.from.isValid()) || (parser.isSet(toOption) && !query.to.isValid())) {
+        qCritical() << "Invalid time range";
+        return 1;
+    }
+
+    // The RA decoder logs every frame that does not converge, the statistics already count them
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    ArchiveRedecoder redecoder(arguments.at(0), arguments.at(1));
+    redecoder.setQuery(query);
+    if (parser.isSet(threadsOption)) {
+        redecoder.setThreadCount(parser.value(threadsOption).toInt());
+    }
+    QTextStream progress(stderr);
+    redecoder.setProgressCallback([&progress](const RedecodeStatistics &statistics) {
+        const double percent = statistics.totalFrames ? 100.0 * statistics.frames / statistics.totalFrames : 100.0;
+        progress << "\r" << statistics.frames << " / " << statistics.totalFrames << " frames ("
+                 << QString::number(percent, 'f', 1) << " %), " << QString::number(statistics.framesPerSecond(), 'f', 0)
+                 << " frames/s   ";
+        progress.flush();
+    });
+
+    const bool success = redecoder.run();
+    const RedecodeStatistics &statistics = redecoder.statistics();
+    const double seconds = statistics.elapsedMs / 1000.0;
+    progress << "\n"
+             << statistics.frames << " frames in " << QString::number(seconds, 'f', 1) << " s ("
+             << QString::number(statistics.framesPerSecond(), 'f', 0) << " frames/s, "
+             << QString::number(seconds > 0 ? statistics.encodedBytes / seconds / 1e6 : 0.0, 'f', 2)
+             << " MB/s encoded)\n"
+             << "  decoded again: " << statistics.redecoded << ", failed: " << statistics.failed
+             << ", changed: " << statistics.changed << ", copied without FEC: " << statistics.passedThrough << "\n";
+    progress.flush();
+    return success ? 0 : 1;
+}
@@ -0,0 +1,53 @@
+# Decodes a packet archive again into a new archive generation, built separately from the application
+# (or with tools/tools.pro):
+#   qmake tools/redecode/redecode.pro && make && ./redecode logs/ logs-redecoded/
+
+TEMPLATE = app
+TARGET = redecode
+
+QT = core
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+ROOT = $$PWD/../..
+INCLUDEPATH += $$ROOT
+
+QMAKE_CXXFLAGS += -Wall -Wextra -Wpedantic
+
+HEADERS += \
+    $$ROOT/source/packet/archiveredecoder.h \
+    $$ROOT/source/packet/decodedpacket.h \
+    $$ROOT/source/packet/fecdecoder.h \
+    $$ROOT/source/packet/packetarchive.h \
+    $$ROOT/source/utilities/satellitechanger.h \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_message.h \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_rs.h \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_spiral-vit_scalar_1280.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_message.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_spiral-vit_scalar.h \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_rs.h \
+    $$ROOT/dependencies/FEC-AO40/common/ao40_unpack.h \
+    $$ROOT/dependencies/racoder/ra_config.h \
+    $$ROOT/dependencies/racoder/ra_decoder_gen.h \
+    $$ROOT/dependencies/racoder/ra_encoder.h \
+    $$ROOT/dependencies/racoder/ra_lfsr.h \
+
+SOURCES += \
+    main.cpp \
+    $$ROOT/source/packet/archiveredecoder.cpp \
+    $$ROOT/source/packet/decodedpacket.cpp \
+    $$ROOT/source/packet/fecdecoder.cpp \
+    $$ROOT/source/packet/packetarchive.cpp \
+    $$ROOT/source/utilities/satellitechanger.cpp \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_message.c \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_decode_rs.c \
+    $$ROOT/dependencies/FEC-AO40/ao40-short/decode/ao40short_spiral-vit_scalar_1280.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_message.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_spiral-vit_scalar.c \
+    $$ROOT/dependencies/FEC-AO40/ao40/decode/ao40_decode_rs.c \
+    $$ROOT/dependencies/FEC-AO40/common/ao40_unpack.c \
+    $$ROOT/dependencies/racoder/ra_config.c \
+    $$ROOT/dependencies/racoder/ra_decoder_gen.c \
+    $$ROOT/dependencies/racoder/ra_encoder.c \
+    $$ROOT/dependencies/racoder/ra_lfsr.c \
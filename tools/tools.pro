@@ -0,0 +1,10 @@
+# The command line tools, built separately from the application:
+#   qmake tools/tools.pro && make
+# fecbench writes the FEC decoder benchmark, see tools/fecbench/results.json for a sweep.
+
+TEMPLATE = subdirs
+
+SUBDIRS += \
+    dspcheck \
+    fecbench \
+    redecode \